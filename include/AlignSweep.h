@@ -0,0 +1,146 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Interface for sweeping buffer alignments and tail lengths.
+ *
+ *  19-Oct-2026   Initial implementation of alignment sweeps.
+ */
+
+/** @file
+ *  Alignment sweeps (user interface).
+ *  An alignment sweep calls a kernel test with input and output buffers
+ *  from the guard-paged arena (see GuardArena.h), once for every offset
+ *  0 to CU_ALIGN_SWEEP_OFFSETS - 1 from a 64-byte boundary and, if
+ *  configured, every tail length added to the base length.  Both
+ *  buffers have the same offset.  The input is filled before each call,
+ *  the output is filled with the canary of its slot,
+ *  CU_GUARD_SLOT_CANARY(1), which differs from the canary around the
+ *  input.
+ *
+ *  A sweep is run from within a test (CU_ASSERT_ALIGN_SWEEP()).  The
+ *  conditions of failures recorded by the kernel test are prefixed with
+ *  the offset and length, e.g. "[offset 13, length 67] ".  Accesses to a
+ *  guard page (LINUX builds) and overwritten canaries are recorded as
+ *  failures of the offset as well.  After the checked call, the kernel
+ *  test is timed in a few more calls with failed assertions only
+ *  counted, and the fastest time of each offset and length is printed as
+ *  a matrix.
+ */
+/** @addtogroup Framework
+ * @{
+ */
+
+#ifndef CUNIT_ALIGNSWEEP_H_SEEN
+#define CUNIT_ALIGNSWEEP_H_SEEN
+
+#include <stddef.h>
+
+#include "CUnit.h"
+#include "CUError.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CU_ALIGN_SWEEP_OFFSETS 64
+/**< Number of offsets swept. */
+
+#define CU_ALIGN_SWEEP_MAX_TAILS 64
+/**< Maximum number of tail lengths swept. */
+
+/** Buffers passed to a kernel test. */
+typedef struct CU_AlignBuffers
+{
+  const void*  pInput;         /**< Input buffer. */
+  size_t       nInputLength;   /**< Bytes in pInput. */
+  void*        pOutput;        /**< Output buffer. */
+  size_t       nOutputLength;  /**< Bytes in pOutput. */
+  unsigned int uiOffset;       /**< Offset of both buffers from a 64-byte boundary. */
+  size_t       nTail;          /**< Bytes added to the base lengths. */
+} CU_AlignBuffers;
+
+typedef void (*CU_AlignSweepTest)(const CU_AlignBuffers *pBuffers);
+/**< Kernel test, running the kernel on the buffers and checking its output. */
+
+typedef void (*CU_AlignSweepFill)(void *pInput, size_t nLength);
+/**< Fills the input buffer before a call of the kernel test. */
+
+/** Description of an alignment sweep. */
+typedef struct CU_AlignSweepSpec
+{
+  CU_AlignSweepTest pTest;          /**< Kernel test. */
+  CU_AlignSweepFill pFill;          /**< Input filler (NULL for a fixed byte pattern). */
+  size_t            nInputLength;   /**< Input bytes without tail. */
+  size_t            nOutputLength;  /**< Output bytes without tail (0 for nInputLength). */
+  unsigned int      uiTails;        /**< Tail lengths swept (0 or 1 for none, at most CU_ALIGN_SWEEP_MAX_TAILS). */
+  size_t            nTailStep;      /**< Bytes between tail lengths (0 for 1). */
+  unsigned int      uiTimedCalls;   /**< Timed calls per offset and length (0 for no timing). */
+} CU_AlignSweepSpec;
+
+/** Outcome of an alignment sweep. */
+typedef struct CU_AlignSweepResult
+{
+  unsigned int uiCells;          /**< Offsets times tail lengths swept. */
+  unsigned int uiFailedCells;    /**< Cells with failures. */
+  unsigned int uiFirstOffset;    /**< Offset of the first failed cell. */
+  size_t       nFirstTail;       /**< Tail of the first failed cell. */
+  double       adNs[CU_ALIGN_SWEEP_OFFSETS][CU_ALIGN_SWEEP_MAX_TAILS];  /**< Fastest timed call of each cell, 0 if not timed. */
+  CU_BOOL      abFailed[CU_ALIGN_SWEEP_OFFSETS][CU_ALIGN_SWEEP_MAX_TAILS];  /**< Whether a cell failed. */
+} CU_AlignSweepResult;
+typedef CU_AlignSweepResult* CU_pAlignSweepResult;  /**< Pointer to an alignment sweep outcome. */
+
+CU_EXPORT CU_ErrorCode CU_align_sweep(const CU_AlignSweepSpec *pSpec, CU_pAlignSweepResult pResult);
+/**<
+ *  Runs an alignment sweep within the current test and prints its
+ *  timing matrix.  Failures are reported in pResult and as failure
+ *  records of the current test, not as an error.
+ *
+ *  CU_align_sweep() sets the following error codes:
+ *  - CUE_SUCCESS if the sweep ran.
+ *  - CUE_NOTEST if no test is running.
+ *  - CUE_NOMEMORY if the guard-paged arena could not be opened.
+ *  - CUE_NOT_SUPPORTED on builds without guard pages.
+ *
+ *  @param pSpec   The sweep (non-NULL).
+ *  @param pResult Receives the outcome (non-NULL).
+ *  @return A CU_ErrorCode indicating the error status.
+ */
+
+CU_EXPORT CU_BOOL CU_assertAlignSweepImplementation(const CU_AlignSweepSpec *pSpec,
+                                                    unsigned int uiLine, const char *strCondition,
+                                                    const char *strFile, const char *strFunction,
+                                                    CU_BOOL bFatal);
+/**<
+ *  Implementation of CU_ASSERT_ALIGN_SWEEP().  Passes if the sweep ran
+ *  and no cell failed; the failure names the failed cells.
+ */
+
+#define CU_ASSERT_ALIGN_SWEEP(spec) \
+  { CU_assertAlignSweepImplementation((spec), __LINE__, ("CU_ASSERT_ALIGN_SWEEP(" #spec ")"), __FILE__, "", CU_FALSE); }
+/**< Asserts that a kernel test passes at all offsets and tail lengths. */
+
+#define CU_ASSERT_ALIGN_SWEEP_FATAL(spec) \
+  { CU_assertAlignSweepImplementation((spec), __LINE__, ("CU_ASSERT_ALIGN_SWEEP_FATAL(" #spec ")"), __FILE__, "", CU_TRUE); }
+/**< Fatal version of CU_ASSERT_ALIGN_SWEEP(). */
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /*  CUNIT_ALIGNSWEEP_H_SEEN  */
+/** @} */
@@ -0,0 +1,138 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Interface for antagonist threads loading the machine during benchmarks.
+ *
+ *  19-Oct-2026   Initial implementation of antagonist load.
+ */
+
+/** @file
+ *  Antagonist load (user interface).
+ *  Antagonists are threads competing with a benchmark for shared
+ *  resources, imitating noisy neighbours on the same machine:
+ *
+ *  - memory bandwidth hogs stream through a large buffer,
+ *  - cache thrashers touch random lines of a buffer about the size of
+ *    the last level cache,
+ *  - spinners execute unpredictable branches on their core.
+ *
+ *  CU_antagonist_open() pins the calling thread to the CPU it runs on
+ *  and creates the antagonists parked; they are pinned to other cores,
+ *  to the hyper-thread siblings of the calling thread's core, or not at
+ *  all.  CU_antagonist_start() and CU_antagonist_stop() release and park
+ *  them, each returning once all antagonists have followed, so they
+ *  only load the machine around the measured region.
+ *
+ *  While the antagonists are open, bench runs (see Bench.h) measure
+ *  every test again under load after the quiet samples and report the
+ *  slowdown.  Antagonists are only available on LINUX builds.
+ */
+/** @addtogroup Framework
+ * @{
+ */
+
+#ifndef CUNIT_ANTAGONIST_H_SEEN
+#define CUNIT_ANTAGONIST_H_SEEN
+
+#include <stddef.h>
+
+#include "CUnit.h"
+#include "CUError.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CU_ANTAGONIST_MAX_THREADS 16
+/**< Maximum number of antagonist threads. */
+
+#define CU_ANTAGONIST_ARENA_SIZE (128UL * 1024UL * 1024UL)
+/**< Maximum bytes mapped for the buffers of all antagonists while they are open. */
+
+/** Kinds of antagonists. */
+typedef enum CU_AntagonistKind
+{
+  CUAK_MemoryBandwidth = 0, /**< Streams through a buffer, consuming memory bandwidth. */
+  CUAK_CacheThrash,         /**< Touches random lines, evicting the last level cache. */
+  CUAK_Spinner,             /**< Executes unpredictable branches, occupying a core. */
+  CUAK_NumKinds             /**< Number of kinds (not a kind). */
+} CU_AntagonistKind;
+
+/** CPUs the antagonists are pinned to. */
+typedef enum CU_AntagonistPlacement
+{
+  CUAP_OtherCores = 0,      /**< Cores other than the one of the calling thread. */
+  CUAP_SiblingCores,        /**< Hyper-thread siblings of the calling thread's CPU. */
+  CUAP_Unpinned             /**< Any CPU but the measuring one, chosen by the scheduler. */
+} CU_AntagonistPlacement;
+
+/** Parameters of the antagonists. */
+typedef struct CU_AntagonistConfig
+{
+  unsigned int           auiThreads[CUAK_NumKinds];  /**< Threads of each kind. */
+  CU_AntagonistPlacement ePlacement;                 /**< CPUs the threads are pinned to. */
+  size_t                 nBandwidthBytes;            /**< Buffer size of each bandwidth hog. */
+  size_t                 nCacheBytes;                /**< Buffer size of each cache thrasher. */
+} CU_AntagonistConfig;
+typedef CU_AntagonistConfig* CU_pAntagonistConfig;  /**< Pointer to an antagonist configuration. */
+
+CU_EXPORT void CU_antagonist_default_config(CU_pAntagonistConfig pConfig);
+/**<
+ *  Fills pConfig with the default parameters: one antagonist of each
+ *  kind on other cores, with buffers of 32 MB (bandwidth) and 8 MB
+ *  (cache).
+ *
+ *  @param pConfig The configuration to initialize (non-NULL).
+ */
+
+CU_EXPORT CU_ErrorCode CU_antagonist_open(const CU_AntagonistConfig *pConfig);
+/**<
+ *  Pins the calling thread to its current CPU, maps the buffers and
+ *  creates the parked antagonists.  The buffers are unmapped by
+ *  CU_antagonist_close().  Antagonists already open are closed first.
+ *
+ *  CU_antagonist_open() sets the following error codes:
+ *  - CUE_SUCCESS if the antagonists were created.
+ *  - CUE_NOMEMORY if there are too many threads, their buffers do not
+ *    fit CU_ANTAGONIST_ARENA_SIZE or could not be mapped.
+ *  - CUE_NOT_SUPPORTED if no CPU matches the placement, or on builds
+ *    without thread affinity.
+ *  - CUE_THREAD_FAILED if a thread could not be created.
+ *
+ *  @param pConfig Parameters of the antagonists (NULL for the defaults).
+ *  @return A CU_ErrorCode indicating the error status.
+ */
+
+CU_EXPORT void CU_antagonist_close(void);
+/**< Ends the antagonists and restores the CPU affinity of the calling thread. */
+
+CU_EXPORT CU_BOOL CU_antagonist_is_open(void);
+/**< Retrieves whether antagonists are open. */
+
+CU_EXPORT void CU_antagonist_start(void);
+/**< Releases the antagonists and waits until all of them are running. */
+
+CU_EXPORT void CU_antagonist_stop(void);
+/**< Parks the antagonists and waits until all of them are idle. */
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /*  CUNIT_ANTAGONIST_H_SEEN  */
+/** @} */
@@ -0,0 +1,143 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Interface for asynchronous report output.
+ *
+ *  19-Oct-2026   Initial implementation of asynchronous output streams.
+ */
+
+/** @file
+ *  Asynchronous report output (user interface).
+ *  An output stream copies data written by a report writer into a
+ *  fixed set of chunks, which a writer thread writes to the file
+ *  descriptor of the stream.  The memory in flight is bounded by
+ *  CU_ASYNC_CHUNKS chunks of CU_ASYNC_CHUNK_SIZE bytes per stream;
+ *  the writing thread only waits for the disk when all chunks are in
+ *  flight.  Partially filled chunks are handed over by
+ *  CU_async_flush() whenever the writer is idle, so small reports are
+ *  batched while the disk is busy.  CU_async_barrier() waits until
+ *  everything written so far has reached the descriptor.  Only
+ *  available on LINUX builds.
+ */
+/** @addtogroup Framework
+ * @{
+ */
+
+#ifndef CUNIT_ASYNCOUTPUT_H_SEEN
+#define CUNIT_ASYNCOUTPUT_H_SEEN
+
+#include <stdio.h>
+#include <stddef.h>
+
+#include "CUnit.h"
+#include "CUError.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CU_ASYNC_MAX_STREAMS 4
+/**< Maximum number of output streams open at the same time. */
+
+#define CU_ASYNC_CHUNKS      8
+/**< Number of chunks per stream (bounds the memory in flight). */
+
+#define CU_ASYNC_CHUNK_SIZE  8192
+/**< Size of a chunk in bytes. */
+
+typedef struct CU_AsyncStream CU_AsyncStream;  /**< Asynchronous output stream. */
+typedef CU_AsyncStream* CU_pAsyncStream;        /**< Pointer to an asynchronous output stream. */
+
+CU_EXPORT CU_pAsyncStream CU_async_open(int fd);
+/**<
+ *  Opens an output stream writing to fd.  The descriptor is not closed
+ *  by CU_async_close().  The writer thread is started with the first
+ *  stream.
+ *
+ *  CU_async_open() sets the following error codes:
+ *  - CUE_SUCCESS if no errors occurred.
+ *  - CUE_BAD_FILENAME if fd is negative.
+ *  - CUE_NOMEMORY if CU_ASYNC_MAX_STREAMS streams are open.
+ *  - CUE_FOPEN_FAILED if the writer thread could not be started.
+ *
+ *  @param fd File descriptor to write to.
+ *  @return The new stream, NULL on error.
+ */
+
+CU_EXPORT void CU_async_write(CU_pAsyncStream pStream, const void *pData, size_t nLength);
+/**<
+ *  Copies data to a stream.  Full chunks are handed to the writer
+ *  thread.  Waits only if all chunks of the stream are in flight.
+ *  Write errors are reported by CU_async_barrier().
+ *
+ *  @param pStream Stream to write to (non-NULL).
+ *  @param pData   Data to write.
+ *  @param nLength Number of bytes to write.
+ */
+
+CU_EXPORT void CU_async_flush(CU_pAsyncStream pStream);
+/**<
+ *  Hands the partially filled chunk of a stream to the writer thread
+ *  if the writer has nothing else to do for the stream.  Never waits.
+ *
+ *  @param pStream Stream to flush (non-NULL).
+ */
+
+CU_EXPORT CU_ErrorCode CU_async_barrier(CU_pAsyncStream pStream);
+/**<
+ *  Waits until all data written to a stream has been written to its
+ *  descriptor.
+ *
+ *  @param pStream Stream to wait for (non-NULL).
+ *  @return CUE_WRITE_ERROR if a write to the descriptor failed since the
+ *          stream was opened, CUE_SUCCESS otherwise.
+ */
+
+CU_EXPORT CU_ErrorCode CU_async_close(CU_pAsyncStream pStream);
+/**<
+ *  Waits for the data of a stream, then closes it.  The writer thread
+ *  is stopped with the last stream.
+ *
+ *  @param pStream Stream to close (non-NULL).
+ *  @return The result of CU_async_barrier().
+ */
+
+CU_EXPORT FILE* CU_async_file(CU_pAsyncStream pStream);
+/**<
+ *  Retrieves a stdio stream writing to an output stream, so that
+ *  writers based on fprintf() can be used.  Data reaches the output
+ *  stream when the FILE is flushed.  The FILE is closed with the
+ *  stream and must not be closed by the caller.
+ *
+ *  @param pStream Stream to write to (non-NULL).
+ *  @return The FILE, NULL if it could not be created.
+ */
+
+CU_EXPORT unsigned int CU_async_get_stalls(CU_pAsyncStream pStream);
+/**<
+ *  Retrieves how often writing to a stream had to wait because all
+ *  chunks were in flight.  Non-zero values mean the descriptor is
+ *  slower than the reports and CU_ASYNC_CHUNKS may need to be raised.
+ */
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /*  CUNIT_ASYNCOUTPUT_H_SEEN  */
+/** @} */
@@ -0,0 +1,153 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Interface for gating test durations against a stored baseline.
+ *
+ *  19-Oct-2026   Initial implementation of duration baselines.
+ */
+
+/** @file
+ *  Duration baselines (user interface).
+ *  A baseline file holds the median and the median absolute deviation
+ *  (MAD) of the wall-clock time of each test over several runs, i.e.
+ *  dWallTime rather than the CPU time in dElapsedTime, which misses
+ *  blocking and adds up threads.  It is built from the result logs of
+ *  those runs with CU_baseline_build() (or the cu_baseline tool), one
+ *  tab-separated line per test:
+ *
+ *  - <CODE>CUnit-baseline version</CODE> (first line)
+ *  - <CODE>suite test median-seconds mad-seconds runs</CODE>
+ *
+ *  While a baseline is loaded, the runner compares each passing test
+ *  against it after the test's time has been taken.  A test is allowed
+ *  the median plus the largest of a multiple of the MAD (scaled to a
+ *  standard deviation), a fraction of the median and an absolute
+ *  margin; the threshold can be set per suite.  A test exceeding it
+ *  gets a CUF_PerfRegression failure record with the measured time,
+ *  the limit and the baseline.  Tests missing from the baseline are
+ *  not checked.
+ */
+/** @addtogroup Framework
+ * @{
+ */
+
+#ifndef CUNIT_BASELINE_H_SEEN
+#define CUNIT_BASELINE_H_SEEN
+
+#include <stdio.h>
+
+#include "CUnit.h"
+#include "CUError.h"
+#include "TestDB.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CU_BASELINE_VERSION 1
+/**< Version of the baseline format written by CU_baseline_build(). */
+
+#define CU_BASELINE_MAX_RUNS 32
+/**< Maximum number of result logs a baseline is built from. */
+
+/** Margin a test may exceed its baseline median by. */
+typedef struct CU_BaselineThreshold
+{
+  double dMadFactor;  /**< Allowed margin in MADs scaled to a standard deviation (x 1.4826). */
+  double dRelative;   /**< Minimum margin as a fraction of the median. */
+  double dAbsolute;   /**< Minimum margin in seconds (covers the clock resolution). */
+} CU_BaselineThreshold;
+typedef CU_BaselineThreshold* CU_pBaselineThreshold;  /**< Pointer to a baseline threshold. */
+
+CU_EXPORT CU_ErrorCode CU_baseline_build(FILE *apLogs[], unsigned int uiLogs, FILE *pOutput);
+/**<
+ *  Writes a baseline computed from the result logs of several runs of
+ *  the same registry.  Only passed tests contribute, and only the first
+ *  run of each log is used.
+ *
+ *  CU_baseline_build() sets the following error codes:
+ *  - CUE_SUCCESS if the baseline was written.
+ *  - CUE_NOMEMORY if uiLogs exceeds CU_BASELINE_MAX_RUNS.
+ *  - CUE_BAD_RESULT_RECORD if a log is malformed.
+ *  - CUE_WRITE_ERROR if writing the baseline failed.
+ *
+ *  @param apLogs  Result logs to read (non-NULL).
+ *  @param uiLogs  Number of logs (> 0).
+ *  @param pOutput Stream receiving the baseline (non-NULL).
+ *  @return A CU_ErrorCode indicating the error status.
+ */
+
+CU_EXPORT CU_ErrorCode CU_baseline_load(const char *szFile);
+/**<
+ *  Loads a baseline file and enables the duration check of the runner.
+ *  A previously loaded baseline is replaced.
+ *
+ *  CU_baseline_load() sets the following error codes:
+ *  - CUE_SUCCESS if the baseline was loaded.
+ *  - CUE_BAD_FILENAME if szFile is NULL or empty.
+ *  - CUE_FOPEN_FAILED if the file could not be opened.
+ *  - CUE_BAD_BASELINE if the file is malformed or has more than
+ *    MAX_NUM_OF_TESTS entries (no baseline is loaded then).
+ *
+ *  @param szFile Name of the baseline file.
+ *  @return A CU_ErrorCode indicating the error status.
+ */
+
+CU_EXPORT void CU_baseline_unload(void);
+/**< Discards the loaded baseline and disables the duration check. */
+
+CU_EXPORT void CU_baseline_default_threshold(CU_pBaselineThreshold pThreshold);
+/**<
+ *  Fills pThreshold with the default margin: 5 MADs, at least 25% of
+ *  the median and at least 1 ms.
+ *
+ *  @param pThreshold The threshold to initialize (non-NULL).
+ */
+
+CU_EXPORT CU_ErrorCode CU_baseline_set_threshold(CU_pSuite pSuite, const CU_BaselineThreshold *pThreshold);
+/**<
+ *  Sets the margin of the tests of a suite, or the margin of suites
+ *  without their own.
+ *
+ *  CU_baseline_set_threshold() sets the following error codes:
+ *  - CUE_SUCCESS if the threshold was set.
+ *  - CUE_NOMEMORY if MAX_NUM_OF_SUITES suites already have thresholds.
+ *
+ *  @param pSuite     Suite to set the margin of (NULL for the default).
+ *  @param pThreshold New margin (NULL to revert the suite to the default,
+ *                    or the default to CU_baseline_default_threshold()).
+ *  @return A CU_ErrorCode indicating the error status.
+ */
+
+CU_EXPORT void CU_baseline_check_test(CU_pSuite pSuite, CU_pTest pTest);
+/**<
+ *  Compares the wall-clock time of a completed test against the loaded
+ *  baseline and records a CUF_PerfRegression failure if it exceeds its
+ *  limit.  Called by the runner for each passing test; does nothing if
+ *  no baseline is loaded.
+ *
+ *  @param pSuite Suite of the test (non-NULL).
+ *  @param pTest  Completed test (non-NULL).
+ */
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /*  CUNIT_BASELINE_H_SEEN  */
+/** @} */
@@ -44,9 +44,13 @@ extern "C" {
 typedef enum {
   CU_BRM_NORMAL = 0,  /**< Normal mode - failures and run summary are printed [default]. */
   CU_BRM_SILENT,      /**< Silent mode - no output is printed except framework error messages. */
-  CU_BRM_VERBOSE      /**< Verbose mode - maximum output of run details. */
+  CU_BRM_VERBOSE,     /**< Verbose mode - maximum output of run details. */
+  CU_BRM_PROGRESS     /**< Progress mode - normal output plus a progress line rewritten in place. */
 } CU_BasicRunMode;
 
+#define CU_BASIC_PROGRESS_INTERVAL_MS 250
+/**< Time between updates of the progress line in milliseconds. */
+
 CU_EXPORT CU_ErrorCode CU_basic_run_tests(void);
 /**<
  *  Runs all registered CUnit tests using the basic interface.
@@ -96,6 +100,26 @@ CU_EXPORT CU_BasicRunMode CU_basic_get_mode(void);
  *              runs using the basic interface.
  */
 
+CU_EXPORT CU_ErrorCode CU_basic_set_progress_history(const char *szResultLog);
+/**<
+ *  Sets the result log used for the ETA of the progress line.
+ *  The log (see CU_export_run_results()) is read at the start of each
+ *  run in CU_BRM_PROGRESS mode, and the durations recorded in it are
+ *  used as expected durations of the tests with the same suite and test
+ *  names.  Tests without history use the duration of their last run in
+ *  this process, or else the average expected duration.  A missing log
+ *  is not an error, so the log of the previous run may be used.
+ *
+ *  The progress line is only shown when stdout is a terminal, and is
+ *  redrawn every CU_BASIC_PROGRESS_INTERVAL_MS milliseconds by a
+ *  separate thread, so the cost per test does not include terminal
+ *  output.  Only available on LINUX builds; elsewhere CU_BRM_PROGRESS
+ *  behaves like CU_BRM_NORMAL.
+ *
+ *  @param szResultLog Path of the result log (NULL or empty to clear).
+ *  @return CUE_BAD_FILENAME if szResultLog is too long, CUE_SUCCESS otherwise.
+ */
+
 CU_EXPORT void CU_basic_show_failures(CU_pFailureRecord pFailure);
 /**<
  *  Prints a summary of run failures to stdout.
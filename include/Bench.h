@@ -0,0 +1,147 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Interface for running registered tests as microbenchmarks.
+ *
+ *  19-Oct-2026   Initial implementation of bench mode.
+ */
+
+/** @file
+ *  Bench mode (user interface).
+ *  A bench run executes the selected tests through the normal runner,
+ *  but calls each test function repeatedly between the suite setup and
+ *  teardown functions.  The first call is an ordinary checked run; a
+ *  test failing it is not benchmarked.  The number of iterations per
+ *  sample is then calibrated until a batch takes the configured sample
+ *  time, and the configured number of samples is measured with the
+ *  wall clock.  While measuring, failed assertions are only counted
+ *  (see CU_set_assert_count_only()); if any occurred, one failure record
+ *  with their number is added to the test.  Tests consuming one-shot
+ *  state (e.g. scripted mock values) may fail in later iterations and
+ *  are reported this way.  While the performance counters are open
+ *  (see CU_perf_open()), the instructions per iteration are reported too.
+ *  While antagonists are open (see CU_antagonist_open()), each test is
+ *  measured again with the antagonists running after its quiet samples,
+ *  and the slowdown of the median is reported.
+ *
+ *  With layout randomization the samples of a test are measured under
+ *  several random memory layouts, uiSamples per layout.  Each layout
+ *  moves the stack below the test function by a random offset and, on
+ *  LINUX builds, places a spacer block of random size on the heap.  The
+ *  stack offset stands in for the shift a different environment size
+ *  gives the initial stack of a fresh process.  The statistics
+ *  then describe the distribution over layouts, and the share of the
+ *  variance caused by the layout is estimated by a one-way analysis of
+ *  variance, which needs at least 2 samples per layout.  Tests whose
+ *  share exceeds dLayoutShare are flagged as layout-sensitive.
+ */
+/** @addtogroup Framework
+ * @{
+ */
+
+#ifndef CUNIT_BENCH_H_SEEN
+#define CUNIT_BENCH_H_SEEN
+
+#include "CUnit.h"
+#include "CUError.h"
+#include "TestDB.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CU_BENCH_MAX_SAMPLES 1000
+/**< Maximum number of samples per test, over all layouts. */
+
+#define CU_BENCH_MAX_LAYOUT_OFFSET 4096
+/**< Upper bound of the random stack offset and heap spacer in bytes. */
+
+/** Parameters of a bench run. */
+typedef struct CU_BenchConfig
+{
+  double             dSampleTime;      /**< Target duration of one sample in seconds. */
+  unsigned int       uiSamples;        /**< Samples per test, or per layout (1 to CU_BENCH_MAX_SAMPLES). */
+  unsigned long      ulMaxIterations;  /**< Upper bound of the iterations per sample. */
+  unsigned int       uiLayouts;        /**< Random memory layouts per test (0 to disable layout randomization). */
+  double             dLayoutShare;     /**< Share of the variance above which a test is layout-sensitive. */
+  unsigned long long ullLayoutSeed;    /**< Seed of the layouts (0 to seed from the clock). */
+} CU_BenchConfig;
+typedef CU_BenchConfig* CU_pBenchConfig;  /**< Pointer to a bench configuration. */
+
+/** Timing statistics of a benchmarked test, in nanoseconds per iteration. */
+typedef struct CU_BenchResult
+{
+  CU_pSuite     pSuite;             /**< Suite of the test. */
+  CU_pTest      pTest;              /**< Benchmarked test. */
+  unsigned long ulIterations;       /**< Iterations per sample. */
+  unsigned int  uiSamples;          /**< Samples measured, 0 if the test was not benchmarked. */
+  double        dMin;               /**< Fastest sample. */
+  double        dMedian;            /**< Median sample. */
+  double        dMean;              /**< Mean of the samples. */
+  double        dStdDev;            /**< Standard deviation of the samples. */
+  unsigned int  uiCountedFailures;  /**< Failed assertions counted while measuring. */
+  double        dInstructions;      /**< Fewest instructions per iteration of a sample, 0 if not counted. */
+  unsigned int  uiLayouts;          /**< Layouts measured, 0 without layout randomization. */
+  double        dLayoutShare;       /**< Estimated share of the variance caused by the layout. */
+  CU_BOOL       bLayoutSensitive;   /**< Whether dLayoutShare exceeds the configured limit. */
+  double        dLoadedMedian;      /**< Median sample with the antagonists running, 0 without antagonists. */
+  double        dSlowdown;          /**< dLoadedMedian relative to dMedian, 0 without antagonists. */
+} CU_BenchResult;
+typedef CU_BenchResult* CU_pBenchResult;  /**< Pointer to a bench result. */
+
+CU_EXPORT void CU_bench_default_config(CU_pBenchConfig pConfig);
+/**<
+ *  Fills pConfig with the default parameters: 10 samples of 10 ms each,
+ *  at most 100000000 iterations per sample and no layout randomization
+ *  (with a layout-sensitivity limit of 0.5 once enabled).
+ *
+ *  @param pConfig The configuration to initialize (non-NULL).
+ */
+
+CU_EXPORT CU_ErrorCode CU_bench_run(CU_pSuite pSuite, const CU_BenchConfig *pConfig);
+/**<
+ *  Runs the active tests of a suite, or of all suites, as benchmarks
+ *  and prints the statistics of each test.  The results of the run are
+ *  available as usual afterwards; assertion counts include all
+ *  iterations.  <b>This function must not be called during a test run
+ *  (checked by assertion)</b>.
+ *
+ *  CU_bench_run() sets the following error codes:
+ *  - CUE_SUCCESS if no errors occurred.
+ *  - CUE_NOREGISTRY if the registry has not been initialized.
+ *  - any error returned by CU_run_suite() or CU_run_all_tests().
+ *
+ *  @param pSuite  Suite to benchmark (NULL for all suites).
+ *  @param pConfig Parameters of the run (NULL for the defaults).
+ *  @return A CU_ErrorCode indicating the error status.
+ */
+
+CU_EXPORT const CU_BenchResult* CU_bench_get_result(CU_pTest pTest);
+/**<
+ *  Retrieves the statistics of a test in the last bench run.
+ *
+ *  @param pTest Test to retrieve the statistics of.
+ *  @return The statistics, or NULL if the test was not run.
+ */
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /*  CUNIT_BENCH_H_SEEN  */
+/** @} */
@@ -87,7 +87,14 @@ typedef enum {
   CUE_FOPEN_FAILED      = 40,  /**< An error occurred opening a file. */
   CUE_FCLOSE_FAILED     = 41,  /**< An error occurred closing a file. */
   CUE_BAD_FILENAME      = 42,  /**< A bad filename was requested (NULL, empty, nonexistent, etc.). */
-  CUE_WRITE_ERROR       = 43   /**< An error occurred during a write to a file. */
+  CUE_WRITE_ERROR       = 43,  /**< An error occurred during a write to a file. */
+  CUE_BAD_RESULT_RECORD = 44,  /**< A malformed record was read from a result log. */
+  CUE_DLOPEN_FAILED     = 45,  /**< A test library could not be loaded or had no suite table. */
+  CUE_BAD_BASELINE      = 46,  /**< A malformed line was read from a baseline file. */
+
+  /* System facility errors */
+  CUE_NOT_SUPPORTED     = 47,  /**< The facility is not available on this platform or build. */
+  CUE_THREAD_FAILED     = 48   /**< A helper thread could not be created or placed. */
 } CU_ErrorCode;
 
 /*------------------------------------------------------------------------*/
@@ -125,6 +125,14 @@
 #include "TestDB.h"   /* not needed here - included for user convenience */
 #include "TestRun.h"  /* not needed here - include (after BOOL define) for user convenience */
 
+/** Implementation of the fatal assertions.
+ *  Records the assertion and aborts the current test if value is CU_FALSE.
+ *  CUnit.hpp redefines it so that C++ tests abort by throwing an exception
+ *  instead of using longjmp().
+ */
+#define CU_ASSERT_FATAL_IMPL(value, line, condition, file, function) \
+  CU_assertImplementation((value), (line), (condition), (file), (function), CU_TRUE)
+
 /** Record a pass condition without performing a logical test. */
 #define CU_PASS(msg) \
   { CU_assertImplementation(CU_TRUE, __LINE__, ("CU_PASS(" #msg ")"), __FILE__, "", CU_FALSE); }
@@ -139,7 +147,7 @@
  *  Reports failure and causes test to abort.
  */
 #define CU_ASSERT_FATAL(value) \
-  { CU_assertImplementation((value), __LINE__, #value, __FILE__, "", CU_TRUE); }
+  { CU_ASSERT_FATAL_IMPL((value), __LINE__, #value, __FILE__, ""); }
 
 /** Simple assertion.
  *  Reports failure with no other action.
@@ -151,7 +159,7 @@
  *  Reports failure and causes test to abort.
  */
 #define CU_TEST_FATAL(value) \
-  { CU_assertImplementation((value), __LINE__, #value, __FILE__, "", CU_TRUE); }
+  { CU_ASSERT_FATAL_IMPL((value), __LINE__, #value, __FILE__, ""); }
 
 /** Record a failure without performing a logical test. */
 #define CU_FAIL(msg) \
@@ -159,7 +167,7 @@
 
 /** Record a failure without performing a logical test, and abort test. */
 #define CU_FAIL_FATAL(msg) \
-  { CU_assertImplementation(CU_FALSE, __LINE__, ("CU_FAIL_FATAL(" #msg ")"), __FILE__, "", CU_TRUE); }
+  { CU_ASSERT_FATAL_IMPL(CU_FALSE, __LINE__, ("CU_FAIL_FATAL(" #msg ")"), __FILE__, ""); }
 
 /** Asserts that value is CU_TRUE.
  *  Reports failure with no other action.
@@ -171,7 +179,7 @@
  *  Reports failure and causes test to abort.
  */
 #define CU_ASSERT_TRUE_FATAL(value) \
-  { CU_assertImplementation((value), __LINE__, ("CU_ASSERT_TRUE_FATAL(" #value ")"), __FILE__, "", CU_TRUE); }
+  { CU_ASSERT_FATAL_IMPL((value), __LINE__, ("CU_ASSERT_TRUE_FATAL(" #value ")"), __FILE__, ""); }
 
 /** Asserts that value is CU_FALSE.
  *  Reports failure with no other action.
@@ -183,7 +191,7 @@
  *  Reports failure and causes test to abort.
  */
 #define CU_ASSERT_FALSE_FATAL(value) \
-  { CU_assertImplementation(!(value), __LINE__, ("CU_ASSERT_FALSE_FATAL(" #value ")"), __FILE__, "", CU_TRUE); }
+  { CU_ASSERT_FATAL_IMPL(!(value), __LINE__, ("CU_ASSERT_FALSE_FATAL(" #value ")"), __FILE__, ""); }
 
 /** Asserts that actual == expected.
  *  Reports failure with no other action.
@@ -195,7 +203,7 @@
  *  Reports failure and causes test to abort.
  */
 #define CU_ASSERT_EQUAL_FATAL(actual, expected) \
-  { CU_assertImplementation(((actual) == (expected)), __LINE__, ("CU_ASSERT_EQUAL_FATAL(" #actual "," #expected ")"), __FILE__, "", CU_TRUE); }
+  { CU_ASSERT_FATAL_IMPL(((actual) == (expected)), __LINE__, ("CU_ASSERT_EQUAL_FATAL(" #actual "," #expected ")"), __FILE__, ""); }
 
 /** Asserts that actual != expected.
  *  Reports failure with no other action.
@@ -207,7 +215,7 @@
  *  Reports failure and causes test to abort.
  */
 #define CU_ASSERT_NOT_EQUAL_FATAL(actual, expected) \
-  { CU_assertImplementation(((actual) != (expected)), __LINE__, ("CU_ASSERT_NOT_EQUAL_FATAL(" #actual "," #expected ")"), __FILE__, "", CU_TRUE); }
+  { CU_ASSERT_FATAL_IMPL(((actual) != (expected)), __LINE__, ("CU_ASSERT_NOT_EQUAL_FATAL(" #actual "," #expected ")"), __FILE__, ""); }
 
 /** Asserts that pointers actual == expected.
  *  Reports failure with no other action.
@@ -219,7 +227,7 @@
  * Reports failure and causes test to abort.
  */
 #define CU_ASSERT_PTR_EQUAL_FATAL(actual, expected) \
-  { CU_assertImplementation(((const void*)(actual) == (const void*)(expected)), __LINE__, ("CU_ASSERT_PTR_EQUAL_FATAL(" #actual "," #expected ")"), __FILE__, "", CU_TRUE); }
+  { CU_ASSERT_FATAL_IMPL(((const void*)(actual) == (const void*)(expected)), __LINE__, ("CU_ASSERT_PTR_EQUAL_FATAL(" #actual "," #expected ")"), __FILE__, ""); }
 
 /** Asserts that pointers actual != expected.
  *  Reports failure with no other action.
@@ -231,7 +239,7 @@
  *  Reports failure and causes test to abort.
  */
 #define CU_ASSERT_PTR_NOT_EQUAL_FATAL(actual, expected) \
-  { CU_assertImplementation(((const void*)(actual) != (const void*)(expected)), __LINE__, ("CU_ASSERT_PTR_NOT_EQUAL_FATAL(" #actual "," #expected ")"), __FILE__, "", CU_TRUE); }
+  { CU_ASSERT_FATAL_IMPL(((const void*)(actual) != (const void*)(expected)), __LINE__, ("CU_ASSERT_PTR_NOT_EQUAL_FATAL(" #actual "," #expected ")"), __FILE__, ""); }
 
 /** Asserts that pointer value is NULL.
  *  Reports failure with no other action.
@@ -243,7 +251,7 @@
  *  Reports failure and causes test to abort.
  */
 #define CU_ASSERT_PTR_NULL_FATAL(value) \
-  { CU_assertImplementation((NULL == (const void*)(value)), __LINE__, ("CU_ASSERT_PTR_NULL_FATAL(" #value")"), __FILE__, "", CU_TRUE); }
+  { CU_ASSERT_FATAL_IMPL((NULL == (const void*)(value)), __LINE__, ("CU_ASSERT_PTR_NULL_FATAL(" #value")"), __FILE__, ""); }
 
 /** Asserts that pointer value is not NULL.
  *  Reports failure with no other action.
@@ -255,7 +263,7 @@
  *  Reports failure and causes test to abort.
  */
 #define CU_ASSERT_PTR_NOT_NULL_FATAL(value) \
-  { CU_assertImplementation((NULL != (const void*)(value)), __LINE__, ("CU_ASSERT_PTR_NOT_NULL_FATAL(" #value")"), __FILE__, "", CU_TRUE); }
+  { CU_ASSERT_FATAL_IMPL((NULL != (const void*)(value)), __LINE__, ("CU_ASSERT_PTR_NOT_NULL_FATAL(" #value")"), __FILE__, ""); }
 
 /** Asserts that string actual == expected.
  *  Reports failure with no other action.
@@ -267,7 +275,7 @@
  *  Reports failure and causes test to abort.
  */
 #define CU_ASSERT_STRING_EQUAL_FATAL(actual, expected) \
-  { CU_assertImplementation(!(strcmp((const char*)(actual), (const char*)(expected))), __LINE__, ("CU_ASSERT_STRING_EQUAL_FATAL(" #actual ","  #expected ")"), __FILE__, "", CU_TRUE); }
+  { CU_ASSERT_FATAL_IMPL(!(strcmp((const char*)(actual), (const char*)(expected))), __LINE__, ("CU_ASSERT_STRING_EQUAL_FATAL(" #actual ","  #expected ")"), __FILE__, ""); }
 
 /** Asserts that string actual != expected.
  *  Reports failure with no other action.
@@ -279,7 +287,7 @@
  *  Reports failure and causes test to abort.
  */
 #define CU_ASSERT_STRING_NOT_EQUAL_FATAL(actual, expected) \
-  { CU_assertImplementation((strcmp((const char*)(actual), (const char*)(expected))), __LINE__, ("CU_ASSERT_STRING_NOT_EQUAL_FATAL(" #actual ","  #expected ")"), __FILE__, "", CU_TRUE); }
+  { CU_ASSERT_FATAL_IMPL((strcmp((const char*)(actual), (const char*)(expected))), __LINE__, ("CU_ASSERT_STRING_NOT_EQUAL_FATAL(" #actual ","  #expected ")"), __FILE__, ""); }
 
 /** Asserts that string actual == expected with length specified.
  *  The comparison is limited to count characters.
@@ -293,7 +301,7 @@
  *  Reports failure and causes test to abort.
  */
 #define CU_ASSERT_NSTRING_EQUAL_FATAL(actual, expected, count) \
-  { CU_assertImplementation(!(strncmp((const char*)(actual), (const char*)(expected), (size_t)(count))), __LINE__, ("CU_ASSERT_NSTRING_EQUAL_FATAL(" #actual ","  #expected "," #count ")"), __FILE__, "", CU_TRUE); }
+  { CU_ASSERT_FATAL_IMPL(!(strncmp((const char*)(actual), (const char*)(expected), (size_t)(count))), __LINE__, ("CU_ASSERT_NSTRING_EQUAL_FATAL(" #actual ","  #expected "," #count ")"), __FILE__, ""); }
 
 /** Asserts that string actual != expected with length specified.
  *  The comparison is limited to count characters.
@@ -307,7 +315,7 @@
  *  Reports failure and causes test to abort.
  */
 #define CU_ASSERT_NSTRING_NOT_EQUAL_FATAL(actual, expected, count) \
-  { CU_assertImplementation((strncmp((const char*)(actual), (const char*)(expected), (size_t)(count))), __LINE__, ("CU_ASSERT_NSTRING_NOT_EQUAL_FATAL(" #actual ","  #expected "," #count ")"), __FILE__, "", CU_TRUE); }
+  { CU_ASSERT_FATAL_IMPL((strncmp((const char*)(actual), (const char*)(expected), (size_t)(count))), __LINE__, ("CU_ASSERT_NSTRING_NOT_EQUAL_FATAL(" #actual ","  #expected "," #count ")"), __FILE__, ""); }
 
 /** Asserts that double actual == expected within the specified tolerance.
  *  If actual is within granularity of expected, the assertion passes.
@@ -321,7 +329,7 @@
  *  Reports failure and causes test to abort.
  */
 #define CU_ASSERT_DOUBLE_EQUAL_FATAL(actual, expected, granularity) \
-  { CU_assertImplementation(((fabs((double)(actual) - (expected)) <= fabs((double)(granularity)))), __LINE__, ("CU_ASSERT_DOUBLE_EQUAL_FATAL(" #actual ","  #expected "," #granularity ")"), __FILE__, "", CU_TRUE); }
+  { CU_ASSERT_FATAL_IMPL(((fabs((double)(actual) - (expected)) <= fabs((double)(granularity)))), __LINE__, ("CU_ASSERT_DOUBLE_EQUAL_FATAL(" #actual ","  #expected "," #granularity ")"), __FILE__, ""); }
 
 /** Asserts that double actual != expected within the specified tolerance.
  *  If actual is within granularity of expected, the assertion fails.
@@ -335,7 +343,7 @@
  *  Reports failure and causes test to abort.
  */
 #define CU_ASSERT_DOUBLE_NOT_EQUAL_FATAL(actual, expected, granularity) \
-  { CU_assertImplementation(((fabs((double)(actual) - (expected)) > fabs((double)(granularity)))), __LINE__, ("CU_ASSERT_DOUBLE_NOT_EQUAL_FATAL(" #actual ","  #expected "," #granularity ")"), __FILE__, "", CU_TRUE); }
+  { CU_ASSERT_FATAL_IMPL(((fabs((double)(actual) - (expected)) > fabs((double)(granularity)))), __LINE__, ("CU_ASSERT_DOUBLE_NOT_EQUAL_FATAL(" #actual ","  #expected "," #granularity ")"), __FILE__, ""); }
 
 #ifdef USE_DEPRECATED_CUNIT_NAMES
 
@@ -0,0 +1,668 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  C++ front-end for writing and registering tests.
+ *
+ *  19-Oct-2026   Initial implementation of the C++ front-end.
+ */
+
+/** @file
+ *  C++17 front-end (header only).
+ *  Adds to the C interface:
+ *
+ *  - registration of lambdas and member functions as tests, run through
+ *    static trampolines which catch exceptions escaping the test body;
+ *  - fixture classes, constructed before and destroyed after each test,
+ *    so that fixture state is managed with RAII instead of globals;
+ *  - fatal assertions which throw cunit::fatal_failure instead of
+ *    calling longjmp(), so that destructors of the aborted test run;
+ *  - templated assertions (CU_CHECK_xxx) which report the compared
+ *    values on failure.  The comparison is selected at compile time and
+ *    the failure path is kept out of line, so the passing path inlines;
+ *  - typed tests, instantiating one test body for each type of a
+ *    cunit::type_list and registering the instantiations in bulk;
+ *  - compile-time tests, evaluated by the compiler and reported as
+ *    passed tests without running.
+ *
+ *  The _FATAL assertions only throw inside tests registered through this
+ *  header; elsewhere they keep their C behaviour.
+ */
+/** @addtogroup Framework
+ * @{
+ */
+
+#ifndef CUNIT_CUNIT_HPP_SEEN
+#define CUNIT_CUNIT_HPP_SEEN
+
+#if !defined(__cplusplus) || (__cplusplus < 201703L && (!defined(_MSVC_LANG) || _MSVC_LANG < 201703L))
+#  error "CUnit.hpp requires C++17."
+#endif
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "CUnit.h"
+
+#if defined(__GNUC__)
+#  define CU_CXX_COLD     __attribute__((cold, noinline))
+#  define CU_CXX_LIKELY(x) __builtin_expect(!!(x), 1)
+#elif defined(_MSC_VER)
+#  define CU_CXX_COLD     __declspec(noinline)
+#  define CU_CXX_LIKELY(x) (x)
+#else
+#  define CU_CXX_COLD
+#  define CU_CXX_LIKELY(x) (x)
+#endif
+
+#define CU_CXX_MAX_LAMBDA_COPIES 8
+/**< Number of times the same lambda expression can be registered. */
+
+#undef CU_ASSERT_FATAL_IMPL
+#define CU_ASSERT_FATAL_IMPL(value, line, condition, file, function) \
+  ::cunit::detail::assert_fatal(((value) ? CU_TRUE : CU_FALSE), (line), (condition), (file), (function))
+
+namespace cunit {
+
+/** Thrown by a failed fatal assertion to abort the current test.
+ *  Deliberately not derived from std::exception, so that test code
+ *  catching std::exception does not swallow it.
+ */
+struct fatal_failure {};
+
+namespace detail {
+
+/** Nesting depth of guarded test bodies (fatal assertions throw if > 0). */
+inline int guard_depth = 0;
+
+/** Records a fatal assertion in a guarded test body and throws to end it.
+ *  The assertion is recorded as fatal, so it is kept even when failures
+ *  are only counted, but the jump buffer is hidden from the runner so
+ *  that the exception, not longjmp(), leaves the body.
+ */
+[[noreturn]] CU_CXX_COLD inline void throw_fatal(CU_BOOL bValue, unsigned int uiLine, const char *szCondition,
+                                                 const char *szFile, const char *szFunction)
+{
+  CU_pTest pTest = CU_get_current_test();
+  jmp_buf *pJumpBuf = pTest->pJumpBuf;
+
+  pTest->pJumpBuf = nullptr;
+  CU_assertImplementation(bValue, uiLine, szCondition, szFile, szFunction, CU_TRUE);
+  pTest->pJumpBuf = pJumpBuf;
+  throw fatal_failure();
+}
+
+/** Records a failed assertion, ending the test if it is fatal. */
+CU_CXX_COLD inline void fail(unsigned int uiLine, const char *szCondition,
+                             const char *szFile, bool bFatal)
+{
+  if (!bFatal) {
+    CU_assertImplementation(CU_FALSE, uiLine, szCondition, szFile, "", CU_FALSE);
+  }
+  else if (0 == guard_depth) {
+    CU_assertImplementation(CU_FALSE, uiLine, szCondition, szFile, "", CU_TRUE);
+  }
+  else {
+    throw_fatal(CU_FALSE, uiLine, szCondition, szFile, "");
+  }
+}
+
+/** Records a passed assertion. */
+inline void pass(unsigned int uiLine, const char *szCondition, const char *szFile)
+{
+  CU_assertImplementation(CU_TRUE, uiLine, szCondition, szFile, "", CU_FALSE);
+}
+
+/** Implementation of CU_ASSERT_FATAL_IMPL for C++ translation units. */
+inline void assert_fatal(CU_BOOL bValue, unsigned int uiLine, const char *szCondition,
+                         const char *szFile, const char *szFunction)
+{
+  if (0 == guard_depth) {
+    CU_assertImplementation(bValue, uiLine, szCondition, szFile, szFunction, CU_TRUE);
+  }
+  else if (CU_FALSE == bValue) {
+    throw_fatal(bValue, uiLine, szCondition, szFile, szFunction);
+  }
+  else {
+    CU_assertImplementation(bValue, uiLine, szCondition, szFile, szFunction, CU_TRUE);
+  }
+}
+
+template <typename T>
+inline constexpr bool is_c_string_v =
+    std::is_same_v<std::decay_t<T>, const char*> || std::is_same_v<std::decay_t<T>, char*>;
+
+/** Formats a value for a failure message, if its type is printable. */
+template <typename T>
+inline void format_value(char *szBuffer, std::size_t uiSize, const T &value)
+{
+  using U = std::decay_t<T>;
+
+  if constexpr (std::is_same_v<U, bool>) {
+    std::snprintf(szBuffer, uiSize, "%s", value ? "true" : "false");
+  }
+  else if constexpr (std::is_enum_v<U>) {
+    format_value(szBuffer, uiSize, static_cast<std::underlying_type_t<U>>(value));
+  }
+  else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+    std::snprintf(szBuffer, uiSize, "%lld", static_cast<long long>(value));
+  }
+  else if constexpr (std::is_integral_v<U>) {
+    std::snprintf(szBuffer, uiSize, "%llu", static_cast<unsigned long long>(value));
+  }
+  else if constexpr (std::is_floating_point_v<U>) {
+    std::snprintf(szBuffer, uiSize, "%.17g", static_cast<double>(value));
+  }
+  else if constexpr (is_c_string_v<U>) {
+    std::snprintf(szBuffer, uiSize, "\"%s\"", (nullptr != value) ? value : "(null)");
+  }
+  else if constexpr (std::is_pointer_v<U> || std::is_null_pointer_v<U>) {
+    std::snprintf(szBuffer, uiSize, "%p", static_cast<const void*>(value));
+  }
+  else {
+    std::snprintf(szBuffer, uiSize, "?");
+  }
+}
+
+/** Records a failed comparison, including the compared values. */
+template <typename A, typename B>
+CU_CXX_COLD void fail_compare(unsigned int uiLine, const char *szCondition, const char *szFile,
+                              bool bFatal, const A &actual, const B &expected)
+{
+  char szActual[MAX_NAME_LEN / 3];
+  char szExpected[MAX_NAME_LEN / 3];
+  char szMessage[MAX_NAME_LEN];
+
+  format_value(szActual, sizeof(szActual), actual);
+  format_value(szExpected, sizeof(szExpected), expected);
+  std::snprintf(szMessage, sizeof(szMessage), "%s [%s vs %s]", szCondition, szActual, szExpected);
+  fail(uiLine, szMessage, szFile, bFatal);
+}
+
+/** Comparison operators of the CU_CHECK_xxx assertions. */
+enum class op { eq, ne, lt, le, gt, ge };
+
+/** Compares two values, avoiding sign-conversion surprises between
+ *  integers and comparing C strings by content.
+ */
+template <op O, typename A, typename B>
+constexpr bool compare(const A &a, const B &b)
+{
+  using UA = std::decay_t<A>;
+  using UB = std::decay_t<B>;
+
+  if constexpr (is_c_string_v<UA> && is_c_string_v<UB>) {
+    const char *szA = a;
+    const char *szB = b;
+    int iCmp = ((nullptr == szA) || (nullptr == szB))
+               ? ((szA == szB) ? 0 : ((nullptr == szA) ? -1 : 1))
+               : std::strcmp(szA, szB);
+    return compare<O>(iCmp, 0);
+  }
+  else if constexpr (std::is_integral_v<UA> && std::is_integral_v<UB> &&
+                     !std::is_same_v<UA, bool> && !std::is_same_v<UB, bool> &&
+                     (std::is_signed_v<UA> != std::is_signed_v<UB>)) {
+    if constexpr (std::is_signed_v<UA>) {
+      if (a < 0) {
+        return (O == op::ne) || (O == op::lt) || (O == op::le);
+      }
+      return compare<O>(static_cast<std::make_unsigned_t<UA>>(a), b);
+    }
+    else {
+      if (b < 0) {
+        return (O == op::ne) || (O == op::gt) || (O == op::ge);
+      }
+      return compare<O>(a, static_cast<std::make_unsigned_t<UB>>(b));
+    }
+  }
+  else if constexpr (O == op::eq) { return a == b; }
+  else if constexpr (O == op::ne) { return a != b; }
+  else if constexpr (O == op::lt) { return a < b; }
+  else if constexpr (O == op::le) { return a <= b; }
+  else if constexpr (O == op::gt) { return a > b; }
+  else                            { return a >= b; }
+}
+
+/** Implementation of the CU_CHECK_xxx comparison assertions. */
+template <op O, typename A, typename B>
+inline void check(const A &actual, const B &expected, unsigned int uiLine,
+                  const char *szCondition, const char *szFile, bool bFatal)
+{
+  if (CU_CXX_LIKELY(compare<O>(actual, expected))) {
+    pass(uiLine, szCondition, szFile);
+  }
+  else {
+    fail_compare(uiLine, szCondition, szFile, bFatal, actual, expected);
+  }
+}
+
+/** Implementation of CU_CHECK_NEAR. */
+template <typename A, typename B, typename T>
+inline void check_near(const A &actual, const B &expected, const T &tolerance,
+                       unsigned int uiLine, const char *szCondition, const char *szFile, bool bFatal)
+{
+  if (CU_CXX_LIKELY(std::fabs(static_cast<double>(actual) - static_cast<double>(expected)) <=
+                    std::fabs(static_cast<double>(tolerance)))) {
+    pass(uiLine, szCondition, szFile);
+  }
+  else {
+    fail_compare(uiLine, szCondition, szFile, bFatal, actual, expected);
+  }
+}
+
+/** Records an exception which escaped a test body. */
+CU_CXX_COLD inline void fail_exception(const char *szWhat)
+{
+  char szMessage[MAX_NAME_LEN];
+
+  std::snprintf(szMessage, sizeof(szMessage), "Uncaught exception: %s", szWhat);
+  CU_assertImplementation(CU_FALSE, 0, szMessage, "", "", CU_FALSE);
+}
+
+/** Runs a test body, converting exceptions into failures.
+ *  Fatal assertion failures have already been recorded when they throw.
+ */
+template <typename Body>
+void run_guarded(Body &&body) noexcept
+{
+  ++guard_depth;
+  try {
+    body();
+  }
+  catch (const fatal_failure&) {
+  }
+  catch (const std::exception &e) {
+    fail_exception(e.what());
+  }
+  catch (...) {
+    fail_exception("(unknown type)");
+  }
+  --guard_depth;
+}
+
+/** Storage and trampoline for one registration of a lambda type. */
+template <typename F, unsigned int N>
+struct lambda_slot
+{
+  static std::optional<F>& closure()
+  {
+    static std::optional<F> slot;
+    return slot;
+  }
+
+  static void trampoline()
+  {
+    run_guarded(*closure());
+  }
+};
+
+/** Stores a lambda in the first free slot of its type and returns
+ *  the matching trampoline (NULL if all slots are taken).
+ */
+template <typename F, unsigned int N = 0>
+CU_TestFunc bind_lambda(F &&body)
+{
+  if constexpr (N == CU_CXX_MAX_LAMBDA_COPIES) {
+    CU_UNREFERENCED_PARAMETER(body);
+    return nullptr;
+  }
+  else {
+    std::optional<F> &slot = lambda_slot<F, N>::closure();
+    if (!slot) {
+      slot.emplace(std::move(body));
+      return &lambda_slot<F, N>::trampoline;
+    }
+    return bind_lambda<F, N + 1>(std::move(body));
+  }
+}
+
+template <typename M> struct member_class;
+template <typename C> struct member_class<void (C::*)()> { using type = C; };
+
+/** Trampoline of a plain function or a fixture member function. */
+template <auto Func>
+void function_trampoline()
+{
+  if constexpr (std::is_member_function_pointer_v<decltype(Func)>) {
+    using Fixture = typename member_class<decltype(Func)>::type;
+    run_guarded([] { Fixture fixture; (fixture.*Func)(); });
+  }
+  else {
+    run_guarded(Func);
+  }
+}
+
+/** Registers a trampoline, reporting CUE_NOMEMORY if none was bound. */
+inline CU_pTest add_trampoline(CU_pSuite pSuite, const char *szName, CU_TestFunc pTrampoline)
+{
+  if (nullptr == pTrampoline) {
+    CU_set_error(CUE_NOMEMORY);
+    return nullptr;
+  }
+  return CU_add_test(pSuite, szName, pTrampoline);
+}
+
+} /* namespace detail */
+
+/** Registers a callable (typically a lambda) as a test.
+ *  The callable is moved into static storage reserved for its type, so
+ *  each lambda expression can be registered at most
+ *  CU_CXX_MAX_LAMBDA_COPIES times.  Errors are reported as for
+ *  CU_add_test(); CUE_NOMEMORY is set if the storage is exhausted.
+ */
+template <typename F>
+CU_pTest add_test(CU_pSuite pSuite, const char *szName, F &&body)
+{
+  return detail::add_trampoline(pSuite, szName, detail::bind_lambda(std::decay_t<F>(std::forward<F>(body))));
+}
+
+/** Registers a test whose body receives a fresh Fixture.
+ *  The fixture is default-constructed before and destroyed after each
+ *  run of the test, also when the test aborts.
+ */
+template <typename Fixture, typename F>
+CU_pTest add_fixture_test(CU_pSuite pSuite, const char *szName, F &&body)
+{
+  return add_test(pSuite, szName,
+                  [body = std::decay_t<F>(std::forward<F>(body))]() mutable {
+                    Fixture fixture;
+                    body(fixture);
+                  });
+}
+
+/** Registers a function or a fixture member function as a test, e.g.
+ *  <CODE>add_test<&MyFixture::test_insert>(pSuite, "insert")</CODE>.
+ *  For member functions the fixture is constructed per test run.
+ */
+template <auto Func>
+CU_pTest add_test(CU_pSuite pSuite, const char *szName)
+{
+  return CU_add_test(pSuite, szName, &detail::function_trampoline<Func>);
+}
+
+/*=================================================================
+ *  Typed tests
+ *=================================================================*/
+/** A list of types over which a typed test is instantiated. */
+template <typename... Ts>
+struct type_list {};
+
+namespace detail {
+
+/** Name of an arithmetic type, derived from its size and signedness. */
+template <typename T>
+const char* arithmetic_type_name()
+{
+  if constexpr (std::is_same_v<T, bool>) {
+    return "bool";
+  }
+  else if constexpr (std::is_same_v<T, char>) {
+    return "char";
+  }
+  else if constexpr (std::is_same_v<T, float>) {
+    return "float";
+  }
+  else if constexpr (std::is_same_v<T, double>) {
+    return "double";
+  }
+  else if constexpr (std::is_floating_point_v<T>) {
+    return "long double";
+  }
+  else if constexpr (std::is_signed_v<T>) {
+    return (1 == sizeof(T)) ? "int8" : (2 == sizeof(T)) ? "int16" :
+           (4 == sizeof(T)) ? "int32" : (8 == sizeof(T)) ? "int64" : "int128";
+  }
+  else {
+    return (1 == sizeof(T)) ? "uint8" : (2 == sizeof(T)) ? "uint16" :
+           (4 == sizeof(T)) ? "uint32" : (8 == sizeof(T)) ? "uint64" : "uint128";
+  }
+}
+
+/** Name of T as spelled in the compiler's function signature. */
+template <typename T>
+const char* signature_type_name()
+{
+  static char szName[MAX_NAME_LEN] = "";
+  const char *szBegin = nullptr;
+  const char *szEnd = nullptr;
+
+  if ('\0' != szName[0]) {
+    return szName;
+  }
+#if defined(__GNUC__)
+  /* "... signature_type_name() [with T = name]" or "[T = name]" */
+  if (nullptr != (szBegin = std::strstr(__PRETTY_FUNCTION__, "T = "))) {
+    szBegin += 4;
+    szEnd = szBegin + std::strcspn(szBegin, ";]");
+  }
+#elif defined(_MSC_VER)
+  /* "... signature_type_name<name>(void)" */
+  if (nullptr != (szBegin = std::strstr(__FUNCSIG__, "signature_type_name<"))) {
+    szBegin += sizeof("signature_type_name<") - 1;
+    szEnd = std::strstr(szBegin, ">(void)");
+  }
+#endif
+  if ((nullptr != szBegin) && (nullptr != szEnd) && (szEnd > szBegin)) {
+    std::snprintf(szName, sizeof(szName), "%.*s", static_cast<int>(szEnd - szBegin), szBegin);
+  }
+  else {
+    std::snprintf(szName, sizeof(szName), "?");
+  }
+  return szName;
+}
+
+/** Trampoline running the typed test Body<T>. */
+template <template <typename> class Body, typename T>
+void typed_trampoline()
+{
+  run_guarded([] { Body<T> body; body(); });
+}
+
+} /* namespace detail */
+
+/** Trait naming a type in the names of typed tests.
+ *  Arithmetic types are named by size and signedness (int8, uint32,
+ *  float, ...), other types as spelled by the compiler.  Specialize it
+ *  with CU_TYPE_NAME for shorter names, e.g. for SIMD wrapper types.
+ */
+template <typename T>
+struct type_name
+{
+  static const char* get()
+  {
+    if constexpr (std::is_arithmetic_v<T>) {
+      return detail::arithmetic_type_name<T>();
+    }
+    else {
+      return detail::signature_type_name<T>();
+    }
+  }
+};
+
+/** Registers the typed test Body for every type in the list.
+ *  Body<T> is a default-constructible class template whose call operator
+ *  holds the test, see CU_TYPED_TEST.  It is constructed and destroyed
+ *  per test run, so it may derive from a fixture.  The instantiations
+ *  are named "name<type>" and added to the suite with a single
+ *  CU_add_tests() call.
+ *
+ *  @return The error code of CU_add_tests().
+ */
+template <template <typename> class Body, typename... Ts>
+CU_ErrorCode add_typed_test(CU_pSuite pSuite, const char *szName, type_list<Ts...>)
+{
+  char aszNames[sizeof...(Ts) + 1][MAX_NAME_LEN];
+  CU_TestInfo aTests[sizeof...(Ts) + 1];
+  std::size_t i = 0;
+
+  ((std::snprintf(aszNames[i], MAX_NAME_LEN, "%s<%s>", szName, type_name<Ts>::get()),
+    aTests[i].pName = aszNames[i],
+    aTests[i].pTestFunc = &detail::typed_trampoline<Body, Ts>,
+    ++i), ...);
+  aTests[i].pName = nullptr;
+  aTests[i].pTestFunc = nullptr;
+
+  return CU_add_tests(pSuite, aTests);
+}
+
+/*=================================================================
+ *  Compile-time tests
+ *=================================================================*/
+/** Reached only when a CU_STATIC_CHECK fails during constant evaluation.
+ *  Not constexpr, so the compiler rejects the failing test and reports
+ *  the call, including the failed condition, at the line of the check.
+ */
+inline void compile_time_check_failed(const char *szCondition)
+{
+  CU_UNREFERENCED_PARAMETER(szCondition);
+}
+
+/** Registers a compile-time test which has passed static_assert.
+ *  The test is reported as passed without being run.
+ */
+template <typename Test>
+CU_pTest add_constexpr_test(CU_pSuite pSuite, const char *szName)
+{
+  static_assert(Test::run(), "compile-time test failed");
+  return CU_add_compile_time_test(pSuite, szName);
+}
+
+} /* namespace cunit */
+
+/** Names type as name in typed tests (use at global scope). */
+#define CU_TYPE_NAME(type, name) \
+  namespace cunit { template <> struct type_name<type> { static const char* get() { return (name); } }; }
+
+/** Declares a typed test; the body follows and refers to the type as
+ *  TypeParam, e.g.
+ *  <PRE>
+ *    CU_TYPED_TEST(test_push) { std::vector<TypeParam> v; ... }
+ *  </PRE>
+ */
+#define CU_TYPED_TEST(name) \
+  template <typename TypeParam> struct name { void operator()(); }; \
+  template <typename TypeParam> void name<TypeParam>::operator()()
+
+/** Declares a typed test deriving from fixture, which may depend on
+ *  TypeParam.  Members of a dependent fixture are reached via this->.
+ */
+#define CU_TYPED_FIXTURE_TEST(fixture, name) \
+  template <typename TypeParam> struct name : fixture { void operator()(); }; \
+  template <typename TypeParam> void name<TypeParam>::operator()()
+
+/** Shortcut macro for registering a typed test over a cunit::type_list
+ *  (the list may be spelled out in place, commas included).
+ */
+#define CU_ADD_TYPED_TEST(suite, name, ...) \
+  (::cunit::add_typed_test<name>((suite), #name, __VA_ARGS__{}))
+
+/** Declares a test evaluated by the compiler; the body follows, uses
+ *  CU_STATIC_CHECK and returns true, e.g.
+ *  <PRE>
+ *    CU_CONSTEXPR_TEST(crc_table) {
+ *      CU_STATIC_CHECK(crc_table[1] == 0x77073096u);
+ *      return true;
+ *    }
+ *  </PRE>
+ *  A failing check makes registering the test with CU_ADD_CONSTEXPR_TEST
+ *  a compile error naming the test and the failed condition.
+ */
+#define CU_CONSTEXPR_TEST(name) \
+  struct name { static constexpr bool run(); }; \
+  constexpr bool name::run()
+
+/** Checks condition inside a CU_CONSTEXPR_TEST. */
+#define CU_STATIC_CHECK(condition) \
+  { if (!(condition)) { ::cunit::compile_time_check_failed("CU_STATIC_CHECK(" #condition ")"); return false; } }
+
+/** Verifies a CU_CONSTEXPR_TEST at compile time and registers it. */
+#define CU_ADD_CONSTEXPR_TEST(suite, name) \
+  ([](CU_pSuite cu_pSuite) { \
+     static_assert(name::run(), "compile-time test " #name " failed"); \
+     return ::cunit::add_constexpr_test<name>(cu_pSuite, #name); \
+   }(suite))
+
+/** Shortcut macro for registering a fixture member function. */
+#define CU_ADD_FIXTURE_TEST(suite, fixture, method) \
+  (::cunit::add_test<&fixture::method>((suite), #method))
+
+#define CU_CXX_CHECK(o, name, actual, expected, fatal) \
+  ::cunit::detail::check<::cunit::detail::op::o>((actual), (expected), __LINE__, \
+      (name "(" #actual "," #expected ")"), __FILE__, (fatal))
+
+/** Asserts that actual == expected (C strings by content). */
+#define CU_CHECK_EQUAL(actual, expected)               CU_CXX_CHECK(eq, "CU_CHECK_EQUAL", actual, expected, false)
+/** Asserts that actual == expected, aborting the test on failure. */
+#define CU_CHECK_EQUAL_FATAL(actual, expected)         CU_CXX_CHECK(eq, "CU_CHECK_EQUAL_FATAL", actual, expected, true)
+/** Asserts that actual != expected. */
+#define CU_CHECK_NOT_EQUAL(actual, expected)           CU_CXX_CHECK(ne, "CU_CHECK_NOT_EQUAL", actual, expected, false)
+/** Asserts that actual != expected, aborting the test on failure. */
+#define CU_CHECK_NOT_EQUAL_FATAL(actual, expected)     CU_CXX_CHECK(ne, "CU_CHECK_NOT_EQUAL_FATAL", actual, expected, true)
+/** Asserts that actual < expected. */
+#define CU_CHECK_LESS(actual, expected)                CU_CXX_CHECK(lt, "CU_CHECK_LESS", actual, expected, false)
+/** Asserts that actual < expected, aborting the test on failure. */
+#define CU_CHECK_LESS_FATAL(actual, expected)          CU_CXX_CHECK(lt, "CU_CHECK_LESS_FATAL", actual, expected, true)
+/** Asserts that actual <= expected. */
+#define CU_CHECK_LESS_EQUAL(actual, expected)          CU_CXX_CHECK(le, "CU_CHECK_LESS_EQUAL", actual, expected, false)
+/** Asserts that actual <= expected, aborting the test on failure. */
+#define CU_CHECK_LESS_EQUAL_FATAL(actual, expected)    CU_CXX_CHECK(le, "CU_CHECK_LESS_EQUAL_FATAL", actual, expected, true)
+/** Asserts that actual > expected. */
+#define CU_CHECK_GREATER(actual, expected)             CU_CXX_CHECK(gt, "CU_CHECK_GREATER", actual, expected, false)
+/** Asserts that actual > expected, aborting the test on failure. */
+#define CU_CHECK_GREATER_FATAL(actual, expected)       CU_CXX_CHECK(gt, "CU_CHECK_GREATER_FATAL", actual, expected, true)
+/** Asserts that actual >= expected. */
+#define CU_CHECK_GREATER_EQUAL(actual, expected)       CU_CXX_CHECK(ge, "CU_CHECK_GREATER_EQUAL", actual, expected, false)
+/** Asserts that actual >= expected, aborting the test on failure. */
+#define CU_CHECK_GREATER_EQUAL_FATAL(actual, expected) CU_CXX_CHECK(ge, "CU_CHECK_GREATER_EQUAL_FATAL", actual, expected, true)
+
+/** Asserts that actual is within tolerance of expected. */
+#define CU_CHECK_NEAR(actual, expected, tolerance) \
+  ::cunit::detail::check_near((actual), (expected), (tolerance), __LINE__, \
+      ("CU_CHECK_NEAR(" #actual "," #expected "," #tolerance ")"), __FILE__, false)
+/** Asserts that actual is within tolerance of expected, aborting the test on failure. */
+#define CU_CHECK_NEAR_FATAL(actual, expected, tolerance) \
+  ::cunit::detail::check_near((actual), (expected), (tolerance), __LINE__, \
+      ("CU_CHECK_NEAR_FATAL(" #actual "," #expected "," #tolerance ")"), __FILE__, true)
+
+/** Asserts that evaluating expression throws an exception of type exception. */
+#define CU_CHECK_THROW(expression, exception) \
+  { \
+    bool cu_bThrown = false; \
+    try { (void)(expression); } \
+    catch (const exception&) { cu_bThrown = true; } \
+    CU_assertImplementation(cu_bThrown ? CU_TRUE : CU_FALSE, __LINE__, \
+        ("CU_CHECK_THROW(" #expression "," #exception ")"), __FILE__, "", CU_FALSE); \
+  }
+
+/** Asserts that evaluating expression does not throw. */
+#define CU_CHECK_NO_THROW(expression) \
+  { \
+    bool cu_bThrown = false; \
+    try { (void)(expression); } \
+    catch (...) { cu_bThrown = true; } \
+    CU_assertImplementation(cu_bThrown ? CU_FALSE : CU_TRUE, __LINE__, \
+        ("CU_CHECK_NO_THROW(" #expression ")"), __FILE__, "", CU_FALSE); \
+  }
+
+#endif  /*  CUNIT_CUNIT_HPP_SEEN  */
+/** @} */
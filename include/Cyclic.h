@@ -0,0 +1,136 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Interface for measuring the jitter of periodic tasks.
+ *
+ *  19-Oct-2026   Initial implementation of cyclic task tests.
+ */
+
+/** @file
+ *  Cyclic task tests (user interface).
+ *  A cyclic test runs a body once per period on the calling thread,
+ *  sleeping until absolute deadlines (clock_nanosleep() with
+ *  TIMER_ABSTIME on CLOCK_MONOTONIC), like cyclictest.  Deadlines are
+ *  multiples of the period from the start, so lateness does not
+ *  accumulate.  For every cycle the wake-up latency (wake-up time minus
+ *  deadline) and the execution time of the body are added to
+ *  histograms.  A cycle whose body ends after the next deadline is a
+ *  deadline miss; the deadlines that already passed are then skipped.
+ *  The jitter checked by CU_ASSERT_CYCLIC() is the largest wake-up
+ *  latency.
+ *
+ *  Optionally the thread runs with a SCHED_FIFO priority during the
+ *  test, which needs CAP_SYS_NICE or an RLIMIT_RTPRIO; without the
+ *  permission the test runs at normal priority.  Cyclic tests are only
+ *  available on LINUX builds.
+ */
+/** @addtogroup Framework
+ * @{
+ */
+
+#ifndef CUNIT_CYCLIC_H_SEEN
+#define CUNIT_CYCLIC_H_SEEN
+
+#include "CUnit.h"
+#include "CUError.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CU_CYCLIC_BINS 100
+/**< Number of histogram bins (not counting the overflow bin). */
+
+typedef void (*CU_CyclicBody)(unsigned long ulCycle, void *pContext);
+/**<
+ *  Body of a cyclic test, called once per period.  A fatal assertion in
+ *  the body ends the test after the scheduling policy is restored.
+ */
+
+/** Description of a cyclic test. */
+typedef struct CU_CyclicSpec
+{
+  CU_CyclicBody pBody;          /**< Body called every period. */
+  void*         pContext;       /**< Passed to the body. */
+  unsigned long ulPeriodNs;     /**< Period in nanoseconds. */
+  unsigned long ulCycles;       /**< Number of cycles. */
+  unsigned long ulBinNs;        /**< Width of the histogram bins in nanoseconds (0 for 1 us). */
+  int           iPriority;      /**< SCHED_FIFO priority during the test (0 to keep the policy). */
+  unsigned long ulMaxJitterNs;  /**< Largest wake-up latency accepted by CU_ASSERT_CYCLIC() (0 to not check). */
+  double        dMaxMissRate;   /**< Largest fraction of deadline misses accepted by CU_ASSERT_CYCLIC(). */
+} CU_CyclicSpec;
+
+/** Histogram of durations in nanoseconds. */
+typedef struct CU_CyclicHistogram
+{
+  unsigned long ulBinNs;                  /**< Width of a bin. */
+  unsigned long aulBins[CU_CYCLIC_BINS];  /**< Counts of durations from i * ulBinNs to below (i + 1) * ulBinNs. */
+  unsigned long ulOverflow;               /**< Count of longer durations. */
+  unsigned long ulMin;                    /**< Shortest duration. */
+  unsigned long ulMax;                    /**< Longest duration. */
+  double        dMean;                    /**< Mean duration. */
+} CU_CyclicHistogram;
+
+/** Outcome of a cyclic test. */
+typedef struct CU_CyclicResult
+{
+  unsigned long      ulCycles;      /**< Cycles run. */
+  unsigned long      ulMisses;      /**< Cycles ending after the next deadline. */
+  unsigned long      ulSkipped;     /**< Deadlines skipped after misses. */
+  CU_BOOL            bRealtime;     /**< Whether the SCHED_FIFO priority was set. */
+  CU_CyclicHistogram latency;       /**< Wake-up latencies. */
+  CU_CyclicHistogram execution;     /**< Execution times of the body. */
+} CU_CyclicResult;
+typedef CU_CyclicResult* CU_pCyclicResult;  /**< Pointer to a cyclic test outcome. */
+
+CU_EXPORT CU_ErrorCode CU_cyclic_run(const CU_CyclicSpec *pSpec, CU_pCyclicResult pResult);
+/**<
+ *  Runs a cyclic test and prints its statistics and histograms.
+ *
+ *  CU_cyclic_run() sets the following error codes:
+ *  - CUE_SUCCESS if the test ran.
+ *  - CUE_NOT_SUPPORTED on builds without clock_nanosleep().
+ *
+ *  @param pSpec   The test (non-NULL, with a non-zero period).
+ *  @param pResult Receives the outcome (non-NULL).
+ *  @return A CU_ErrorCode indicating the error status.
+ */
+
+CU_EXPORT CU_BOOL CU_assertCyclicImplementation(const CU_CyclicSpec *pSpec,
+                                                unsigned int uiLine, const char *strCondition,
+                                                const char *strFile, const char *strFunction,
+                                                CU_BOOL bFatal);
+/**<
+ *  Implementation of CU_ASSERT_CYCLIC().  Passes if the largest wake-up
+ *  latency and the miss rate are within the limits of the test.
+ */
+
+#define CU_ASSERT_CYCLIC(spec) \
+  { CU_assertCyclicImplementation((spec), __LINE__, ("CU_ASSERT_CYCLIC(" #spec ")"), __FILE__, "", CU_FALSE); }
+/**< Asserts that a cyclic task meets its jitter and deadline limits. */
+
+#define CU_ASSERT_CYCLIC_FATAL(spec) \
+  { CU_assertCyclicImplementation((spec), __LINE__, ("CU_ASSERT_CYCLIC_FATAL(" #spec ")"), __FILE__, "", CU_TRUE); }
+/**< Fatal version of CU_ASSERT_CYCLIC(). */
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /*  CUNIT_CYCLIC_H_SEEN  */
+/** @} */
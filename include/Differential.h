@@ -0,0 +1,190 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Interface for differential testing of alternative implementations.
+ *
+ *  19-Oct-2026   Initial implementation of differential testing.
+ */
+
+/** @file
+ *  Differential testing (user interface).
+ *  A differential test runs several implementations of the same kernel
+ *  (e.g. a scalar reference and SIMD versions) on the same generated
+ *  inputs and compares their outputs with the output of the first one,
+ *  the reference.  A kernel maps an input buffer of a fixed size to an
+ *  output buffer of a fixed size; buffers are aligned to 64 bytes.
+ *  Outputs are compared bytewise, or as arrays of float or double with
+ *  an absolute and a relative tolerance.
+ *
+ *  Inputs are generated from their index, so every input can be
+ *  regenerated.  They are processed in batches by several threads
+ *  (LINUX builds; elsewhere by the calling thread): each batch is
+ *  generated, passed through every implementation in turn, and
+ *  compared.  The first divergent input (the one with the lowest index)
+ *  is then shrunk with the optional shrinker, which proposes simpler
+ *  variants of an input; a variant that still diverges replaces it.
+ *  The shrunk input is saved as raw bytes if a file is given.  The time
+ *  per input of each implementation is reported as a by-product.
+ *  Kernels and generators must be thread-safe.
+ */
+/** @addtogroup Framework
+ * @{
+ */
+
+#ifndef CUNIT_DIFFERENTIAL_H_SEEN
+#define CUNIT_DIFFERENTIAL_H_SEEN
+
+#include <stddef.h>
+
+#include "CUnit.h"
+#include "CUError.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CU_DIFFERENTIAL_MAX_IMPLS 8
+/**< Maximum number of implementations of a differential test. */
+
+#define CU_DIFFERENTIAL_MAX_THREADS 16
+/**< Maximum number of worker threads. */
+
+#ifndef CU_DIFFERENTIAL_ARENA_SIZE
+#ifdef LINUX
+#define CU_DIFFERENTIAL_ARENA_SIZE (8UL * 1024UL * 1024UL)
+#else
+#define CU_DIFFERENTIAL_ARENA_SIZE (256UL * 1024UL)
+#endif
+#endif
+/**<
+ *  Bytes available for the input and output buffers of all threads,
+ *  allocated statically.  Builds for small targets may define it on the
+ *  compiler command line; without LINUX only one thread runs, and the
+ *  default is smaller.
+ */
+
+#define CU_DIFFERENTIAL_MAX_SHRINKS 1000
+/**< Maximum number of candidates tried while shrinking. */
+
+typedef void (*CU_DifferentialKernel)(const void *pInput, void *pOutput);
+/**< Implementation under test, computing the output of one input. */
+
+typedef void (*CU_DifferentialGenerator)(unsigned long long ullSeed, void *pInput);
+/**< Fills an input buffer from a seed derived from the input index. */
+
+typedef CU_BOOL (*CU_DifferentialShrinker)(const void *pInput, unsigned int uiCandidate, void *pCandidate);
+/**< Fills pCandidate with the uiCandidate-th simpler variant of pInput.
+ *  Returns CU_FALSE if there is no such variant.
+ */
+
+/** Interpretation of the outputs for comparison. */
+typedef enum CU_DifferentialElement
+{
+  CUDE_Bytes = 0,   /**< Outputs must be identical. */
+  CUDE_Float,       /**< Outputs are arrays of float. */
+  CUDE_Double       /**< Outputs are arrays of double. */
+} CU_DifferentialElement;
+
+/** An implementation of the kernel. */
+typedef struct CU_DifferentialImpl
+{
+  const char*           szName;   /**< Name used in reports. */
+  CU_DifferentialKernel pKernel;  /**< The implementation. */
+} CU_DifferentialImpl;
+
+/** Description of a differential test. */
+typedef struct CU_DifferentialSpec
+{
+  const CU_DifferentialImpl* aImpls;      /**< Implementations, the reference first. */
+  unsigned int               uiImpls;     /**< Number of implementations (2 to CU_DIFFERENTIAL_MAX_IMPLS). */
+  size_t                     nInputSize;  /**< Bytes per input. */
+  size_t                     nOutputSize; /**< Bytes per output. */
+  CU_DifferentialElement     eElement;    /**< How outputs are compared. */
+  double                     dAbsTolerance; /**< Allowed absolute difference (CUDE_Float, CUDE_Double). */
+  double                     dRelTolerance; /**< Allowed difference relative to the larger magnitude. */
+  CU_DifferentialGenerator   pGenerator;  /**< Input generator. */
+  CU_DifferentialShrinker    pShrinker;   /**< Input shrinker (NULL to keep the input). */
+  unsigned long              ulInputs;    /**< Number of inputs to compare. */
+  unsigned int               uiBatch;     /**< Inputs per batch (0 for 64). */
+  unsigned int               uiThreads;   /**< Worker threads (0 for the number of CPUs). */
+  unsigned long long         ullSeed;     /**< Seed of the input sequence. */
+  const char*                szSaveFile;  /**< File receiving the divergent input (NULL for none). */
+} CU_DifferentialSpec;
+typedef CU_DifferentialSpec* CU_pDifferentialSpec;  /**< Pointer to a differential test description. */
+
+/** Outcome of a differential test. */
+typedef struct CU_DifferentialResult
+{
+  unsigned long ulInputs;          /**< Inputs compared. */
+  CU_BOOL       bDiverged;         /**< Whether an implementation diverged. */
+  unsigned long ulFirstDivergent;  /**< Index of the first divergent input. */
+  unsigned int  uiImpl;            /**< Implementation diverging from the reference on the shrunk input. */
+  size_t        nElement;          /**< First divergent output element (byte for CUDE_Bytes). */
+  unsigned int  uiShrinkSteps;     /**< Number of accepted shrink steps. */
+  double        adNsPerInput[CU_DIFFERENTIAL_MAX_IMPLS];  /**< Wall time per input of each implementation. */
+} CU_DifferentialResult;
+typedef CU_DifferentialResult* CU_pDifferentialResult;  /**< Pointer to a differential test outcome. */
+
+CU_EXPORT CU_ErrorCode CU_differential_run(const CU_DifferentialSpec *pSpec, CU_pDifferentialResult pResult);
+/**<
+ *  Runs a differential test and prints the time per input of each
+ *  implementation.  Divergence is reported in pResult, not as an error.
+ *
+ *  CU_differential_run() sets the following error codes:
+ *  - CUE_SUCCESS if the test ran.
+ *  - CUE_NOMEMORY if the implementations are too many or too few, or
+ *    the buffers of one input do not fit CU_DIFFERENTIAL_ARENA_SIZE.
+ *  - CUE_FOPEN_FAILED if the divergent input could not be saved.
+ *
+ *  @param pSpec   The test (non-NULL).
+ *  @param pResult Receives the outcome (non-NULL).
+ *  @return A CU_ErrorCode indicating the error status.
+ */
+
+CU_EXPORT unsigned long long CU_differential_next(unsigned long long *pullState);
+/**<
+ *  Returns the next value of a fast pseudo-random sequence (splitmix64)
+ *  and advances its state, for use in generators and shrinkers.
+ *
+ *  @param pullState State of the sequence, e.g. a generator's seed (non-NULL).
+ */
+
+CU_EXPORT CU_BOOL CU_assertDifferentialImplementation(const CU_DifferentialSpec *pSpec,
+                                                      unsigned int uiLine, const char *strCondition,
+                                                      const char *strFile, const char *strFunction,
+                                                      CU_BOOL bFatal);
+/**<
+ *  Implementation of CU_ASSERT_DIFFERENTIAL().  Passes if no
+ *  implementation diverged; the failure names the divergent
+ *  implementation, output element and input.
+ */
+
+#define CU_ASSERT_DIFFERENTIAL(spec) \
+  { CU_assertDifferentialImplementation((spec), __LINE__, ("CU_ASSERT_DIFFERENTIAL(" #spec ")"), __FILE__, "", CU_FALSE); }
+/**< Asserts that all implementations of a differential test agree with the reference. */
+
+#define CU_ASSERT_DIFFERENTIAL_FATAL(spec) \
+  { CU_assertDifferentialImplementation((spec), __LINE__, ("CU_ASSERT_DIFFERENTIAL_FATAL(" #spec ")"), __FILE__, "", CU_TRUE); }
+/**< Fatal version of CU_ASSERT_DIFFERENTIAL(). */
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /*  CUNIT_DIFFERENTIAL_H_SEEN  */
+/** @} */
@@ -0,0 +1,324 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Interface for exporting and reading compact result logs.
+ *
+ *  19-Oct-2026   Initial implementation of compact result export.
+ */
+
+/** @file
+ *  Compact result log export (user interface).
+ *  A result log is a line-oriented, tab-separated text rendering of
+ *  the last test run: a header, one record per test reached by the run
+ *  (followed by its failure records), the suite-level failures after the
+ *  tests of their suite, and the run summary.  Logs are
+ *  written in registration order so that logs from several processes
+ *  can be combined by external tools.  Each line starts with a record
+ *  tag:
+ *
+ *  - <CODE>H version package suites tests</CODE>
+ *  - <CODE>T index suite test outcome asserts failed seconds [heap-growth [wall-seconds]]</CODE>
+ *  - <CODE>F index suite test type line file condition [statistic p-value]</CODE>
+ *  - <CODE>R suites-run suites-failed suites-inactive tests-run
+ *        tests-failed tests-inactive asserts asserts-failed
+ *        failure-records seconds</CODE>
+ *
+ *  The index is the registration index of the test within the registry.
+ *  Suite-level failures carry an empty test name and the index after the
+ *  last test of their suite, so that the records of a log are ordered by
+ *  index.  The tests of a suite whose initialization failed are written
+ *  with outcome '-' (not run).  Failures of statistical assertions carry
+ *  the test statistic and its p-value in two additional fields.  The
+ *  net heap growth of a test in bytes and its wall-clock time are
+ *  optional when reading; a missing wall-clock time reads as the
+ *  elapsed (CPU) time.
+ *
+ *  Logs of runs sharded across processes are combined with
+ *  CU_merge_result_logs(), and the logs of two runs are compared with
+ *  CU_diff_result_logs().
+ */
+/** @addtogroup Framework
+ * @{
+ */
+
+#ifndef CUNIT_EXPORT_H_SEEN
+#define CUNIT_EXPORT_H_SEEN
+
+#include <stdio.h>
+
+#include "CUnit.h"
+#include "TestDB.h"
+#include "TestRun.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CU_RESULT_LOG_VERSION 2
+/**< Version of the result log format written by CU_export_run_results(). */
+
+#define CU_RESULT_FD_ENV "CU_RESULT_FD"
+/**< Environment variable naming a descriptor to receive the result log. */
+
+/** Types of records in a result log. */
+typedef enum CU_ResultRecordType
+{
+  CURR_Header = 1,  /**< Log header (format version, package, registry size). */
+  CURR_Test,        /**< Outcome and counters of a single test. */
+  CURR_Failure,     /**< A failure record. */
+  CURR_Summary      /**< The run summary. */
+} CU_ResultRecordType;
+
+/** A single record of a result log.
+ *  Only the members applicable to the record type are meaningful.
+ */
+typedef struct CU_ResultRecord
+{
+  CU_ResultRecordType type;                    /**< Record type. */
+  unsigned int   uiIndex;                      /**< Registration index (CURR_Test, CURR_Failure). */
+  char           strSuiteName[MAX_NAME_LEN];   /**< Suite name (CURR_Test, CURR_Failure). */
+  char           strTestName[MAX_NAME_LEN];    /**< Test name, empty for suite failures. */
+  CU_TestOutcome eOutcome;                     /**< Outcome of the test (CURR_Test). */
+  unsigned int   uiNumberOfAsserts;            /**< Assertions tested (CURR_Test). */
+  unsigned int   uiNumberOfAssertsFailed;      /**< Failed assertions (CURR_Test). */
+  double         dElapsedTime;                 /**< Test elapsed time in seconds (CURR_Test). */
+  long           lHeapGrowth;                  /**< Net heap growth in bytes (CURR_Test). */
+  double         dWallTime;                    /**< Test wall-clock time in seconds (CURR_Test). */
+  CU_FailureType eFailureType;                 /**< Failure type (CURR_Failure). */
+  unsigned int   uiLineNumber;                 /**< Line number of failure (CURR_Failure). */
+  char           strFileName[MAX_NAME_LEN];    /**< File name of failure (CURR_Failure). */
+  char           strCondition[MAX_NAME_LEN];   /**< Failed condition (CURR_Failure). */
+  CU_BOOL        fStatistic;                   /**< Whether a statistic is present (CURR_Failure). */
+  double         dStatistic;                   /**< Test statistic (CURR_Failure). */
+  double         dPValue;                      /**< p-value, negative if not applicable (CURR_Failure). */
+  unsigned int   uiVersion;                    /**< Log format version (CURR_Header). */
+  unsigned int   uiNumberOfSuites;             /**< Registered suites (CURR_Header). */
+  unsigned int   uiNumberOfTests;              /**< Registered tests (CURR_Header). */
+  CU_RunSummary  summary;                      /**< Package name (CURR_Header), run counts (CURR_Summary). */
+} CU_ResultRecord;
+typedef CU_ResultRecord* CU_pResultRecord;     /**< Pointer to CU_ResultRecord. */
+
+#define CU_MERGE_MAX_LOGS 128
+/**< Maximum number of logs combined by CU_merge_result_logs(). */
+
+/** Outcome of merging result logs. */
+typedef struct CU_MergeSummary
+{
+  CU_RunSummary  summary;              /**< Run summary of the merged log. */
+  unsigned int   uiNumberOfSuites;     /**< Registered suites according to the headers. */
+  unsigned int   uiNumberOfTests;      /**< Registered tests according to the headers. */
+  unsigned int   uiMissingTests;       /**< Registered tests reported by no log. */
+  unsigned int   uiDuplicateTests;     /**< Test records dropped as reported by an earlier log. */
+  unsigned int   uiIncompleteLogs;     /**< Logs ending without a run summary. */
+} CU_MergeSummary;
+typedef CU_MergeSummary* CU_pMergeSummary;     /**< Pointer to CU_MergeSummary. */
+
+typedef void (*CU_MergeRecordHandler)(const CU_ResultRecord *pRecord);
+/**< Receives each record of a merged log. */
+
+#define CU_DIFF_WINDOW 64
+/**< Tests looked ahead in each log to match added, removed or moved tests. */
+
+#define CU_DIFF_MAX_DELTAS 32
+/**< Number of most significant deltas kept by CU_diff_result_logs(). */
+
+/** Kinds of differences between two result logs. */
+typedef enum CU_DiffType
+{
+  CUDT_NewlyFailing = 1,  /**< Test failed now but passed before. */
+  CUDT_NewlyPassing,      /**< Test passed now but failed before. */
+  CUDT_Disappeared,       /**< Test reported before but not now. */
+  CUDT_Added,             /**< Test reported now but not before. */
+  CUDT_Time,              /**< Change of the wall-clock time in seconds. */
+  CUDT_Heap,              /**< Change of the heap growth in bytes. */
+  CUDT_Asserts            /**< Change of the number of assertions. */
+} CU_DiffType;
+
+/** A difference of a test between two result logs. */
+typedef struct CU_DiffEntry
+{
+  CU_DiffType    type;                         /**< Kind of difference. */
+  char           strSuiteName[MAX_NAME_LEN];   /**< Suite name. */
+  char           strTestName[MAX_NAME_LEN];    /**< Test name. */
+  double         dBefore;                      /**< Value in the earlier log (deltas). */
+  double         dAfter;                       /**< Value in the later log (deltas). */
+  double         dSignificance;                /**< Change in multiples of its expected noise (deltas). */
+} CU_DiffEntry;
+typedef CU_DiffEntry* CU_pDiffEntry;           /**< Pointer to CU_DiffEntry. */
+
+typedef void (*CU_DiffHandler)(const CU_DiffEntry *pEntry);
+/**< Receives each outcome change, disappeared and added test of a comparison. */
+
+/** Outcome of comparing two result logs. */
+typedef struct CU_DiffSummary
+{
+  unsigned int   uiCompared;                   /**< Tests found in both logs. */
+  unsigned int   uiNewlyFailing;               /**< Tests failing now but passing before. */
+  unsigned int   uiNewlyPassing;               /**< Tests passing now but failing before. */
+  unsigned int   uiDisappeared;                /**< Tests only in the earlier log. */
+  unsigned int   uiAdded;                      /**< Tests only in the later log. */
+  unsigned int   uiDeltas;                     /**< Significant deltas found. */
+  unsigned int   uiNumberOfDeltas;             /**< Entries in aDeltas. */
+  CU_DiffEntry   aDeltas[CU_DIFF_MAX_DELTAS];  /**< Most significant deltas, most significant first. */
+} CU_DiffSummary;
+typedef CU_DiffSummary* CU_pDiffSummary;       /**< Pointer to CU_DiffSummary. */
+
+CU_EXPORT CU_ErrorCode CU_export_run_results(FILE *file);
+/**<
+ *  Writes the result log of the last test run to file.
+ *  The registry must be initialized.  Tests which were not reached
+ *  by the last run are omitted.
+ *
+ *  @param file Stream to receive the log (non-NULL).
+ *  @return CUE_NOREGISTRY if the registry is not initialized,
+ *          CUE_WRITE_ERROR if writing failed, CUE_SUCCESS otherwise.
+ */
+
+CU_EXPORT void CU_export_requested_results(void);
+/**<
+ *  Writes the result log of the last test run to the descriptor named
+ *  by the CU_RESULT_FD environment variable, if set.  This is the hook
+ *  used by test orchestrators to collect results from test executables
+ *  over a pipe.  The basic interface calls it when all tests are
+ *  complete.  Only available on LINUX builds (no-op otherwise).
+ */
+
+CU_EXPORT CU_ErrorCode CU_export_stream_results(int fd);
+/**<
+ *  Streams the result log of the following runs to fd while they run.
+ *  The records of a test are written when it completes, so a log
+ *  survives a crash of the test process up to the last completed test.
+ *  Suite-level failures follow the tests of their suite, and the
+ *  summary ends the log of each run.  The output goes through an
+ *  asynchronous stream (see AsyncOutput.h), so tests do not wait for
+ *  the descriptor; the end of the run waits until the log is written.
+ *  Calling it again ends the previous stream; a negative fd just ends
+ *  it.  The descriptor is not closed.  <b>This function must not be
+ *  called during a test run (checked by assertion)</b>.
+ *
+ *  @param fd Descriptor to stream to, negative to stop streaming.
+ *  @return CUE_WRITE_ERROR if writing the previous stream failed, an
+ *          error of CU_async_open(), or CUE_SUCCESS.
+ */
+
+CU_EXPORT void CU_export_stream_run_start(void);
+/**< Streams the header of a run.  Called by the test runner. */
+
+CU_EXPORT void CU_export_stream_test(CU_pSuite pSuite, CU_pTest pTest);
+/**< Streams the records of a completed test.  Called by the test runner. */
+
+CU_EXPORT void CU_export_stream_suite(CU_pSuite pSuite);
+/**< Streams the suite-level failures of a completed suite.  Called by the test runner. */
+
+CU_EXPORT void CU_export_stream_run_complete(void);
+/**< Streams the summary of a run and waits until the log is written.  Called by the test runner. */
+
+CU_EXPORT CU_ErrorCode CU_write_result_record(FILE *file, const CU_ResultRecord *pRecord);
+/**<
+ *  Writes a single result log record to file.
+ *
+ *  @param file    Stream to receive the record (non-NULL).
+ *  @param pRecord Record to write (non-NULL).
+ *  @return CUE_WRITE_ERROR if writing failed, CUE_SUCCESS otherwise.
+ */
+
+CU_EXPORT CU_BOOL CU_read_result_record(FILE *file, CU_pResultRecord pRecord);
+/**<
+ *  Reads the next record from a result log.
+ *  Blank lines are skipped.  The framework error is set to
+ *  CUE_BAD_RESULT_RECORD if a malformed line is encountered, and
+ *  to CUE_SUCCESS otherwise.
+ *
+ *  @param file    Stream holding the log (non-NULL).
+ *  @param pRecord Record to fill in (non-NULL).
+ *  @return CU_TRUE if a record was read, CU_FALSE at end of file
+ *          or on a malformed record.
+ */
+
+CU_EXPORT CU_ErrorCode CU_merge_result_logs(FILE *apLogs[],
+                                            unsigned int uiLogs,
+                                            FILE *pOutput,
+                                            CU_MergeRecordHandler pHandler,
+                                            CU_pMergeSummary pMerge);
+/**<
+ *  Combines the result logs of shards of one registry into a single
+ *  log in registration order.  The logs are merged as they are read,
+ *  holding one record per log, so memory does not depend on the size
+ *  of the logs.  Only the first run of each log is used.  A test
+ *  reported by several logs is kept from the first of them, a test
+ *  not run because its suite failed initialization only if no log ran
+ *  it, and identical suite-level failures are kept once.  Tests, suites,
+ *  assertions and failure records of the merged summary are counted
+ *  from the merged records; inactive suites and the elapsed time are
+ *  the largest values reported by a log (shards run concurrently).
+ *  Missing and duplicated tests are reported with VLA_error(); tests of
+ *  suites inactive in every log are missing.
+ *
+ *  CU_merge_result_logs() sets the following error codes:
+ *  - CUE_SUCCESS if the logs were merged (see pMerge for missing,
+ *    duplicated and incomplete results).
+ *  - CUE_NOMEMORY if uiLogs exceeds CU_MERGE_MAX_LOGS.
+ *  - CUE_BAD_RESULT_RECORD if a log is malformed, does not start with
+ *    a header, or its header differs from the first log's.
+ *  - CUE_WRITE_ERROR if writing the merged log failed.
+ *
+ *  @param apLogs   Logs to merge (non-NULL, in shard order).
+ *  @param uiLogs   Number of logs (> 0).
+ *  @param pOutput  Stream receiving the merged log (may be NULL).
+ *  @param pHandler Called with each merged record (may be NULL).
+ *  @param pMerge   Receives the outcome of the merge (non-NULL).
+ *  @return A CU_ErrorCode indicating the error status.
+ */
+
+CU_EXPORT CU_ErrorCode CU_diff_result_logs(FILE *pBefore,
+                                           FILE *pAfter,
+                                           CU_DiffHandler pHandler,
+                                           CU_pDiffSummary pDiff);
+/**<
+ *  Compares the result logs of two runs, e.g. the previous nightly run
+ *  and the current one.  Tests are identified by suite and test name
+ *  and compared as both logs are read, in registration order, so a
+ *  comparison holds at most CU_DIFF_WINDOW tests per log.  Tests moved
+ *  further than that appear as disappeared and added.  Only the first
+ *  run of each log is used.
+ *
+ *  Outcome changes, disappeared and added tests are passed to pHandler
+ *  as they are found.  Tests run in both logs also yield deltas of
+ *  their wall-clock time, heap growth and number of assertions.  A delta
+ *  is significant if it exceeds its expected noise: 1 ms plus 10% of
+ *  the smaller time, 256 bytes of heap, or any change of assertions.
+ *  The CU_DIFF_MAX_DELTAS most significant are kept in pDiff.
+ *
+ *  CU_diff_result_logs() sets the following error codes:
+ *  - CUE_SUCCESS if the logs were compared.
+ *  - CUE_BAD_RESULT_RECORD if a log is malformed or does not start
+ *    with a header.
+ *
+ *  @param pBefore  Log of the earlier run (non-NULL).
+ *  @param pAfter   Log of the later run (non-NULL).
+ *  @param pHandler Called with each change of the test set or outcomes (may be NULL).
+ *  @param pDiff    Receives the outcome of the comparison (non-NULL).
+ *  @return A CU_ErrorCode indicating the error status.
+ */
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /*  CUNIT_EXPORT_H_SEEN  */
+/** @} */
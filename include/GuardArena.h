@@ -0,0 +1,123 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Interface for test buffers bounded by guard pages.
+ *
+ *  19-Oct-2026   Initial implementation of the guard-paged arena.
+ */
+
+/** @file
+ *  Guard-paged arena (user interface).
+ *  The arena consists of a few slots of whole pages, each followed by
+ *  an inaccessible guard page.  CU_guard_arena_place() places a buffer
+ *  at a given offset from a 64-byte boundary as close to the end of its
+ *  slot as possible.  The buffer ends flush with the guard page at the
+ *  one offset congruent to (slot size - length) modulo 64, where the
+ *  first read or write past the end faults.  At the other offsets less
+ *  than 64 bytes lie between the buffer and the guard page, and an
+ *  overrun into them is only found by the canaries.  These bytes and the
+ *  64 or more bytes before the buffer are filled with the canary of the
+ *  slot, CU_GUARD_SLOT_CANARY(); CU_guard_arena_check() finds writes to
+ *  them.  The canaries differ between slots, so that a buffer copied
+ *  together with the canaries of another slot is noticed.  The arena is
+ *  mapped once and reused until it is closed or a larger one is opened.
+ *  It is only available on LINUX builds.
+ */
+/** @addtogroup Framework
+ * @{
+ */
+
+#ifndef CUNIT_GUARDARENA_H_SEEN
+#define CUNIT_GUARDARENA_H_SEEN
+
+#include <stddef.h>
+
+#include "CUnit.h"
+#include "CUError.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CU_GUARD_ARENA_MAX_SLOTS 4
+/**< Maximum number of slots in the arena. */
+
+#define CU_GUARD_ALIGN 64U
+/**< Boundary the placement offsets are relative to. */
+
+#define CU_GUARD_CANARY 0xA5U
+/**< Value of the canary bytes around a buffer placed in slot 0. */
+
+#define CU_GUARD_SLOT_CANARY(slot) ((unsigned char)(CU_GUARD_CANARY ^ ((unsigned int)(slot) * 0x3BU)))
+/**< Value of the canary bytes around a buffer placed in a slot. */
+
+CU_EXPORT CU_ErrorCode CU_guard_arena_open(size_t nSlotBytes, unsigned int uiSlots);
+/**<
+ *  Maps the arena with slots of at least nSlotBytes usable bytes.  An
+ *  open arena with enough slots of sufficient size is kept.
+ *
+ *  CU_guard_arena_open() sets the following error codes:
+ *  - CUE_SUCCESS if the arena is open.
+ *  - CUE_NOMEMORY if uiSlots is 0 or above CU_GUARD_ARENA_MAX_SLOTS,
+ *    or the arena could not be mapped.
+ *  - CUE_NOT_SUPPORTED on builds without guard pages.
+ *
+ *  @param nSlotBytes Bytes needed in each slot.
+ *  @param uiSlots    Number of slots needed.
+ *  @return A CU_ErrorCode indicating the error status.
+ */
+
+CU_EXPORT void CU_guard_arena_close(void);
+/**< Unmaps the arena. */
+
+CU_EXPORT void* CU_guard_arena_place(unsigned int uiSlot, size_t nLength, unsigned int uiOffset);
+/**<
+ *  Places a buffer in a slot and fills the canaries around it.  The
+ *  contents of the buffer are undefined.
+ *
+ *  @param uiSlot   Slot of the buffer.
+ *  @param nLength  Length of the buffer in bytes.
+ *  @param uiOffset Offset of the buffer from a CU_GUARD_ALIGN boundary
+ *                  (taken modulo CU_GUARD_ALIGN).  The buffer ends at
+ *                  the guard page if (slot size - nLength - uiOffset)
+ *                  is a multiple of CU_GUARD_ALIGN.
+ *  @return The buffer, or NULL if the arena is not open or the slot
+ *          does not exist or is too small.
+ */
+
+CU_EXPORT CU_BOOL CU_guard_arena_check(unsigned int uiSlot, size_t *pnUnderrun, size_t *pnOverrun);
+/**<
+ *  Checks the canaries of the buffer placed last in a slot.
+ *
+ *  @param uiSlot     Slot of the buffer.
+ *  @param pnUnderrun Receives how far before the buffer the first
+ *                    overwritten canary lies (0 if none; may be NULL).
+ *  @param pnOverrun  Receives how far past the end of the buffer the
+ *                    last overwritten canary lies (0 if none; may be NULL).
+ *  @return CU_TRUE if all canaries are intact.
+ */
+
+CU_EXPORT CU_BOOL CU_guard_arena_is_guard(const void *pAddress);
+/**< Retrieves whether an address lies in a guard page of the arena. */
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /*  CUNIT_GUARDARENA_H_SEEN  */
+/** @} */
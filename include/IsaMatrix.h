@@ -0,0 +1,152 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Interface for running suites once per instruction set level.
+ *
+ *  19-Oct-2026   Initial implementation of ISA-matrix runs.
+ */
+
+/** @file
+ *  ISA-matrix runs (user interface).
+ *  Code dispatching at run time between scalar and SIMD paths is only
+ *  tested on the best path of the host by a normal run.  Suites marked
+ *  with CU_isa_mark_suite() are instead run by CU_isa_run() once per
+ *  instruction set level supported by the host.  Before each level the
+ *  registered dispatch hook forces the code under test to that level;
+ *  afterwards it is called again with the best level of the host.
+ *
+ *  The outcome and wall-clock time of every test are kept per level and
+ *  printed as a matrix.  Failure conditions are prefixed with the level
+ *  they occurred at, e.g. "[avx2] ".  The failure records of all levels
+ *  are available after the matrix run, and the run summary adds up the
+ *  suites, tests, assertions and times of all levels, so a test run at
+ *  three levels counts three times.
+ */
+/** @addtogroup Framework
+ * @{
+ */
+
+#ifndef CUNIT_ISAMATRIX_H_SEEN
+#define CUNIT_ISAMATRIX_H_SEEN
+
+#include "CUnit.h"
+#include "CUError.h"
+#include "TestDB.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CU_ISA_MAX_FAILURES 256
+/**< Maximum number of failure records kept from runs before the last one. */
+
+/** Instruction set levels, in ascending order. */
+typedef enum CU_IsaLevel
+{
+  CU_ISA_SCALAR = 0,    /**< No SIMD instructions. */
+  CU_ISA_SSE42,         /**< SSE up to SSE4.2. */
+  CU_ISA_AVX2,          /**< AVX2 (and FMA where the code uses it). */
+  CU_ISA_AVX512,        /**< AVX-512 Foundation. */
+  CU_ISA_NUM_LEVELS     /**< Number of levels (not a level). */
+} CU_IsaLevel;
+
+#define CU_ISA_LEVEL_MASK(level) (1U << (unsigned int)(level))
+/**< Bit of a level in a level mask. */
+
+typedef CU_BOOL (*CU_IsaDispatchHook)(CU_IsaLevel eLevel);
+/**< Forces the code under test to a level.  Returns CU_FALSE if the
+ *   code cannot run at that level; the level is then skipped.
+ */
+
+/** Results of a test at each level of the last matrix run. */
+typedef struct CU_IsaResult
+{
+  CU_pSuite      pSuite;                            /**< Suite of the test. */
+  CU_pTest       pTest;                             /**< The test. */
+  CU_TestOutcome aeOutcome[CU_ISA_NUM_LEVELS];      /**< Outcome at each level (CUTO_NotRun if skipped). */
+  double         adSeconds[CU_ISA_NUM_LEVELS];      /**< Wall-clock time at each level, in seconds. */
+  unsigned int   auiFailed[CU_ISA_NUM_LEVELS];      /**< Failed assertions at each level. */
+} CU_IsaResult;
+
+CU_EXPORT unsigned int CU_isa_host_levels(void);
+/**<
+ *  Retrieves the mask of levels supported by the host (see
+ *  CU_ISA_LEVEL_MASK()).  The scalar level is always supported; the
+ *  others are detected on x86 with GCC-compatible compilers.
+ */
+
+CU_EXPORT const char* CU_isa_level_name(CU_IsaLevel eLevel);
+/**< Retrieves the name of a level as used in reports, e.g. "avx2". */
+
+CU_EXPORT void CU_isa_set_dispatch_hook(CU_IsaDispatchHook pHook);
+/**<
+ *  Registers the function forcing the dispatch level of the code under
+ *  test (NULL to unregister).
+ */
+
+CU_EXPORT CU_ErrorCode CU_isa_mark_suite(CU_pSuite pSuite, CU_BOOL bMarked);
+/**<
+ *  Marks a suite to be run at every level by CU_isa_run(), or removes
+ *  the mark.
+ *
+ *  CU_isa_mark_suite() sets the following error codes:
+ *  - CUE_SUCCESS if the mark was changed.
+ *  - CUE_NOSUITE if pSuite is NULL.
+ *  - CUE_NOMEMORY if MAX_NUM_OF_SUITES suites are already marked.
+ *
+ *  @param pSuite  Suite to mark.
+ *  @param bMarked CU_TRUE to mark the suite, CU_FALSE to remove the mark.
+ *  @return A CU_ErrorCode indicating the error status.
+ */
+
+CU_EXPORT CU_BOOL CU_isa_is_marked(CU_pSuite pSuite);
+/**< Retrieves whether a suite is marked for matrix runs. */
+
+CU_EXPORT CU_ErrorCode CU_isa_run(CU_pSuite pSuite, unsigned int uiLevels);
+/**<
+ *  Runs a marked suite, or all active marked suites, once per level
+ *  and prints the matrix of outcomes and times.  <b>This function must
+ *  not be called during a test run (checked by assertion)</b>.
+ *
+ *  CU_isa_run() sets the following error codes:
+ *  - CUE_SUCCESS if no errors occurred.
+ *  - CUE_NOREGISTRY if the registry has not been initialized.
+ *  - CUE_NOTEST if no dispatch hook is registered.
+ *  - CUE_NOSUITE if pSuite is not marked.
+ *  - any error returned by CU_run_suite().
+ *
+ *  @param pSuite   Marked suite to run (NULL for all marked suites).
+ *  @param uiLevels Mask of levels to run (0 for all), limited to the
+ *                  levels of the host.
+ *  @return A CU_ErrorCode indicating the error status.
+ */
+
+CU_EXPORT const CU_IsaResult* CU_isa_get_result(CU_pTest pTest);
+/**<
+ *  Retrieves the results of a test in the last matrix run.
+ *
+ *  @param pTest Test to retrieve the results of.
+ *  @return The results, or NULL if the test was not run.
+ */
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /*  CUNIT_ISAMATRIX_H_SEEN  */
+/** @} */
@@ -0,0 +1,141 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Interface for loading test suites from shared libraries.
+ *
+ *  19-Oct-2026   Initial implementation of suite libraries and watch mode.
+ */
+
+/** @file
+ *  Loading of test suites from shared libraries (user interface).
+ *  A test library is a shared object exporting a NULL-terminated
+ *  CU_SuiteInfo array named by CU_LIBRARY_SUITES_SYMBOL, e.g.
+ *
+ *  <PRE>
+ *    CU_SuiteInfo CU_library_suites[] = {
+ *      { "suite1", NULL, NULL, NULL, NULL, suite1_tests },
+ *      CU_SUITE_INFO_NULL
+ *    };
+ *  </PRE>
+ *
+ *  Test libraries resolve the CUnit functions they call against the
+ *  host executable, which must therefore export its symbols (e.g. be
+ *  linked with <CODE>-rdynamic</CODE>).
+ *
+ *  Loading a library registers its suites with the current registry.
+ *  Unloading it removes those suites again and releases their storage.
+ *  The watch mode keeps the process (and any fixtures it holds) alive,
+ *  reloads libraries whose file has changed and re-runs only their
+ *  suites.  Only available on LINUX builds.
+ */
+/** @addtogroup Framework
+ * @{
+ */
+
+#ifndef CUNIT_LIBRARY_H_SEEN
+#define CUNIT_LIBRARY_H_SEEN
+
+#include "CUnit.h"
+#include "CUError.h"
+#include "TestDB.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CU_LIBRARY_SUITES_SYMBOL "CU_library_suites"
+/**< Name of the CU_SuiteInfo array exported by test libraries. */
+
+#define CU_MAX_LIBRARIES    16
+/**< Maximum number of test libraries loaded at the same time. */
+
+#define CU_MAX_LIBRARY_PATH 256
+/**< Maximum length of a test library path (including the NULL). */
+
+typedef CU_ErrorCode (*CU_LibrarySuiteRunner)(CU_pSuite pSuite);
+/**< Function used by the watch mode to run a reloaded suite. */
+
+CU_EXPORT CU_ErrorCode CU_load_suites_from_library(const char *szPath);
+/**<
+ *  Loads a test library and registers its suites.
+ *  The library is loaded from a private copy of szPath, so the file
+ *  may be rebuilt while loaded.  If szPath is already loaded it is
+ *  unloaded first, i.e. this function also reloads a library.  Suite
+ *  names must be unique within the registry.  On error no suites of
+ *  the library remain registered.  <b>This function must not be called
+ *  during a test run (checked by assertion)</b>.
+ *
+ *  CU_load_suites_from_library() sets the following error codes:
+ *  - CUE_SUCCESS if no errors occurred.
+ *  - CUE_NOREGISTRY if the registry has not been initialized.
+ *  - CUE_BAD_FILENAME if szPath is NULL, empty or too long.
+ *  - CUE_NOMEMORY if CU_MAX_LIBRARIES libraries are already loaded.
+ *  - CUE_DLOPEN_FAILED if the library could not be loaded or does not
+ *    export CU_LIBRARY_SUITES_SYMBOL.
+ *  - any error set by CU_register_suites().
+ *
+ *  @param szPath Path of the shared library (non-NULL).
+ *  @return A CU_ErrorCode indicating the error status.
+ */
+
+CU_EXPORT CU_ErrorCode CU_unload_suites_from_library(const char *szPath);
+/**<
+ *  Removes the suites of a loaded test library and unloads it.
+ *  The results of the previous run are cleared, since they may refer
+ *  to the removed suites.  <b>This function must not be called during
+ *  a test run (checked by assertion)</b>.
+ *
+ *  @param szPath Path the library was loaded from (non-NULL).
+ *  @return CUE_BAD_FILENAME if szPath is not loaded, CUE_SUCCESS otherwise.
+ */
+
+CU_EXPORT void CU_unload_all_libraries(void);
+/**<
+ *  Unloads all test libraries.  Must be called before
+ *  CU_cleanup_registry() if libraries are still loaded.
+ */
+
+CU_EXPORT CU_ErrorCode CU_watch_libraries(unsigned int uiIntervalMs,
+                                          CU_LibrarySuiteRunner pRunner);
+/**<
+ *  Watches the loaded test libraries for changes until
+ *  CU_stop_watching_libraries() is called.  The files are polled every
+ *  uiIntervalMs milliseconds.  A library is reloaded once its file has
+ *  changed and then stayed unchanged for one further interval, so that
+ *  partially written files are not loaded.  After a reload the suites
+ *  of that library are run with pRunner (CU_run_suite() if NULL);
+ *  suites of other libraries and of the host are not run again.
+ *
+ *  @param uiIntervalMs Polling interval in milliseconds (0 uses 500).
+ *  @param pRunner      Function used to run reloaded suites (may be NULL).
+ *  @return CUE_NOREGISTRY if the registry is not initialized,
+ *          CUE_SUCCESS when the watch ended.
+ */
+
+CU_EXPORT void CU_stop_watching_libraries(void);
+/**<
+ *  Ends CU_watch_libraries() after its current poll.  This function is
+ *  async-signal-safe, so it may be called from a signal handler.
+ */
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /*  CUNIT_LIBRARY_H_SEEN  */
+/** @} */
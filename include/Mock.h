@@ -0,0 +1,366 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Interface for call-recording mock functions.
+ *
+ *  19-Oct-2026   Initial implementation of mocks.
+ */
+
+/** @file
+ *  Call-recording mock functions (user interface).
+ *  A mock replaces a function for the test executable and records the
+ *  arguments of each call in a fixed-size ring buffer.  It returns the
+ *  values scripted by the test, or falls back to the real function
+ *  (wrapped mocks) or to a zero value (overriding mocks).  All storage
+ *  is static and typed, so a call does not allocate.
+ *
+ *  There are two ways of replacing a function:
+ *
+ *  - CU_MOCK_WRAPn defines <CODE>__wrap_name()</CODE> for use with the
+ *    linker option <CODE>-Wl,--wrap=name</CODE>.  The real function
+ *    remains reachable as <CODE>__real_name()</CODE>.
+ *  - CU_MOCK_OVERRIDEn defines <CODE>name()</CODE> itself, overriding a
+ *    weak definition or standing in for a function which is not linked
+ *    into the test executable.
+ *
+ *  n is the number of parameters (0 to 6), given as type/name pairs:
+ *
+ *  <PRE>
+ *    CU_MOCK_WRAP2(int, hw_read, unsigned int, addr, int, flags)
+ *
+ *    static void test_probe(void)
+ *    {
+ *      CU_MOCK_RETURN(hw_read, 0x42);
+ *      CU_ASSERT_EQUAL(probe(), 0);
+ *      CU_ASSERT_MOCK_CALLED(hw_read, 1);
+ *      CU_ASSERT_MOCK_ARG_EQUAL(hw_read, 0, addr, 0x1000);
+ *    }
+ *  </PRE>
+ *
+ *  The recorded calls and scripted values are reset before each test
+ *  is run.  A mock registers itself lazily, the first time it is used
+ *  within a test.
+ */
+/** @addtogroup Framework
+ * @{
+ */
+
+#ifndef CUNIT_MOCK_H_SEEN
+#define CUNIT_MOCK_H_SEEN
+
+#include <string.h>
+
+#include "CUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CU_MOCK_MAX_CALLS   32
+/**< Number of most recent calls whose arguments are kept per mock. */
+
+#define CU_MOCK_MAX_RETURNS 16
+/**< Number of return values which can be scripted per mock and test. */
+
+/** State common to all mocks. */
+typedef struct CU_Mock
+{
+  const char*     pName;              /**< Name of the mocked function. */
+  unsigned int    uiCalls;            /**< Number of calls since the last reset. */
+  unsigned int    uiNumberOfReturns;  /**< Number of scripted return values. */
+  unsigned int    uiNextReturn;       /**< Index of the next scripted return value. */
+  CU_BOOL         fRepeatLast;        /**< Keep returning the last scripted value. */
+  CU_BOOL         fRegistered;        /**< Flag for whether the mock is in the active list. */
+  struct CU_Mock* pNext;              /**< Next mock in the active list. */
+} CU_Mock;
+typedef CU_Mock* CU_pMock;  /**< Pointer to a CU_Mock. */
+
+CU_EXPORT void CU_register_mock(CU_pMock pMock, const char *pName);
+/**<
+ *  Adds a mock to the list of mocks reset by CU_reset_mocks().
+ *  Called by the mock definitions on first use; does nothing if the
+ *  mock is already registered.
+ *
+ *  @param pMock Mock to register (non-NULL).
+ *  @param pName Name of the mocked function (non-NULL).
+ */
+
+CU_EXPORT void CU_reset_mocks(void);
+/**<
+ *  Clears the recorded calls and scripted values of all registered
+ *  mocks and empties the list of registered mocks.  The runner calls
+ *  it before and after each test.
+ */
+
+CU_EXPORT unsigned int CU_mock_add_return(CU_pMock pMock, const char *pName);
+/**<
+ *  Reserves the next scripted return value of a mock.
+ *  Registers the mock if needed.  If CU_MOCK_MAX_RETURNS values are
+ *  already scripted, an assertion failure is recorded for the current
+ *  test and CU_MOCK_MAX_RETURNS is returned.
+ *
+ *  @param pMock Mock to script (non-NULL).
+ *  @param pName Name of the mocked function (non-NULL).
+ *  @return Index of the reserved return value.
+ */
+
+/*------------------------------------------------------------------------*/
+/* Parameter list helpers, indexed by arity. */
+#define CU_MOCK_PARAMS_0()                                  void
+#define CU_MOCK_PARAMS_1(t1,a1)                             t1 a1
+#define CU_MOCK_PARAMS_2(t1,a1,t2,a2)                       t1 a1, t2 a2
+#define CU_MOCK_PARAMS_3(t1,a1,t2,a2,t3,a3)                 t1 a1, t2 a2, t3 a3
+#define CU_MOCK_PARAMS_4(t1,a1,t2,a2,t3,a3,t4,a4)           t1 a1, t2 a2, t3 a3, t4 a4
+#define CU_MOCK_PARAMS_5(t1,a1,t2,a2,t3,a3,t4,a4,t5,a5)     t1 a1, t2 a2, t3 a3, t4 a4, t5 a5
+#define CU_MOCK_PARAMS_6(t1,a1,t2,a2,t3,a3,t4,a4,t5,a5,t6,a6) t1 a1, t2 a2, t3 a3, t4 a4, t5 a5, t6 a6
+
+#define CU_MOCK_NAMES_0()
+#define CU_MOCK_NAMES_1(t1,a1)                              a1
+#define CU_MOCK_NAMES_2(t1,a1,t2,a2)                        a1, a2
+#define CU_MOCK_NAMES_3(t1,a1,t2,a2,t3,a3)                  a1, a2, a3
+#define CU_MOCK_NAMES_4(t1,a1,t2,a2,t3,a3,t4,a4)            a1, a2, a3, a4
+#define CU_MOCK_NAMES_5(t1,a1,t2,a2,t3,a3,t4,a4,t5,a5)      a1, a2, a3, a4, a5
+#define CU_MOCK_NAMES_6(t1,a1,t2,a2,t3,a3,t4,a4,t5,a5,t6,a6) a1, a2, a3, a4, a5, a6
+
+#define CU_MOCK_FIELDS_0()                                  char cu_unused;
+#define CU_MOCK_FIELDS_1(t1,a1)                             t1 a1;
+#define CU_MOCK_FIELDS_2(t1,a1,t2,a2)                       t1 a1; t2 a2;
+#define CU_MOCK_FIELDS_3(t1,a1,t2,a2,t3,a3)                 t1 a1; t2 a2; t3 a3;
+#define CU_MOCK_FIELDS_4(t1,a1,t2,a2,t3,a3,t4,a4)           t1 a1; t2 a2; t3 a3; t4 a4;
+#define CU_MOCK_FIELDS_5(t1,a1,t2,a2,t3,a3,t4,a4,t5,a5)     t1 a1; t2 a2; t3 a3; t4 a4; t5 a5;
+#define CU_MOCK_FIELDS_6(t1,a1,t2,a2,t3,a3,t4,a4,t5,a5,t6,a6) t1 a1; t2 a2; t3 a3; t4 a4; t5 a5; t6 a6;
+
+#define CU_MOCK_STORE_0(p)                                  (void)(p);
+#define CU_MOCK_STORE_1(p,t1,a1)                            (p)->a1 = a1;
+#define CU_MOCK_STORE_2(p,t1,a1,t2,a2)                      (p)->a1 = a1; (p)->a2 = a2;
+#define CU_MOCK_STORE_3(p,t1,a1,t2,a2,t3,a3)                (p)->a1 = a1; (p)->a2 = a2; (p)->a3 = a3;
+#define CU_MOCK_STORE_4(p,t1,a1,t2,a2,t3,a3,t4,a4)          (p)->a1 = a1; (p)->a2 = a2; (p)->a3 = a3; (p)->a4 = a4;
+#define CU_MOCK_STORE_5(p,t1,a1,t2,a2,t3,a3,t4,a4,t5,a5)    (p)->a1 = a1; (p)->a2 = a2; (p)->a3 = a3; (p)->a4 = a4; (p)->a5 = a5;
+#define CU_MOCK_STORE_6(p,t1,a1,t2,a2,t3,a3,t4,a4,t5,a5,t6,a6) (p)->a1 = a1; (p)->a2 = a2; (p)->a3 = a3; (p)->a4 = a4; (p)->a5 = a5; (p)->a6 = a6;
+
+#ifdef __cplusplus
+#  define CU_MOCK_LINKAGE extern "C"
+#else
+#  define CU_MOCK_LINKAGE
+#endif
+
+/*------------------------------------------------------------------------*/
+/* Mock definitions (internal). */
+
+/* Storage of a mock: its state, the ring buffer of call arguments and
+ * the scripted return values.  Zero-initialized, named on registration. */
+#define CU_MOCK_STORAGE_(name, fields, returns) \
+  typedef struct name##_cu_mock_args { fields } name##_cu_mock_args; \
+  struct name##_cu_mock { \
+    CU_Mock base; \
+    name##_cu_mock_args calls[CU_MOCK_MAX_CALLS]; \
+    returns \
+  } name##_mock;
+
+/* Records a call, leaving cu_pArgs at its ring buffer entry. */
+#define CU_MOCK_RECORD_(name, store) \
+  name##_cu_mock_args *cu_pArgs; \
+  if (CU_FALSE == name##_mock.base.fRegistered) { \
+    CU_register_mock(&name##_mock.base, #name); \
+  } \
+  cu_pArgs = &name##_mock.calls[name##_mock.base.uiCalls++ % CU_MOCK_MAX_CALLS]; \
+  store
+
+/* Returns the next scripted value, if any. */
+#define CU_MOCK_SCRIPTED_(name) \
+  if (name##_mock.base.uiNextReturn < name##_mock.base.uiNumberOfReturns) { \
+    return name##_mock.returns[name##_mock.base.uiNextReturn++]; \
+  } \
+  if ((CU_FALSE != name##_mock.base.fRepeatLast) && (0 < name##_mock.base.uiNumberOfReturns)) { \
+    return name##_mock.returns[name##_mock.base.uiNumberOfReturns - 1]; \
+  }
+
+#define CU_MOCK_WRAP_(ret, name, params, names, fields, store) \
+  CU_MOCK_STORAGE_(name, fields, ret returns[CU_MOCK_MAX_RETURNS];) \
+  CU_MOCK_LINKAGE ret __real_##name(params); \
+  CU_MOCK_LINKAGE ret __wrap_##name(params); \
+  ret __wrap_##name(params) \
+  { \
+    CU_MOCK_RECORD_(name, store) \
+    CU_MOCK_SCRIPTED_(name) \
+    return __real_##name(names); \
+  }
+
+#define CU_MOCK_OVERRIDE_(ret, name, params, fields, store) \
+  CU_MOCK_STORAGE_(name, fields, ret returns[CU_MOCK_MAX_RETURNS];) \
+  CU_MOCK_LINKAGE ret name(params); \
+  ret name(params) \
+  { \
+    ret cu_zero; \
+    CU_MOCK_RECORD_(name, store) \
+    CU_MOCK_SCRIPTED_(name) \
+    memset(&cu_zero, 0, sizeof(cu_zero)); \
+    return cu_zero; \
+  }
+
+#define CU_MOCK_VOID_WRAP_(name, params, names, fields, store) \
+  CU_MOCK_STORAGE_(name, fields, char cu_unused;) \
+  CU_MOCK_LINKAGE void __real_##name(params); \
+  CU_MOCK_LINKAGE void __wrap_##name(params); \
+  void __wrap_##name(params) \
+  { \
+    CU_MOCK_RECORD_(name, store) \
+    __real_##name(names); \
+  }
+
+#define CU_MOCK_VOID_OVERRIDE_(name, params, fields, store) \
+  CU_MOCK_STORAGE_(name, fields, char cu_unused;) \
+  CU_MOCK_LINKAGE void name(params); \
+  void name(params) \
+  { \
+    CU_MOCK_RECORD_(name, store) \
+  }
+
+/*------------------------------------------------------------------------*/
+/* Mock definitions.  Use at file scope, once per mocked function. */
+
+#define CU_MOCK_WRAP0(ret, name) \
+  CU_MOCK_WRAP_(ret, name, CU_MOCK_PARAMS_0(), CU_MOCK_NAMES_0(), CU_MOCK_FIELDS_0(), CU_MOCK_STORE_0(cu_pArgs))
+/**< Defines __wrap_name() for ret name(void), see -Wl,--wrap. */
+#define CU_MOCK_WRAP1(ret, name, ...) \
+  CU_MOCK_WRAP_(ret, name, CU_MOCK_PARAMS_1(__VA_ARGS__), CU_MOCK_NAMES_1(__VA_ARGS__), CU_MOCK_FIELDS_1(__VA_ARGS__), CU_MOCK_STORE_1(cu_pArgs, __VA_ARGS__))
+/**< Defines __wrap_name() for a function with 1 parameter. */
+#define CU_MOCK_WRAP2(ret, name, ...) \
+  CU_MOCK_WRAP_(ret, name, CU_MOCK_PARAMS_2(__VA_ARGS__), CU_MOCK_NAMES_2(__VA_ARGS__), CU_MOCK_FIELDS_2(__VA_ARGS__), CU_MOCK_STORE_2(cu_pArgs, __VA_ARGS__))
+/**< Defines __wrap_name() for a function with 2 parameters. */
+#define CU_MOCK_WRAP3(ret, name, ...) \
+  CU_MOCK_WRAP_(ret, name, CU_MOCK_PARAMS_3(__VA_ARGS__), CU_MOCK_NAMES_3(__VA_ARGS__), CU_MOCK_FIELDS_3(__VA_ARGS__), CU_MOCK_STORE_3(cu_pArgs, __VA_ARGS__))
+/**< Defines __wrap_name() for a function with 3 parameters. */
+#define CU_MOCK_WRAP4(ret, name, ...) \
+  CU_MOCK_WRAP_(ret, name, CU_MOCK_PARAMS_4(__VA_ARGS__), CU_MOCK_NAMES_4(__VA_ARGS__), CU_MOCK_FIELDS_4(__VA_ARGS__), CU_MOCK_STORE_4(cu_pArgs, __VA_ARGS__))
+/**< Defines __wrap_name() for a function with 4 parameters. */
+#define CU_MOCK_WRAP5(ret, name, ...) \
+  CU_MOCK_WRAP_(ret, name, CU_MOCK_PARAMS_5(__VA_ARGS__), CU_MOCK_NAMES_5(__VA_ARGS__), CU_MOCK_FIELDS_5(__VA_ARGS__), CU_MOCK_STORE_5(cu_pArgs, __VA_ARGS__))
+/**< Defines __wrap_name() for a function with 5 parameters. */
+#define CU_MOCK_WRAP6(ret, name, ...) \
+  CU_MOCK_WRAP_(ret, name, CU_MOCK_PARAMS_6(__VA_ARGS__), CU_MOCK_NAMES_6(__VA_ARGS__), CU_MOCK_FIELDS_6(__VA_ARGS__), CU_MOCK_STORE_6(cu_pArgs, __VA_ARGS__))
+/**< Defines __wrap_name() for a function with 6 parameters. */
+
+#define CU_MOCK_VOID_WRAP0(name) \
+  CU_MOCK_VOID_WRAP_(name, CU_MOCK_PARAMS_0(), CU_MOCK_NAMES_0(), CU_MOCK_FIELDS_0(), CU_MOCK_STORE_0(cu_pArgs))
+/**< Defines __wrap_name() for void name(void). */
+#define CU_MOCK_VOID_WRAP1(name, ...) \
+  CU_MOCK_VOID_WRAP_(name, CU_MOCK_PARAMS_1(__VA_ARGS__), CU_MOCK_NAMES_1(__VA_ARGS__), CU_MOCK_FIELDS_1(__VA_ARGS__), CU_MOCK_STORE_1(cu_pArgs, __VA_ARGS__))
+/**< Defines __wrap_name() for a void function with 1 parameter. */
+#define CU_MOCK_VOID_WRAP2(name, ...) \
+  CU_MOCK_VOID_WRAP_(name, CU_MOCK_PARAMS_2(__VA_ARGS__), CU_MOCK_NAMES_2(__VA_ARGS__), CU_MOCK_FIELDS_2(__VA_ARGS__), CU_MOCK_STORE_2(cu_pArgs, __VA_ARGS__))
+/**< Defines __wrap_name() for a void function with 2 parameters. */
+#define CU_MOCK_VOID_WRAP3(name, ...) \
+  CU_MOCK_VOID_WRAP_(name, CU_MOCK_PARAMS_3(__VA_ARGS__), CU_MOCK_NAMES_3(__VA_ARGS__), CU_MOCK_FIELDS_3(__VA_ARGS__), CU_MOCK_STORE_3(cu_pArgs, __VA_ARGS__))
+/**< Defines __wrap_name() for a void function with 3 parameters. */
+#define CU_MOCK_VOID_WRAP4(name, ...) \
+  CU_MOCK_VOID_WRAP_(name, CU_MOCK_PARAMS_4(__VA_ARGS__), CU_MOCK_NAMES_4(__VA_ARGS__), CU_MOCK_FIELDS_4(__VA_ARGS__), CU_MOCK_STORE_4(cu_pArgs, __VA_ARGS__))
+/**< Defines __wrap_name() for a void function with 4 parameters. */
+#define CU_MOCK_VOID_WRAP5(name, ...) \
+  CU_MOCK_VOID_WRAP_(name, CU_MOCK_PARAMS_5(__VA_ARGS__), CU_MOCK_NAMES_5(__VA_ARGS__), CU_MOCK_FIELDS_5(__VA_ARGS__), CU_MOCK_STORE_5(cu_pArgs, __VA_ARGS__))
+/**< Defines __wrap_name() for a void function with 5 parameters. */
+#define CU_MOCK_VOID_WRAP6(name, ...) \
+  CU_MOCK_VOID_WRAP_(name, CU_MOCK_PARAMS_6(__VA_ARGS__), CU_MOCK_NAMES_6(__VA_ARGS__), CU_MOCK_FIELDS_6(__VA_ARGS__), CU_MOCK_STORE_6(cu_pArgs, __VA_ARGS__))
+/**< Defines __wrap_name() for a void function with 6 parameters. */
+
+#define CU_MOCK_OVERRIDE0(ret, name) \
+  CU_MOCK_OVERRIDE_(ret, name, CU_MOCK_PARAMS_0(), CU_MOCK_FIELDS_0(), CU_MOCK_STORE_0(cu_pArgs))
+/**< Defines name() for ret name(void), returning zero unless scripted. */
+#define CU_MOCK_OVERRIDE1(ret, name, ...) \
+  CU_MOCK_OVERRIDE_(ret, name, CU_MOCK_PARAMS_1(__VA_ARGS__), CU_MOCK_FIELDS_1(__VA_ARGS__), CU_MOCK_STORE_1(cu_pArgs, __VA_ARGS__))
+/**< Defines name() for a function with 1 parameter. */
+#define CU_MOCK_OVERRIDE2(ret, name, ...) \
+  CU_MOCK_OVERRIDE_(ret, name, CU_MOCK_PARAMS_2(__VA_ARGS__), CU_MOCK_FIELDS_2(__VA_ARGS__), CU_MOCK_STORE_2(cu_pArgs, __VA_ARGS__))
+/**< Defines name() for a function with 2 parameters. */
+#define CU_MOCK_OVERRIDE3(ret, name, ...) \
+  CU_MOCK_OVERRIDE_(ret, name, CU_MOCK_PARAMS_3(__VA_ARGS__), CU_MOCK_FIELDS_3(__VA_ARGS__), CU_MOCK_STORE_3(cu_pArgs, __VA_ARGS__))
+/**< Defines name() for a function with 3 parameters. */
+#define CU_MOCK_OVERRIDE4(ret, name, ...) \
+  CU_MOCK_OVERRIDE_(ret, name, CU_MOCK_PARAMS_4(__VA_ARGS__), CU_MOCK_FIELDS_4(__VA_ARGS__), CU_MOCK_STORE_4(cu_pArgs, __VA_ARGS__))
+/**< Defines name() for a function with 4 parameters. */
+#define CU_MOCK_OVERRIDE5(ret, name, ...) \
+  CU_MOCK_OVERRIDE_(ret, name, CU_MOCK_PARAMS_5(__VA_ARGS__), CU_MOCK_FIELDS_5(__VA_ARGS__), CU_MOCK_STORE_5(cu_pArgs, __VA_ARGS__))
+/**< Defines name() for a function with 5 parameters. */
+#define CU_MOCK_OVERRIDE6(ret, name, ...) \
+  CU_MOCK_OVERRIDE_(ret, name, CU_MOCK_PARAMS_6(__VA_ARGS__), CU_MOCK_FIELDS_6(__VA_ARGS__), CU_MOCK_STORE_6(cu_pArgs, __VA_ARGS__))
+/**< Defines name() for a function with 6 parameters. */
+
+#define CU_MOCK_VOID_OVERRIDE0(name) \
+  CU_MOCK_VOID_OVERRIDE_(name, CU_MOCK_PARAMS_0(), CU_MOCK_FIELDS_0(), CU_MOCK_STORE_0(cu_pArgs))
+/**< Defines name() for void name(void). */
+#define CU_MOCK_VOID_OVERRIDE1(name, ...) \
+  CU_MOCK_VOID_OVERRIDE_(name, CU_MOCK_PARAMS_1(__VA_ARGS__), CU_MOCK_FIELDS_1(__VA_ARGS__), CU_MOCK_STORE_1(cu_pArgs, __VA_ARGS__))
+/**< Defines name() for a void function with 1 parameter. */
+#define CU_MOCK_VOID_OVERRIDE2(name, ...) \
+  CU_MOCK_VOID_OVERRIDE_(name, CU_MOCK_PARAMS_2(__VA_ARGS__), CU_MOCK_FIELDS_2(__VA_ARGS__), CU_MOCK_STORE_2(cu_pArgs, __VA_ARGS__))
+/**< Defines name() for a void function with 2 parameters. */
+#define CU_MOCK_VOID_OVERRIDE3(name, ...) \
+  CU_MOCK_VOID_OVERRIDE_(name, CU_MOCK_PARAMS_3(__VA_ARGS__), CU_MOCK_FIELDS_3(__VA_ARGS__), CU_MOCK_STORE_3(cu_pArgs, __VA_ARGS__))
+/**< Defines name() for a void function with 3 parameters. */
+#define CU_MOCK_VOID_OVERRIDE4(name, ...) \
+  CU_MOCK_VOID_OVERRIDE_(name, CU_MOCK_PARAMS_4(__VA_ARGS__), CU_MOCK_FIELDS_4(__VA_ARGS__), CU_MOCK_STORE_4(cu_pArgs, __VA_ARGS__))
+/**< Defines name() for a void function with 4 parameters. */
+#define CU_MOCK_VOID_OVERRIDE5(name, ...) \
+  CU_MOCK_VOID_OVERRIDE_(name, CU_MOCK_PARAMS_5(__VA_ARGS__), CU_MOCK_FIELDS_5(__VA_ARGS__), CU_MOCK_STORE_5(cu_pArgs, __VA_ARGS__))
+/**< Defines name() for a void function with 5 parameters. */
+#define CU_MOCK_VOID_OVERRIDE6(name, ...) \
+  CU_MOCK_VOID_OVERRIDE_(name, CU_MOCK_PARAMS_6(__VA_ARGS__), CU_MOCK_FIELDS_6(__VA_ARGS__), CU_MOCK_STORE_6(cu_pArgs, __VA_ARGS__))
+/**< Defines name() for a void function with 6 parameters. */
+
+/*------------------------------------------------------------------------*/
+/* Scripting and checking, for use inside tests. */
+
+#define CU_MOCK_RETURN(name, value) \
+  { unsigned int cu_uiReturn = CU_mock_add_return(&name##_mock.base, #name); \
+    if (cu_uiReturn < CU_MOCK_MAX_RETURNS) { name##_mock.returns[cu_uiReturn] = (value); } }
+/**< Scripts the value returned by the next unscripted call of a mock. */
+
+#define CU_MOCK_RETURN_ALWAYS(name, value) \
+  { CU_MOCK_RETURN(name, value) name##_mock.base.fRepeatLast = CU_TRUE; }
+/**< Scripts a value returned by all further calls of a mock. */
+
+#define CU_MOCK_CALLS(name) (name##_mock.base.uiCalls)
+/**< Number of calls of a mock in the current test. */
+
+#define CU_MOCK_HAS_CALL(name, call) \
+  (((unsigned int)(call) < name##_mock.base.uiCalls) && \
+   ((name##_mock.base.uiCalls - (unsigned int)(call)) <= CU_MOCK_MAX_CALLS))
+/**< Whether the arguments of call (0-based) are still recorded. */
+
+#define CU_MOCK_ARG(name, call, arg) \
+  (name##_mock.calls[(unsigned int)(call) % CU_MOCK_MAX_CALLS].arg)
+/**< Argument arg of call (0-based); check CU_MOCK_HAS_CALL first. */
+
+#define CU_ASSERT_MOCK_CALLED(name, count) \
+  { CU_assertImplementation((CU_MOCK_CALLS(name) == (unsigned int)(count)), __LINE__, ("CU_ASSERT_MOCK_CALLED(" #name "," #count ")"), __FILE__, "", CU_FALSE); }
+/**< Asserts that a mock was called count times in the current test. */
+
+#define CU_ASSERT_MOCK_NOT_CALLED(name) \
+  { CU_assertImplementation((0 == CU_MOCK_CALLS(name)), __LINE__, ("CU_ASSERT_MOCK_NOT_CALLED(" #name ")"), __FILE__, "", CU_FALSE); }
+/**< Asserts that a mock was not called in the current test. */
+
+#define CU_ASSERT_MOCK_ARG_EQUAL(name, call, arg, expected) \
+  { CU_assertImplementation((CU_MOCK_HAS_CALL(name, call) && (CU_MOCK_ARG(name, call, arg) == (expected))), __LINE__, ("CU_ASSERT_MOCK_ARG_EQUAL(" #name "," #call "," #arg "," #expected ")"), __FILE__, "", CU_FALSE); }
+/**< Asserts that argument arg of call (0-based) of a mock equals expected. */
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /*  CUNIT_MOCK_H_SEEN  */
+/** @} */
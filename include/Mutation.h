@@ -0,0 +1,130 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Interface for runtime mutation testing.
+ *
+ *  19-Oct-2026   Initial implementation of mutation testing.
+ */
+
+/** @file
+ *  Runtime mutation testing (user interface).
+ *  Code under test marks mutation points with CU_MUTATE(), e.g.
+ *
+ *  <PRE>
+ *    if (CU_MUTATE(len < max, len <= max)) ...
+ *    return CU_MUTATE(a + b, a - b);
+ *  </PRE>
+ *
+ *  Unless CU_ENABLE_MUTATION is defined, CU_MUTATE() is just the
+ *  original expression.  With it, each point is a switchable site: it
+ *  evaluates the mutant only while the site is the active mutation.
+ *
+ *  CU_mutation_run() first runs all tests once to record which tests
+ *  reach which sites.  Each pair of a site and a suite covering it is
+ *  then tested in a forked worker with the site switched on, running
+ *  only the covering tests of that suite and stopping at the first
+ *  failure (the mutant is killed).  A worker that crashes or exceeds
+ *  the timeout also kills the mutant.  The mutation score of a suite is
+ *  the fraction of its mutants killed.  Only sites reached by some test
+ *  are known to the engine.  Requires GCC or Clang (statement
+ *  expressions) and is only available on LINUX builds.
+ */
+/** @addtogroup Framework
+ * @{
+ */
+
+#ifndef CUNIT_MUTATION_H_SEEN
+#define CUNIT_MUTATION_H_SEEN
+
+#include "CUnit.h"
+#include "CUError.h"
+#include "TestDB.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CU_MUTATION_MAX_SITES 256
+/**< Maximum number of mutation sites. */
+
+/** A mutation point in the code under test. */
+typedef struct CU_MutationSite
+{
+  const char*   strFile;        /**< File of the site. */
+  unsigned int  uiLine;         /**< Line of the site. */
+  const char*   strOriginal;    /**< Original expression. */
+  const char*   strMutant;      /**< Mutated expression. */
+  unsigned int  uiId;           /**< Site number (1-based), 0 until the site is first reached. */
+} CU_MutationSite;
+typedef CU_MutationSite* CU_pMutationSite;  /**< Pointer to a mutation site. */
+
+CU_EXPORT CU_BOOL CU_mutation_hit(CU_pMutationSite pSite);
+/**<
+ *  Called by CU_MUTATE() each time a site is reached.  Registers the
+ *  site on first use and records coverage for the current test.
+ *
+ *  @param pSite The site reached (non-NULL).
+ *  @return CU_TRUE if the mutant of the site is to be evaluated.
+ */
+
+CU_EXPORT CU_ErrorCode CU_mutation_run(unsigned int uiWorkers, double dTimeout);
+/**<
+ *  Runs the mutation analysis of the registered tests and prints a
+ *  report with the score of each suite and the surviving mutants.
+ *  Tests failing without mutation are not used to kill mutants.
+ *  Result streaming (CU_export_stream_results()) is ended first, since
+ *  forked workers cannot use it.  <b>This function must not be called
+ *  during a test run (checked by assertion)</b>.
+ *
+ *  CU_mutation_run() sets the following error codes:
+ *  - CUE_SUCCESS if no errors occurred (surviving mutants are not an error).
+ *  - CUE_NOREGISTRY if the registry has not been initialized.
+ *  - CUE_NOMEMORY if a worker could not be forked.
+ *
+ *  @param uiWorkers Number of parallel workers (0 for the number of CPUs).
+ *  @param dTimeout  Time limit of a worker in seconds (<= 0 for ten times
+ *                   the duration of the coverage run plus one second).
+ *  @return A CU_ErrorCode indicating the error status.
+ */
+
+CU_EXPORT double CU_mutation_get_score(CU_pSuite pSuite);
+/**<
+ *  Retrieves the mutation score of the last mutation run.
+ *
+ *  @param pSuite Suite to retrieve the score of (NULL for all mutants,
+ *                which count as killed if any suite killed them).
+ *  @return The fraction of killed mutants, or -1 if there were none.
+ */
+
+#if defined(CU_ENABLE_MUTATION) && defined(__GNUC__)
+#define CU_MUTATE(original, mutant) \
+  (__extension__ ({ \
+    static CU_MutationSite cu_mutation_site_ = { __FILE__, __LINE__, #original, #mutant, 0 }; \
+    CU_mutation_hit(&cu_mutation_site_) ? (mutant) : (original); \
+  }))
+#else
+#define CU_MUTATE(original, mutant) (original)
+#endif
+/**< Mutation point evaluating original, or mutant while the site is the active mutation. */
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /*  CUNIT_MUTATION_H_SEEN  */
+/** @} */
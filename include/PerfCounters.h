@@ -0,0 +1,188 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Interface for deterministic performance checks with hardware counters.
+ *
+ *  19-Oct-2026   Initial implementation of counter-based checks.
+ */
+
+/** @file
+ *  Hardware performance counters (user interface).
+ *  The counters are opened as one perf_event group of the calling
+ *  thread, counting user space only: retired instructions, and
+ *  optionally L1 data cache and last level cache read misses.  Unlike
+ *  wall-clock time, the instruction count of a deterministic test body
+ *  hardly depends on the load of the machine, so it can be gated with
+ *  tight thresholds on shared CI runners.
+ *
+ *  A counter run (CU_perf_run()) executes the selected tests through the
+ *  normal runner, counting only the test function.  After a checked
+ *  first call, the function is counted a few more times and the smallest
+ *  count of each event is kept, which removes one-time costs such as
+ *  lazy symbol binding.  The counts are compared against a budget file:
+ *
+ *  - <CODE>CUnit-budget version</CODE> (first line)
+ *  - <CODE>suite test instructions l1d-misses llc-misses</CODE>
+ *    ('-' for events not counted)
+ *
+ *  A test exceeding a budget by more than the tolerance of its event
+ *  gets a CUF_PerfRegression failure record.  CU_perf_write_budgets()
+ *  writes the counts of the last run as the new budgets.
+ *
+ *  While the counters are open, bench runs (see Bench.h) also report
+ *  instructions per iteration.  Counting requires a PMU visible to the
+ *  process and kernel.perf_event_paranoid <= 2; it is only available on
+ *  LINUX builds.
+ */
+/** @addtogroup Framework
+ * @{
+ */
+
+#ifndef CUNIT_PERFCOUNTERS_H_SEEN
+#define CUNIT_PERFCOUNTERS_H_SEEN
+
+#include "CUnit.h"
+#include "CUError.h"
+#include "TestDB.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CU_PERF_BUDGET_VERSION 1
+/**< Version of the budget format written by CU_perf_write_budgets(). */
+
+/** Events counted by the performance counters. */
+typedef enum CU_PerfEvent
+{
+  CU_PERF_INSTRUCTIONS = 0, /**< Retired instructions in user space. */
+  CU_PERF_L1D_MISSES,       /**< L1 data cache read misses. */
+  CU_PERF_LLC_MISSES,       /**< Last level cache read misses. */
+  CU_PERF_NUM_EVENTS        /**< Number of events (not an event). */
+} CU_PerfEvent;
+
+#define CU_PERF_EVENT_MASK(event) (1U << (unsigned int)(event))
+/**< Bit of an event in an event mask. */
+
+/** Parameters of a counter run. */
+typedef struct CU_PerfConfig
+{
+  unsigned int uiEvents;        /**< Mask of events to count (instructions are always counted). */
+  unsigned int uiRepeats;       /**< Counted calls per test after the checked call. */
+  double       dTolerance;      /**< Allowed instruction excess as a fraction of the budget. */
+  double       dMissTolerance;  /**< Allowed cache miss excess as a fraction of the budget. */
+  unsigned long ulMissSlack;    /**< Allowed cache miss excess in misses (small counts). */
+} CU_PerfConfig;
+typedef CU_PerfConfig* CU_pPerfConfig;  /**< Pointer to a counter run configuration. */
+
+CU_EXPORT CU_ErrorCode CU_perf_open(unsigned int uiEvents);
+/**<
+ *  Opens the counters of the calling thread.  Counters already open
+ *  are closed first.
+ *
+ *  CU_perf_open() sets the following error codes:
+ *  - CUE_SUCCESS if the counters were opened.
+ *  - CUE_FOPEN_FAILED if an event is not supported or not permitted.
+ *
+ *  @param uiEvents Mask of events to count (see CU_PERF_EVENT_MASK());
+ *                  instructions are always counted.
+ *  @return A CU_ErrorCode indicating the error status.
+ */
+
+CU_EXPORT void CU_perf_close(void);
+/**< Closes the counters. */
+
+CU_EXPORT CU_BOOL CU_perf_is_open(void);
+/**< Retrieves whether the counters are open. */
+
+CU_EXPORT void CU_perf_start(void);
+/**< Resets the open counters and starts counting. */
+
+CU_EXPORT CU_BOOL CU_perf_stop(unsigned long long aullCounts[CU_PERF_NUM_EVENTS]);
+/**<
+ *  Stops counting and reads the counts since CU_perf_start().  Events
+ *  not opened read as 0.
+ *
+ *  @param aullCounts Receives the count of each event.
+ *  @return CU_TRUE if the counts are exact, CU_FALSE if the counters
+ *          are not open or were multiplexed with other users.
+ */
+
+CU_EXPORT void CU_perf_default_config(CU_pPerfConfig pConfig);
+/**<
+ *  Fills pConfig with the default parameters: instructions only,
+ *  3 counted calls, 0.5% instruction and 10% (at least 64) cache miss
+ *  tolerance.
+ *
+ *  @param pConfig The configuration to initialize (non-NULL).
+ */
+
+CU_EXPORT CU_ErrorCode CU_perf_run(CU_pSuite pSuite, const char *szBudgetFile, const CU_PerfConfig *pConfig);
+/**<
+ *  Runs the active tests of a suite, or of all suites, counting the
+ *  events of each test function, and checks the counts against a
+ *  budget file.  Tests without a budget and failing tests are only
+ *  counted.  Prints the counts of each test.  The counters are opened
+ *  for the run unless they are open already.  <b>This function must
+ *  not be called during a test run (checked by assertion)</b>.
+ *
+ *  CU_perf_run() sets the following error codes:
+ *  - CUE_SUCCESS if no errors occurred (regressions are reported as
+ *    failure records, not as an error).
+ *  - CUE_NOREGISTRY if the registry has not been initialized.
+ *  - CUE_FOPEN_FAILED if the counters or the budget file could not be
+ *    opened.
+ *  - CUE_BAD_BASELINE if the budget file is malformed.
+ *  - any error returned by CU_run_suite() or CU_run_all_tests().
+ *
+ *  @param pSuite       Suite to run (NULL for all suites).
+ *  @param szBudgetFile Budget file to check against (NULL to only count).
+ *  @param pConfig      Parameters of the run (NULL for the defaults).
+ *  @return A CU_ErrorCode indicating the error status.
+ */
+
+CU_EXPORT CU_ErrorCode CU_perf_write_budgets(const char *szFile);
+/**<
+ *  Writes the counts of the passed tests of the last counter run as a
+ *  budget file.
+ *
+ *  CU_perf_write_budgets() sets the following error codes:
+ *  - CUE_SUCCESS if the file was written.
+ *  - CUE_BAD_FILENAME if szFile is NULL or empty.
+ *  - CUE_FOPEN_FAILED if the file could not be opened.
+ *  - CUE_WRITE_ERROR if writing the file failed.
+ *
+ *  @param szFile Name of the budget file.
+ *  @return A CU_ErrorCode indicating the error status.
+ */
+
+CU_EXPORT CU_BOOL CU_perf_get_counts(CU_pTest pTest, unsigned long long aullCounts[CU_PERF_NUM_EVENTS]);
+/**<
+ *  Retrieves the counts of a test in the last counter run.
+ *
+ *  @param pTest      Test to retrieve the counts of.
+ *  @param aullCounts Receives the count of each event.
+ *  @return CU_TRUE if the test was counted, CU_FALSE otherwise.
+ */
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /*  CUNIT_PERFCOUNTERS_H_SEEN  */
+/** @} */
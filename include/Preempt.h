@@ -0,0 +1,151 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Interface for preempting test bodies with emulated interrupts.
+ *
+ *  19-Oct-2026   Initial implementation of preemption injection.
+ */
+
+/** @file
+ *  Preemption injection (user interface).
+ *  A preemption run interrupts the body of every test with a one-shot
+ *  timer signal (SIGRTMIN, delivered to the thread running the tests)
+ *  that calls a user-registered "ISR" and rearms itself with the next
+ *  interval.  Intervals are drawn uniformly between a minimum and a
+ *  maximum from a seeded generator, and are recorded per test, so that
+ *  a failing test can be run again with the same intervals.  A replay
+ *  reproduces the timing of the interrupts, not the exact instructions
+ *  they hit.
+ *
+ *  The ISR runs in a signal handler, so it may only use async-signal-safe
+ *  functions and must not use the CUnit assertions.  It checks its
+ *  conditions with CU_PREEMPT_ASSERT(), which puts failures into a
+ *  lock-free queue.  The queue is drained after each test body and its
+ *  failures are recorded as failed assertions of the test that was
+ *  interrupted, with the condition prefixed by the interrupt number,
+ *  e.g. "ISR #12: ".  System calls interrupted in the test body are
+ *  restarted (SA_RESTART).  Preemption runs are only available on LINUX
+ *  builds.
+ */
+/** @addtogroup Framework
+ * @{
+ */
+
+#ifndef CUNIT_PREEMPT_H_SEEN
+#define CUNIT_PREEMPT_H_SEEN
+
+#include "CUnit.h"
+#include "CUError.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CU_PREEMPT_MAX_INTERRUPTS 32768U
+/**< Maximum number of interrupts recorded in a run; no more are injected after it. */
+
+#define CU_PREEMPT_QUEUE_SIZE 64U
+/**< Number of ISR failures queued until the end of a test body. */
+
+typedef void (*CU_PreemptIsr)(unsigned long ulInterrupt, void *pContext);
+/**< Emulated interrupt service routine, called in a signal handler. */
+
+/** Configuration of a preemption run. */
+typedef struct CU_PreemptConfig
+{
+  CU_PreemptIsr        pIsr;              /**< ISR called on each interrupt. */
+  void*                pContext;          /**< Passed to the ISR. */
+  unsigned long        ulMinIntervalNs;   /**< Shortest interval between interrupts. */
+  unsigned long        ulMaxIntervalNs;   /**< Longest interval between interrupts. */
+  unsigned long long   ullSeed;           /**< Seed of the intervals (0 to seed from the clock). */
+  const unsigned long* pulReplay;         /**< Intervals replayed in every test body instead (NULL for random ones). */
+  unsigned int         uiReplayLength;    /**< Number of intervals in pulReplay. */
+} CU_PreemptConfig;
+typedef CU_PreemptConfig* CU_pPreemptConfig;  /**< Pointer to a preemption run configuration. */
+
+/** Interrupts injected into one test. */
+typedef struct CU_PreemptResult
+{
+  CU_pTest      pTest;            /**< Test interrupted. */
+  unsigned int  uiFirstInterval;  /**< Index of its first interval in the run. */
+  unsigned int  uiIntervals;      /**< Intervals armed in its body (one more than delivered if the body ended first). */
+  unsigned int  uiInterrupts;     /**< Interrupts delivered in its body. */
+  unsigned long ulIsrAsserts;     /**< CU_PREEMPT_ASSERT() checks made by the ISR. */
+  unsigned long ulIsrFailures;    /**< Failed checks, including ones lost to a full queue. */
+} CU_PreemptResult;
+typedef CU_PreemptResult* CU_pPreemptResult;  /**< Pointer to the interrupts of a test. */
+
+CU_EXPORT void CU_preempt_default_config(CU_pPreemptConfig pConfig);
+/**<
+ *  Fills a configuration with no ISR, intervals between 20 and 200
+ *  microseconds, a seed from the clock and no replay.
+ *
+ *  @param pConfig Configuration to fill (non-NULL).
+ */
+
+CU_EXPORT CU_ErrorCode CU_preempt_run(CU_pSuite pSuite, const CU_PreemptConfig *pConfig);
+/**<
+ *  Runs a suite (or all tests if pSuite is NULL) with interrupts
+ *  injected into the test bodies, and prints the seed and the interrupts
+ *  of each test.
+ *
+ *  CU_preempt_run() sets the following error codes:
+ *  - CUE_SUCCESS if the run completed.
+ *  - CUE_NOT_SUPPORTED if the timer could not be created, or on builds
+ *    without timer signals.
+ *  - the error codes of CU_run_suite() and CU_run_all_tests().
+ *
+ *  @param pSuite  Suite to run (NULL for all tests).
+ *  @param pConfig Configuration (non-NULL, with a non-zero maximum interval).
+ *  @return A CU_ErrorCode indicating the error status.
+ */
+
+CU_EXPORT const CU_PreemptResult* CU_preempt_get_result(CU_pTest pTest);
+/**< Retrieves the interrupts of a test in the last preemption run (NULL if it was not run). */
+
+CU_EXPORT const unsigned long* CU_preempt_get_intervals(CU_pTest pTest, unsigned int *puiCount);
+/**<
+ *  Retrieves the intervals of the interrupts armed in a test body in the
+ *  last preemption run, for use as CU_PreemptConfig.pulReplay.  The array
+ *  stays valid until the next run.
+ *
+ *  @param pTest    Test to look up.
+ *  @param puiCount Receives the number of intervals (non-NULL).
+ *  @return The intervals in nanoseconds (NULL if the test was not run).
+ */
+
+CU_EXPORT CU_BOOL CU_preemptAssertImplementation(CU_BOOL bValue, unsigned int uiLine,
+                                                 const char *strCondition, const char *strFile);
+/**<
+ *  Implementation of CU_PREEMPT_ASSERT().  Async-signal-safe; a failure
+ *  is queued with the condition and file name pointers, which must stay
+ *  valid until the end of the test body.
+ *
+ *  @return As a convenience, returns bValue.
+ */
+
+#define CU_PREEMPT_ASSERT(value) \
+  { CU_preemptAssertImplementation((value), __LINE__, #value, __FILE__); }
+/**< Asserts a condition in an ISR; the failure is recorded for the interrupted test. */
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /*  CUNIT_PREEMPT_H_SEEN  */
+/** @} */
@@ -0,0 +1,131 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Interface for soak runs with resource trend detection.
+ *
+ *  19-Oct-2026   Initial implementation of soak mode.
+ */
+
+/** @file
+ *  Soak mode (user interface).
+ *  A soak run executes the active suites of the registry over and over
+ *  for a given duration or number of iterations.  After every suite the
+ *  resident set size, the number of open file descriptors, the number of
+ *  threads and the heap usage of the process are sampled.  The growth a
+ *  suite causes in each iteration is accumulated per suite, and a least
+ *  squares trend line is fitted to it.  Suites whose trend exceeds the
+ *  configured growth per iteration are reported as CUF_ResourceGrowth
+ *  failures.  Allocator caches may shift small amounts of heap between
+ *  neighbouring suites (memory freed by one suite and reused by the
+ *  next), so the process trend is exact while the per-suite trend is
+ *  an attribution.  Only available on LINUX builds.
+ */
+/** @addtogroup Framework
+ * @{
+ */
+
+#ifndef CUNIT_SOAK_H_SEEN
+#define CUNIT_SOAK_H_SEEN
+
+#include "CUnit.h"
+#include "CUError.h"
+#include "TestDB.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Resources sampled during a soak run. */
+typedef enum CU_SoakMetric
+{
+  CU_SOAK_RSS = 0,          /**< Resident set size in bytes. */
+  CU_SOAK_FDS,              /**< Number of open file descriptors. */
+  CU_SOAK_THREADS,          /**< Number of threads. */
+  CU_SOAK_HEAP,             /**< Heap memory in use in bytes. */
+  CU_SOAK_NUM_METRICS       /**< Number of metrics (not a metric). */
+} CU_SoakMetric;
+
+/** Parameters of a soak run. */
+typedef struct CU_SoakConfig
+{
+  double       dDuration;           /**< Run time in seconds, 0 for no limit. */
+  unsigned int uiMaxIterations;     /**< Number of iterations, 0 for no limit. */
+  unsigned int uiWarmupIterations;  /**< Iterations excluded from the trend (caches, lazy init). */
+  double       adMaxGrowth[CU_SOAK_NUM_METRICS];
+                                    /**< Allowed growth per iteration for each metric, <= 0 disables the check. */
+} CU_SoakConfig;
+typedef CU_SoakConfig* CU_pSoakConfig;  /**< Pointer to a soak configuration. */
+
+CU_EXPORT void CU_soak_default_config(CU_pSoakConfig pConfig);
+/**<
+ *  Fills pConfig with the default parameters: 60 seconds, no iteration
+ *  limit, 2 warmup iterations and a growth limit of one page of RSS,
+ *  64 bytes of heap and half a file descriptor or thread per iteration.
+ *
+ *  @param pConfig The configuration to initialize (non-NULL).
+ */
+
+CU_EXPORT CU_ErrorCode CU_soak_run(const CU_SoakConfig *pConfig);
+/**<
+ *  Runs the active suites repeatedly and checks the resource trends.
+ *  The run ends when the duration or the iteration limit is reached,
+ *  when CU_soak_stop() is called, or after the first iteration with
+ *  failures.  In the latter case the results of the failing suite are
+ *  kept.  Otherwise the results are cleared and replaced by one
+ *  CUF_ResourceGrowth failure record per suite and metric exceeding
+ *  its limit, and a trend report is printed.  At least 3 iterations
+ *  after the warmup are needed for a trend.  <b>This function must not
+ *  be called during a test run (checked by assertion)</b>.
+ *
+ *  CU_soak_run() sets the following error codes:
+ *  - CUE_SUCCESS if no errors occurred (resource growth is reported as
+ *    failure records, not as an error).
+ *  - CUE_NOREGISTRY if the registry has not been initialized.
+ *  - CUE_FOPEN_FAILED if the process statistics could not be opened.
+ *  - any error returned by CU_run_suite().
+ *
+ *  @param pConfig Parameters of the run (NULL for the defaults).
+ *  @return A CU_ErrorCode indicating the error status.
+ */
+
+CU_EXPORT void CU_soak_stop(void);
+/**<
+ *  Ends a soak run after the current iteration.  This function is
+ *  async-signal-safe, so it may be called from a signal handler.
+ */
+
+CU_EXPORT unsigned int CU_soak_get_iterations(void);
+/**< Retrieves the number of complete iterations of the last soak run. */
+
+CU_EXPORT double CU_soak_get_growth(CU_pSuite pSuite, CU_SoakMetric metric);
+/**<
+ *  Retrieves the trend of a metric in the last soak run, i.e. the
+ *  fitted growth per iteration.  With a suite, only the growth measured
+ *  across that suite is considered.  Returns 0 if there was no trend.
+ *
+ *  @param pSuite Suite to retrieve the trend for (NULL for the whole process).
+ *  @param metric Metric to retrieve.
+ *  @return The growth per iteration in the unit of the metric.
+ */
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /*  CUNIT_SOAK_H_SEEN  */
+/** @} */
@@ -0,0 +1,214 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Interface for statistical assertions on sample arrays.
+ *
+ *  19-Oct-2026   Initial implementation of distribution assertions.
+ */
+
+/** @file
+ *  Statistical assertions (user interface).
+ *  Assertions on the distribution of large sample arrays, e.g. from
+ *  random number or noise generators: chi-square uniformity,
+ *  Kolmogorov-Smirnov against a reference CDF, bounds on mean and
+ *  variance, and limits on the autocorrelation.  A failed statistical
+ *  assertion stores its test statistic and p-value in the failure
+ *  record (see CU_assertStatisticImplementation()).  The underlying
+ *  statistics are available as CU_stat_xxx() functions.
+ */
+/** @addtogroup Framework
+ * @{
+ */
+
+#ifndef CUNIT_STATISTICS_H_SEEN
+#define CUNIT_STATISTICS_H_SEEN
+
+#include <stddef.h>
+
+#include "CUnit.h"
+#include "TestRun.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CU_STAT_MAX_BINS 1024U
+/**< Maximum number of histogram bins of a chi-square test. */
+
+typedef double (*CU_StatCdf)(double dX);
+/**< Cumulative distribution function of a reference distribution. */
+
+CU_EXPORT double CU_stat_chi_square_uniform(const double *pdSamples,
+                                            size_t nSamples,
+                                            double dLow,
+                                            double dHigh,
+                                            unsigned int uiBins,
+                                            double *pdPValue);
+/**<
+ *  Computes the chi-square statistic of the samples against a uniform
+ *  distribution on [dLow, dHigh), using uiBins equal-width bins.  For
+ *  a meaningful result every bin should expect at least 5 samples.
+ *  Samples outside the range (or NaN) give an infinite statistic.
+ *
+ *  @param pdSamples Samples (non-NULL).
+ *  @param nSamples  Number of samples (> 0).
+ *  @param dLow      Lower bound of the range.
+ *  @param dHigh     Upper bound of the range (> dLow).
+ *  @param uiBins    Number of bins (2 to CU_STAT_MAX_BINS).
+ *  @param pdPValue  Receives the p-value (may be NULL).
+ *  @return The chi-square statistic with uiBins - 1 degrees of freedom.
+ */
+
+CU_EXPORT double CU_stat_ks(double *pdSamples,
+                            size_t nSamples,
+                            CU_StatCdf pCdf,
+                            double *pdPValue);
+/**<
+ *  Computes the Kolmogorov-Smirnov statistic of the samples against a
+ *  reference distribution.  <b>The samples are sorted in place.</b>
+ *
+ *  @param pdSamples Samples (non-NULL), sorted on return.
+ *  @param nSamples  Number of samples (> 0).
+ *  @param pCdf      Reference cumulative distribution function (non-NULL).
+ *  @param pdPValue  Receives the asymptotic p-value (may be NULL).
+ *  @return The largest distance between the empirical and reference CDF.
+ */
+
+CU_EXPORT void CU_stat_moments(const double *pdSamples,
+                               size_t nSamples,
+                               double *pdMean,
+                               double *pdVariance);
+/**<
+ *  Computes the mean and the unbiased sample variance of the samples.
+ *
+ *  @param pdSamples  Samples (non-NULL).
+ *  @param nSamples   Number of samples (> 0, > 1 for the variance).
+ *  @param pdMean     Receives the mean (may be NULL).
+ *  @param pdVariance Receives the variance (may be NULL).
+ */
+
+CU_EXPORT double CU_stat_autocorrelation(const double *pdSamples,
+                                         size_t nSamples,
+                                         unsigned int uiLag);
+/**<
+ *  Computes the sample autocorrelation of the samples at a lag.
+ *  For independent samples it is approximately normal with mean 0
+ *  and variance 1/nSamples.  Returns 0 for constant samples.
+ *
+ *  @param pdSamples Samples (non-NULL).
+ *  @param nSamples  Number of samples (> uiLag).
+ *  @param uiLag     Lag (> 0).
+ *  @return The autocorrelation coefficient in [-1, 1].
+ */
+
+CU_EXPORT double CU_stat_normal_cdf(double dX);
+/**< Cumulative distribution function of the standard normal distribution. */
+
+CU_EXPORT CU_BOOL CU_assertUniformImplementation(const double *pdSamples, size_t nSamples,
+                                                 double dLow, double dHigh,
+                                                 unsigned int uiBins, double dAlpha,
+                                                 unsigned int uiLine, const char *strCondition,
+                                                 const char *strFile, const char *strFunction,
+                                                 CU_BOOL bFatal);
+/**<
+ *  Implementation of CU_ASSERT_UNIFORM().  Passes if the p-value of
+ *  CU_stat_chi_square_uniform() is at least dAlpha.  Fails for invalid
+ *  arguments.
+ */
+
+CU_EXPORT CU_BOOL CU_assertDistributionImplementation(double *pdSamples, size_t nSamples,
+                                                      CU_StatCdf pCdf, double dAlpha,
+                                                      unsigned int uiLine, const char *strCondition,
+                                                      const char *strFile, const char *strFunction,
+                                                      CU_BOOL bFatal);
+/**<
+ *  Implementation of CU_ASSERT_DISTRIBUTION().  Passes if the p-value
+ *  of CU_stat_ks() is at least dAlpha.  Fails for invalid arguments.
+ */
+
+CU_EXPORT CU_BOOL CU_assertMeanImplementation(const double *pdSamples, size_t nSamples,
+                                              double dLow, double dHigh,
+                                              unsigned int uiLine, const char *strCondition,
+                                              const char *strFile, const char *strFunction,
+                                              CU_BOOL bFatal);
+/**< Implementation of CU_ASSERT_MEAN_WITHIN(). */
+
+CU_EXPORT CU_BOOL CU_assertVarianceImplementation(const double *pdSamples, size_t nSamples,
+                                                  double dLow, double dHigh,
+                                                  unsigned int uiLine, const char *strCondition,
+                                                  const char *strFile, const char *strFunction,
+                                                  CU_BOOL bFatal);
+/**< Implementation of CU_ASSERT_VARIANCE_WITHIN(). */
+
+CU_EXPORT CU_BOOL CU_assertAutocorrelationImplementation(const double *pdSamples, size_t nSamples,
+                                                         unsigned int uiMaxLag, double dLimit,
+                                                         unsigned int uiLine, const char *strCondition,
+                                                         const char *strFile, const char *strFunction,
+                                                         CU_BOOL bFatal);
+/**<
+ *  Implementation of CU_ASSERT_AUTOCORRELATION_BELOW().  The statistic
+ *  stored on failure is the autocorrelation at the worst lag, with the
+ *  two-sided p-value of that value under independence.
+ */
+
+#define CU_ASSERT_UNIFORM(samples, count, low, high, bins, alpha) \
+  { CU_assertUniformImplementation((samples), (size_t)(count), (double)(low), (double)(high), (unsigned int)(bins), (double)(alpha), __LINE__, ("CU_ASSERT_UNIFORM(" #samples "," #count "," #low "," #high "," #bins "," #alpha ")"), __FILE__, "", CU_FALSE); }
+/**< Asserts that count samples are uniform on [low, high) by a chi-square test at significance alpha. */
+
+#define CU_ASSERT_UNIFORM_FATAL(samples, count, low, high, bins, alpha) \
+  { CU_assertUniformImplementation((samples), (size_t)(count), (double)(low), (double)(high), (unsigned int)(bins), (double)(alpha), __LINE__, ("CU_ASSERT_UNIFORM_FATAL(" #samples "," #count "," #low "," #high "," #bins "," #alpha ")"), __FILE__, "", CU_TRUE); }
+/**< Fatal version of CU_ASSERT_UNIFORM(). */
+
+#define CU_ASSERT_DISTRIBUTION(samples, count, cdf, alpha) \
+  { CU_assertDistributionImplementation((samples), (size_t)(count), (cdf), (double)(alpha), __LINE__, ("CU_ASSERT_DISTRIBUTION(" #samples "," #count "," #cdf "," #alpha ")"), __FILE__, "", CU_FALSE); }
+/**< Asserts that count samples follow cdf by a Kolmogorov-Smirnov test at significance alpha (sorts the samples). */
+
+#define CU_ASSERT_DISTRIBUTION_FATAL(samples, count, cdf, alpha) \
+  { CU_assertDistributionImplementation((samples), (size_t)(count), (cdf), (double)(alpha), __LINE__, ("CU_ASSERT_DISTRIBUTION_FATAL(" #samples "," #count "," #cdf "," #alpha ")"), __FILE__, "", CU_TRUE); }
+/**< Fatal version of CU_ASSERT_DISTRIBUTION(). */
+
+#define CU_ASSERT_MEAN_WITHIN(samples, count, low, high) \
+  { CU_assertMeanImplementation((samples), (size_t)(count), (double)(low), (double)(high), __LINE__, ("CU_ASSERT_MEAN_WITHIN(" #samples "," #count "," #low "," #high ")"), __FILE__, "", CU_FALSE); }
+/**< Asserts that the mean of count samples is within [low, high]. */
+
+#define CU_ASSERT_MEAN_WITHIN_FATAL(samples, count, low, high) \
+  { CU_assertMeanImplementation((samples), (size_t)(count), (double)(low), (double)(high), __LINE__, ("CU_ASSERT_MEAN_WITHIN_FATAL(" #samples "," #count "," #low "," #high ")"), __FILE__, "", CU_TRUE); }
+/**< Fatal version of CU_ASSERT_MEAN_WITHIN(). */
+
+#define CU_ASSERT_VARIANCE_WITHIN(samples, count, low, high) \
+  { CU_assertVarianceImplementation((samples), (size_t)(count), (double)(low), (double)(high), __LINE__, ("CU_ASSERT_VARIANCE_WITHIN(" #samples "," #count "," #low "," #high ")"), __FILE__, "", CU_FALSE); }
+/**< Asserts that the sample variance of count samples is within [low, high]. */
+
+#define CU_ASSERT_VARIANCE_WITHIN_FATAL(samples, count, low, high) \
+  { CU_assertVarianceImplementation((samples), (size_t)(count), (double)(low), (double)(high), __LINE__, ("CU_ASSERT_VARIANCE_WITHIN_FATAL(" #samples "," #count "," #low "," #high ")"), __FILE__, "", CU_TRUE); }
+/**< Fatal version of CU_ASSERT_VARIANCE_WITHIN(). */
+
+#define CU_ASSERT_AUTOCORRELATION_BELOW(samples, count, max_lag, limit) \
+  { CU_assertAutocorrelationImplementation((samples), (size_t)(count), (unsigned int)(max_lag), (double)(limit), __LINE__, ("CU_ASSERT_AUTOCORRELATION_BELOW(" #samples "," #count "," #max_lag "," #limit ")"), __FILE__, "", CU_FALSE); }
+/**< Asserts that the absolute autocorrelation of count samples is at most limit for lags 1 to max_lag. */
+
+#define CU_ASSERT_AUTOCORRELATION_BELOW_FATAL(samples, count, max_lag, limit) \
+  { CU_assertAutocorrelationImplementation((samples), (size_t)(count), (unsigned int)(max_lag), (double)(limit), __LINE__, ("CU_ASSERT_AUTOCORRELATION_BELOW_FATAL(" #samples "," #count "," #max_lag "," #limit ")"), __FILE__, "", CU_TRUE); }
+/**< Fatal version of CU_ASSERT_AUTOCORRELATION_BELOW(). */
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /*  CUNIT_STATISTICS_H_SEEN  */
+/** @} */
@@ -80,6 +80,15 @@ typedef void (*CU_TestFunc)(void);        /**< Signature for a testing function
 typedef void (*CU_SetUpFunc)(void);       /**< Signature for a test SetUp function. */
 typedef void (*CU_TearDownFunc)(void);    /**< Signature for a test TearDown function. */
 
+/** Outcome of the most recent run of a test. */
+typedef enum CU_TestOutcome
+{
+  CUTO_NotRun = 0,  /**< Test was not reached during the last run. */
+  CUTO_Passed,      /**< Test ran without generating failure records. */
+  CUTO_Failed,      /**< Test ran and generated failure records. */
+  CUTO_Inactive     /**< Test was inactive when its suite was run. */
+} CU_TestOutcome;
+
 /*-----------------------------------------------------------------
  * CU_Test, CU_pTest
  *-----------------------------------------------------------------*/
@@ -89,7 +98,9 @@ typedef void (*CU_TearDownFunc)(void);    /**< Signature for a test TearDown fun
  *  test is active and thus executed during a  test run.  A test
  *  also holds links to the next and previous tests in the list,
  *  as well as a jmp_buf reference for use in implementing fatal
- *  assertions.<br /><br />
+ *  assertions.  The outcome, assertion counts and elapsed time of the
+ *  most recent run are kept with the test for reporting and export.
+ *  <br /><br />
  *
  *  Generally, the linked list includes tests which are associated
  *  with each other in a CU_Suite.  As a result, tests are run in
@@ -110,9 +121,17 @@ typedef struct CU_Test
 {
   char*           pName;      /**< Test name. */
   CU_BOOL         fActive;    /**< Flag for whether test is executed during a run. */
+  CU_BOOL         fCompileTime; /**< Flag for a test verified by the compiler (nothing to run). */
   CU_TestFunc     pTestFunc;  /**< Pointer to the test function. */
   jmp_buf*        pJumpBuf;   /**< Jump buffer for setjmp/longjmp test abort mechanism. */
 
+  CU_TestOutcome  eOutcome;                 /**< Outcome of the last run. */
+  unsigned int    uiNumberOfAsserts;        /**< Number of assertions tested during the last run. */
+  unsigned int    uiNumberOfAssertsFailed;  /**< Number of failed assertions during the last run. */
+  double          dElapsedTime;             /**< Elapsed time for the last run in seconds. */
+  double          dWallTime;                /**< Wall-clock time for the last run in seconds (see CU_get_time_ns()). */
+  long            lHeapGrowth;              /**< Net heap growth in bytes during the last run (see CU_get_heap_in_use()). */
+
   struct CU_Test* pNext;      /**< Pointer to the next test in linked list. */
   struct CU_Test* pPrev;      /**< Pointer to the previous test in linked list. */
 
@@ -385,6 +404,24 @@ CU_pTest CU_add_test(CU_pSuite pSuite, const char* strName, CU_TestFunc pTestFun
  *  @return A pointer to the newly-created test (NULL if creation failed)
  */
 
+CU_EXPORT
+CU_pTest CU_add_compile_time_test(CU_pSuite pSuite, const char* strName);
+/**<
+ *  Adds a test which has already been verified at compile time.
+ *  Such tests have no function to run.  When an active compile-time
+ *  test is reached during a run it is reported as run and passed,
+ *  without calling the suite's setup and teardown functions and
+ *  without counting assertions.  This keeps checks which moved into
+ *  the compiler (e.g. static assertions on constant tables) visible in
+ *  the registry and in reports.  Errors are reported as for
+ *  CU_add_test().
+ *
+ *  @param pSuite  Test suite to which to add new test (non-NULL).
+ *  @param strName Name for the new test case (non-NULL).
+ *  @return A pointer to the newly-created test (NULL if creation failed)
+ *  @see CU_CONSTEXPR_TEST in CUnit.hpp
+ */
+
 CU_EXPORT
 CU_pTest CU_get_test(CU_pSuite pSuite, const char *strName);
 /**<
@@ -409,6 +446,24 @@ CU_pTest CU_get_test(CU_pSuite pSuite, const char *strName);
 #define CU_ADD_TEST(suite, test) (CU_add_test(suite, #test, (CU_TestFunc)test))
 /**< Shortcut macro for adding a test to a suite. */
 
+CU_EXPORT
+CU_ErrorCode CU_remove_suite(CU_pSuite pSuite);
+/**<
+ *  Removes a suite and all of its tests from the test registry.
+ *  The storage held by the suite and its tests is released for
+ *  reuse by later registrations, so any pointers to them held by the
+ *  user are invalidated.  <b>This function must not be called during
+ *  a test run (checked by assertion)</b>.
+ *
+ *  CU_remove_suite() sets the following error codes:
+ *  - CUE_SUCCESS if no errors occurred.
+ *  - CUE_NOREGISTRY if the registry has not been initialized.
+ *  - CUE_NOSUITE if pSuite is NULL or not registered.
+ *
+ *  @param pSuite The suite to remove (non-NULL).
+ *  @return A CU_ErrorCode indicating the error status.
+ */
+
 /*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*/
 /*  This section is based conceptually on code
  *  Copyright (C) 2004  Aurema Pty Ltd.
@@ -466,6 +521,32 @@ typedef CU_SuiteInfo* CU_pSuiteInfo;  /**< Pointer to CU_SuiteInfo type. */
 /**< NULL CU_suite_info_t to terminate arrays of suites. */
 
 
+CU_EXPORT CU_ErrorCode CU_add_tests(CU_pSuite pSuite, CU_TestInfo test_info[]);
+/**<
+ *  Registers the tests in a CU_TestInfo array with a suite in one step.
+ *  The array is terminated by an entry with NULL name and function and
+ *  is validated before any test is registered.  The tests are appended
+ *  in array order after a single walk to the end of the suite's list,
+ *  instead of one walk per test as with repeated CU_add_test() calls.
+ *  If the test pool is exhausted, the tests registered up to that point
+ *  remain in the suite.  A test with a duplicate name is registered, but
+ *  CUE_DUP_TEST is reported.  <b>This function must not be called during
+ *  a test run (checked by assertion)</b>.
+ *
+ *  CU_add_tests() sets the following error codes:
+ *  - CUE_SUCCESS if no errors occurred.
+ *  - CUE_NOREGISTRY if the registry has not been initialized.
+ *  - CUE_NOSUITE if pSuite is NULL.
+ *  - CUE_NO_TESTNAME if an entry has a NULL name but a function.
+ *  - CUE_NOTEST if an entry has a name but a NULL function.
+ *  - CUE_DUP_TEST if a test name was already registered with pSuite.
+ *  - CUE_NOMEMORY if the test pool was exhausted.
+ *
+ *  @param pSuite    Suite to receive the tests (non-NULL).
+ *  @param test_info Terminated array of tests to register (may be NULL).
+ *  @return A CU_ErrorCode indicating the error status.
+ */
+
 CU_EXPORT CU_ErrorCode CU_register_suites(CU_SuiteInfo suite_info[]);
 /**<
  *  Registers the suites in a single CU_SuiteInfo array.
@@ -481,7 +562,9 @@ CU_EXPORT CU_ErrorCode CU_register_nsuites(int suite_count, ...);
  *  The function accepts a variable number of suite arrays to be registered.
  *  The number of arrays is indicated by the value of the 1st argument,
  *  suite_count.  Each suite in each array is registered with the CUnit test
- *  registry, along with all of the associated tests.
+ *  registry, along with all of the associated tests.  Registration stops
+ *  at the first error (a suite with a duplicate name is still registered),
+ *  and that error is returned.
  *
  *  @param	suite_count The number of CU_SuiteInfo* arguments to follow.
  *  @param ...          suite_count number of CU_SuiteInfo* arguments.  NULLs are ignored.
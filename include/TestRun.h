@@ -83,7 +83,9 @@ typedef enum CU_FailureTypes
   CUF_SuiteInitFailed,      /**< Suite initialization function failed. */
   CUF_SuiteCleanupFailed,   /**< Suite cleanup function failed. */
   CUF_TestInactive,         /**< Inactive test was run. */
-  CUF_AssertFailed          /**< CUnit assertion failed during test run. */
+  CUF_AssertFailed,         /**< CUnit assertion failed during test run. */
+  CUF_ResourceGrowth,       /**< Resource usage kept growing during a soak run. */
+  CUF_PerfRegression        /**< Test took longer than its baseline allows. */
 } CU_FailureType;           /**< Failure type. */
 
 /* CU_FailureRecord type definition. */
@@ -96,6 +98,9 @@ typedef struct CU_FailureRecord
   char*           strCondition;   /**< Test condition which failed. */
   CU_pTest        pTest;          /**< Test containing failure. */
   CU_pSuite       pSuite;         /**< Suite containing test having failure. */
+  CU_BOOL         fStatistic;     /**< Whether the failure carries a test statistic. */
+  double          dStatistic;     /**< Test statistic of a statistical assertion. */
+  double          dPValue;        /**< p-value of the statistic, negative if not applicable. */
 
   struct CU_FailureRecord* pNext; /**< Pointer to next record in linked list. */
   struct CU_FailureRecord* pPrev; /**< Pointer to previous record in linked list. */
@@ -169,6 +174,13 @@ typedef void (*CU_SuiteCleanupFailureMessageHandler)(const CU_pSuite pSuite);
  *  The test run is considered in progress when the message handler is called.
  */
 
+typedef void (*CU_TestBodyWrapper)(const CU_pSuite pSuite, const CU_pTest pTest);
+/**< Function running the body of a test in place of the runner.
+ *  It is called between the suite setup and teardown functions and is
+ *  expected to call pTest->pTestFunc (which may be NULL) at least once.
+ *  A fatal assertion in the test function leaves the wrapper by longjmp.
+ */
+
 /*--------------------------------------------------------------------
  * Get/Set functions for Message Handlers
  *--------------------------------------------------------------------*/
@@ -308,6 +320,33 @@ CU_EXPORT CU_BOOL CU_get_fail_on_inactive(void);
  *  @see CU_set_fail_on_inactive()
  */
 
+CU_EXPORT void CU_set_test_body_wrapper(CU_TestBodyWrapper pWrapper);
+/**<
+ *  Sets the function running the body of each test.  By default
+ *  (NULL) the runner calls the test function once.
+ *
+ *  @param pWrapper New test body wrapper (NULL to call the test function).
+ */
+
+CU_EXPORT CU_TestBodyWrapper CU_get_test_body_wrapper(void);
+/**< Retrieves the test body wrapper (NULL if none is set). */
+
+CU_EXPORT void CU_set_assert_count_only(CU_BOOL bCountOnly);
+/**<
+ *  Sets whether failed assertions only update the assertion counts.
+ *  If CU_TRUE, failed non-fatal assertions create no failure records,
+ *  so a test repeating them many times does not exhaust the record
+ *  pool.  Fatal assertions are recorded as usual, since they end the
+ *  test.  Note that a test with only counted failures passes.  The
+ *  runner restores the setting when a fatal assertion ends a test
+ *  body.  The default is CU_FALSE.
+ *
+ *  @param bCountOnly CU_TRUE to only count failed assertions.
+ */
+
+CU_EXPORT CU_BOOL CU_get_assert_count_only(void);
+/**< Retrieves whether failed assertions are only counted. */
+
 /*--------------------------------------------------------------------
  * Functions for getting information about the previous test run.
  *--------------------------------------------------------------------*/
@@ -408,6 +447,56 @@ CU_EXPORT void      CU_clear_previous_results(void);
  *  @see clear_previous_results()
  */
 
+CU_EXPORT void      CU_record_failure(CU_FailureType type,
+                                      unsigned int uiLine,
+                                      const char *strCondition,
+                                      const char *strFile,
+                                      CU_pSuite pSuite,
+                                      CU_pTest pTest);
+/**<
+ *  Adds a failure record to the results of the current or last run.
+ *  This allows checks made by the framework outside of tests (e.g. the
+ *  soak mode) to be reported like assertion failures.  The record is
+ *  counted in the run summary, but not as an assertion.
+ *
+ *  @param type         Type of failure.
+ *  @param uiLine       Line number of the failure (0 if not applicable).
+ *  @param strCondition Description of the failure (non-NULL).
+ *  @param strFile      File name of the failure (non-NULL).
+ *  @param pSuite       Suite the failure is attributed to (may be NULL).
+ *  @param pTest        Test the failure is attributed to (may be NULL).
+ */
+
+#define CU_DUMP_SLOWEST  5
+/**< Number of slowest tests listed in a state dump. */
+#define CU_DUMP_FAILURES 5
+/**< Number of most recent failures listed in a state dump. */
+
+CU_EXPORT CU_ErrorCode CU_enable_state_dump(const char *szFile);
+/**<
+ *  Installs a SIGUSR1 handler writing a snapshot of the run, so that a
+ *  run which seems stuck or slow can be inspected without stopping it
+ *  (<CODE>kill -USR1 pid</CODE>).  The snapshot lists the current suite
+ *  and test with the wall-clock time spent in the test so far, the
+ *  counters of the run summary, the CU_DUMP_SLOWEST slowest tests (by
+ *  wall-clock time) and the CU_DUMP_FAILURES most recent failures.  The
+ *  handler only uses async-signal-safe calls and formats into a static
+ *  buffer.  As with any signal, a sleep of the interrupted test returns
+ *  early.  Calling it again replaces the destination.  Only available
+ *  on LINUX builds.
+ *
+ *  CU_enable_state_dump() sets the following error codes:
+ *  - CUE_SUCCESS if the handler was installed.
+ *  - CUE_FOPEN_FAILED if szFile could not be opened or the handler
+ *    could not be installed.
+ *
+ *  @param szFile File to append snapshots to (NULL for stderr).
+ *  @return A CU_ErrorCode indicating the error status.
+ */
+
+CU_EXPORT void CU_disable_state_dump(void);
+/**< Restores the previous SIGUSR1 handler and closes the dump file. */
+
 CU_EXPORT CU_BOOL CU_assertImplementation(CU_BOOL bValue,
                                           unsigned int uiLine,
                                           const char *strCondition,
@@ -429,6 +518,24 @@ CU_EXPORT CU_BOOL CU_assertImplementation(CU_BOOL bValue,
  *  @return As a convenience, returns the value of the assertion (i.e. bValue).
  */
 
+CU_EXPORT CU_BOOL CU_assertStatisticImplementation(CU_BOOL bValue,
+                                                   unsigned int uiLine,
+                                                   const char *strCondition,
+                                                   const char *strFile,
+                                                   const char *strFunction,
+                                                   CU_BOOL bFatal,
+                                                   double dStatistic,
+                                                   double dPValue);
+/**<
+ *  Assertion implementation function for statistical assertions.
+ *  Same as CU_assertImplementation(), but a failure record created for
+ *  the assertion also holds the test statistic and its p-value.
+ *
+ *  @param dStatistic    Value of the test statistic.
+ *  @param dPValue       p-value of the statistic (negative if not applicable).
+ *  @see CU_assertImplementation()
+ */
+
 #ifdef USE_DEPRECATED_CUNIT_NAMES
 typedef CU_FailureRecord  _TestResult;  /**< @deprecated Use CU_FailureRecord. */
 typedef CU_pFailureRecord PTestResult;  /**< @deprecated Use CU_pFailureRecord. */
@@ -0,0 +1,216 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Interface for assertions searching large text buffers.
+ *
+ *  19-Oct-2026   Initial implementation of text search assertions.
+ */
+
+/** @file
+ *  Text search assertions (user interface).
+ *  The assertions search a text buffer given by pointer and length in
+ *  place; the buffer need not be NUL-terminated and is never copied, so
+ *  logs of hundreds of megabytes can be checked directly.  Patterns are
+ *  NUL-terminated strings.
+ *
+ *  Single patterns are searched by comparing the first and last byte of
+ *  the pattern at 16 positions at once (SSE2 builds) or with memchr(),
+ *  and comparing the whole pattern only at candidates.  Sets of patterns
+ *  are matched in one pass by an Aho-Corasick automaton of at most
+ *  CU_TEXT_MAX_STATES states, built in static tables (about 532 KB by
+ *  default on LINUX builds) for each assertion.
+ *
+ *  Failures report where the text violates the assertion as a 1-based
+ *  line and byte column, e.g. "found at line 1042, column 17: ".
+ */
+/** @addtogroup Framework
+ * @{
+ */
+
+#ifndef CUNIT_TEXTSEARCH_H_SEEN
+#define CUNIT_TEXTSEARCH_H_SEEN
+
+#include <stddef.h>
+
+#include "CUnit.h"
+#include "CUError.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef CU_TEXT_MAX_PATTERNS
+#define CU_TEXT_MAX_PATTERNS 32U
+#endif
+/**< Maximum number of patterns in a set (at most 32, the bits of an unsigned int). */
+
+#ifndef CU_TEXT_MAX_STATES
+#ifdef LINUX
+#define CU_TEXT_MAX_STATES 1024U
+#else
+#define CU_TEXT_MAX_STATES 128U
+#endif
+#endif
+/**<
+ *  Maximum number of automaton states (roughly the total length of a
+ *  pattern set, at most 65536).  The automaton takes 520 bytes of static
+ *  storage per state: about 532 KB on LINUX builds and 66 KB on other
+ *  (small target) builds by default.  Builds may define their own limit
+ *  on the compiler command line.
+ */
+
+CU_EXPORT const char* CU_text_find(const char *pText, size_t nLength, const char *szPattern);
+/**<
+ *  Finds the first occurrence of a pattern in a text.
+ *
+ *  @param pText     Text to search (non-NULL unless nLength is 0).
+ *  @param nLength   Bytes in pText.
+ *  @param szPattern Pattern (non-NULL; an empty pattern is found at pText).
+ *  @return The start of the occurrence, NULL if there is none.
+ */
+
+CU_EXPORT CU_ErrorCode CU_text_find_any(const char *pText, size_t nLength,
+                                        const char * const *aszPatterns, unsigned int uiPatterns,
+                                        const char **ppFound, unsigned int *puiPattern);
+/**<
+ *  Finds the first occurrence of any of a set of patterns in one pass.
+ *  The first occurrence is the one ending first; of patterns ending at
+ *  the same byte, the one listed first is reported.
+ *
+ *  CU_text_find_any() sets the following error codes:
+ *  - CUE_SUCCESS if the text was searched.
+ *  - CUE_NOMEMORY if the set has more than CU_TEXT_MAX_PATTERNS patterns
+ *    or needs more than CU_TEXT_MAX_STATES states.
+ *
+ *  @param pText       Text to search.
+ *  @param nLength     Bytes in pText.
+ *  @param aszPatterns Patterns (non-NULL).
+ *  @param uiPatterns  Number of patterns.
+ *  @param ppFound     Receives the start of the occurrence, NULL if there is none (non-NULL).
+ *  @param puiPattern  Receives the index of the pattern found (may be NULL).
+ *  @return A CU_ErrorCode indicating the error status.
+ */
+
+CU_EXPORT size_t CU_text_count_lines(const char *pText, size_t nLength);
+/**<
+ *  Counts the lines of a text: its newlines, plus one if the last line
+ *  is not terminated by a newline.
+ */
+
+CU_EXPORT void CU_text_position(const char *pText, const char *pAt, size_t *pnLine, size_t *pnColumn);
+/**<
+ *  Computes the 1-based line and byte column of a position in a text.
+ *
+ *  @param pText    Start of the text.
+ *  @param pAt      Position within the text (or its end).
+ *  @param pnLine   Receives the line (non-NULL).
+ *  @param pnColumn Receives the column (non-NULL).
+ */
+
+CU_EXPORT CU_BOOL CU_assertContainsImplementation(const char *pText, size_t nLength,
+                                                  const char *szPattern, CU_BOOL bExpected,
+                                                  unsigned int uiLine, const char *strCondition,
+                                                  const char *strFile, const char *strFunction,
+                                                  CU_BOOL bFatal);
+/**<
+ *  Implementation of CU_ASSERT_CONTAINS() (bExpected CU_TRUE) and
+ *  CU_ASSERT_NOT_CONTAINS() (bExpected CU_FALSE).
+ */
+
+CU_EXPORT CU_BOOL CU_assertPatternsImplementation(const char *pText, size_t nLength,
+                                                  const char * const *aszPatterns, unsigned int uiPatterns,
+                                                  CU_BOOL bExpected,
+                                                  unsigned int uiLine, const char *strCondition,
+                                                  const char *strFile, const char *strFunction,
+                                                  CU_BOOL bFatal);
+/**<
+ *  Implementation of CU_ASSERT_CONTAINS_ALL() (bExpected CU_TRUE) and
+ *  CU_ASSERT_NOT_CONTAINS_ANY() (bExpected CU_FALSE).  Fails without
+ *  searching if the pattern set is too large for the automaton.
+ */
+
+CU_EXPORT CU_BOOL CU_assertSequenceImplementation(const char *pText, size_t nLength,
+                                                  const char * const *aszPatterns, unsigned int uiPatterns,
+                                                  unsigned int uiLine, const char *strCondition,
+                                                  const char *strFile, const char *strFunction,
+                                                  CU_BOOL bFatal);
+/**<
+ *  Implementation of CU_ASSERT_SEQUENCE().  Each pattern is searched
+ *  after the end of the occurrence of the previous one.
+ */
+
+CU_EXPORT CU_BOOL CU_assertLineCountImplementation(const char *pText, size_t nLength, size_t nExpected,
+                                                   unsigned int uiLine, const char *strCondition,
+                                                   const char *strFile, const char *strFunction,
+                                                   CU_BOOL bFatal);
+/**< Implementation of CU_ASSERT_LINE_COUNT(). */
+
+#define CU_ASSERT_CONTAINS(text, length, pattern) \
+  { CU_assertContainsImplementation((text), (length), (pattern), CU_TRUE, __LINE__, ("CU_ASSERT_CONTAINS(" #text "," #length "," #pattern ")"), __FILE__, "", CU_FALSE); }
+/**< Asserts that a text contains a pattern. */
+
+#define CU_ASSERT_CONTAINS_FATAL(text, length, pattern) \
+  { CU_assertContainsImplementation((text), (length), (pattern), CU_TRUE, __LINE__, ("CU_ASSERT_CONTAINS_FATAL(" #text "," #length "," #pattern ")"), __FILE__, "", CU_TRUE); }
+/**< Fatal version of CU_ASSERT_CONTAINS(). */
+
+#define CU_ASSERT_NOT_CONTAINS(text, length, pattern) \
+  { CU_assertContainsImplementation((text), (length), (pattern), CU_FALSE, __LINE__, ("CU_ASSERT_NOT_CONTAINS(" #text "," #length "," #pattern ")"), __FILE__, "", CU_FALSE); }
+/**< Asserts that a text does not contain a pattern; the failure gives the position of the first occurrence. */
+
+#define CU_ASSERT_NOT_CONTAINS_FATAL(text, length, pattern) \
+  { CU_assertContainsImplementation((text), (length), (pattern), CU_FALSE, __LINE__, ("CU_ASSERT_NOT_CONTAINS_FATAL(" #text "," #length "," #pattern ")"), __FILE__, "", CU_TRUE); }
+/**< Fatal version of CU_ASSERT_NOT_CONTAINS(). */
+
+#define CU_ASSERT_CONTAINS_ALL(text, length, patterns, count) \
+  { CU_assertPatternsImplementation((text), (length), (patterns), (count), CU_TRUE, __LINE__, ("CU_ASSERT_CONTAINS_ALL(" #text "," #length "," #patterns "," #count ")"), __FILE__, "", CU_FALSE); }
+/**< Asserts that a text contains every pattern of a set; the failure names the first missing one. */
+
+#define CU_ASSERT_CONTAINS_ALL_FATAL(text, length, patterns, count) \
+  { CU_assertPatternsImplementation((text), (length), (patterns), (count), CU_TRUE, __LINE__, ("CU_ASSERT_CONTAINS_ALL_FATAL(" #text "," #length "," #patterns "," #count ")"), __FILE__, "", CU_TRUE); }
+/**< Fatal version of CU_ASSERT_CONTAINS_ALL(). */
+
+#define CU_ASSERT_NOT_CONTAINS_ANY(text, length, patterns, count) \
+  { CU_assertPatternsImplementation((text), (length), (patterns), (count), CU_FALSE, __LINE__, ("CU_ASSERT_NOT_CONTAINS_ANY(" #text "," #length "," #patterns "," #count ")"), __FILE__, "", CU_FALSE); }
+/**< Asserts that a text contains no pattern of a set; the failure gives the first occurrence. */
+
+#define CU_ASSERT_NOT_CONTAINS_ANY_FATAL(text, length, patterns, count) \
+  { CU_assertPatternsImplementation((text), (length), (patterns), (count), CU_FALSE, __LINE__, ("CU_ASSERT_NOT_CONTAINS_ANY_FATAL(" #text "," #length "," #patterns "," #count ")"), __FILE__, "", CU_TRUE); }
+/**< Fatal version of CU_ASSERT_NOT_CONTAINS_ANY(). */
+
+#define CU_ASSERT_SEQUENCE(text, length, patterns, count) \
+  { CU_assertSequenceImplementation((text), (length), (patterns), (count), __LINE__, ("CU_ASSERT_SEQUENCE(" #text "," #length "," #patterns "," #count ")"), __FILE__, "", CU_FALSE); }
+/**< Asserts that the patterns of a set occur in a text in the given order. */
+
+#define CU_ASSERT_SEQUENCE_FATAL(text, length, patterns, count) \
+  { CU_assertSequenceImplementation((text), (length), (patterns), (count), __LINE__, ("CU_ASSERT_SEQUENCE_FATAL(" #text "," #length "," #patterns "," #count ")"), __FILE__, "", CU_TRUE); }
+/**< Fatal version of CU_ASSERT_SEQUENCE(). */
+
+#define CU_ASSERT_LINE_COUNT(text, length, expected) \
+  { CU_assertLineCountImplementation((text), (length), (expected), __LINE__, ("CU_ASSERT_LINE_COUNT(" #text "," #length "," #expected ")"), __FILE__, "", CU_FALSE); }
+/**< Asserts that a text has the expected number of lines. */
+
+#define CU_ASSERT_LINE_COUNT_FATAL(text, length, expected) \
+  { CU_assertLineCountImplementation((text), (length), (expected), __LINE__, ("CU_ASSERT_LINE_COUNT_FATAL(" #text "," #length "," #expected ")"), __FILE__, "", CU_TRUE); }
+/**< Fatal version of CU_ASSERT_LINE_COUNT(). */
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /*  CUNIT_TEXTSEARCH_H_SEEN  */
+/** @} */
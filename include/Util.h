@@ -78,6 +78,63 @@ CU_EXPORT size_t CU_number_width(int number);
  *  number in decimal.
  */
 
+CU_EXPORT size_t CU_get_heap_in_use(void);
+/**<
+ *  Retrieves the number of heap bytes currently allocated by the
+ *  process, as reported by the C library.  Returns 0 where the C
+ *  library does not report it (only glibc does).
+ */
+
+CU_EXPORT unsigned long long CU_get_time_ns(void);
+/**<
+ *  Retrieves a monotonic wall-clock time in nanoseconds, for measuring
+ *  short intervals.  Without a monotonic clock it is derived from the
+ *  tick counter of CU_get_time(), so its resolution is one tick
+ *  (1/CLOCKS_PER_SEC, as the runner's times assume).
+ */
+
+/** Suite and test name leading each entry of a per-test file (baseline, budget). */
+typedef struct CU_TestNames
+{
+  char szSuiteName[MAX_NAME_LEN];   /**< Suite name. */
+  char szTestName[MAX_NAME_LEN];    /**< Test name. */
+} CU_TestNames;
+
+CU_EXPORT int CU_compare_doubles(const void *pA, const void *pB);
+/**< qsort() comparison of doubles in ascending order. */
+
+CU_EXPORT double CU_median_of_sorted(const double adValues[], unsigned int uiCount);
+/**< Returns the median of sorted values (uiCount must be non-zero). */
+
+CU_EXPORT void CU_copy_name(char szDest[MAX_NAME_LEN], const char *szSrc);
+/**<
+ *  Copies a name into a MAX_NAME_LEN buffer, truncating it if needed.
+ *  The copy is always NUL-terminated.
+ */
+
+CU_EXPORT unsigned int CU_split_tab_line(char *szLine, char *aszFields[], unsigned int uiMaxFields);
+/**<
+ *  Splits a line read with fgets() into tab-separated fields in place,
+ *  removing the line end.
+ *
+ *  @param szLine      Line including its newline (non-NULL).
+ *  @param aszFields   Receives the fields (at least uiMaxFields entries).
+ *  @param uiMaxFields Maximum number of fields.
+ *  @return The number of fields, 0 if the line has no newline (too long
+ *          or truncated file) or more than uiMaxFields fields.
+ */
+
+CU_EXPORT const void* CU_find_test_entry(const void *pEntries, size_t nEntrySize, unsigned int uiEntries,
+                                         unsigned int *puiNext, const char *szSuiteName, const char *szTestName);
+/**<
+ *  Looks up the entry of a test in an array of entries starting with a
+ *  CU_TestNames.  Tests run in registration order, like the entries of
+ *  the files they are read from, so the entry after the last match
+ *  (*puiNext) is tried first.
+ *
+ *  @return The entry, NULL if the test has none.
+ */
+
 #ifdef LINUX
 	#define CU_get_time()   clock()
 #else
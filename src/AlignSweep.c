@@ -0,0 +1,416 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Implementation of sweeping buffer alignments and tail lengths.
+ *
+ *  19-Oct-2026   Initial implementation of alignment sweeps.
+ */
+
+/** @file
+ *  Alignment sweeps (implementation).
+ *  While the kernel test runs, a SIGSEGV/SIGBUS handler turns accesses
+ *  to a guard page into a jump back to the sweep.  Other faults are
+ *  passed on by restoring the previous action and returning, so that
+ *  the faulting instruction faults again.  Kernel tests must not use
+ *  fatal assertions, which would leave the sweep without restoring the
+ *  handlers.
+ */
+/** @addtogroup Framework
+ @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#ifdef LINUX
+#include <setjmp.h>
+#include <signal.h>
+#endif
+
+#include "CUnit.h"
+#include "TestDB.h"
+#include "TestRun.h"
+#include "Util.h"
+#include "GuardArena.h"
+#include "AlignSweep.h"
+#include "VLA_Lite_Log.h"
+#include "CUnit_intl.h"
+
+/*=================================================================
+ *  Global/Static Definitions
+ *=================================================================*/
+#ifdef LINUX
+
+/** File name used in the failure records of sweeps. */
+#define SWEEP_FAILURE_FILE "alignsweep"
+
+/** Arena slots of the input and output buffers. */
+#define SWEEP_INPUT_SLOT  0U
+#define SWEEP_OUTPUT_SLOT 1U
+
+static sigjmp_buf          f_faultJump;            /**< Return point of guard page faults. */
+static volatile sig_atomic_t f_bArmed = 0;         /**< Whether a kernel test is running. */
+static CU_pTest            f_pArmedTest = NULL;    /**< Test running the sweep. */
+static void* volatile      f_pFaultAddress = NULL; /**< Address of the last guard page fault. */
+static struct sigaction    f_prevSegv;             /**< SIGSEGV action before the sweep. */
+static struct sigaction    f_prevBus;              /**< SIGBUS action before the sweep. */
+
+static CU_AlignSweepResult f_assertResult;         /**< Outcome of the sweep of an assertion. */
+
+/*=================================================================
+ *  Private function forward declarations
+ *=================================================================*/
+static void    fault_handler(int iSignal, siginfo_t *pInfo, void *pContext);
+static void    sweep_cell(const CU_AlignSweepSpec *pSpec, CU_AlignBuffers *pBuffers,
+                          CU_pAlignSweepResult pResult, unsigned int uiTail);
+static void*   call_guarded(const CU_AlignSweepSpec *pSpec, const CU_AlignBuffers *pBuffers,
+                            unsigned int uiCalls, double *pdBestNs);
+static void    fill_buffers(const CU_AlignSweepSpec *pSpec, const CU_AlignBuffers *pBuffers);
+static void    label_failures(CU_pFailureRecord pFirst, const CU_AlignBuffers *pBuffers);
+static void    report_matrix(const CU_AlignSweepSpec *pSpec, const CU_AlignSweepResult *pResult,
+                             unsigned int uiTails);
+
+/*=================================================================
+ *  Public Interface functions
+ *=================================================================*/
+CU_ErrorCode CU_align_sweep(const CU_AlignSweepSpec *pSpec, CU_pAlignSweepResult pResult)
+{
+  CU_AlignBuffers buffers;
+  struct sigaction action;
+  CU_ErrorCode result;
+  size_t nStep;
+  size_t nOutputLength;
+  size_t nMaxTail;
+  unsigned int uiTails;
+  unsigned int uiOffset;
+  unsigned int uiTail;
+
+  assert(NULL != pSpec);
+  assert(NULL != pResult);
+  assert(NULL != pSpec->pTest);
+
+  memset(pResult, 0, sizeof(*pResult));
+  if ((CU_FALSE == CU_is_test_running()) || (NULL == CU_get_current_test())) {
+    CU_set_error(CUE_NOTEST);
+    return CUE_NOTEST;
+  }
+
+  uiTails = (0 != pSpec->uiTails) ? pSpec->uiTails : 1;
+  if (uiTails > CU_ALIGN_SWEEP_MAX_TAILS) {
+    uiTails = CU_ALIGN_SWEEP_MAX_TAILS;
+  }
+  nStep = (0 != pSpec->nTailStep) ? pSpec->nTailStep : 1;
+  nOutputLength = (0 != pSpec->nOutputLength) ? pSpec->nOutputLength : pSpec->nInputLength;
+  nMaxTail = (uiTails - 1) * nStep;
+
+  /* room for every offset and the canaries below the buffer */
+  result = CU_guard_arena_open(((pSpec->nInputLength > nOutputLength) ? pSpec->nInputLength : nOutputLength)
+                               + nMaxTail + 2 * CU_GUARD_ALIGN, 2);
+  if (CUE_SUCCESS != result) {
+    CU_set_error(result);
+    return result;
+  }
+
+  memset(&action, 0, sizeof(action));
+  action.sa_sigaction = fault_handler;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = SA_SIGINFO;
+  sigaction(SIGSEGV, &action, &f_prevSegv);
+  sigaction(SIGBUS, &action, &f_prevBus);
+  f_pArmedTest = CU_get_current_test();
+
+  for (uiOffset = 0 ; uiOffset < CU_ALIGN_SWEEP_OFFSETS ; uiOffset++) {
+    for (uiTail = 0 ; uiTail < uiTails ; uiTail++) {
+      buffers.uiOffset = uiOffset;
+      buffers.nTail = uiTail * nStep;
+      buffers.nInputLength = pSpec->nInputLength + buffers.nTail;
+      buffers.nOutputLength = nOutputLength + buffers.nTail;
+      sweep_cell(pSpec, &buffers, pResult, uiTail);
+    }
+  }
+
+  f_pArmedTest = NULL;
+  sigaction(SIGSEGV, &f_prevSegv, NULL);
+  sigaction(SIGBUS, &f_prevBus, NULL);
+
+  pResult->uiCells = CU_ALIGN_SWEEP_OFFSETS * uiTails;
+  report_matrix(pSpec, pResult, uiTails);
+
+  CU_set_error(CUE_SUCCESS);
+  return CUE_SUCCESS;
+}
+
+/*------------------------------------------------------------------------*/
+CU_BOOL CU_assertAlignSweepImplementation(const CU_AlignSweepSpec *pSpec,
+                                          unsigned int uiLine, const char *strCondition,
+                                          const char *strFile, const char *strFunction,
+                                          CU_BOOL bFatal)
+{
+  char szCondition[MAX_NAME_LEN];
+  CU_ErrorCode error;
+
+  error = CU_align_sweep(pSpec, &f_assertResult);
+  if (0 != f_assertResult.uiFailedCells) {
+    snprintf(szCondition, sizeof(szCondition), "%u of %u cells failed, first at offset %u, tail %lu: %s",
+             f_assertResult.uiFailedCells, f_assertResult.uiCells, f_assertResult.uiFirstOffset,
+             (unsigned long)f_assertResult.nFirstTail, strCondition);
+    return CU_assertImplementation(CU_FALSE, uiLine, szCondition, strFile, strFunction, bFatal);
+  }
+  return CU_assertImplementation((CUE_SUCCESS == error) ? CU_TRUE : CU_FALSE,
+                                 uiLine, strCondition, strFile, strFunction, bFatal);
+}
+
+/*=================================================================
+ *  Static module functions
+ *=================================================================*/
+/** Returns to the sweep on guard page faults of the kernel test. */
+static void fault_handler(int iSignal, siginfo_t *pInfo, void *pContext)
+{
+  CU_UNREFERENCED_PARAMETER(pContext);
+
+  if ((0 != f_bArmed) && (f_pArmedTest == CU_get_current_test()) &&
+      (CU_FALSE != CU_guard_arena_is_guard(pInfo->si_addr))) {
+    f_bArmed = 0;
+    f_pFaultAddress = pInfo->si_addr;
+    siglongjmp(f_faultJump, 1);
+  }
+
+  /* not ours - the instruction faults again under the previous action */
+  sigaction(iSignal, (SIGSEGV == iSignal) ? &f_prevSegv : &f_prevBus, NULL);
+}
+
+/*------------------------------------------------------------------------*/
+/** Runs the checked and timed calls of one offset and tail length. */
+static void sweep_cell(const CU_AlignSweepSpec *pSpec, CU_AlignBuffers *pBuffers,
+                       CU_pAlignSweepResult pResult, unsigned int uiTail)
+{
+  CU_pSuite pSuite = CU_get_current_suite();
+  CU_pTest pTest = CU_get_current_test();
+  CU_pFailureRecord pLast;
+  CU_pFailureRecord pFirst;
+  char szCondition[MAX_NAME_LEN];
+  const char *szBuffer;
+  unsigned char *pFault;
+  unsigned char *pEnd;
+  unsigned int uiFailedBefore;
+  size_t nUnderrun;
+  size_t nOverrun;
+  unsigned int uiSlot;
+
+  pBuffers->pInput = CU_guard_arena_place(SWEEP_INPUT_SLOT, pBuffers->nInputLength, pBuffers->uiOffset);
+  pBuffers->pOutput = CU_guard_arena_place(SWEEP_OUTPUT_SLOT, pBuffers->nOutputLength, pBuffers->uiOffset);
+
+  for (pLast = CU_get_failure_list() ; (NULL != pLast) && (NULL != pLast->pNext) ; pLast = pLast->pNext) {
+  }
+
+  fill_buffers(pSpec, pBuffers);
+  pFault = (unsigned char*)call_guarded(pSpec, pBuffers, 1, NULL);
+  if (NULL != pFault) {
+    /* the output slot lies above the guard page of the input slot */
+    pEnd = (unsigned char*)pBuffers->pOutput + pBuffers->nOutputLength;
+    szBuffer = "output";
+    if (pFault < pEnd) {
+      pEnd = (unsigned char*)pBuffers->pInput + pBuffers->nInputLength;
+      szBuffer = "input";
+    }
+    snprintf(szCondition, sizeof(szCondition), "guard page hit %lu bytes past the end of the %s",
+             (unsigned long)(pFault - pEnd), szBuffer);
+    CU_record_failure(CUF_AssertFailed, 0, szCondition, SWEEP_FAILURE_FILE, pSuite, pTest);
+  }
+
+  for (uiSlot = SWEEP_INPUT_SLOT ; uiSlot <= SWEEP_OUTPUT_SLOT ; uiSlot++) {
+    if (CU_FALSE == CU_guard_arena_check(uiSlot, &nUnderrun, &nOverrun)) {
+      szBuffer = (SWEEP_INPUT_SLOT == uiSlot) ? "input" : "output";
+      if (0 != nOverrun) {
+        snprintf(szCondition, sizeof(szCondition), "%s written up to %lu bytes past its end",
+                 szBuffer, (unsigned long)nOverrun);
+      }
+      else {
+        snprintf(szCondition, sizeof(szCondition), "%s written up to %lu bytes before its start",
+                 szBuffer, (unsigned long)nUnderrun);
+      }
+      CU_record_failure(CUF_AssertFailed, 0, szCondition, SWEEP_FAILURE_FILE, pSuite, pTest);
+    }
+  }
+
+  pFirst = (NULL != pLast) ? pLast->pNext : CU_get_failure_list();
+  if ((NULL == pFirst) && (0 != pSpec->uiTimedCalls)) {
+    uiFailedBefore = pTest->uiNumberOfAssertsFailed;
+    CU_set_assert_count_only(CU_TRUE);
+    pFault = (unsigned char*)call_guarded(pSpec, pBuffers, pSpec->uiTimedCalls,
+                                          &pResult->adNs[pBuffers->uiOffset][uiTail]);
+    CU_set_assert_count_only(CU_FALSE);
+    if ((NULL != pFault) || (pTest->uiNumberOfAssertsFailed != uiFailedBefore)) {
+      CU_record_failure(CUF_AssertFailed, 0, "failed in timed calls", SWEEP_FAILURE_FILE, pSuite, pTest);
+      pFirst = (NULL != pLast) ? pLast->pNext : CU_get_failure_list();
+    }
+  }
+
+  if (NULL != pFirst) {
+    label_failures(pFirst, pBuffers);
+    pResult->abFailed[pBuffers->uiOffset][uiTail] = CU_TRUE;
+    if (0 == pResult->uiFailedCells++) {
+      pResult->uiFirstOffset = pBuffers->uiOffset;
+      pResult->nFirstTail = pBuffers->nTail;
+    }
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Calls the kernel test with the fault handler armed, refilling the
+ *  buffers before every call after the first.  Keeps the fastest call
+ *  in *pdBestNs if given.  Returns the guard page address hit, or NULL.
+ */
+static void* call_guarded(const CU_AlignSweepSpec *pSpec, const CU_AlignBuffers *pBuffers,
+                          unsigned int uiCalls, double *pdBestNs)
+{
+  volatile unsigned int uiCall = 0;
+  volatile double dBest = 0.0;
+  unsigned long long ullStart;
+  double dTime;
+
+  if (0 != sigsetjmp(f_faultJump, 1)) {
+    return f_pFaultAddress;
+  }
+
+  for ( ; uiCall < uiCalls ; uiCall++) {
+    if (0 != uiCall) {
+      fill_buffers(pSpec, pBuffers);
+    }
+    f_bArmed = 1;
+    ullStart = CU_get_time_ns();
+    (*pSpec->pTest)(pBuffers);
+    dTime = (double)(CU_get_time_ns() - ullStart);
+    f_bArmed = 0;
+    if ((0.0 == dBest) || (dTime < dBest)) {
+      dBest = dTime;
+    }
+  }
+
+  if (NULL != pdBestNs) {
+    *pdBestNs = dBest;
+  }
+  return NULL;
+}
+
+/*------------------------------------------------------------------------*/
+/** Fills the input and clears the output to the canary value of its slot. */
+static void fill_buffers(const CU_AlignSweepSpec *pSpec, const CU_AlignBuffers *pBuffers)
+{
+  unsigned char *pInput = (unsigned char*)pBuffers->pInput;
+  size_t i;
+
+  if (NULL != pSpec->pFill) {
+    (*pSpec->pFill)(pInput, pBuffers->nInputLength);
+  }
+  else {
+    for (i = 0 ; i < pBuffers->nInputLength ; i++) {
+      pInput[i] = (unsigned char)(i * 131U + 17U);
+    }
+  }
+  memset(pBuffers->pOutput, CU_GUARD_SLOT_CANARY(SWEEP_OUTPUT_SLOT), pBuffers->nOutputLength);
+}
+
+/*------------------------------------------------------------------------*/
+/** Prefixes the conditions of the failure records from pFirst on with the cell. */
+static void label_failures(CU_pFailureRecord pFirst, const CU_AlignBuffers *pBuffers)
+{
+  CU_pFailureRecord pFailure;
+  char szLabelled[MAX_NAME_LEN];
+  size_t nPrefix;
+
+  for (pFailure = pFirst ; NULL != pFailure ; pFailure = pFailure->pNext) {
+    if (NULL == pFailure->strCondition) {
+      continue;
+    }
+    memset(szLabelled, 0, sizeof(szLabelled));
+    nPrefix = (size_t)snprintf(szLabelled, sizeof(szLabelled), "[offset %u, length %lu] ",
+                               pBuffers->uiOffset, (unsigned long)pBuffers->nInputLength);
+    if (nPrefix < sizeof(szLabelled) - 1) {
+      strncpy(szLabelled + nPrefix, pFailure->strCondition, sizeof(szLabelled) - nPrefix - 1);
+    }
+    memcpy(pFailure->strCondition, szLabelled, sizeof(szLabelled));
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/** Prints the fastest call of every cell, one offset per line. */
+static void report_matrix(const CU_AlignSweepSpec *pSpec, const CU_AlignSweepResult *pResult,
+                          unsigned int uiTails)
+{
+  char szLine[16 + 9 * CU_ALIGN_SWEEP_MAX_TAILS];
+  size_t nLen;
+  size_t nStep = (0 != pSpec->nTailStep) ? pSpec->nTailStep : 1;
+  unsigned int uiOffset;
+  unsigned int uiTail;
+
+  VLA_info(_("Alignment sweep: %u of %u cells failed (ns per call; rows: offset, columns: tail bytes)."),
+           pResult->uiFailedCells, pResult->uiCells);
+  if (0 == pSpec->uiTimedCalls) {
+    return;
+  }
+
+  nLen = (size_t)snprintf(szLine, sizeof(szLine), "    ");
+  for (uiTail = 0 ; uiTail < uiTails ; uiTail++) {
+    nLen += (size_t)snprintf(szLine + nLen, sizeof(szLine) - nLen, " %8lu", (unsigned long)(uiTail * nStep));
+  }
+  VLA_info("%s", szLine);
+
+  for (uiOffset = 0 ; uiOffset < CU_ALIGN_SWEEP_OFFSETS ; uiOffset++) {
+    nLen = (size_t)snprintf(szLine, sizeof(szLine), "  %2u", uiOffset);
+    for (uiTail = 0 ; uiTail < uiTails ; uiTail++) {
+      if (CU_FALSE != pResult->abFailed[uiOffset][uiTail]) {
+        nLen += (size_t)snprintf(szLine + nLen, sizeof(szLine) - nLen, " %8s", _("FAILED"));
+      }
+      else {
+        nLen += (size_t)snprintf(szLine + nLen, sizeof(szLine) - nLen, " %8.1f",
+                                 pResult->adNs[uiOffset][uiTail]);
+      }
+    }
+    VLA_info("%s", szLine);
+  }
+}
+
+#else  /* LINUX */
+
+/*=================================================================
+ *  Public Interface functions (not supported)
+ *=================================================================*/
+CU_ErrorCode CU_align_sweep(const CU_AlignSweepSpec *pSpec, CU_pAlignSweepResult pResult)
+{
+  CU_UNREFERENCED_PARAMETER(pSpec);
+  memset(pResult, 0, sizeof(*pResult));
+  CU_set_error(CUE_NOT_SUPPORTED);
+  return CUE_NOT_SUPPORTED;
+}
+
+CU_BOOL CU_assertAlignSweepImplementation(const CU_AlignSweepSpec *pSpec,
+                                          unsigned int uiLine, const char *strCondition,
+                                          const char *strFile, const char *strFunction,
+                                          CU_BOOL bFatal)
+{
+  CU_UNREFERENCED_PARAMETER(pSpec);
+  return CU_assertImplementation(CU_FALSE, uiLine, strCondition, strFile, strFunction, bFatal);
+}
+
+#endif /* LINUX */
+
+/** @} */
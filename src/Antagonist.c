@@ -0,0 +1,502 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Implementation of antagonist threads loading the machine during benchmarks.
+ *
+ *  19-Oct-2026   Initial implementation of antagonist load.
+ */
+
+/** @file
+ *  Antagonist load (implementation).
+ *  The antagonists wait on f_wakeup while parked.  While f_iRunning is
+ *  set they work in short chunks, checking the flag between chunks, so
+ *  that parking takes at most one chunk.  f_uiActive counts the threads
+ *  between both states; start and stop wait on f_changed for it.
+ */
+/** @addtogroup Framework
+ @{
+*/
+
+#ifdef LINUX
+#define _GNU_SOURCE   /* sched_getcpu(), pthread_setaffinity_np() */
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#ifdef LINUX
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+#include "CUnit.h"
+#include "Antagonist.h"
+
+/*=================================================================
+ *  Global/Static Definitions
+ *=================================================================*/
+#ifdef LINUX
+
+/** Cache line size assumed for buffer alignment and cache thrashing. */
+#define ANTAGONIST_LINE 64U
+
+/** Bytes streamed by a bandwidth hog between checks of the run flag. */
+#define ANTAGONIST_CHUNK (256UL * 1024UL)
+
+/** Lines touched by a cache thrasher between checks of the run flag. */
+#define ANTAGONIST_TOUCHES 4096U
+
+/** Branches executed by a spinner between checks of the run flag. */
+#define ANTAGONIST_SPINS 65536U
+
+/** State of an antagonist thread. */
+typedef struct antagonist
+{
+  CU_AntagonistKind  eKind;      /**< What the thread does. */
+  unsigned char*     pBuffer;    /**< Buffer of a bandwidth hog or cache thrasher. */
+  size_t             nBytes;     /**< Size of pBuffer. */
+  size_t             nPosition;  /**< Next chunk of a bandwidth hog. */
+  unsigned long long ullState;   /**< Random state of a thrasher or spinner. */
+  unsigned long long ullSink;    /**< Keeps the spinner's work alive. */
+  pthread_t          thread;     /**< The thread. */
+} antagonist;
+
+static unsigned char* f_pArena = NULL;        /**< Mapping of the buffers of the antagonists, NULL if none. */
+static size_t        f_nArenaBytes = 0;        /**< Size of the mapping. */
+static antagonist    f_antagonists[CU_ANTAGONIST_MAX_THREADS];
+static unsigned int  f_uiNumThreads = 0;       /**< Antagonists created. */
+static CU_BOOL       f_bOpen = CU_FALSE;       /**< Whether antagonists are open. */
+static cpu_set_t     f_savedAffinity;          /**< CPU affinity of the caller before opening. */
+
+static int           f_iRunning = 0;           /**< Whether the antagonists should work (read without the lock). */
+static CU_BOOL       f_bClosing = CU_FALSE;    /**< Whether the antagonists should end. */
+static unsigned int  f_uiActive = 0;           /**< Antagonists currently working. */
+static pthread_mutex_t f_antagonist_lock = PTHREAD_MUTEX_INITIALIZER;  /**< Protects the three above. */
+static pthread_cond_t  f_wakeup = PTHREAD_COND_INITIALIZER;    /**< Signals changes of f_iRunning and f_bClosing. */
+static pthread_cond_t  f_changed = PTHREAD_COND_INITIALIZER;   /**< Signals changes of f_uiActive. */
+
+/*=================================================================
+ *  Private function forward declarations
+ *=================================================================*/
+static unsigned int select_cpus(CU_AntagonistPlacement ePlacement, int iOwnCpu, int aiCpus[]);
+static void         read_siblings(int iCpu, cpu_set_t *pSiblings);
+static void*        antagonist_main(void *pArg);
+static void         run_chunk(antagonist *pAntagonist);
+
+/*=================================================================
+ *  Public Interface functions
+ *=================================================================*/
+void CU_antagonist_default_config(CU_pAntagonistConfig pConfig)
+{
+  assert(NULL != pConfig);
+
+  pConfig->auiThreads[CUAK_MemoryBandwidth] = 1;
+  pConfig->auiThreads[CUAK_CacheThrash] = 1;
+  pConfig->auiThreads[CUAK_Spinner] = 1;
+  pConfig->ePlacement = CUAP_OtherCores;
+  pConfig->nBandwidthBytes = 32UL * 1024UL * 1024UL;
+  pConfig->nCacheBytes = 8UL * 1024UL * 1024UL;
+}
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_antagonist_open(const CU_AntagonistConfig *pConfig)
+{
+  CU_AntagonistConfig config;
+  cpu_set_t ownCpu;
+  cpu_set_t threadCpu;
+  cpu_set_t unpinnedCpus;
+  int aiCpus[CPU_SETSIZE];
+  unsigned int uiCpus;
+  unsigned int uiThreads = 0;
+  int iOwnCpu;
+  size_t anBytes[CUAK_NumKinds];
+  size_t nTotal = 0;
+  unsigned char *pBuffer;
+  antagonist *pAntagonist;
+  unsigned int k;
+  unsigned int i;
+
+  CU_antagonist_close();
+
+  if (NULL == pConfig) {
+    CU_antagonist_default_config(&config);
+  }
+  else {
+    config = *pConfig;
+  }
+
+  /* bandwidth hogs stream whole chunks, thrashers touch whole lines */
+  anBytes[CUAK_MemoryBandwidth] = (config.nBandwidthBytes + ANTAGONIST_CHUNK - 1) / ANTAGONIST_CHUNK * ANTAGONIST_CHUNK;
+  anBytes[CUAK_CacheThrash] = (config.nCacheBytes + ANTAGONIST_LINE - 1) / ANTAGONIST_LINE * ANTAGONIST_LINE;
+  anBytes[CUAK_Spinner] = 0;
+  if (0 == anBytes[CUAK_MemoryBandwidth]) {
+    anBytes[CUAK_MemoryBandwidth] = ANTAGONIST_CHUNK;
+  }
+  if (0 == anBytes[CUAK_CacheThrash]) {
+    anBytes[CUAK_CacheThrash] = ANTAGONIST_LINE;
+  }
+  for (k = 0 ; k < CUAK_NumKinds ; k++) {
+    uiThreads += config.auiThreads[k];
+    nTotal += config.auiThreads[k] * anBytes[k];
+  }
+  if ((uiThreads > CU_ANTAGONIST_MAX_THREADS) || (nTotal > CU_ANTAGONIST_ARENA_SIZE)) {
+    CU_set_error(CUE_NOMEMORY);
+    return CUE_NOMEMORY;
+  }
+
+  iOwnCpu = sched_getcpu();
+  uiCpus = (iOwnCpu >= 0) ? select_cpus(config.ePlacement, iOwnCpu, aiCpus) : 0;
+  if ((iOwnCpu < 0) || ((CUAP_Unpinned != config.ePlacement) && (0 == uiCpus))) {
+    CU_set_error(CUE_NOT_SUPPORTED);
+    return CUE_NOT_SUPPORTED;
+  }
+
+  if (0 != nTotal) {
+    f_pArena = (unsigned char*)mmap(NULL, nTotal, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (MAP_FAILED == (void*)f_pArena) {
+      f_pArena = NULL;
+      CU_set_error(CUE_NOMEMORY);
+      return CUE_NOMEMORY;
+    }
+    f_nArenaBytes = nTotal;
+  }
+
+  /* the measuring thread stays on its CPU, away from the antagonists */
+  pthread_getaffinity_np(pthread_self(), sizeof(f_savedAffinity), &f_savedAffinity);
+  CPU_ZERO(&ownCpu);
+  CPU_SET(iOwnCpu, &ownCpu);
+  pthread_setaffinity_np(pthread_self(), sizeof(ownCpu), &ownCpu);
+  f_bOpen = CU_TRUE;
+
+  /* unpinned antagonists would otherwise inherit the measuring CPU */
+  unpinnedCpus = f_savedAffinity;
+  CPU_CLR(iOwnCpu, &unpinnedCpus);
+  if (0 == CPU_COUNT(&unpinnedCpus)) {
+    unpinnedCpus = f_savedAffinity;
+  }
+
+  pBuffer = f_pArena;
+  for (k = 0 ; k < CUAK_NumKinds ; k++) {
+    for (i = 0 ; i < config.auiThreads[k] ; i++) {
+      pAntagonist = &f_antagonists[f_uiNumThreads];
+      pAntagonist->eKind = (CU_AntagonistKind)k;
+      pAntagonist->pBuffer = pBuffer;
+      pAntagonist->nBytes = anBytes[k];
+      pAntagonist->nPosition = 0;
+      pAntagonist->ullState = 0x9E3779B97F4A7C15ULL * (f_uiNumThreads + 1);
+      pAntagonist->ullSink = 0;
+      /* fault the pages in now rather than in the first measurement */
+      memset(pBuffer, 1, anBytes[k]);
+      pBuffer += anBytes[k];
+
+      if (0 != pthread_create(&pAntagonist->thread, NULL, antagonist_main, pAntagonist)) {
+        CU_antagonist_close();
+        CU_set_error(CUE_THREAD_FAILED);
+        return CUE_THREAD_FAILED;
+      }
+      if (0 != uiCpus) {
+        CPU_ZERO(&threadCpu);
+        CPU_SET(aiCpus[f_uiNumThreads % uiCpus], &threadCpu);
+        pthread_setaffinity_np(pAntagonist->thread, sizeof(threadCpu), &threadCpu);
+      }
+      else {
+        pthread_setaffinity_np(pAntagonist->thread, sizeof(unpinnedCpus), &unpinnedCpus);
+      }
+      f_uiNumThreads++;
+    }
+  }
+
+  CU_set_error(CUE_SUCCESS);
+  return CUE_SUCCESS;
+}
+
+/*------------------------------------------------------------------------*/
+void CU_antagonist_close(void)
+{
+  unsigned int i;
+
+  if (CU_FALSE == f_bOpen) {
+    return;
+  }
+
+  pthread_mutex_lock(&f_antagonist_lock);
+  f_bClosing = CU_TRUE;
+  __atomic_store_n(&f_iRunning, 0, __ATOMIC_RELAXED);
+  pthread_cond_broadcast(&f_wakeup);
+  pthread_mutex_unlock(&f_antagonist_lock);
+
+  for (i = 0 ; i < f_uiNumThreads ; i++) {
+    pthread_join(f_antagonists[i].thread, NULL);
+  }
+
+  if (NULL != f_pArena) {
+    munmap(f_pArena, f_nArenaBytes);
+    f_pArena = NULL;
+    f_nArenaBytes = 0;
+  }
+  f_uiNumThreads = 0;
+  f_uiActive = 0;
+  f_bClosing = CU_FALSE;
+  pthread_setaffinity_np(pthread_self(), sizeof(f_savedAffinity), &f_savedAffinity);
+  f_bOpen = CU_FALSE;
+}
+
+/*------------------------------------------------------------------------*/
+CU_BOOL CU_antagonist_is_open(void)
+{
+  return f_bOpen;
+}
+
+/*------------------------------------------------------------------------*/
+void CU_antagonist_start(void)
+{
+  if (CU_FALSE == f_bOpen) {
+    return;
+  }
+
+  pthread_mutex_lock(&f_antagonist_lock);
+  __atomic_store_n(&f_iRunning, 1, __ATOMIC_RELAXED);
+  pthread_cond_broadcast(&f_wakeup);
+  while (f_uiActive < f_uiNumThreads) {
+    pthread_cond_wait(&f_changed, &f_antagonist_lock);
+  }
+  pthread_mutex_unlock(&f_antagonist_lock);
+}
+
+/*------------------------------------------------------------------------*/
+void CU_antagonist_stop(void)
+{
+  if (CU_FALSE == f_bOpen) {
+    return;
+  }
+
+  pthread_mutex_lock(&f_antagonist_lock);
+  __atomic_store_n(&f_iRunning, 0, __ATOMIC_RELAXED);
+  while (0 != f_uiActive) {
+    pthread_cond_wait(&f_changed, &f_antagonist_lock);
+  }
+  pthread_mutex_unlock(&f_antagonist_lock);
+}
+
+/*=================================================================
+ *  Static module functions
+ *=================================================================*/
+/**
+ *  Collects the CPUs allowed for the process that match a placement
+ *  relative to the CPU of the calling thread.  Returns their number.
+ */
+static unsigned int select_cpus(CU_AntagonistPlacement ePlacement, int iOwnCpu, int aiCpus[])
+{
+  cpu_set_t allowed;
+  cpu_set_t siblings;
+  unsigned int uiCpus = 0;
+  CU_BOOL bSibling;
+  int iCpu;
+
+  if ((CUAP_Unpinned == ePlacement) || (0 != sched_getaffinity(0, sizeof(allowed), &allowed))) {
+    return 0;
+  }
+  read_siblings(iOwnCpu, &siblings);
+
+  for (iCpu = 0 ; iCpu < CPU_SETSIZE ; iCpu++) {
+    if ((iCpu == iOwnCpu) || !CPU_ISSET(iCpu, &allowed)) {
+      continue;
+    }
+    bSibling = CPU_ISSET(iCpu, &siblings) ? CU_TRUE : CU_FALSE;
+    if ((CUAP_SiblingCores == ePlacement) == (CU_FALSE != bSibling)) {
+      aiCpus[uiCpus++] = iCpu;
+    }
+  }
+  return uiCpus;
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Reads the hyper-thread siblings of a CPU (including the CPU itself)
+ *  from sysfs.  Without topology information the CPU has no siblings.
+ */
+static void read_siblings(int iCpu, cpu_set_t *pSiblings)
+{
+  char szPath[128];
+  char szList[256];
+  FILE *pFile;
+  char *pCur;
+  char *pEnd;
+  long lFirst;
+  long lLast;
+
+  CPU_ZERO(pSiblings);
+  CPU_SET(iCpu, pSiblings);
+
+  snprintf(szPath, sizeof(szPath), "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", iCpu);
+  if (NULL == (pFile = fopen(szPath, "r"))) {
+    return;
+  }
+  if (NULL == fgets(szList, sizeof(szList), pFile)) {
+    szList[0] = '\0';
+  }
+  fclose(pFile);
+
+  /* a list of CPUs and ranges, e.g. "0,4" or "0-1" */
+  for (pCur = szList ; ; pCur = pEnd + 1) {
+    lFirst = strtol(pCur, &pEnd, 10);
+    if (pEnd == pCur) {
+      break;
+    }
+    lLast = lFirst;
+    if ('-' == *pEnd) {
+      pCur = pEnd + 1;
+      lLast = strtol(pCur, &pEnd, 10);
+    }
+    for ( ; (lFirst <= lLast) && (lFirst < CPU_SETSIZE) ; lFirst++) {
+      if (lFirst >= 0) {
+        CPU_SET((int)lFirst, pSiblings);
+      }
+    }
+    if (',' != *pEnd) {
+      break;
+    }
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/** Main function of an antagonist thread. */
+static void* antagonist_main(void *pArg)
+{
+  antagonist *pAntagonist = (antagonist*)pArg;
+
+  pthread_mutex_lock(&f_antagonist_lock);
+  for (;;) {
+    while ((0 == f_iRunning) && (CU_FALSE == f_bClosing)) {
+      pthread_cond_wait(&f_wakeup, &f_antagonist_lock);
+    }
+    if (CU_FALSE != f_bClosing) {
+      break;
+    }
+    f_uiActive++;
+    pthread_cond_broadcast(&f_changed);
+    pthread_mutex_unlock(&f_antagonist_lock);
+
+    while (0 != __atomic_load_n(&f_iRunning, __ATOMIC_RELAXED)) {
+      run_chunk(pAntagonist);
+    }
+
+    pthread_mutex_lock(&f_antagonist_lock);
+    f_uiActive--;
+    pthread_cond_broadcast(&f_changed);
+  }
+  pthread_mutex_unlock(&f_antagonist_lock);
+  return NULL;
+}
+
+/*------------------------------------------------------------------------*/
+/** Does one chunk of an antagonist's work. */
+static void run_chunk(antagonist *pAntagonist)
+{
+  unsigned long long ullState = pAntagonist->ullState;
+  unsigned long long ullSum = 0;
+  unsigned long *pulChunk;
+  size_t nLines;
+  size_t i;
+
+  switch (pAntagonist->eKind) {
+    case CUAK_MemoryBandwidth:
+      /* read and write every word, continuing where the last chunk ended */
+      pulChunk = (unsigned long*)(pAntagonist->pBuffer + pAntagonist->nPosition);
+      for (i = 0 ; i < ANTAGONIST_CHUNK / sizeof(unsigned long) ; i++) {
+        pulChunk[i] += 1;
+      }
+      pAntagonist->nPosition += ANTAGONIST_CHUNK;
+      if (pAntagonist->nPosition >= pAntagonist->nBytes) {
+        pAntagonist->nPosition = 0;
+      }
+      break;
+
+    case CUAK_CacheThrash:
+      nLines = pAntagonist->nBytes / ANTAGONIST_LINE;
+      for (i = 0 ; i < ANTAGONIST_TOUCHES ; i++) {
+        ullState ^= ullState << 13;
+        ullState ^= ullState >> 7;
+        ullState ^= ullState << 17;
+        pAntagonist->pBuffer[(size_t)(ullState % nLines) * ANTAGONIST_LINE] += 1;
+      }
+      break;
+
+    case CUAK_Spinner:
+      /* random branch directions defeat the predictor */
+      for (i = 0 ; i < ANTAGONIST_SPINS ; i++) {
+        ullState ^= ullState << 13;
+        ullState ^= ullState >> 7;
+        ullState ^= ullState << 17;
+        if (0 != (ullState & 1)) {
+          ullSum += ullState * 3;
+        }
+        else {
+          ullSum ^= ullState >> 5;
+        }
+      }
+      pAntagonist->ullSink += ullSum;
+      break;
+
+    default:
+      break;
+  }
+  pAntagonist->ullState = ullState;
+}
+
+#else  /* LINUX */
+
+/*=================================================================
+ *  Public Interface functions (not supported)
+ *=================================================================*/
+void CU_antagonist_default_config(CU_pAntagonistConfig pConfig)
+{
+  assert(NULL != pConfig);
+  memset(pConfig, 0, sizeof(*pConfig));
+}
+
+CU_ErrorCode CU_antagonist_open(const CU_AntagonistConfig *pConfig)
+{
+  CU_UNREFERENCED_PARAMETER(pConfig);
+  CU_set_error(CUE_NOT_SUPPORTED);
+  return CUE_NOT_SUPPORTED;
+}
+
+void CU_antagonist_close(void)
+{
+}
+
+CU_BOOL CU_antagonist_is_open(void)
+{
+  return CU_FALSE;
+}
+
+void CU_antagonist_start(void)
+{
+}
+
+void CU_antagonist_stop(void)
+{
+}
+
+#endif /* LINUX */
+
+/** @} */
@@ -0,0 +1,430 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Implementation of asynchronous report output.
+ *
+ *  19-Oct-2026   Initial implementation of asynchronous output streams.
+ */
+
+/** @file
+ *  Asynchronous report output (implementation).
+ *  Each stream owns a ring of CU_ASYNC_CHUNKS chunks.  The writing
+ *  thread fills the chunk at uiSubmitted and hands it over by advancing
+ *  uiSubmitted; the writer thread writes the chunk at uiWritten and
+ *  releases it by advancing uiWritten.  Both counters are protected by
+ *  f_async_lock, the chunk contents are owned by one side at a time.
+ */
+/** @addtogroup Framework
+ @{
+*/
+
+#ifdef LINUX
+#define _GNU_SOURCE   /* fopencookie() */
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#ifdef LINUX
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#include "CUnit.h"
+#include "AsyncOutput.h"
+
+/*=================================================================
+ *  Global/Static Definitions
+ *=================================================================*/
+#ifdef LINUX
+
+/** A chunk of output data. */
+typedef struct async_chunk
+{
+  size_t nLength;                       /**< Bytes used. */
+  char   acData[CU_ASYNC_CHUNK_SIZE];   /**< Data. */
+} async_chunk;
+
+/** An output stream (slot is free if bOpen is CU_FALSE). */
+struct CU_AsyncStream
+{
+  CU_BOOL      bOpen;                   /**< Slot is in use. */
+  int          fd;                      /**< Descriptor written to. */
+  FILE*        pFile;                   /**< stdio adapter, NULL if not created. */
+  CU_BOOL      bHaveChunk;              /**< The chunk at uiSubmitted is owned by the writing thread. */
+  unsigned int uiSubmitted;             /**< Chunks handed to the writer thread. */
+  unsigned int uiWritten;               /**< Chunks written to the descriptor. */
+  CU_BOOL      bError;                  /**< A write failed. */
+  unsigned int uiStalls;                /**< Waits for a free chunk. */
+  async_chunk  aChunks[CU_ASYNC_CHUNKS];
+};
+
+static CU_AsyncStream  f_streams[CU_ASYNC_MAX_STREAMS];
+static unsigned int    f_uiOpenStreams = 0;
+static CU_BOOL         f_bWriterRunning = CU_FALSE;
+static pthread_t       f_writer;
+static pthread_mutex_t f_async_control = PTHREAD_MUTEX_INITIALIZER; /* serializes open/close (writer start/stop) */
+static pthread_mutex_t f_async_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  f_async_work = PTHREAD_COND_INITIALIZER;   /* chunk submitted or writer stopping */
+static pthread_cond_t  f_async_done = PTHREAD_COND_INITIALIZER;   /* chunk written */
+
+/*=================================================================
+ *  Private function forward declarations
+ *=================================================================*/
+static void    submit_chunk(CU_pAsyncStream pStream);
+static void    acquire_chunk(CU_pAsyncStream pStream);
+static CU_BOOL write_all(int fd, const char *pData, size_t nLength);
+static void*   writer_thread(void *pArg);
+static ssize_t cookie_write(void *pCookie, const char *pData, size_t nLength);
+
+/*=================================================================
+ *  Public Interface functions
+ *=================================================================*/
+CU_pAsyncStream CU_async_open(int fd)
+{
+  CU_pAsyncStream pStream = NULL;
+  unsigned int i;
+
+  if (fd < 0) {
+    CU_set_error(CUE_BAD_FILENAME);
+    return NULL;
+  }
+
+  pthread_mutex_lock(&f_async_control);
+  pthread_mutex_lock(&f_async_lock);
+  for (i = 0 ; i < CU_ASYNC_MAX_STREAMS ; i++) {
+    if (CU_FALSE == f_streams[i].bOpen) {
+      pStream = &f_streams[i];
+      break;
+    }
+  }
+  if (NULL == pStream) {
+    pthread_mutex_unlock(&f_async_lock);
+    pthread_mutex_unlock(&f_async_control);
+    CU_set_error(CUE_NOMEMORY);
+    return NULL;
+  }
+
+  if (CU_FALSE == f_bWriterRunning) {
+    f_bWriterRunning = CU_TRUE;
+    if (0 != pthread_create(&f_writer, NULL, writer_thread, NULL)) {
+      f_bWriterRunning = CU_FALSE;
+      pthread_mutex_unlock(&f_async_lock);
+      pthread_mutex_unlock(&f_async_control);
+      CU_set_error(CUE_FOPEN_FAILED);
+      return NULL;
+    }
+  }
+
+  pStream->bOpen = CU_TRUE;
+  pStream->fd = fd;
+  pStream->pFile = NULL;
+  pStream->bHaveChunk = CU_FALSE;
+  pStream->uiSubmitted = 0;
+  pStream->uiWritten = 0;
+  pStream->bError = CU_FALSE;
+  pStream->uiStalls = 0;
+  f_uiOpenStreams++;
+  pthread_mutex_unlock(&f_async_lock);
+  pthread_mutex_unlock(&f_async_control);
+
+  CU_set_error(CUE_SUCCESS);
+  return pStream;
+}
+
+/*------------------------------------------------------------------------*/
+void CU_async_write(CU_pAsyncStream pStream, const void *pData, size_t nLength)
+{
+  const char *pSource = (const char*)pData;
+  async_chunk *pChunk;
+  size_t nCopy;
+
+  assert(NULL != pStream);
+  assert(CU_TRUE == pStream->bOpen);
+
+  while (0 < nLength) {
+    if (CU_FALSE == pStream->bHaveChunk) {
+      acquire_chunk(pStream);
+    }
+    pChunk = &pStream->aChunks[pStream->uiSubmitted % CU_ASYNC_CHUNKS];
+    nCopy = CU_ASYNC_CHUNK_SIZE - pChunk->nLength;
+    if (nCopy > nLength) {
+      nCopy = nLength;
+    }
+    memcpy(pChunk->acData + pChunk->nLength, pSource, nCopy);
+    pChunk->nLength += nCopy;
+    pSource += nCopy;
+    nLength -= nCopy;
+
+    if (CU_ASYNC_CHUNK_SIZE == pChunk->nLength) {
+      pthread_mutex_lock(&f_async_lock);
+      submit_chunk(pStream);
+      pthread_mutex_unlock(&f_async_lock);
+    }
+  }
+}
+
+/*------------------------------------------------------------------------*/
+void CU_async_flush(CU_pAsyncStream pStream)
+{
+  assert(NULL != pStream);
+
+  if ((CU_FALSE == pStream->bHaveChunk) ||
+      (0 == pStream->aChunks[pStream->uiSubmitted % CU_ASYNC_CHUNKS].nLength)) {
+    return;
+  }
+
+  /* while the writer is busy, keep batching into the current chunk */
+  pthread_mutex_lock(&f_async_lock);
+  if (pStream->uiWritten == pStream->uiSubmitted) {
+    submit_chunk(pStream);
+  }
+  pthread_mutex_unlock(&f_async_lock);
+}
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_async_barrier(CU_pAsyncStream pStream)
+{
+  CU_ErrorCode result;
+
+  assert(NULL != pStream);
+
+  if (NULL != pStream->pFile) {
+    fflush(pStream->pFile);
+  }
+
+  pthread_mutex_lock(&f_async_lock);
+  if ((CU_TRUE == pStream->bHaveChunk) &&
+      (0 != pStream->aChunks[pStream->uiSubmitted % CU_ASYNC_CHUNKS].nLength)) {
+    submit_chunk(pStream);
+  }
+  while (pStream->uiWritten != pStream->uiSubmitted) {
+    pthread_cond_wait(&f_async_done, &f_async_lock);
+  }
+  result = (CU_TRUE == pStream->bError) ? CUE_WRITE_ERROR : CUE_SUCCESS;
+  pthread_mutex_unlock(&f_async_lock);
+
+  return result;
+}
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_async_close(CU_pAsyncStream pStream)
+{
+  CU_ErrorCode result;
+  CU_BOOL bStopWriter = CU_FALSE;
+
+  assert(NULL != pStream);
+
+  result = CU_async_barrier(pStream);
+  if (NULL != pStream->pFile) {
+    fclose(pStream->pFile);
+    pStream->pFile = NULL;
+  }
+
+  pthread_mutex_lock(&f_async_control);
+  pthread_mutex_lock(&f_async_lock);
+  pStream->bOpen = CU_FALSE;
+  if (0 == --f_uiOpenStreams) {
+    f_bWriterRunning = CU_FALSE;
+    bStopWriter = CU_TRUE;
+    pthread_cond_signal(&f_async_work);
+  }
+  pthread_mutex_unlock(&f_async_lock);
+
+  if (CU_TRUE == bStopWriter) {
+    pthread_join(f_writer, NULL);
+  }
+  pthread_mutex_unlock(&f_async_control);
+  return result;
+}
+
+/*------------------------------------------------------------------------*/
+FILE* CU_async_file(CU_pAsyncStream pStream)
+{
+  cookie_io_functions_t functions;
+
+  assert(NULL != pStream);
+
+  if (NULL == pStream->pFile) {
+    memset(&functions, 0, sizeof(functions));
+    functions.write = cookie_write;
+    pStream->pFile = fopencookie(pStream, "w", functions);
+  }
+  return pStream->pFile;
+}
+
+/*------------------------------------------------------------------------*/
+unsigned int CU_async_get_stalls(CU_pAsyncStream pStream)
+{
+  assert(NULL != pStream);
+  return pStream->uiStalls;
+}
+
+/*=================================================================
+ *  Static module functions
+ *=================================================================*/
+/** Hands the current chunk to the writer.  Called with f_async_lock held. */
+static void submit_chunk(CU_pAsyncStream pStream)
+{
+  pStream->uiSubmitted++;
+  pStream->bHaveChunk = CU_FALSE;
+  pthread_cond_signal(&f_async_work);
+}
+
+/*------------------------------------------------------------------------*/
+/** Waits for a free chunk to fill, i.e. one not in flight. */
+static void acquire_chunk(CU_pAsyncStream pStream)
+{
+  pthread_mutex_lock(&f_async_lock);
+  if (CU_ASYNC_CHUNKS <= pStream->uiSubmitted - pStream->uiWritten) {
+    pStream->uiStalls++;
+    do {
+      pthread_cond_wait(&f_async_done, &f_async_lock);
+    } while (CU_ASYNC_CHUNKS <= pStream->uiSubmitted - pStream->uiWritten);
+  }
+  pthread_mutex_unlock(&f_async_lock);
+
+  pStream->aChunks[pStream->uiSubmitted % CU_ASYNC_CHUNKS].nLength = 0;
+  pStream->bHaveChunk = CU_TRUE;
+}
+
+/*------------------------------------------------------------------------*/
+static CU_BOOL write_all(int fd, const char *pData, size_t nLength)
+{
+  ssize_t nWritten;
+
+  while (0 < nLength) {
+    nWritten = write(fd, pData, nLength);
+    if (nWritten < 0) {
+      if (EINTR == errno) {
+        continue;
+      }
+      return CU_FALSE;
+    }
+    pData += nWritten;
+    nLength -= (size_t)nWritten;
+  }
+  return CU_TRUE;
+}
+
+/*------------------------------------------------------------------------*/
+/** Writer thread: writes submitted chunks of all streams in turn. */
+static void* writer_thread(void *pArg)
+{
+  CU_pAsyncStream pStream;
+  async_chunk *pChunk;
+  unsigned int uiNext = 0;
+  unsigned int i;
+  CU_BOOL bWritten;
+
+  CU_UNREFERENCED_PARAMETER(pArg);
+
+  pthread_mutex_lock(&f_async_lock);
+  while (CU_TRUE == f_bWriterRunning) {
+    pStream = NULL;
+    for (i = 0 ; i < CU_ASYNC_MAX_STREAMS ; i++) {
+      if ((CU_TRUE == f_streams[(uiNext + i) % CU_ASYNC_MAX_STREAMS].bOpen) &&
+          (f_streams[(uiNext + i) % CU_ASYNC_MAX_STREAMS].uiWritten !=
+           f_streams[(uiNext + i) % CU_ASYNC_MAX_STREAMS].uiSubmitted)) {
+        pStream = &f_streams[(uiNext + i) % CU_ASYNC_MAX_STREAMS];
+        uiNext = (uiNext + i + 1) % CU_ASYNC_MAX_STREAMS;
+        break;
+      }
+    }
+    if (NULL == pStream) {
+      pthread_cond_wait(&f_async_work, &f_async_lock);
+      continue;
+    }
+
+    pChunk = &pStream->aChunks[pStream->uiWritten % CU_ASYNC_CHUNKS];
+    pthread_mutex_unlock(&f_async_lock);
+    bWritten = write_all(pStream->fd, pChunk->acData, pChunk->nLength);
+    pthread_mutex_lock(&f_async_lock);
+
+    if (CU_FALSE == bWritten) {
+      pStream->bError = CU_TRUE;
+    }
+    pStream->uiWritten++;
+    pthread_cond_broadcast(&f_async_done);
+  }
+  pthread_mutex_unlock(&f_async_lock);
+  return NULL;
+}
+
+/*------------------------------------------------------------------------*/
+/** Write function of the stdio adapter. */
+static ssize_t cookie_write(void *pCookie, const char *pData, size_t nLength)
+{
+  CU_async_write((CU_pAsyncStream)pCookie, pData, nLength);
+  return (ssize_t)nLength;
+}
+
+#else  /* LINUX */
+
+/*=================================================================
+ *  Public Interface functions (not supported)
+ *=================================================================*/
+CU_pAsyncStream CU_async_open(int fd)
+{
+  CU_UNREFERENCED_PARAMETER(fd);
+  CU_set_error(CUE_FOPEN_FAILED);
+  return NULL;
+}
+
+void CU_async_write(CU_pAsyncStream pStream, const void *pData, size_t nLength)
+{
+  CU_UNREFERENCED_PARAMETER(pStream);
+  CU_UNREFERENCED_PARAMETER(pData);
+  CU_UNREFERENCED_PARAMETER(nLength);
+}
+
+void CU_async_flush(CU_pAsyncStream pStream)
+{
+  CU_UNREFERENCED_PARAMETER(pStream);
+}
+
+CU_ErrorCode CU_async_barrier(CU_pAsyncStream pStream)
+{
+  CU_UNREFERENCED_PARAMETER(pStream);
+  return CUE_SUCCESS;
+}
+
+CU_ErrorCode CU_async_close(CU_pAsyncStream pStream)
+{
+  CU_UNREFERENCED_PARAMETER(pStream);
+  return CUE_SUCCESS;
+}
+
+FILE* CU_async_file(CU_pAsyncStream pStream)
+{
+  CU_UNREFERENCED_PARAMETER(pStream);
+  return NULL;
+}
+
+unsigned int CU_async_get_stalls(CU_pAsyncStream pStream)
+{
+  CU_UNREFERENCED_PARAMETER(pStream);
+  return 0;
+}
+
+#endif /* LINUX */
+
+/** @} */
@@ -0,0 +1,384 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Implementation of gating test durations against a stored baseline.
+ *
+ *  19-Oct-2026   Initial implementation of duration baselines.
+ */
+
+/** @file
+ *  Duration baselines (implementation).
+ */
+/** @addtogroup Framework
+ @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+#include "CUnit.h"
+#include "TestDB.h"
+#include "TestRun.h"
+#include "Export.h"
+#include "Baseline.h"
+#include "Util.h"
+#include "CUnit_intl.h"
+
+/*=================================================================
+ *  Global/Static Definitions
+ *=================================================================*/
+/** Tag on the first line of a baseline file. */
+#define BASELINE_TAG "CUnit-baseline"
+
+/** File name used in CUF_PerfRegression failure records. */
+#define BASELINE_FAILURE_FILE "baseline"
+
+/** Scale of the MAD to the standard deviation of a normal distribution. */
+#define BASELINE_MAD_SCALE 1.4826
+
+/** Baseline of a single test. */
+typedef struct baseline_entry
+{
+  CU_TestNames names;                      /**< Suite and test name. */
+  double       dMedian;                    /**< Median wall-clock time in seconds. */
+  double       dMad;                       /**< Median absolute deviation in seconds. */
+  unsigned int uiRuns;                     /**< Number of runs measured. */
+} baseline_entry;
+
+/** Durations of a test collected by CU_baseline_build(). */
+typedef struct baseline_samples
+{
+  char         szSuiteName[MAX_NAME_LEN];       /**< Suite name, empty if unused. */
+  char         szTestName[MAX_NAME_LEN];        /**< Test name. */
+  unsigned int uiRuns;                          /**< Entries used in adTimes. */
+  double       adTimes[CU_BASELINE_MAX_RUNS];   /**< Wall-clock times in seconds. */
+} baseline_samples;
+
+/** Margin of the tests of one suite. */
+typedef struct baseline_suite_threshold
+{
+  CU_pSuite            pSuite;     /**< Suite, NULL if the slot is unused. */
+  CU_BaselineThreshold threshold;  /**< Margin of its tests. */
+} baseline_suite_threshold;
+
+static baseline_entry   f_entries[MAX_NUM_OF_TESTS];     /**< The loaded baseline. */
+static unsigned int     f_uiNumEntries = 0;              /**< Entries used in f_entries. */
+static CU_BOOL          f_bLoaded = CU_FALSE;            /**< Whether a baseline is loaded. */
+static unsigned int     f_uiNextEntry = 0;               /**< Entry expected for the next test. */
+static baseline_samples f_samples[MAX_NUM_OF_TESTS];     /**< Durations collected by a build. */
+
+static CU_BaselineThreshold     f_default_threshold = { 5.0, 0.25, 0.001 };
+static baseline_suite_threshold f_suite_thresholds[MAX_NUM_OF_SUITES];
+
+/*=================================================================
+ *  Private function forward declarations
+ *=================================================================*/
+static CU_ErrorCode collect_log(FILE *pLog);
+static void         median_and_mad(double *adTimes, unsigned int uiRuns, double *pdMedian, double *pdMad);
+static CU_BOOL      parse_entry(char *szLine, baseline_entry *pEntry);
+static const CU_BaselineThreshold* suite_threshold(CU_pSuite pSuite);
+
+/*=================================================================
+ *  Public Interface functions
+ *=================================================================*/
+CU_ErrorCode CU_baseline_build(FILE *apLogs[], unsigned int uiLogs, FILE *pOutput)
+{
+  CU_ErrorCode result = CUE_SUCCESS;
+  double dMedian;
+  double dMad;
+  unsigned int i;
+
+  assert(NULL != apLogs);
+  assert(NULL != pOutput);
+
+  if ((0 == uiLogs) || (uiLogs > CU_BASELINE_MAX_RUNS)) {
+    CU_set_error(CUE_NOMEMORY);
+    return CUE_NOMEMORY;
+  }
+
+  memset(f_samples, 0, sizeof(f_samples));
+  for (i = 0 ; (i < uiLogs) && (CUE_SUCCESS == result) ; i++) {
+    result = collect_log(apLogs[i]);
+  }
+
+  if (CUE_SUCCESS == result) {
+    if (0 > fprintf(pOutput, "%s\t%d\n", BASELINE_TAG, CU_BASELINE_VERSION)) {
+      result = CUE_WRITE_ERROR;
+    }
+    for (i = 0 ; (i < MAX_NUM_OF_TESTS) && (CUE_SUCCESS == result) ; i++) {
+      if (0 == f_samples[i].uiRuns) {
+        continue;
+      }
+      median_and_mad(f_samples[i].adTimes, f_samples[i].uiRuns, &dMedian, &dMad);
+      if (0 > fprintf(pOutput, "%s\t%s\t%.9f\t%.9f\t%u\n", f_samples[i].szSuiteName,
+                      f_samples[i].szTestName, dMedian, dMad, f_samples[i].uiRuns)) {
+        result = CUE_WRITE_ERROR;
+      }
+    }
+  }
+
+  CU_set_error(result);
+  return result;
+}
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_baseline_load(const char *szFile)
+{
+  FILE *pFile;
+  char szLine[2 * MAX_NAME_LEN + 128];
+  char szHeader[sizeof(BASELINE_TAG) + 16];
+  CU_ErrorCode result = CUE_SUCCESS;
+
+  CU_baseline_unload();
+
+  if ((NULL == szFile) || ('\0' == *szFile)) {
+    CU_set_error(CUE_BAD_FILENAME);
+    return CUE_BAD_FILENAME;
+  }
+  if (NULL == (pFile = fopen(szFile, "r"))) {
+    CU_set_error(CUE_FOPEN_FAILED);
+    return CUE_FOPEN_FAILED;
+  }
+
+  snprintf(szHeader, sizeof(szHeader), "%s\t%d\n", BASELINE_TAG, CU_BASELINE_VERSION);
+  if ((NULL == fgets(szLine, sizeof(szLine), pFile)) || (0 != strcmp(szLine, szHeader))) {
+    result = CUE_BAD_BASELINE;
+  }
+  while ((CUE_SUCCESS == result) && (NULL != fgets(szLine, sizeof(szLine), pFile))) {
+    if ('\n' == szLine[0]) {
+      continue;
+    }
+    if ((f_uiNumEntries >= MAX_NUM_OF_TESTS) ||
+        (CU_FALSE == parse_entry(szLine, &f_entries[f_uiNumEntries]))) {
+      result = CUE_BAD_BASELINE;
+      break;
+    }
+    f_uiNumEntries++;
+  }
+  fclose(pFile);
+
+  if (CUE_SUCCESS == result) {
+    f_bLoaded = CU_TRUE;
+  }
+  else {
+    f_uiNumEntries = 0;
+  }
+
+  CU_set_error(result);
+  return result;
+}
+
+/*------------------------------------------------------------------------*/
+void CU_baseline_unload(void)
+{
+  f_bLoaded = CU_FALSE;
+  f_uiNumEntries = 0;
+  f_uiNextEntry = 0;
+}
+
+/*------------------------------------------------------------------------*/
+void CU_baseline_default_threshold(CU_pBaselineThreshold pThreshold)
+{
+  assert(NULL != pThreshold);
+
+  pThreshold->dMadFactor = 5.0;
+  pThreshold->dRelative = 0.25;
+  pThreshold->dAbsolute = 0.001;
+}
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_baseline_set_threshold(CU_pSuite pSuite, const CU_BaselineThreshold *pThreshold)
+{
+  baseline_suite_threshold *pFree = NULL;
+  unsigned int i;
+
+  if (NULL == pSuite) {
+    if (NULL != pThreshold) {
+      f_default_threshold = *pThreshold;
+    }
+    else {
+      CU_baseline_default_threshold(&f_default_threshold);
+    }
+    CU_set_error(CUE_SUCCESS);
+    return CUE_SUCCESS;
+  }
+
+  for (i = 0 ; i < MAX_NUM_OF_SUITES ; i++) {
+    if (f_suite_thresholds[i].pSuite == pSuite) {
+      pFree = &f_suite_thresholds[i];
+      break;
+    }
+    if ((NULL == pFree) && (NULL == f_suite_thresholds[i].pSuite)) {
+      pFree = &f_suite_thresholds[i];
+    }
+  }
+
+  if (NULL == pThreshold) {
+    if ((NULL != pFree) && (pFree->pSuite == pSuite)) {
+      pFree->pSuite = NULL;
+    }
+  }
+  else if (NULL == pFree) {
+    CU_set_error(CUE_NOMEMORY);
+    return CUE_NOMEMORY;
+  }
+  else {
+    pFree->pSuite = pSuite;
+    pFree->threshold = *pThreshold;
+  }
+
+  CU_set_error(CUE_SUCCESS);
+  return CUE_SUCCESS;
+}
+
+/*------------------------------------------------------------------------*/
+void CU_baseline_check_test(CU_pSuite pSuite, CU_pTest pTest)
+{
+  const baseline_entry *pEntry;
+  const CU_BaselineThreshold *pThreshold;
+  double dMargin;
+  double dLimit;
+  char szCondition[MAX_NAME_LEN];
+
+  assert(NULL != pSuite);
+  assert(NULL != pTest);
+
+  if ((CU_FALSE == f_bLoaded) ||
+      (NULL == (pEntry = (const baseline_entry*)CU_find_test_entry(f_entries, sizeof(f_entries[0]), f_uiNumEntries,
+                                                                   &f_uiNextEntry, pSuite->pName, pTest->pName)))) {
+    return;
+  }
+
+  pThreshold = suite_threshold(pSuite);
+  dMargin = pThreshold->dMadFactor * BASELINE_MAD_SCALE * pEntry->dMad;
+  if (dMargin < pThreshold->dRelative * pEntry->dMedian) {
+    dMargin = pThreshold->dRelative * pEntry->dMedian;
+  }
+  if (dMargin < pThreshold->dAbsolute) {
+    dMargin = pThreshold->dAbsolute;
+  }
+  dLimit = pEntry->dMedian + dMargin;
+
+  if (pTest->dWallTime > dLimit) {
+    snprintf(szCondition, sizeof(szCondition), "took %.4g s, limit %.4g s (baseline %.4g s, MAD %.3g s)",
+             pTest->dWallTime, dLimit, pEntry->dMedian, pEntry->dMad);
+    CU_record_failure(CUF_PerfRegression, 0, szCondition, BASELINE_FAILURE_FILE, pSuite, pTest);
+  }
+}
+
+/*=================================================================
+ *  Static module functions
+ *=================================================================*/
+/** Adds the passed tests of the first run in a result log to f_samples. */
+static CU_ErrorCode collect_log(FILE *pLog)
+{
+  CU_ResultRecord record;
+  baseline_samples *pSamples;
+
+  while (CU_FALSE != CU_read_result_record(pLog, &record)) {
+    if (CURR_Summary == record.type) {
+      return CUE_SUCCESS;
+    }
+    if ((CURR_Test != record.type) || (CUTO_Passed != record.eOutcome) ||
+        (record.uiIndex >= MAX_NUM_OF_TESTS)) {
+      continue;
+    }
+    /* the registration index identifies the test, as long as the names agree */
+    pSamples = &f_samples[record.uiIndex];
+    if ('\0' == pSamples->szSuiteName[0]) {
+      strcpy(pSamples->szSuiteName, record.strSuiteName);
+      strcpy(pSamples->szTestName, record.strTestName);
+    }
+    else if ((0 != strcmp(pSamples->szSuiteName, record.strSuiteName)) ||
+             (0 != strcmp(pSamples->szTestName, record.strTestName)) ||
+             (pSamples->uiRuns >= CU_BASELINE_MAX_RUNS)) {
+      continue;
+    }
+    pSamples->adTimes[pSamples->uiRuns++] = record.dWallTime;
+  }
+
+  return (CUE_BAD_RESULT_RECORD == CU_get_error()) ? CUE_BAD_RESULT_RECORD : CUE_SUCCESS;
+}
+
+/*------------------------------------------------------------------------*/
+/** Computes the median and the median absolute deviation (sorts adTimes). */
+static void median_and_mad(double *adTimes, unsigned int uiRuns, double *pdMedian, double *pdMad)
+{
+  double adDeviations[CU_BASELINE_MAX_RUNS];
+  unsigned int i;
+
+  qsort(adTimes, uiRuns, sizeof(double), CU_compare_doubles);
+  *pdMedian = CU_median_of_sorted(adTimes, uiRuns);
+
+  for (i = 0 ; i < uiRuns ; i++) {
+    adDeviations[i] = (adTimes[i] > *pdMedian) ? adTimes[i] - *pdMedian : *pdMedian - adTimes[i];
+  }
+  qsort(adDeviations, uiRuns, sizeof(double), CU_compare_doubles);
+  *pdMad = CU_median_of_sorted(adDeviations, uiRuns);
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Parses a test line of a baseline file.
+ *  @return CU_TRUE if the line is valid, CU_FALSE otherwise.
+ */
+static CU_BOOL parse_entry(char *szLine, baseline_entry *pEntry)
+{
+  char *aszFields[5];
+  char *szEnd;
+
+  if ((5 != CU_split_tab_line(szLine, aszFields, 5)) ||
+      ('\0' == aszFields[0][0]) || ('\0' == aszFields[1][0])) {
+    return CU_FALSE;
+  }
+
+  CU_copy_name(pEntry->names.szSuiteName, aszFields[0]);
+  CU_copy_name(pEntry->names.szTestName, aszFields[1]);
+  pEntry->dMedian = strtod(aszFields[2], &szEnd);
+  if ((szEnd == aszFields[2]) || ('\0' != *szEnd) || (pEntry->dMedian < 0.0)) {
+    return CU_FALSE;
+  }
+  pEntry->dMad = strtod(aszFields[3], &szEnd);
+  if ((szEnd == aszFields[3]) || ('\0' != *szEnd) || (pEntry->dMad < 0.0)) {
+    return CU_FALSE;
+  }
+  pEntry->uiRuns = (unsigned int)strtoul(aszFields[4], &szEnd, 10);
+  if ((szEnd == aszFields[4]) || ('\0' != *szEnd)) {
+    return CU_FALSE;
+  }
+  return CU_TRUE;
+}
+
+/*------------------------------------------------------------------------*/
+/** Returns the margin of the tests of a suite. */
+static const CU_BaselineThreshold* suite_threshold(CU_pSuite pSuite)
+{
+  unsigned int i;
+
+  for (i = 0 ; i < MAX_NUM_OF_SUITES ; i++) {
+    if (f_suite_thresholds[i].pSuite == pSuite) {
+      return &f_suite_thresholds[i].threshold;
+    }
+  }
+  return &f_default_threshold;
+}
+
+/** @} */
@@ -41,12 +41,19 @@
 #include <ctype.h>
 #include <assert.h>
 #include <string.h>
+#ifdef LINUX
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#endif
 
 #include "CUnit.h"
 #include "TestDB.h"
 #include "Util.h"
 #include "TestRun.h"
 #include "Basic.h"
+#include "Export.h"
 #include "CUnit_intl.h"
 
 /*=================================================================
@@ -57,6 +64,48 @@ static CU_pSuite f_pRunningSuite = NULL;
 /** Current run mode. */
 static CU_BasicRunMode f_run_mode = CU_BRM_NORMAL;
 
+/** Maximum length of the progress history path (including the NULL). */
+#define BASIC_MAX_HISTORY_PATH 256
+/** Result log providing the expected test durations for the progress ETA. */
+static char f_szProgressHistory[BASIC_MAX_HISTORY_PATH] = "";
+
+#ifdef LINUX
+/** Size of the progress line buffer. */
+#define BASIC_PROGRESS_LINE 512
+
+/** Expected duration of a test in the progress ETA. */
+typedef struct basic_expected
+{
+  CU_pSuite pSuite;     /**< Suite of the test. */
+  CU_pTest  pTest;      /**< The test. */
+  double    dSeconds;   /**< Expected duration, negative if unknown. */
+} basic_expected;
+
+/** State of the progress line, shared with the progress thread. */
+typedef struct basic_progress
+{
+  CU_BOOL         bActive;          /**< Progress thread is running. */
+  CU_BOOL         bLineShown;       /**< Progress line is on screen. */
+  unsigned int    uiColumns;        /**< Terminal width. */
+  unsigned int    uiTotal;          /**< Tests to run. */
+  unsigned int    uiDone;           /**< Tests completed. */
+  unsigned int    uiFailed;         /**< Tests completed with failures. */
+  double          dExpectedTotal;   /**< Expected duration of the run. */
+  double          dExpectedDone;    /**< Expected duration of the completed tests. */
+  double          dLastDone;        /**< Time of the last completion since start. */
+  CU_pSuite       pSuite;           /**< Suite of the current test. */
+  CU_pTest        pTest;            /**< Current test. */
+  struct timespec start;            /**< Start of the run. */
+  pthread_t       thread;           /**< Progress thread. */
+} basic_progress;
+
+static pthread_mutex_t f_progress_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  f_progress_wake = PTHREAD_COND_INITIALIZER;
+static basic_progress  f_progress;
+static basic_expected  f_aExpected[MAX_NUM_OF_TESTS];
+static unsigned int    f_uiExpected = 0;
+#endif
+
 /*=================================================================
  *  Forward declaration of module functions *
  *=================================================================*/
@@ -70,6 +119,19 @@ static void basic_test_complete_message_handler(const CU_pTest pTest, const CU_p
 static void basic_all_tests_complete_message_handler(const CU_pFailureRecord pFailure);
 static void basic_suite_init_failure_message_handler(const CU_pSuite pSuite);
 static void basic_suite_cleanup_failure_message_handler(const CU_pSuite pSuite);
+static void basic_show_statistic(const CU_pFailureRecord pFailure, const char *szIndent);
+
+static void basic_progress_start(CU_pSuite pOnlySuite, CU_pTest pOnlyTest);
+static void basic_progress_stop(void);
+static void basic_progress_hide(void);
+static void basic_progress_show(void);
+#ifdef LINUX
+static void   basic_progress_load_history(void);
+static double basic_progress_expected(CU_pTest pTest);
+static double basic_progress_now(void);
+static void   basic_progress_draw(void);
+static void*  basic_progress_thread(void *pArg);
+#endif
 
 /*=================================================================
  *  Public Interface functions
@@ -129,6 +191,19 @@ CU_BasicRunMode CU_basic_get_mode(void)
   return f_run_mode;
 }
 
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_basic_set_progress_history(const char *szResultLog)
+{
+  if (NULL == szResultLog) {
+    szResultLog = "";
+  }
+  if (strlen(szResultLog) >= BASIC_MAX_HISTORY_PATH) {
+    return CUE_BAD_FILENAME;
+  }
+  strcpy(f_szProgressHistory, szResultLog);
+  return CUE_SUCCESS;
+}
+
 /*------------------------------------------------------------------------*/
 void CU_basic_show_failures(CU_pFailureRecord pFailure)
 {
@@ -139,6 +214,7 @@ void CU_basic_show_failures(CU_pFailureRecord pFailure)
         (NULL != pFailure->strFileName) ? pFailure->strFileName : "",
         pFailure->uiLineNumber,
         (NULL != pFailure->strCondition) ? pFailure->strCondition : "");
+   basic_show_statistic(pFailure, "     ");
   }
 }
 
@@ -194,7 +270,9 @@ static CU_ErrorCode basic_run_all_tests(CU_pTestRegistry pRegistry)
 
   if (NULL != pRegistry)
     pOldRegistry = CU_set_registry(pRegistry);
+  basic_progress_start(NULL, NULL);
   result = CU_run_all_tests();
+  basic_progress_stop();
   if (NULL != pRegistry)
     CU_set_registry(pOldRegistry);
   return result;
@@ -208,8 +286,13 @@ static CU_ErrorCode basic_run_all_tests(CU_pTestRegistry pRegistry)
  */
 static CU_ErrorCode basic_run_suite(CU_pSuite pSuite)
 {
+  CU_ErrorCode result;
+
   f_pRunningSuite = NULL;
-  return CU_run_suite(pSuite);
+  basic_progress_start(pSuite, NULL);
+  result = CU_run_suite(pSuite);
+  basic_progress_stop();
+  return result;
 }
 
 /*------------------------------------------------------------------------*/
@@ -222,8 +305,13 @@ static CU_ErrorCode basic_run_suite(CU_pSuite pSuite)
  */
 static CU_ErrorCode basic_run_single_test(CU_pSuite pSuite, CU_pTest pTest)
 {
+  CU_ErrorCode result;
+
   f_pRunningSuite = NULL;
-  return CU_run_test(pSuite, pTest);
+  basic_progress_start(pSuite, pTest);
+  result = CU_run_test(pSuite, pTest);
+  basic_progress_stop();
+  return result;
 }
 
 /*------------------------------------------------------------------------*/
@@ -236,6 +324,15 @@ static void basic_test_start_message_handler(const CU_pTest pTest, const CU_pSui
   assert(NULL != pSuite);
   assert(NULL != pTest);
 
+#ifdef LINUX
+  if (CU_TRUE == f_progress.bActive) {
+    pthread_mutex_lock(&f_progress_lock);
+    f_progress.pSuite = pSuite;
+    f_progress.pTest = pTest;
+    pthread_mutex_unlock(&f_progress_lock);
+  }
+#endif
+
   if (CU_BRM_VERBOSE == f_run_mode) {
     assert(NULL != pTest->pName);
     if ((NULL == f_pRunningSuite) || (f_pRunningSuite != pSuite)) {
@@ -266,8 +363,24 @@ static void basic_test_complete_message_handler(const CU_pTest pTest,
   assert(NULL != pSuite);
   assert(NULL != pTest);
 
+#ifdef LINUX
+  if (CU_TRUE == f_progress.bActive) {
+    pthread_mutex_lock(&f_progress_lock);
+    f_progress.uiDone++;
+    if (NULL != pFailure) {
+      f_progress.uiFailed++;
+    }
+    f_progress.dExpectedDone += basic_progress_expected(pTest);
+    f_progress.dLastDone = basic_progress_now();
+    pthread_mutex_unlock(&f_progress_lock);
+  }
+#endif
+
   if (NULL == pFailure) {
-    if (CU_BRM_VERBOSE == f_run_mode) {
+    if ((CU_BRM_VERBOSE == f_run_mode) && (CU_FALSE != pTest->fCompileTime)) {
+      VLA_info(_("passed (compile-time)"));
+    }
+    else if (CU_BRM_VERBOSE == f_run_mode) {
       VLA_info(_("passed"));
     }
   }
@@ -277,6 +390,8 @@ static void basic_test_complete_message_handler(const CU_pTest pTest,
         VLA_info(_("FAILED"));
         break;
       case CU_BRM_NORMAL:
+      case CU_BRM_PROGRESS:
+        basic_progress_hide();
         assert(NULL != pSuite->pName);
         assert(NULL != pTest->pName);
         VLA_info(_("\nSuite %s, Test %s had failures:"), pSuite->pName, pTest->pName);
@@ -290,7 +405,9 @@ static void basic_test_complete_message_handler(const CU_pTest pTest,
             (NULL != pFailure->strFileName) ? pFailure->strFileName : "",
             pFailure->uiLineNumber,
             (NULL != pFailure->strCondition) ? pFailure->strCondition : "");
+       basic_show_statistic(pFailure, "       ");
       }
+      basic_progress_show();
     }
   }
 }
@@ -302,9 +419,11 @@ static void basic_test_complete_message_handler(const CU_pTest pTest,
 static void basic_all_tests_complete_message_handler(const CU_pFailureRecord pFailure)
 {
   CU_UNREFERENCED_PARAMETER(pFailure); /* not used in basic interface */
+  basic_progress_stop();
  VLA_info("\n");
   CU_print_run_results(stdout);
  VLA_info("");
+  CU_export_requested_results();
 }
 
 /*------------------------------------------------------------------------*/
@@ -316,8 +435,27 @@ static void basic_suite_init_failure_message_handler(const CU_pSuite pSuite)
   assert(NULL != pSuite);
   assert(NULL != pSuite->pName);
 
-  if (CU_BRM_SILENT != f_run_mode)
+#ifdef LINUX
+  /* the tests of the suite will not run - count them as done */
+  if (CU_TRUE == f_progress.bActive) {
+    CU_pTest pTest;
+
+    pthread_mutex_lock(&f_progress_lock);
+    for (pTest = pSuite->pTest ; NULL != pTest ; pTest = pTest->pNext) {
+      if (CU_FALSE != pTest->fActive) {
+        f_progress.uiDone++;
+        f_progress.dExpectedDone += basic_progress_expected(pTest);
+      }
+    }
+    pthread_mutex_unlock(&f_progress_lock);
+  }
+#endif
+
+  if (CU_BRM_SILENT != f_run_mode) {
+    basic_progress_hide();
     VLA_info(_("\nWARNING - Suite initialization failed for '%s'."), pSuite->pName);
+    basic_progress_show();
+  }
 }
 
 /*------------------------------------------------------------------------*/
@@ -329,8 +467,313 @@ static void basic_suite_cleanup_failure_message_handler(const CU_pSuite pSuite)
   assert(NULL != pSuite);
   assert(NULL != pSuite->pName);
 
-  if (CU_BRM_SILENT != f_run_mode)
+  if (CU_BRM_SILENT != f_run_mode) {
+    basic_progress_hide();
     VLA_info(_("\nWARNING - Suite cleanup failed for '%s'."), pSuite->pName);
+    basic_progress_show();
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/** Prints the test statistic of a failure from a statistical assertion.
+ *  @param pFailure Failure record to print the statistic of.
+ *  @param szIndent Indentation matching the failure line.
+ */
+static void basic_show_statistic(const CU_pFailureRecord pFailure, const char *szIndent)
+{
+  if (CU_TRUE != pFailure->fStatistic) {
+    return;
+  }
+  if (pFailure->dPValue < 0.0) {
+    VLA_info(_("%sstatistic = %g"), szIndent, pFailure->dStatistic);
+  }
+  else {
+    VLA_info(_("%sstatistic = %g, p-value = %g"), szIndent,
+             pFailure->dStatistic, pFailure->dPValue);
+  }
+}
+
+#ifdef LINUX
+/*------------------------------------------------------------------------*/
+/** Starts the progress line for a run in CU_BRM_PROGRESS mode.
+ *  Determines the tests to run and their expected durations, then
+ *  starts the thread redrawing the line.
+ *  @param pOnlySuite Suite to run (NULL for all suites).
+ *  @param pOnlyTest  Test to run (NULL for all tests of the suites).
+ */
+static void basic_progress_start(CU_pSuite pOnlySuite, CU_pTest pOnlyTest)
+{
+  CU_pTestRegistry pRegistry = CU_get_registry();
+  CU_pSuite pSuite;
+  CU_pTest pTest;
+  struct winsize size;
+  double dKnown = 0.0;
+  unsigned int uiKnown = 0;
+  unsigned int i;
+
+  if ((CU_BRM_PROGRESS != f_run_mode) || (NULL == pRegistry) ||
+      (CU_TRUE == f_progress.bActive) || (0 == isatty(STDOUT_FILENO))) {
+    return;
+  }
+
+  memset(&f_progress, 0, sizeof(f_progress));
+  f_uiExpected = 0;
+
+  /* the durations of the last run are cleared when the run starts */
+  for (pSuite = pRegistry->pSuite ; NULL != pSuite ; pSuite = pSuite->pNext) {
+    if (((NULL != pOnlySuite) && (pSuite != pOnlySuite)) || (CU_FALSE == pSuite->fActive)) {
+      continue;
+    }
+    for (pTest = pSuite->pTest ; (NULL != pTest) && (f_uiExpected < MAX_NUM_OF_TESTS) ; pTest = pTest->pNext) {
+      if (((NULL != pOnlyTest) && (pTest != pOnlyTest)) || (CU_FALSE == pTest->fActive)) {
+        continue;
+      }
+      f_aExpected[f_uiExpected].pSuite = pSuite;
+      f_aExpected[f_uiExpected].pTest = pTest;
+      f_aExpected[f_uiExpected].dSeconds =
+          ((CUTO_Passed == pTest->eOutcome) || (CUTO_Failed == pTest->eOutcome)) ? pTest->dElapsedTime : -1.0;
+      f_uiExpected++;
+    }
+  }
+  basic_progress_load_history();
+
+  for (i = 0 ; i < f_uiExpected ; i++) {
+    if (0.0 <= f_aExpected[i].dSeconds) {
+      dKnown += f_aExpected[i].dSeconds;
+      uiKnown++;
+    }
+  }
+  /* unknown tests are expected to take the average; with no history at
+   * all dExpectedTotal stays 0 and the ETA uses the observed rate */
+  for (i = 0 ; i < f_uiExpected ; i++) {
+    if (0.0 > f_aExpected[i].dSeconds) {
+      f_aExpected[i].dSeconds = (0 != uiKnown) ? dKnown / (double)uiKnown : 0.0;
+    }
+    f_progress.dExpectedTotal += f_aExpected[i].dSeconds;
+  }
+
+  f_progress.uiTotal = f_uiExpected;
+  f_progress.uiColumns = 80;
+  if ((0 == ioctl(STDOUT_FILENO, TIOCGWINSZ, &size)) && (0 != size.ws_col)) {
+    f_progress.uiColumns = size.ws_col;
+  }
+  clock_gettime(CLOCK_MONOTONIC, &f_progress.start);
+
+  f_progress.bActive = CU_TRUE;
+  if (0 != pthread_create(&f_progress.thread, NULL, basic_progress_thread, NULL)) {
+    f_progress.bActive = CU_FALSE;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/** Stops the progress thread and removes the progress line. */
+static void basic_progress_stop(void)
+{
+  if (CU_TRUE != f_progress.bActive) {
+    return;
+  }
+
+  pthread_mutex_lock(&f_progress_lock);
+  f_progress.bActive = CU_FALSE;
+  pthread_cond_signal(&f_progress_wake);
+  pthread_mutex_unlock(&f_progress_lock);
+  pthread_join(f_progress.thread, NULL);
+
+  if (CU_TRUE == f_progress.bLineShown) {
+    fputs("\r\033[K", stdout);
+    fflush(stdout);
+    f_progress.bLineShown = CU_FALSE;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/** Removes the progress line and keeps it from being redrawn until
+ *  basic_progress_show(), so that other output can be printed.
+ */
+static void basic_progress_hide(void)
+{
+  if (CU_TRUE != f_progress.bActive) {
+    return;
+  }
+
+  pthread_mutex_lock(&f_progress_lock);
+  if (CU_TRUE == f_progress.bLineShown) {
+    fputs("\r\033[K", stdout);
+    f_progress.bLineShown = CU_FALSE;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/** Allows the progress line to be redrawn after basic_progress_hide(). */
+static void basic_progress_show(void)
+{
+  if (CU_TRUE != f_progress.bActive) {
+    return;
+  }
+
+  fflush(stdout);
+  pthread_mutex_unlock(&f_progress_lock);
+}
+
+/*------------------------------------------------------------------------*/
+/** Reads the expected test durations from the progress history log. */
+static void basic_progress_load_history(void)
+{
+  CU_ResultRecord record;
+  FILE *pFile;
+  unsigned int i;
+
+  if ('\0' == f_szProgressHistory[0]) {
+    return;
+  }
+  if (NULL == (pFile = fopen(f_szProgressHistory, "r"))) {
+    return;
+  }
+
+  while (CU_TRUE == CU_read_result_record(pFile, &record)) {
+    if ((CURR_Test != record.type) ||
+        ((CUTO_Passed != record.eOutcome) && (CUTO_Failed != record.eOutcome))) {
+      continue;
+    }
+    for (i = 0 ; i < f_uiExpected ; i++) {
+      if ((0 == strcmp(f_aExpected[i].pTest->pName, record.strTestName)) &&
+          (0 == strcmp(f_aExpected[i].pSuite->pName, record.strSuiteName))) {
+        f_aExpected[i].dSeconds = record.dElapsedTime;
+        break;
+      }
+    }
+  }
+
+  fclose(pFile);
+  CU_set_error(CUE_SUCCESS);
 }
 
+/*------------------------------------------------------------------------*/
+/** Returns the expected duration of a test of the current run.
+ *  Tests run in registration order, so the search starts after the
+ *  last test found.
+ */
+static double basic_progress_expected(CU_pTest pTest)
+{
+  static unsigned int uiNext = 0;
+  unsigned int i;
+  unsigned int uiIndex;
+
+  for (i = 0 ; i < f_uiExpected ; i++) {
+    uiIndex = (uiNext + i) % f_uiExpected;
+    if (f_aExpected[uiIndex].pTest == pTest) {
+      uiNext = uiIndex + 1;
+      return f_aExpected[uiIndex].dSeconds;
+    }
+  }
+  return 0.0;
+}
+
+/*------------------------------------------------------------------------*/
+/** Returns the time since the start of the run in seconds. */
+static double basic_progress_now(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)(now.tv_sec - f_progress.start.tv_sec)
+       + (double)(now.tv_nsec - f_progress.start.tv_nsec) / 1e9;
+}
+
+/*------------------------------------------------------------------------*/
+/** Draws the progress line.  Called with f_progress_lock held. */
+static void basic_progress_draw(void)
+{
+  char szLine[BASIC_PROGRESS_LINE];
+  char szEta[32] = "--:--";
+  double dNow = basic_progress_now();
+  double dCurrent = dNow - f_progress.dLastDone;
+  double dRemaining = 0.0;
+  CU_BOOL bEstimate = CU_FALSE;
+  unsigned long ulEta;
+  size_t nWidth;
+
+  if ((0.0 < f_progress.dExpectedTotal) && (0.0 < f_progress.dExpectedDone)) {
+    /* scale the history by how fast this run is compared to it */
+    dRemaining = (f_progress.dExpectedTotal - f_progress.dExpectedDone)
+               * (f_progress.dLastDone / f_progress.dExpectedDone) - dCurrent;
+    bEstimate = CU_TRUE;
+  }
+  else if (0 != f_progress.uiDone) {
+    dRemaining = f_progress.dLastDone / (double)f_progress.uiDone
+               * (double)(f_progress.uiTotal - f_progress.uiDone) - dCurrent;
+    bEstimate = CU_TRUE;
+  }
+  if (f_progress.uiDone >= f_progress.uiTotal) {
+    dRemaining = 0.0;
+    bEstimate = CU_TRUE;
+  }
+  if (CU_TRUE == bEstimate) {
+    ulEta = (0.0 < dRemaining) ? (unsigned long)(dRemaining + 0.5) : 0UL;
+    if (3600 <= ulEta) {
+      snprintf(szEta, sizeof(szEta), "%lu:%02lu:%02lu", ulEta / 3600, (ulEta / 60) % 60, ulEta % 60);
+    }
+    else {
+      snprintf(szEta, sizeof(szEta), "%lu:%02lu", ulEta / 60, ulEta % 60);
+    }
+  }
+
+  /* stay within the terminal width, a wrapped line cannot be rewritten */
+  nWidth = (f_progress.uiColumns < sizeof(szLine)) ? f_progress.uiColumns : sizeof(szLine);
+  snprintf(szLine, nWidth, _("\r[%u/%u] %u failed, ETA %s  %s: %s"),
+           f_progress.uiDone, f_progress.uiTotal, f_progress.uiFailed, szEta,
+           (NULL != f_progress.pSuite) ? f_progress.pSuite->pName : "",
+           (NULL != f_progress.pTest) ? f_progress.pTest->pName : "");
+  fputs(szLine, stdout);
+  fputs("\033[K", stdout);
+  fflush(stdout);
+  f_progress.bLineShown = CU_TRUE;
+}
+
+/*------------------------------------------------------------------------*/
+/** Progress thread: redraws the progress line at a fixed interval. */
+static void* basic_progress_thread(void *pArg)
+{
+  struct timespec deadline;
+
+  CU_UNREFERENCED_PARAMETER(pArg);
+
+  pthread_mutex_lock(&f_progress_lock);
+  while (CU_TRUE == f_progress.bActive) {
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_nsec += (long)CU_BASIC_PROGRESS_INTERVAL_MS * 1000000L;
+    deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+    deadline.tv_nsec %= 1000000000L;
+    pthread_cond_timedwait(&f_progress_wake, &f_progress_lock, &deadline);
+    if (CU_TRUE == f_progress.bActive) {
+      basic_progress_draw();
+    }
+  }
+  pthread_mutex_unlock(&f_progress_lock);
+  return NULL;
+}
+
+#else  /* LINUX */
+
+/*------------------------------------------------------------------------*/
+static void basic_progress_start(CU_pSuite pOnlySuite, CU_pTest pOnlyTest)
+{
+  CU_UNREFERENCED_PARAMETER(pOnlySuite);
+  CU_UNREFERENCED_PARAMETER(pOnlyTest);
+}
+
+static void basic_progress_stop(void)
+{
+}
+
+static void basic_progress_hide(void)
+{
+}
+
+static void basic_progress_show(void)
+{
+}
+
+#endif /* LINUX */
+
 /** @} */
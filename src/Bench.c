@@ -0,0 +1,475 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Implementation of running registered tests as microbenchmarks.
+ *
+ *  19-Oct-2026   Initial implementation of bench mode.
+ */
+
+/** @file
+ *  Bench mode (implementation).
+ */
+/** @addtogroup Framework
+ @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <math.h>
+
+#include "CUnit.h"
+#include "TestDB.h"
+#include "TestRun.h"
+#include "MyMem.h"
+#include "Util.h"
+#include "Statistics.h"
+#include "PerfCounters.h"
+#include "Antagonist.h"
+#include "Bench.h"
+#include "VLA_Lite_Log.h"
+#include "CUnit_intl.h"
+
+/*=================================================================
+ *  Global/Static Definitions
+ *=================================================================*/
+/** File name used in the failure records of bench runs. */
+#define BENCH_FAILURE_FILE "bench"
+
+static CU_BenchResult f_results[MAX_NUM_OF_TESTS];  /**< Results of the last bench run. */
+static unsigned int   f_uiNumResults = 0;           /**< Entries used in f_results. */
+static CU_BenchConfig f_config;                     /**< Parameters of the current bench run. */
+
+static unsigned long long f_ullLayoutState = 1;     /**< State of the layout random sequence. */
+static size_t f_nStackOffset = 0;                   /**< Stack offset of the current layout. */
+#ifdef LINUX
+static void*  f_pHeapSpacer = NULL;                 /**< Heap spacer of the current layout. */
+#endif
+static CU_BOOL f_bCounting = CU_FALSE;              /**< Whether the performance counters were started. */
+
+/*=================================================================
+ *  Private function forward declarations
+ *=================================================================*/
+static void   bench_test_body(const CU_pSuite pSuite, const CU_pTest pTest);
+static void   measure_test(const CU_pSuite pSuite, const CU_pTest pTest);
+static double time_batch(CU_TestFunc pTestFunc, unsigned long ulIterations);
+static double time_batch_at_offset(CU_TestFunc pTestFunc, unsigned long ulIterations, size_t nOffset);
+static unsigned long long next_layout_random(void);
+static void   enter_layout(void);
+static void   leave_layout(void);
+static void   end_measurement(void);
+static double layout_share(const double adSamples[], unsigned int uiLayouts, unsigned int uiPerLayout);
+static void   report_results(void);
+
+/*=================================================================
+ *  Public Interface functions
+ *=================================================================*/
+void CU_bench_default_config(CU_pBenchConfig pConfig)
+{
+  assert(NULL != pConfig);
+
+  pConfig->dSampleTime = 0.01;
+  pConfig->uiSamples = 10;
+  pConfig->ulMaxIterations = 100000000UL;
+  pConfig->uiLayouts = 0;
+  pConfig->dLayoutShare = 0.5;
+  pConfig->ullLayoutSeed = 0;
+}
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_bench_run(CU_pSuite pSuite, const CU_BenchConfig *pConfig)
+{
+  CU_TestBodyWrapper pPrevWrapper;
+  CU_BOOL bPrevCountOnly;
+  CU_ErrorCode result;
+
+  assert(CU_FALSE == CU_is_test_running());
+
+  if (NULL == CU_get_registry()) {
+    CU_set_error(CUE_NOREGISTRY);
+    return CUE_NOREGISTRY;
+  }
+  if (NULL == pConfig) {
+    CU_bench_default_config(&f_config);
+  }
+  else {
+    f_config = *pConfig;
+  }
+  if (0 == f_config.uiSamples) {
+    f_config.uiSamples = 1;
+  }
+  else if (f_config.uiSamples > CU_BENCH_MAX_SAMPLES) {
+    f_config.uiSamples = CU_BENCH_MAX_SAMPLES;
+  }
+  if (0 == f_config.ulMaxIterations) {
+    f_config.ulMaxIterations = 1;
+  }
+  if (f_config.uiLayouts > CU_BENCH_MAX_SAMPLES / f_config.uiSamples) {
+    f_config.uiLayouts = CU_BENCH_MAX_SAMPLES / f_config.uiSamples;
+  }
+  f_ullLayoutState = (0 != f_config.ullLayoutSeed) ? f_config.ullLayoutSeed : CU_get_time_ns();
+  f_ullLayoutState |= 1;
+
+  memset(f_results, 0, sizeof(f_results));
+  f_uiNumResults = 0;
+
+  pPrevWrapper = CU_get_test_body_wrapper();
+  bPrevCountOnly = CU_get_assert_count_only();
+  CU_set_test_body_wrapper(bench_test_body);
+
+  result = (NULL != pSuite) ? CU_run_suite(pSuite) : CU_run_all_tests();
+
+  CU_set_test_body_wrapper(pPrevWrapper);
+  CU_set_assert_count_only(bPrevCountOnly);
+
+  report_results();
+
+  CU_set_error(result);
+  return result;
+}
+
+/*------------------------------------------------------------------------*/
+const CU_BenchResult* CU_bench_get_result(CU_pTest pTest)
+{
+  unsigned int i;
+
+  for (i = 0 ; i < f_uiNumResults ; i++) {
+    if (f_results[i].pTest == pTest) {
+      return &f_results[i];
+    }
+  }
+  return NULL;
+}
+
+/*=================================================================
+ *  Static module functions
+ *=================================================================*/
+/** Test body wrapper measuring the test function. */
+static void bench_test_body(const CU_pSuite pSuite, const CU_pTest pTest)
+{
+  jmp_buf *pRunnerJump = pTest->pJumpBuf;
+  jmp_buf buf;
+
+  /* a fatal assertion comes back here to end the measurement before teardown runs */
+  pTest->pJumpBuf = &buf;
+  if (0 == setjmp(buf)) {
+    measure_test(pSuite, pTest);
+    pTest->pJumpBuf = pRunnerJump;
+  }
+  else {
+    pTest->pJumpBuf = pRunnerJump;
+    end_measurement();
+    if (NULL != pRunnerJump) {
+      longjmp(*pRunnerJump, 1);
+    }
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/** Calibrates and measures a test function. */
+static void measure_test(const CU_pSuite pSuite, const CU_pTest pTest)
+{
+  CU_pBenchResult pResult;
+  double adSamples[CU_BENCH_MAX_SAMPLES];
+  double adLoaded[CU_BENCH_MAX_SAMPLES];
+  double dTarget = f_config.dSampleTime * 1e9;
+  double dTime;
+  double dVariance;
+  double dInstructions;
+  unsigned long long aullCounts[CU_PERF_NUM_EVENTS];
+  unsigned int uiFailedBefore;
+  unsigned int uiFailures;
+  unsigned long ulIterations = 1;
+  unsigned int uiLayouts;
+  unsigned int uiSamples;
+  unsigned int uiLayout;
+  unsigned int i;
+  char szCondition[MAX_NAME_LEN];
+
+  if (NULL == pTest->pTestFunc) {
+    return;
+  }
+  if (f_uiNumResults >= MAX_NUM_OF_TESTS) {
+    (*pTest->pTestFunc)();
+    return;
+  }
+  pResult = &f_results[f_uiNumResults++];
+  pResult->pSuite = pSuite;
+  pResult->pTest = pTest;
+
+  /* checked run - failing tests are not benchmarked */
+  uiFailures = CU_get_number_of_failure_records();
+  (*pTest->pTestFunc)();
+  if (CU_get_number_of_failure_records() != uiFailures) {
+    return;
+  }
+
+  CU_set_assert_count_only(CU_TRUE);
+  uiFailedBefore = pTest->uiNumberOfAssertsFailed;
+
+  /* calibrate - the batches also warm up caches and branch predictors */
+  for (;;) {
+    dTime = time_batch(pTest->pTestFunc, ulIterations);
+    if ((dTime >= dTarget) || (ulIterations >= f_config.ulMaxIterations)) {
+      break;
+    }
+    if (dTime * 10.0 < dTarget) {
+      ulIterations *= 10;
+    }
+    else {
+      ulIterations = (unsigned long)((double)ulIterations * 1.1 * dTarget / dTime) + 1;
+    }
+    if (ulIterations > f_config.ulMaxIterations) {
+      ulIterations = f_config.ulMaxIterations;
+    }
+  }
+
+  /* the counters are switched outside the timed batch */
+  uiLayouts = (0 != f_config.uiLayouts) ? f_config.uiLayouts : 1;
+  uiSamples = uiLayouts * f_config.uiSamples;
+  for (uiLayout = 0 ; uiLayout < uiLayouts ; uiLayout++) {
+    if (0 != f_config.uiLayouts) {
+      enter_layout();
+    }
+    for (i = uiLayout * f_config.uiSamples ; i < (uiLayout + 1) * f_config.uiSamples ; i++) {
+      f_bCounting = CU_TRUE;
+      CU_perf_start();
+      adSamples[i] = time_batch_at_offset(pTest->pTestFunc, ulIterations, f_nStackOffset) / (double)ulIterations;
+      f_bCounting = CU_FALSE;
+      if (CU_FALSE != CU_perf_stop(aullCounts)) {
+        dInstructions = (double)aullCounts[CU_PERF_INSTRUCTIONS] / (double)ulIterations;
+        if ((0.0 == pResult->dInstructions) || (dInstructions < pResult->dInstructions)) {
+          pResult->dInstructions = dInstructions;
+        }
+      }
+    }
+    if (0 != f_config.uiLayouts) {
+      leave_layout();
+    }
+  }
+
+  /* the antagonists only run around these samples */
+  if (CU_FALSE != CU_antagonist_is_open()) {
+    CU_antagonist_start();
+    for (i = 0 ; i < f_config.uiSamples ; i++) {
+      adLoaded[i] = time_batch(pTest->pTestFunc, ulIterations) / (double)ulIterations;
+    }
+    CU_antagonist_stop();
+    qsort(adLoaded, f_config.uiSamples, sizeof(double), CU_compare_doubles);
+    pResult->dLoadedMedian = CU_median_of_sorted(adLoaded, f_config.uiSamples);
+  }
+
+  CU_set_assert_count_only(CU_FALSE);
+
+  /* the samples are still grouped by layout here */
+  if (0 != f_config.uiLayouts) {
+    pResult->uiLayouts = f_config.uiLayouts;
+    pResult->dLayoutShare = layout_share(adSamples, f_config.uiLayouts, f_config.uiSamples);
+    pResult->bLayoutSensitive = (pResult->dLayoutShare > f_config.dLayoutShare) ? CU_TRUE : CU_FALSE;
+  }
+
+  CU_stat_moments(adSamples, uiSamples, &pResult->dMean, &dVariance);
+  qsort(adSamples, uiSamples, sizeof(double), CU_compare_doubles);
+  pResult->ulIterations = ulIterations;
+  pResult->uiSamples = uiSamples;
+  pResult->dMin = adSamples[0];
+  pResult->dMedian = CU_median_of_sorted(adSamples, uiSamples);
+  if ((0.0 != pResult->dLoadedMedian) && (pResult->dMedian > 0.0)) {
+    pResult->dSlowdown = pResult->dLoadedMedian / pResult->dMedian;
+  }
+  pResult->dStdDev = (dVariance > 0.0) ? sqrt(dVariance) : 0.0;
+
+  pResult->uiCountedFailures = pTest->uiNumberOfAssertsFailed - uiFailedBefore;
+  if (0 != pResult->uiCountedFailures) {
+    snprintf(szCondition, sizeof(szCondition), "%u assertions failed while benchmarking",
+             pResult->uiCountedFailures);
+    CU_record_failure(CUF_AssertFailed, 0, szCondition, BENCH_FAILURE_FILE, pSuite, pTest);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/** Calls a test function repeatedly and returns the elapsed nanoseconds. */
+static double time_batch(CU_TestFunc pTestFunc, unsigned long ulIterations)
+{
+  unsigned long long ullStart;
+  unsigned long i;
+
+  ullStart = CU_get_time_ns();
+  for (i = 0 ; i < ulIterations ; i++) {
+    (*pTestFunc)();
+  }
+  return (double)(CU_get_time_ns() - ullStart);
+}
+
+/*------------------------------------------------------------------------*/
+/** Calls time_batch() with the stack moved down by nOffset bytes. */
+static double time_batch_at_offset(CU_TestFunc pTestFunc, unsigned long ulIterations, size_t nOffset)
+{
+  volatile char acPadding[nOffset + 1];
+  double dTime;
+
+  /* touching both ends keeps the padding alive around the call */
+  acPadding[0] = 0;
+  dTime = time_batch(pTestFunc, ulIterations);
+  acPadding[nOffset] = acPadding[0];
+  return dTime;
+}
+
+/*------------------------------------------------------------------------*/
+/** Returns the next value of the layout sequence (xorshift64*). */
+static unsigned long long next_layout_random(void)
+{
+  f_ullLayoutState ^= f_ullLayoutState >> 12;
+  f_ullLayoutState ^= f_ullLayoutState << 25;
+  f_ullLayoutState ^= f_ullLayoutState >> 27;
+  return f_ullLayoutState * 2685821657736338717ULL;
+}
+
+/*------------------------------------------------------------------------*/
+/** Sets up a random stack offset and (LINUX builds) heap spacer. */
+static void enter_layout(void)
+{
+  f_nStackOffset = (size_t)(next_layout_random() % CU_BENCH_MAX_LAYOUT_OFFSET);
+#ifdef LINUX
+  /* blocks allocated by the test now start after the spacer */
+  f_pHeapSpacer = CU_MALLOC((size_t)(next_layout_random() % CU_BENCH_MAX_LAYOUT_OFFSET) + 1);
+#endif
+}
+
+/*------------------------------------------------------------------------*/
+/** Releases the heap spacer of the current layout. */
+static void leave_layout(void)
+{
+#ifdef LINUX
+  if (NULL != f_pHeapSpacer) {
+    CU_FREE(f_pHeapSpacer);
+    f_pHeapSpacer = NULL;
+  }
+#endif
+  f_nStackOffset = 0;
+}
+
+/*------------------------------------------------------------------------*/
+/** Stops the counters and antagonists and leaves the layout of a measurement ended by a fatal assertion. */
+static void end_measurement(void)
+{
+  unsigned long long aullCounts[CU_PERF_NUM_EVENTS];
+
+  if (CU_FALSE != f_bCounting) {
+    f_bCounting = CU_FALSE;
+    CU_perf_stop(aullCounts);
+  }
+  CU_antagonist_stop();
+  leave_layout();
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Estimates the share of the variance between layouts from the samples
+ *  grouped by layout (one-way random effects analysis of variance).
+ *  Returns 0 if the groups are too small or the layouts do not differ
+ *  more than the samples within a layout.
+ */
+static double layout_share(const double adSamples[], unsigned int uiLayouts, unsigned int uiPerLayout)
+{
+  double dGrandMean = 0.0;
+  double dLayoutMean;
+  double dBetween = 0.0;
+  double dWithin = 0.0;
+  double dMsWithin;
+  double dComponent;
+  unsigned int uiLayout;
+  unsigned int i;
+
+  if ((uiLayouts < 2) || (uiPerLayout < 2)) {
+    return 0.0;
+  }
+  for (i = 0 ; i < uiLayouts * uiPerLayout ; i++) {
+    dGrandMean += adSamples[i];
+  }
+  dGrandMean /= (double)(uiLayouts * uiPerLayout);
+
+  for (uiLayout = 0 ; uiLayout < uiLayouts ; uiLayout++) {
+    dLayoutMean = 0.0;
+    for (i = 0 ; i < uiPerLayout ; i++) {
+      dLayoutMean += adSamples[uiLayout * uiPerLayout + i];
+    }
+    dLayoutMean /= (double)uiPerLayout;
+    dBetween += (double)uiPerLayout * (dLayoutMean - dGrandMean) * (dLayoutMean - dGrandMean);
+    for (i = 0 ; i < uiPerLayout ; i++) {
+      dWithin += (adSamples[uiLayout * uiPerLayout + i] - dLayoutMean)
+                 * (adSamples[uiLayout * uiPerLayout + i] - dLayoutMean);
+    }
+  }
+
+  /* variance component of the layout from the mean squares */
+  dMsWithin = dWithin / (double)(uiLayouts * (uiPerLayout - 1));
+  dComponent = (dBetween / (double)(uiLayouts - 1) - dMsWithin) / (double)uiPerLayout;
+  if (dComponent <= 0.0) {
+    return 0.0;
+  }
+  return dComponent / (dComponent + dMsWithin);
+}
+
+/*------------------------------------------------------------------------*/
+/** Prints the statistics of all tests of the last bench run. */
+static void report_results(void)
+{
+  const CU_BenchResult *pResult;
+  unsigned int i;
+
+  if (0 != f_config.uiLayouts) {
+    VLA_info(_("Bench run: %u tests, %u layouts of %u samples of %.1f ms (ns/iteration)."),
+             f_uiNumResults, f_config.uiLayouts, f_config.uiSamples, f_config.dSampleTime * 1e3);
+  }
+  else {
+    VLA_info(_("Bench run: %u tests, %u samples of %.1f ms (ns/iteration)."),
+             f_uiNumResults, f_config.uiSamples, f_config.dSampleTime * 1e3);
+  }
+  for (i = 0 ; i < f_uiNumResults ; i++) {
+    pResult = &f_results[i];
+    if (0 == pResult->uiSamples) {
+      VLA_info(_("  %s:%s not benchmarked (failed)"),
+               pResult->pSuite->pName, pResult->pTest->pName);
+      continue;
+    }
+    if (0.0 != pResult->dInstructions) {
+      VLA_info(_("  %s:%s median %.1f min %.1f mean %.1f sd %.1f (%lu iterations, %.1f instructions)"),
+               pResult->pSuite->pName, pResult->pTest->pName, pResult->dMedian, pResult->dMin,
+               pResult->dMean, pResult->dStdDev, pResult->ulIterations, pResult->dInstructions);
+    }
+    else {
+      VLA_info(_("  %s:%s median %.1f min %.1f mean %.1f sd %.1f (%lu iterations)"),
+               pResult->pSuite->pName, pResult->pTest->pName, pResult->dMedian,
+               pResult->dMin, pResult->dMean, pResult->dStdDev, pResult->ulIterations);
+    }
+    if (0 != pResult->uiLayouts) {
+      VLA_info(_("  %s:%s layouts cause %.0f%% of the variance%s"),
+               pResult->pSuite->pName, pResult->pTest->pName, pResult->dLayoutShare * 100.0,
+               (CU_FALSE != pResult->bLayoutSensitive) ? _(" - layout-sensitive") : "");
+    }
+    if (0.0 != pResult->dSlowdown) {
+      VLA_info(_("  %s:%s %.2fx slower under antagonists (median %.1f)"),
+               pResult->pSuite->pName, pResult->pTest->pName, pResult->dSlowdown, pResult->dLoadedMedian);
+    }
+  }
+}
+
+/** @} */
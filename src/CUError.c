@@ -161,6 +161,11 @@ static const char* get_error_desc(CU_ErrorCode iError)
     N_("Error closing file."),                    /* CUE_FCLOSE_FAILED - 41 */
     N_("Bad file name."),                         /* CUE_BAD_FILENAME - 42 */
     N_("Error during write to file."),            /* CUE_WRITE_ERROR - 43 */
+    N_("Malformed result log record."),           /* CUE_BAD_RESULT_RECORD - 44 */
+    N_("Test library could not be loaded."),      /* CUE_DLOPEN_FAILED - 45 */
+    N_("Malformed baseline file."),               /* CUE_BAD_BASELINE - 46 */
+    N_("Not supported on this platform."),        /* CUE_NOT_SUPPORTED - 47 */
+    N_("Thread could not be created."),           /* CUE_THREAD_FAILED - 48 */
     N_("Undefined Error")
   };
 
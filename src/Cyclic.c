@@ -0,0 +1,286 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Implementation of measuring the jitter of periodic tasks.
+ *
+ *  19-Oct-2026   Initial implementation of cyclic task tests.
+ */
+
+/** @file
+ *  Cyclic task tests (implementation).
+ */
+/** @addtogroup Framework
+ @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#ifdef LINUX
+#include <errno.h>
+#include <setjmp.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "CUnit.h"
+#include "TestRun.h"
+#include "Util.h"
+#include "Cyclic.h"
+#include "VLA_Lite_Log.h"
+#include "CUnit_intl.h"
+
+/*=================================================================
+ *  Global/Static Definitions
+ *=================================================================*/
+#ifdef LINUX
+
+/** Default width of the histogram bins in nanoseconds. */
+#define CYCLIC_DEFAULT_BIN_NS 1000UL
+
+/*=================================================================
+ *  Private function forward declarations
+ *=================================================================*/
+static void run_cycles(const CU_CyclicSpec *pSpec, CU_pCyclicResult pResult);
+static void init_histogram(CU_CyclicHistogram *pHistogram, unsigned long ulBinNs);
+static void add_duration(CU_CyclicHistogram *pHistogram, unsigned long long ullNs);
+static void sleep_until(unsigned long long ullDeadline);
+static void report_histogram(const char *szName, const CU_CyclicHistogram *pHistogram);
+
+/*=================================================================
+ *  Public Interface functions
+ *=================================================================*/
+CU_ErrorCode CU_cyclic_run(const CU_CyclicSpec *pSpec, CU_pCyclicResult pResult)
+{
+  struct sched_param prevParam;
+  struct sched_param param;
+  int iPrevPolicy;
+  unsigned long ulBinNs;
+  CU_pTest pTest;
+  jmp_buf *pRunnerJump;
+  jmp_buf buf;
+
+  assert(NULL != pSpec);
+  assert(NULL != pResult);
+  assert(NULL != pSpec->pBody);
+  assert(0 != pSpec->ulPeriodNs);
+
+  memset(pResult, 0, sizeof(*pResult));
+  ulBinNs = (0 != pSpec->ulBinNs) ? pSpec->ulBinNs : CYCLIC_DEFAULT_BIN_NS;
+  init_histogram(&pResult->latency, ulBinNs);
+  init_histogram(&pResult->execution, ulBinNs);
+
+  pthread_getschedparam(pthread_self(), &iPrevPolicy, &prevParam);
+  if (0 != pSpec->iPriority) {
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = pSpec->iPriority;
+    pResult->bRealtime = (0 == pthread_setschedparam(pthread_self(), SCHED_FIFO, &param)) ? CU_TRUE : CU_FALSE;
+    if (CU_FALSE == pResult->bRealtime) {
+      VLA_info(_("Cyclic test runs without SCHED_FIFO priority %d (not permitted)."), pSpec->iPriority);
+    }
+  }
+
+  /* a fatal assertion in the body comes back here to drop the priority */
+  pTest = CU_get_current_test();
+  pRunnerJump = (NULL != pTest) ? pTest->pJumpBuf : NULL;
+  if (NULL != pTest) {
+    pTest->pJumpBuf = &buf;
+  }
+  if (0 == setjmp(buf)) {
+    run_cycles(pSpec, pResult);
+    if (NULL != pTest) {
+      pTest->pJumpBuf = pRunnerJump;
+    }
+    if (CU_FALSE != pResult->bRealtime) {
+      pthread_setschedparam(pthread_self(), iPrevPolicy, &prevParam);
+    }
+  }
+  else {
+    pTest->pJumpBuf = pRunnerJump;
+    if (CU_FALSE != pResult->bRealtime) {
+      pthread_setschedparam(pthread_self(), iPrevPolicy, &prevParam);
+    }
+    if (NULL != pRunnerJump) {
+      longjmp(*pRunnerJump, 1);
+    }
+  }
+
+  if (0 != pResult->ulCycles) {
+    pResult->latency.dMean /= (double)pResult->ulCycles;
+    pResult->execution.dMean /= (double)pResult->ulCycles;
+  }
+  VLA_info(_("Cyclic test: %lu cycles of %lu ns, %lu deadline misses (%lu deadlines skipped)."),
+           pResult->ulCycles, pSpec->ulPeriodNs, pResult->ulMisses, pResult->ulSkipped);
+  report_histogram(_("wake-up latency"), &pResult->latency);
+  report_histogram(_("execution time"), &pResult->execution);
+
+  CU_set_error(CUE_SUCCESS);
+  return CUE_SUCCESS;
+}
+
+/*------------------------------------------------------------------------*/
+CU_BOOL CU_assertCyclicImplementation(const CU_CyclicSpec *pSpec,
+                                      unsigned int uiLine, const char *strCondition,
+                                      const char *strFile, const char *strFunction,
+                                      CU_BOOL bFatal)
+{
+  CU_CyclicResult result;
+  char szCondition[MAX_NAME_LEN];
+  double dMissRate;
+
+  if (CUE_SUCCESS != CU_cyclic_run(pSpec, &result)) {
+    return CU_assertImplementation(CU_FALSE, uiLine, strCondition, strFile, strFunction, bFatal);
+  }
+
+  dMissRate = (0 != result.ulCycles) ? (double)result.ulMisses / (double)result.ulCycles : 0.0;
+  if ((0 != pSpec->ulMaxJitterNs) && (result.latency.ulMax > pSpec->ulMaxJitterNs)) {
+    snprintf(szCondition, sizeof(szCondition), "jitter %lu ns > %lu ns: %s",
+             result.latency.ulMax, pSpec->ulMaxJitterNs, strCondition);
+    return CU_assertImplementation(CU_FALSE, uiLine, szCondition, strFile, strFunction, bFatal);
+  }
+  if (dMissRate > pSpec->dMaxMissRate) {
+    snprintf(szCondition, sizeof(szCondition), "miss rate %.4g > %.4g: %s",
+             dMissRate, pSpec->dMaxMissRate, strCondition);
+    return CU_assertImplementation(CU_FALSE, uiLine, szCondition, strFile, strFunction, bFatal);
+  }
+  return CU_assertImplementation(CU_TRUE, uiLine, strCondition, strFile, strFunction, bFatal);
+}
+
+/*=================================================================
+ *  Static module functions
+ *=================================================================*/
+/** Runs the cycles of a cyclic test, recording them in pResult. */
+static void run_cycles(const CU_CyclicSpec *pSpec, CU_pCyclicResult pResult)
+{
+  unsigned long long ullDeadline;
+  unsigned long long ullWake;
+  unsigned long long ullEnd;
+  unsigned long ulCycle;
+
+  ullDeadline = CU_get_time_ns() + pSpec->ulPeriodNs;
+  for (ulCycle = 0 ; ulCycle < pSpec->ulCycles ; ulCycle++) {
+    sleep_until(ullDeadline);
+    ullWake = CU_get_time_ns();
+    (*pSpec->pBody)(ulCycle, pSpec->pContext);
+    ullEnd = CU_get_time_ns();
+
+    add_duration(&pResult->latency, (ullWake > ullDeadline) ? ullWake - ullDeadline : 0);
+    add_duration(&pResult->execution, ullEnd - ullWake);
+
+    /* the next deadline stays on the grid of the first one */
+    ullDeadline += pSpec->ulPeriodNs;
+    if (ullEnd > ullDeadline) {
+      pResult->ulMisses++;
+      while (ullEnd > ullDeadline) {
+        ullDeadline += pSpec->ulPeriodNs;
+        pResult->ulSkipped++;
+      }
+    }
+  }
+  pResult->ulCycles = ulCycle;
+}
+
+/*------------------------------------------------------------------------*/
+/** Empties a histogram. */
+static void init_histogram(CU_CyclicHistogram *pHistogram, unsigned long ulBinNs)
+{
+  memset(pHistogram, 0, sizeof(*pHistogram));
+  pHistogram->ulBinNs = ulBinNs;
+  pHistogram->ulMin = (unsigned long)-1;
+}
+
+/*------------------------------------------------------------------------*/
+/** Adds a duration to a histogram; the mean is summed up until the end. */
+static void add_duration(CU_CyclicHistogram *pHistogram, unsigned long long ullNs)
+{
+  unsigned long long ullBin = ullNs / pHistogram->ulBinNs;
+
+  if (ullBin < CU_CYCLIC_BINS) {
+    pHistogram->aulBins[ullBin]++;
+  }
+  else {
+    pHistogram->ulOverflow++;
+  }
+  if (ullNs < pHistogram->ulMin) {
+    pHistogram->ulMin = (unsigned long)ullNs;
+  }
+  if (ullNs > pHistogram->ulMax) {
+    pHistogram->ulMax = (unsigned long)ullNs;
+  }
+  pHistogram->dMean += (double)ullNs;
+}
+
+/*------------------------------------------------------------------------*/
+/** Sleeps until an absolute CLOCK_MONOTONIC time in nanoseconds. */
+static void sleep_until(unsigned long long ullDeadline)
+{
+  struct timespec deadline;
+
+  deadline.tv_sec = (time_t)(ullDeadline / 1000000000ULL);
+  deadline.tv_nsec = (long)(ullDeadline % 1000000000ULL);
+  while (EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL)) {
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/** Prints the statistics and the non-empty bins of a histogram. */
+static void report_histogram(const char *szName, const CU_CyclicHistogram *pHistogram)
+{
+  unsigned int i;
+
+  VLA_info(_("  %s (ns): min %lu mean %.0f max %lu"), szName,
+           (pHistogram->ulMin <= pHistogram->ulMax) ? pHistogram->ulMin : 0UL,
+           pHistogram->dMean, pHistogram->ulMax);
+  for (i = 0 ; i < CU_CYCLIC_BINS ; i++) {
+    if (0 != pHistogram->aulBins[i]) {
+      VLA_info(_("    < %8lu: %lu"), (i + 1) * pHistogram->ulBinNs, pHistogram->aulBins[i]);
+    }
+  }
+  if (0 != pHistogram->ulOverflow) {
+    VLA_info(_("    >= %7lu: %lu"), CU_CYCLIC_BINS * pHistogram->ulBinNs, pHistogram->ulOverflow);
+  }
+}
+
+#else  /* LINUX */
+
+/*=================================================================
+ *  Public Interface functions (not supported)
+ *=================================================================*/
+CU_ErrorCode CU_cyclic_run(const CU_CyclicSpec *pSpec, CU_pCyclicResult pResult)
+{
+  CU_UNREFERENCED_PARAMETER(pSpec);
+  memset(pResult, 0, sizeof(*pResult));
+  CU_set_error(CUE_NOT_SUPPORTED);
+  return CUE_NOT_SUPPORTED;
+}
+
+CU_BOOL CU_assertCyclicImplementation(const CU_CyclicSpec *pSpec,
+                                      unsigned int uiLine, const char *strCondition,
+                                      const char *strFile, const char *strFunction,
+                                      CU_BOOL bFatal)
+{
+  CU_UNREFERENCED_PARAMETER(pSpec);
+  return CU_assertImplementation(CU_FALSE, uiLine, strCondition, strFile, strFunction, bFatal);
+}
+
+#endif /* LINUX */
+
+/** @} */
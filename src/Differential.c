@@ -0,0 +1,546 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Implementation of differential testing of alternative implementations.
+ *
+ *  19-Oct-2026   Initial implementation of differential testing.
+ */
+
+/** @file
+ *  Differential testing (implementation).
+ */
+/** @addtogroup Framework
+ @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <math.h>
+#ifdef LINUX
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#include "CUnit.h"
+#include "TestRun.h"
+#include "Util.h"
+#include "Differential.h"
+#include "VLA_Lite_Log.h"
+#include "CUnit_intl.h"
+
+/*=================================================================
+ *  Global/Static Definitions
+ *=================================================================*/
+/** Alignment of all buffers passed to kernels. */
+#define DIFF_ALIGN 64U
+
+/** Default number of inputs per batch. */
+#define DIFF_DEFAULT_BATCH 64U
+
+/** Elements compared per branch-free (vectorizable) block. */
+#define DIFF_BLOCK 16U
+
+/** State of a worker thread. */
+typedef struct diff_worker
+{
+  unsigned char* pInputs;     /**< Inputs of the current batch. */
+  unsigned char* pOutputs;    /**< Outputs of the batch, per implementation. */
+  unsigned long  ulInputs;    /**< Inputs processed. */
+  double         adNs[CU_DIFFERENTIAL_MAX_IMPLS];  /**< Time spent in each implementation. */
+#ifdef LINUX
+  pthread_t      thread;      /**< The thread (unused for worker 0). */
+#endif
+} diff_worker;
+
+static unsigned char f_aArena[CU_DIFFERENTIAL_ARENA_SIZE + DIFF_ALIGN];  /**< Buffers of a test. */
+static diff_worker   f_workers[CU_DIFFERENTIAL_MAX_THREADS];
+
+static const CU_DifferentialSpec* f_pSpec = NULL;  /**< Test being run. */
+static size_t         f_nInputStride = 0;          /**< Aligned bytes per input. */
+static size_t         f_nOutputStride = 0;         /**< Aligned bytes per output. */
+static unsigned int   f_uiBatch = 0;               /**< Inputs per batch. */
+static unsigned char* f_pShrinkInput = NULL;       /**< Input being shrunk. */
+static unsigned char* f_pShrinkCandidate = NULL;   /**< Candidate of the shrinker. */
+static unsigned char* f_pShrinkOutputs = NULL;     /**< Outputs of a candidate, per implementation. */
+
+static unsigned long  f_ulNextInput = 0;           /**< Next input to hand out. */
+static unsigned long  f_ulFirstDivergent = 0;      /**< Lowest divergent input, ulInputs if none. */
+#ifdef LINUX
+static pthread_mutex_t f_diff_lock = PTHREAD_MUTEX_INITIALIZER;  /**< Protects the two above. */
+#endif
+
+/*=================================================================
+ *  Private function forward declarations
+ *=================================================================*/
+static CU_ErrorCode  layout_buffers(unsigned int *puiThreads);
+static void*         worker_main(void *pArg);
+static CU_BOOL       next_batch(unsigned long *pulStart, unsigned long *pulEnd);
+static void          record_divergence(unsigned long ulInput);
+static unsigned long long input_seed(unsigned long ulInput);
+static CU_BOOL       outputs_diverge(const void *pRef, const void *pOut, size_t *pnElement);
+static CU_BOOL       doubles_diverge(const double *pdRef, const double *pdOut, size_t nCount, size_t *pnElement);
+static CU_BOOL       floats_diverge(const float *pfRef, const float *pfOut, size_t nCount, size_t *pnElement);
+static CU_BOOL       input_diverges(const void *pInput, unsigned int *puiImpl, size_t *pnElement);
+static void          shrink_input(CU_pDifferentialResult pResult);
+static void          report_throughput(const CU_DifferentialResult *pResult, unsigned int uiThreads);
+
+/*=================================================================
+ *  Public Interface functions
+ *=================================================================*/
+CU_ErrorCode CU_differential_run(const CU_DifferentialSpec *pSpec, CU_pDifferentialResult pResult)
+{
+  CU_ErrorCode result;
+  FILE *pFile;
+  unsigned int uiThreads;
+  unsigned int uiStarted = 1;
+  unsigned int i;
+  unsigned int k;
+
+  assert(NULL != pSpec);
+  assert(NULL != pResult);
+  assert(NULL != pSpec->pGenerator);
+
+  memset(pResult, 0, sizeof(*pResult));
+  if ((pSpec->uiImpls < 2) || (pSpec->uiImpls > CU_DIFFERENTIAL_MAX_IMPLS)) {
+    CU_set_error(CUE_NOMEMORY);
+    return CUE_NOMEMORY;
+  }
+
+  f_pSpec = pSpec;
+  if (CUE_SUCCESS != (result = layout_buffers(&uiThreads))) {
+    CU_set_error(result);
+    return result;
+  }
+  f_ulNextInput = 0;
+  f_ulFirstDivergent = pSpec->ulInputs;
+
+#ifdef LINUX
+  for ( ; uiStarted < uiThreads ; uiStarted++) {
+    if (0 != pthread_create(&f_workers[uiStarted].thread, NULL, worker_main, &f_workers[uiStarted])) {
+      break;                               /* the started workers take over the inputs */
+    }
+  }
+#endif
+  worker_main(&f_workers[0]);
+#ifdef LINUX
+  for (i = 1 ; i < uiStarted ; i++) {
+    pthread_join(f_workers[i].thread, NULL);
+  }
+#endif
+
+  for (i = 0 ; i < uiStarted ; i++) {
+    pResult->ulInputs += f_workers[i].ulInputs;
+    for (k = 0 ; k < pSpec->uiImpls ; k++) {
+      pResult->adNsPerInput[k] += f_workers[i].adNs[k];
+    }
+  }
+  for (k = 0 ; (k < pSpec->uiImpls) && (0 != pResult->ulInputs) ; k++) {
+    pResult->adNsPerInput[k] /= (double)pResult->ulInputs;
+  }
+  report_throughput(pResult, uiStarted);
+
+  if (f_ulFirstDivergent < pSpec->ulInputs) {
+    pResult->bDiverged = CU_TRUE;
+    pResult->ulFirstDivergent = f_ulFirstDivergent;
+    shrink_input(pResult);
+    VLA_error(_("%s diverges from %s at output element %lu of input %lu (%u shrink steps)."),
+              pSpec->aImpls[pResult->uiImpl].szName, pSpec->aImpls[0].szName,
+              (unsigned long)pResult->nElement, pResult->ulFirstDivergent, pResult->uiShrinkSteps);
+
+    if (NULL != pSpec->szSaveFile) {
+      if ((NULL == (pFile = fopen(pSpec->szSaveFile, "wb"))) ||
+          (1 != fwrite(f_pShrinkInput, pSpec->nInputSize, 1, pFile)) ||
+          (0 != fclose(pFile))) {
+        result = CUE_FOPEN_FAILED;
+      }
+    }
+  }
+
+  f_pSpec = NULL;
+  CU_set_error(result);
+  return result;
+}
+
+/*------------------------------------------------------------------------*/
+unsigned long long CU_differential_next(unsigned long long *pullState)
+{
+  unsigned long long ullZ;
+
+  assert(NULL != pullState);
+
+  ullZ = (*pullState += 0x9E3779B97F4A7C15ULL);
+  ullZ = (ullZ ^ (ullZ >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  ullZ = (ullZ ^ (ullZ >> 27)) * 0x94D049BB133111EBULL;
+  return ullZ ^ (ullZ >> 31);
+}
+
+/*------------------------------------------------------------------------*/
+CU_BOOL CU_assertDifferentialImplementation(const CU_DifferentialSpec *pSpec,
+                                            unsigned int uiLine, const char *strCondition,
+                                            const char *strFile, const char *strFunction,
+                                            CU_BOOL bFatal)
+{
+  CU_DifferentialResult result;
+  char szCondition[MAX_NAME_LEN];
+  CU_ErrorCode error;
+
+  error = CU_differential_run(pSpec, &result);
+  if (CU_FALSE != result.bDiverged) {
+    snprintf(szCondition, sizeof(szCondition), "%s != %s at [%lu] of input %lu: %s",
+             pSpec->aImpls[result.uiImpl].szName, pSpec->aImpls[0].szName,
+             (unsigned long)result.nElement, result.ulFirstDivergent, strCondition);
+    return CU_assertImplementation(CU_FALSE, uiLine, szCondition, strFile, strFunction, bFatal);
+  }
+  return CU_assertImplementation((CUE_SUCCESS == error) ? CU_TRUE : CU_FALSE,
+                                 uiLine, strCondition, strFile, strFunction, bFatal);
+}
+
+/*=================================================================
+ *  Static module functions
+ *=================================================================*/
+/**
+ *  Splits the arena into the shrink buffers and one batch region per
+ *  worker, lowering the batch size and the number of workers as needed.
+ */
+static CU_ErrorCode layout_buffers(unsigned int *puiThreads)
+{
+  unsigned char *pBase = f_aArena + ((DIFF_ALIGN - ((size_t)f_aArena % DIFF_ALIGN)) % DIFF_ALIGN);
+  size_t nShrink;
+  size_t nRegion;
+  size_t nPerInput;
+  unsigned long ulBatches;
+  unsigned int uiThreads = f_pSpec->uiThreads;
+  unsigned int i;
+
+  f_nInputStride = (f_pSpec->nInputSize + DIFF_ALIGN - 1) / DIFF_ALIGN * DIFF_ALIGN;
+  f_nOutputStride = (f_pSpec->nOutputSize + DIFF_ALIGN - 1) / DIFF_ALIGN * DIFF_ALIGN;
+  if (0 == f_nInputStride) {
+    f_nInputStride = DIFF_ALIGN;
+  }
+  if (0 == f_nOutputStride) {
+    f_nOutputStride = DIFF_ALIGN;
+  }
+  nPerInput = f_nInputStride + f_pSpec->uiImpls * f_nOutputStride;
+  nShrink = f_nInputStride + nPerInput;
+  if (nShrink + nPerInput > CU_DIFFERENTIAL_ARENA_SIZE) {
+    return CUE_NOMEMORY;
+  }
+
+  f_uiBatch = (0 != f_pSpec->uiBatch) ? f_pSpec->uiBatch : DIFF_DEFAULT_BATCH;
+#ifdef LINUX
+  if (0 == uiThreads) {
+    uiThreads = (unsigned int)sysconf(_SC_NPROCESSORS_ONLN);
+  }
+#else
+  uiThreads = 1;
+#endif
+  if ((0 == uiThreads) || (uiThreads > CU_DIFFERENTIAL_MAX_THREADS)) {
+    uiThreads = (0 == uiThreads) ? 1 : CU_DIFFERENTIAL_MAX_THREADS;
+  }
+  ulBatches = (f_pSpec->ulInputs + f_uiBatch - 1) / f_uiBatch;
+  if ((unsigned long)uiThreads > ulBatches) {
+    uiThreads = (0 != ulBatches) ? (unsigned int)ulBatches : 1;
+  }
+
+  for (;;) {
+    nRegion = (CU_DIFFERENTIAL_ARENA_SIZE - nShrink) / uiThreads;
+    if (nRegion >= nPerInput) {
+      break;
+    }
+    uiThreads--;
+  }
+  if ((size_t)f_uiBatch > nRegion / nPerInput) {
+    f_uiBatch = (unsigned int)(nRegion / nPerInput);
+  }
+
+  f_pShrinkInput = pBase;
+  f_pShrinkCandidate = pBase + f_nInputStride;
+  f_pShrinkOutputs = f_pShrinkCandidate + f_nInputStride;
+  pBase += nShrink;
+  for (i = 0 ; i < uiThreads ; i++) {
+    memset(&f_workers[i], 0, sizeof(f_workers[i]));
+    f_workers[i].pInputs = pBase;
+    f_workers[i].pOutputs = pBase + (size_t)f_uiBatch * f_nInputStride;
+    pBase += (size_t)f_uiBatch * nPerInput;
+  }
+
+  *puiThreads = uiThreads;
+  return CUE_SUCCESS;
+}
+
+/*------------------------------------------------------------------------*/
+/** Processes batches until all inputs are handed out or one diverged. */
+static void* worker_main(void *pArg)
+{
+  diff_worker *pWorker = (diff_worker*)pArg;
+  const CU_DifferentialSpec *pSpec = f_pSpec;
+  unsigned long ulStart;
+  unsigned long ulEnd;
+  unsigned long long ullStart;
+  size_t nElement;
+  size_t nBatchOutputs = (size_t)f_uiBatch * f_nOutputStride;
+  unsigned int uiCount;
+  unsigned int i;
+  unsigned int k;
+
+  while (CU_FALSE != next_batch(&ulStart, &ulEnd)) {
+    uiCount = (unsigned int)(ulEnd - ulStart);
+    for (i = 0 ; i < uiCount ; i++) {
+      (*pSpec->pGenerator)(input_seed(ulStart + i), pWorker->pInputs + i * f_nInputStride);
+    }
+
+    /* each implementation runs on the whole batch, timed as a block */
+    for (k = 0 ; k < pSpec->uiImpls ; k++) {
+      ullStart = CU_get_time_ns();
+      for (i = 0 ; i < uiCount ; i++) {
+        (*pSpec->aImpls[k].pKernel)(pWorker->pInputs + i * f_nInputStride,
+                                    pWorker->pOutputs + k * nBatchOutputs + i * f_nOutputStride);
+      }
+      pWorker->adNs[k] += (double)(CU_get_time_ns() - ullStart);
+    }
+    pWorker->ulInputs += uiCount;
+
+    for (i = 0 ; i < uiCount ; i++) {
+      for (k = 1 ; k < pSpec->uiImpls ; k++) {
+        if (CU_FALSE != outputs_diverge(pWorker->pOutputs + i * f_nOutputStride,
+                                        pWorker->pOutputs + k * nBatchOutputs + i * f_nOutputStride,
+                                        &nElement)) {
+          record_divergence(ulStart + i);
+          break;
+        }
+      }
+      if (k < pSpec->uiImpls) {
+        break;
+      }
+    }
+  }
+
+  return NULL;
+}
+
+/*------------------------------------------------------------------------*/
+/** Hands out the next batch, stopping at the first divergent input. */
+static CU_BOOL next_batch(unsigned long *pulStart, unsigned long *pulEnd)
+{
+  CU_BOOL bBatch = CU_FALSE;
+
+#ifdef LINUX
+  pthread_mutex_lock(&f_diff_lock);
+#endif
+  if (f_ulNextInput < f_ulFirstDivergent) {
+    *pulStart = f_ulNextInput;
+    *pulEnd = (f_ulFirstDivergent - f_ulNextInput > f_uiBatch) ? f_ulNextInput + f_uiBatch : f_ulFirstDivergent;
+    f_ulNextInput = *pulEnd;
+    bBatch = CU_TRUE;
+  }
+#ifdef LINUX
+  pthread_mutex_unlock(&f_diff_lock);
+#endif
+  return bBatch;
+}
+
+/*------------------------------------------------------------------------*/
+static void record_divergence(unsigned long ulInput)
+{
+#ifdef LINUX
+  pthread_mutex_lock(&f_diff_lock);
+#endif
+  if (ulInput < f_ulFirstDivergent) {
+    f_ulFirstDivergent = ulInput;
+  }
+#ifdef LINUX
+  pthread_mutex_unlock(&f_diff_lock);
+#endif
+}
+
+/*------------------------------------------------------------------------*/
+/** Derives the generator seed of an input from the seed of the test. */
+static unsigned long long input_seed(unsigned long ulInput)
+{
+  unsigned long long ullState = f_pSpec->ullSeed ^ ((unsigned long long)ulInput * 0xD1B54A32D192ED03ULL);
+
+  return CU_differential_next(&ullState);
+}
+
+/*------------------------------------------------------------------------*/
+/** Compares an output with the reference output. */
+static CU_BOOL outputs_diverge(const void *pRef, const void *pOut, size_t *pnElement)
+{
+  const unsigned char *pcRef = (const unsigned char*)pRef;
+  const unsigned char *pcOut = (const unsigned char*)pOut;
+  size_t i;
+
+  switch (f_pSpec->eElement) {
+    case CUDE_Float:
+      return floats_diverge((const float*)pRef, (const float*)pOut,
+                            f_pSpec->nOutputSize / sizeof(float), pnElement);
+    case CUDE_Double:
+      return doubles_diverge((const double*)pRef, (const double*)pOut,
+                             f_pSpec->nOutputSize / sizeof(double), pnElement);
+    default:
+      if (0 == memcmp(pRef, pOut, f_pSpec->nOutputSize)) {
+        return CU_FALSE;
+      }
+      for (i = 0 ; pcRef[i] == pcOut[i] ; i++) {
+      }
+      *pnElement = i;
+      return CU_TRUE;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Compares arrays of doubles within the tolerances.  Blocks are checked
+ *  without branches so that the compiler can vectorize the check; only a
+ *  failing block is searched element by element.  Equal values (also
+ *  infinities) and two NaNs agree.
+ */
+static CU_BOOL doubles_diverge(const double *pdRef, const double *pdOut, size_t nCount, size_t *pnElement)
+{
+  double dAbs = f_pSpec->dAbsTolerance;
+  double dRel = f_pSpec->dRelTolerance;
+  size_t nEnd;
+  size_t i;
+  size_t j;
+  int iBad;
+
+  for (i = 0 ; i < nCount ; i = nEnd) {
+    nEnd = (nCount - i > DIFF_BLOCK) ? i + DIFF_BLOCK : nCount;
+    iBad = 0;
+    for (j = i ; j < nEnd ; j++) {
+      iBad |= !(fabs(pdOut[j] - pdRef[j]) <= dAbs + dRel * fmax(fabs(pdRef[j]), fabs(pdOut[j])));
+    }
+    if (0 == iBad) {
+      continue;
+    }
+    for (j = i ; j < nEnd ; j++) {
+      if (!(fabs(pdOut[j] - pdRef[j]) <= dAbs + dRel * fmax(fabs(pdRef[j]), fabs(pdOut[j]))) &&
+          (pdOut[j] != pdRef[j]) && !(isnan(pdOut[j]) && isnan(pdRef[j]))) {
+        *pnElement = j;
+        return CU_TRUE;
+      }
+    }
+  }
+  return CU_FALSE;
+}
+
+/*------------------------------------------------------------------------*/
+/** Compares arrays of floats within the tolerances (see doubles_diverge()). */
+static CU_BOOL floats_diverge(const float *pfRef, const float *pfOut, size_t nCount, size_t *pnElement)
+{
+  float fAbs = (float)f_pSpec->dAbsTolerance;
+  float fRel = (float)f_pSpec->dRelTolerance;
+  size_t nEnd;
+  size_t i;
+  size_t j;
+  int iBad;
+
+  for (i = 0 ; i < nCount ; i = nEnd) {
+    nEnd = (nCount - i > DIFF_BLOCK) ? i + DIFF_BLOCK : nCount;
+    iBad = 0;
+    for (j = i ; j < nEnd ; j++) {
+      iBad |= !(fabsf(pfOut[j] - pfRef[j]) <= fAbs + fRel * fmaxf(fabsf(pfRef[j]), fabsf(pfOut[j])));
+    }
+    if (0 == iBad) {
+      continue;
+    }
+    for (j = i ; j < nEnd ; j++) {
+      if (!(fabsf(pfOut[j] - pfRef[j]) <= fAbs + fRel * fmaxf(fabsf(pfRef[j]), fabsf(pfOut[j]))) &&
+          (pfOut[j] != pfRef[j]) && !(isnan(pfOut[j]) && isnan(pfRef[j]))) {
+        *pnElement = j;
+        return CU_TRUE;
+      }
+    }
+  }
+  return CU_FALSE;
+}
+
+/*------------------------------------------------------------------------*/
+/** Runs all implementations on one input and compares their outputs. */
+static CU_BOOL input_diverges(const void *pInput, unsigned int *puiImpl, size_t *pnElement)
+{
+  unsigned int k;
+
+  for (k = 0 ; k < f_pSpec->uiImpls ; k++) {
+    (*f_pSpec->aImpls[k].pKernel)(pInput, f_pShrinkOutputs + k * f_nOutputStride);
+  }
+  for (k = 1 ; k < f_pSpec->uiImpls ; k++) {
+    if (CU_FALSE != outputs_diverge(f_pShrinkOutputs, f_pShrinkOutputs + k * f_nOutputStride, pnElement)) {
+      *puiImpl = k;
+      return CU_TRUE;
+    }
+  }
+  return CU_FALSE;
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Regenerates the first divergent input into f_pShrinkInput and shrinks
+ *  it greedily: the first candidate that still diverges replaces it and
+ *  the shrinker starts over from its first candidate.
+ */
+static void shrink_input(CU_pDifferentialResult pResult)
+{
+  unsigned int uiCandidate = 0;
+  unsigned int uiTries;
+  unsigned int uiImpl;
+  size_t nElement;
+
+  (*f_pSpec->pGenerator)(input_seed(pResult->ulFirstDivergent), f_pShrinkInput);
+  if (CU_FALSE == input_diverges(f_pShrinkInput, &pResult->uiImpl, &pResult->nElement)) {
+    pResult->uiImpl = 1;                   /* not reproducible - report the first alternative */
+    return;
+  }
+  if (NULL == f_pSpec->pShrinker) {
+    return;
+  }
+
+  for (uiTries = 0 ; uiTries < CU_DIFFERENTIAL_MAX_SHRINKS ; uiTries++) {
+    if (CU_FALSE == (*f_pSpec->pShrinker)(f_pShrinkInput, uiCandidate, f_pShrinkCandidate)) {
+      break;
+    }
+    if (CU_FALSE != input_diverges(f_pShrinkCandidate, &uiImpl, &nElement)) {
+      memcpy(f_pShrinkInput, f_pShrinkCandidate, f_pSpec->nInputSize);
+      pResult->uiImpl = uiImpl;
+      pResult->nElement = nElement;
+      pResult->uiShrinkSteps++;
+      uiCandidate = 0;
+    }
+    else {
+      uiCandidate++;
+    }
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/** Prints the time per input of each implementation. */
+static void report_throughput(const CU_DifferentialResult *pResult, unsigned int uiThreads)
+{
+  unsigned int k;
+
+  VLA_info(_("Differential test: %lu inputs on %u threads."), pResult->ulInputs, uiThreads);
+  for (k = 0 ; k < f_pSpec->uiImpls ; k++) {
+    VLA_info(_("  %-20s %10.1f ns/input %6.2fx"), f_pSpec->aImpls[k].szName, pResult->adNsPerInput[k],
+             (0.0 < pResult->adNsPerInput[k]) ? pResult->adNsPerInput[0] / pResult->adNsPerInput[k] : 0.0);
+  }
+}
+
+/** @} */
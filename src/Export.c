@@ -0,0 +1,1340 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Implementation of compact result log export.
+ *
+ *  19-Oct-2026   Initial implementation of compact result export.
+ */
+
+/** @file
+ *  Compact result log export (implementation).
+ */
+/** @addtogroup Framework
+ @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#ifdef LINUX
+#include <unistd.h>
+#endif
+
+#include "CUnit.h"
+#include "TestDB.h"
+#include "TestRun.h"
+#include "Export.h"
+#include "AsyncOutput.h"
+#include "Util.h"
+#include "CUnit_intl.h"
+
+/*=================================================================
+ *  Global/Static Definitions
+ *=================================================================*/
+/** Maximum length of a result log line (including newline and NULL). */
+#define RESULT_LINE_LENGTH (4 * MAX_NAME_LEN + 256)
+/** Maximum number of fields in a result log line. */
+#define RESULT_MAX_FIELDS  12
+
+/** Outcome markers, indexed by CU_TestOutcome. */
+static const char f_outcome_chars[] = { '-', 'P', 'F', 'I' };
+
+/** Stream receiving the result log during runs, NULL if not streaming. */
+static CU_pAsyncStream f_pStream = NULL;
+/** stdio adapter of f_pStream. */
+static FILE* f_pStreamFile = NULL;
+/** Suite last streamed, and the registration index of its first test. */
+static CU_pSuite f_pStreamSuite = NULL;
+static unsigned int f_uiStreamSuiteIndex = 0;
+/** Test last streamed within f_pStreamSuite, and its registration index. */
+static CU_pTest f_pStreamTest = NULL;
+static unsigned int f_uiStreamTestIndex = 0;
+/** Last failure records scanned for streamed tests and suites, NULL for none. */
+static CU_pFailureRecord f_pStreamTestMark = NULL;
+static CU_pFailureRecord f_pStreamSuiteMark = NULL;
+
+/** A log being merged. */
+typedef struct merge_input
+{
+  FILE*           file;          /**< Log, NULL after its summary or end. */
+  unsigned int    uiLog;         /**< Position of the log in the merge. */
+  CU_ResultRecord head;          /**< Next record of the log. */
+  CU_BOOL         bHead;         /**< Whether head holds a record. */
+  CU_BOOL         bSkipping;     /**< Whether failures of a duplicated test are dropped. */
+  unsigned int    uiSkipIndex;   /**< Index of the duplicated test. */
+} merge_input;
+
+static merge_input f_merge_inputs[CU_MERGE_MAX_LOGS];
+
+/** Expected noise of deltas compared by CU_diff_result_logs(). */
+#define DIFF_TIME_NOISE     0.001
+#define DIFF_TIME_NOISE_REL 0.1
+#define DIFF_HEAP_NOISE     256.0
+
+/** A test of a log being compared. */
+typedef struct diff_test
+{
+  char           strSuiteName[MAX_NAME_LEN];
+  char           strTestName[MAX_NAME_LEN];
+  CU_TestOutcome eOutcome;
+  unsigned int   uiNumberOfAsserts;
+  double         dWallTime;
+  long           lHeapGrowth;
+  CU_BOOL        bMatched;       /**< Already compared with a moved test of the other log. */
+} diff_test;
+
+/** Lookahead window of a log being compared. */
+typedef struct diff_side
+{
+  FILE*        file;                       /**< Log, NULL after its summary or end. */
+  diff_test    aWindow[CU_DIFF_WINDOW];    /**< Ring buffer of the next tests. */
+  unsigned int uiFirst;                    /**< Position of the next test in aWindow. */
+  unsigned int uiCount;                    /**< Number of tests in aWindow. */
+} diff_side;
+
+static diff_side f_diff_sides[2];
+
+/*=================================================================
+ *  Private function forward declarations
+ *=================================================================*/
+static void         write_field(FILE *file, const char *szField);
+static CU_ErrorCode export_failures(FILE *file, CU_pFailureRecord pFirst,
+                                    CU_pSuite pSuite, CU_pTest pTest, unsigned int uiIndex);
+static CU_ErrorCode export_header(FILE *file, CU_pTestRegistry pRegistry);
+static CU_ErrorCode export_test(FILE *file, CU_pFailureRecord pFirst,
+                                CU_pSuite pSuite, CU_pTest pTest, unsigned int uiIndex);
+static CU_ErrorCode export_summary(FILE *file);
+static unsigned int registry_index(CU_pSuite pSuite, CU_pTest pTest);
+static unsigned int stream_index(CU_pSuite pSuite, CU_pTest pTest);
+static CU_pFailureRecord stream_failures(CU_pFailureRecord pMark);
+static CU_pFailureRecord last_failure(CU_pFailureRecord pMark);
+static CU_BOOL      suite_init_failed(CU_pFailureRecord pFirst, CU_pSuite pSuite);
+static CU_ErrorCode export_not_run(FILE *file, CU_pFailureRecord pFirst,
+                                   CU_pSuite pSuite, unsigned int uiIndex);
+static unsigned int split_fields(char *szLine, char *aszFields[]);
+static void         copy_field(char *szDest, const char *szSrc);
+static CU_BOOL      parse_outcome(const char *szField, CU_TestOutcome *pOutcome);
+static CU_ErrorCode merge_advance(merge_input *pInput, CU_pMergeSummary pMerge);
+static unsigned long merge_key(const CU_ResultRecord *pRecord);
+static void         merge_report_missing(unsigned int uiFirst, unsigned int uiLast, CU_pMergeSummary pMerge);
+static CU_ErrorCode merge_emit(FILE *pOutput, CU_MergeRecordHandler pHandler, const CU_ResultRecord *pRecord);
+static CU_ErrorCode diff_fill(diff_side *pSide);
+static diff_test*   diff_at(diff_side *pSide, unsigned int uiPos);
+static unsigned int diff_find(diff_side *pSide, const diff_test *pTest);
+static void         diff_pop(diff_side *pSide, diff_side *pOther, CU_DiffType type,
+                             CU_DiffHandler pHandler, CU_pDiffSummary pDiff);
+static void         diff_compare(const diff_test *pBefore, const diff_test *pAfter,
+                                 CU_DiffHandler pHandler, CU_pDiffSummary pDiff);
+static void         diff_add_delta(CU_DiffType type, const diff_test *pTest, double dBefore,
+                                   double dAfter, double dNoise, CU_pDiffSummary pDiff);
+static int          diff_compare_significance(const void *pA, const void *pB);
+
+/*=================================================================
+ *  Public Interface functions
+ *=================================================================*/
+CU_ErrorCode CU_export_run_results(FILE *file)
+{
+  CU_pTestRegistry pRegistry = CU_get_registry();
+  CU_pSuite pSuite = NULL;
+  CU_pTest pTest = NULL;
+  unsigned int uiIndex = 0;
+  CU_ErrorCode result = CUE_SUCCESS;
+
+  assert(NULL != file);
+
+  if (NULL == pRegistry) {
+    CU_set_error(CUE_NOREGISTRY);
+    return CUE_NOREGISTRY;
+  }
+
+  result = export_header(file, pRegistry);
+
+  for (pSuite = pRegistry->pSuite ; (NULL != pSuite) && (CUE_SUCCESS == result) ; pSuite = pSuite->pNext) {
+    if (CU_FALSE != suite_init_failed(CU_get_failure_list(), pSuite)) {
+      result = export_not_run(file, CU_get_failure_list(), pSuite, uiIndex);
+      uiIndex += pSuite->uiNumberOfTests;
+    }
+    else {
+      for (pTest = pSuite->pTest ; (NULL != pTest) && (CUE_SUCCESS == result) ; pTest = pTest->pNext, uiIndex++) {
+        if (CUTO_NotRun == pTest->eOutcome) {
+          continue;
+        }
+        result = export_test(file, CU_get_failure_list(), pSuite, pTest, uiIndex);
+      }
+    }
+
+    /* suite failures follow the tests, as in a streamed log */
+    if (CUE_SUCCESS == result) {
+      result = export_failures(file, CU_get_failure_list(), pSuite, NULL, uiIndex);
+    }
+  }
+
+  if (CUE_SUCCESS == result) {
+    result = export_summary(file);
+  }
+
+  if ((CUE_SUCCESS == result) && (0 != fflush(file))) {
+    result = CUE_WRITE_ERROR;
+  }
+
+  CU_set_error(result);
+  return result;
+}
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_export_stream_results(int fd)
+{
+  CU_ErrorCode result = CUE_SUCCESS;
+
+  assert(CU_FALSE == CU_is_test_running());
+
+  if (NULL != f_pStream) {
+    result = CU_async_close(f_pStream);
+    f_pStream = NULL;
+    f_pStreamFile = NULL;
+  }
+
+  if (0 <= fd) {
+    if (NULL == (f_pStream = CU_async_open(fd))) {
+      result = CU_get_error();
+    }
+    else if (NULL == (f_pStreamFile = CU_async_file(f_pStream))) {
+      CU_async_close(f_pStream);
+      f_pStream = NULL;
+      result = CUE_FOPEN_FAILED;
+    }
+  }
+
+  CU_set_error(result);
+  return result;
+}
+
+/*------------------------------------------------------------------------*/
+void CU_export_stream_run_start(void)
+{
+  f_pStreamSuite = NULL;
+  f_pStreamTest = NULL;
+  f_pStreamTestMark = NULL;
+  f_pStreamSuiteMark = NULL;
+
+  if (NULL != f_pStreamFile) {
+    export_header(f_pStreamFile, CU_get_registry());
+    fflush(f_pStreamFile);
+    CU_async_flush(f_pStream);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+void CU_export_stream_test(CU_pSuite pSuite, CU_pTest pTest)
+{
+  unsigned int uiIndex;
+
+  if (NULL != f_pStreamFile) {
+    /* only failures recorded since the previous streamed test can be this test's */
+    uiIndex = stream_index(pSuite, pTest);
+    export_test(f_pStreamFile, stream_failures(f_pStreamTestMark), pSuite, pTest, uiIndex);
+    f_pStreamTestMark = last_failure(f_pStreamTestMark);
+    fflush(f_pStreamFile);
+    CU_async_flush(f_pStream);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+void CU_export_stream_suite(CU_pSuite pSuite)
+{
+  unsigned int uiIndex;
+  CU_pFailureRecord pFirst;
+
+  if (NULL != f_pStreamFile) {
+    /* only failures recorded since the previous streamed suite can be this suite's */
+    uiIndex = stream_index(pSuite, NULL);
+    pFirst = stream_failures(f_pStreamSuiteMark);
+    if (CU_FALSE != suite_init_failed(pFirst, pSuite)) {
+      export_not_run(f_pStreamFile, pFirst, pSuite, uiIndex);
+    }
+    export_failures(f_pStreamFile, pFirst, pSuite, NULL, uiIndex + pSuite->uiNumberOfTests);
+    f_pStreamSuiteMark = last_failure(f_pStreamSuiteMark);
+    f_pStreamTestMark = f_pStreamSuiteMark;
+    fflush(f_pStreamFile);
+    CU_async_flush(f_pStream);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+void CU_export_stream_run_complete(void)
+{
+  if (NULL != f_pStreamFile) {
+    export_summary(f_pStreamFile);
+    if (CUE_SUCCESS != CU_async_barrier(f_pStream)) {
+      VLA_error(_("Unable to stream results, the result log is incomplete."));
+    }
+  }
+}
+
+/*------------------------------------------------------------------------*/
+void CU_export_requested_results(void)
+{
+#ifdef LINUX
+  const char *szFd = getenv(CU_RESULT_FD_ENV);
+  FILE *file = NULL;
+  int fd;
+
+  if ((NULL == szFd) || ('\0' == *szFd)) {
+    return;
+  }
+
+  /* write through a duplicate so that repeated runs can export again */
+  fd = dup(atoi(szFd));
+  if ((fd < 0) || (NULL == (file = fdopen(fd, "w")))) {
+    if (fd >= 0) {
+      close(fd);
+    }
+    VLA_error(_("Unable to export results to descriptor %s."), szFd);
+    CU_set_error(CUE_FOPEN_FAILED);
+    return;
+  }
+
+  CU_export_run_results(file);
+  if (0 != fclose(file)) {
+    CU_set_error(CUE_FCLOSE_FAILED);
+  }
+#endif
+}
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_write_result_record(FILE *file, const CU_ResultRecord *pRecord)
+{
+  const CU_RunSummary *pSummary = NULL;
+
+  assert(NULL != file);
+  assert(NULL != pRecord);
+
+  switch (pRecord->type) {
+    case CURR_Header:
+      fprintf(file, "H\t%u\t", pRecord->uiVersion);
+      write_field(file, pRecord->summary.PackageName);
+      fprintf(file, "\t%u\t%u\n", pRecord->uiNumberOfSuites, pRecord->uiNumberOfTests);
+      break;
+
+    case CURR_Test:
+      fprintf(file, "T\t%u\t", pRecord->uiIndex);
+      write_field(file, pRecord->strSuiteName);
+      fputc('\t', file);
+      write_field(file, pRecord->strTestName);
+      fprintf(file, "\t%c\t%u\t%u\t%.6f\t%ld\t%.6f\n",
+              f_outcome_chars[(unsigned int)pRecord->eOutcome % sizeof(f_outcome_chars)],
+              pRecord->uiNumberOfAsserts,
+              pRecord->uiNumberOfAssertsFailed,
+              pRecord->dElapsedTime,
+              pRecord->lHeapGrowth,
+              pRecord->dWallTime);
+      break;
+
+    case CURR_Failure:
+      fprintf(file, "F\t%u\t", pRecord->uiIndex);
+      write_field(file, pRecord->strSuiteName);
+      fputc('\t', file);
+      write_field(file, pRecord->strTestName);
+      fprintf(file, "\t%d\t%u\t", (int)pRecord->eFailureType, pRecord->uiLineNumber);
+      write_field(file, pRecord->strFileName);
+      fputc('\t', file);
+      write_field(file, pRecord->strCondition);
+      if (CU_TRUE == pRecord->fStatistic) {
+        fprintf(file, "\t%.17g\t%.17g", pRecord->dStatistic, pRecord->dPValue);
+      }
+      fputc('\n', file);
+      break;
+
+    case CURR_Summary:
+      pSummary = &pRecord->summary;
+      fprintf(file, "R\t%u\t%u\t%u\t%u\t%u\t%u\t%u\t%u\t%u\t%.6f\n",
+              pSummary->nSuitesRun, pSummary->nSuitesFailed, pSummary->nSuitesInactive,
+              pSummary->nTestsRun, pSummary->nTestsFailed, pSummary->nTestsInactive,
+              pSummary->nAsserts, pSummary->nAssertsFailed, pSummary->nFailureRecords,
+              pSummary->ElapsedTime);
+      break;
+
+    default:
+      break;
+  }
+
+  return (0 != ferror(file)) ? CUE_WRITE_ERROR : CUE_SUCCESS;
+}
+
+/*------------------------------------------------------------------------*/
+CU_BOOL CU_read_result_record(FILE *file, CU_pResultRecord pRecord)
+{
+  static char szLine[RESULT_LINE_LENGTH];
+  char *aszFields[RESULT_MAX_FIELDS];
+  unsigned int nFields = 0;
+  size_t len;
+  int c;
+
+  assert(NULL != file);
+  assert(NULL != pRecord);
+
+  CU_set_error(CUE_SUCCESS);
+
+  do {
+    if (NULL == fgets(szLine, RESULT_LINE_LENGTH, file)) {
+      return CU_FALSE;
+    }
+    len = strlen(szLine);
+    if ((0 < len) && ('\n' != szLine[len - 1]) && (0 == feof(file))) {
+      /* overlong line - discard the remainder and report it */
+      while ((EOF != (c = fgetc(file))) && ('\n' != c)) {
+      }
+      CU_set_error(CUE_BAD_RESULT_RECORD);
+      return CU_FALSE;
+    }
+    while ((0 < len) && (('\n' == szLine[len - 1]) || ('\r' == szLine[len - 1]))) {
+      szLine[--len] = '\0';
+    }
+  } while (0 == len);
+
+  memset(pRecord, 0, sizeof(*pRecord));
+  nFields = split_fields(szLine, aszFields);
+
+  if ((0 == strcmp(aszFields[0], "H")) && (5 == nFields)) {
+    pRecord->type = CURR_Header;
+    pRecord->uiVersion = (unsigned int)strtoul(aszFields[1], NULL, 10);
+    strncpy(pRecord->summary.PackageName, aszFields[2], sizeof(pRecord->summary.PackageName) - 1);
+    pRecord->uiNumberOfSuites = (unsigned int)strtoul(aszFields[3], NULL, 10);
+    pRecord->uiNumberOfTests = (unsigned int)strtoul(aszFields[4], NULL, 10);
+  }
+  else if ((0 == strcmp(aszFields[0], "T")) && (8 <= nFields) && (10 >= nFields) &&
+           (CU_TRUE == parse_outcome(aszFields[4], &pRecord->eOutcome))) {
+    pRecord->type = CURR_Test;
+    pRecord->uiIndex = (unsigned int)strtoul(aszFields[1], NULL, 10);
+    copy_field(pRecord->strSuiteName, aszFields[2]);
+    copy_field(pRecord->strTestName, aszFields[3]);
+    pRecord->uiNumberOfAsserts = (unsigned int)strtoul(aszFields[5], NULL, 10);
+    pRecord->uiNumberOfAssertsFailed = (unsigned int)strtoul(aszFields[6], NULL, 10);
+    pRecord->dElapsedTime = strtod(aszFields[7], NULL);
+    if (9 <= nFields) {
+      pRecord->lHeapGrowth = strtol(aszFields[8], NULL, 10);
+    }
+    pRecord->dWallTime = (10 == nFields) ? strtod(aszFields[9], NULL) : pRecord->dElapsedTime;
+  }
+  else if ((0 == strcmp(aszFields[0], "F")) && ((8 == nFields) || (10 == nFields))) {
+    pRecord->type = CURR_Failure;
+    pRecord->uiIndex = (unsigned int)strtoul(aszFields[1], NULL, 10);
+    copy_field(pRecord->strSuiteName, aszFields[2]);
+    copy_field(pRecord->strTestName, aszFields[3]);
+    pRecord->eFailureType = (CU_FailureType)strtol(aszFields[4], NULL, 10);
+    pRecord->uiLineNumber = (unsigned int)strtoul(aszFields[5], NULL, 10);
+    copy_field(pRecord->strFileName, aszFields[6]);
+    copy_field(pRecord->strCondition, aszFields[7]);
+    if (10 == nFields) {
+      pRecord->fStatistic = CU_TRUE;
+      pRecord->dStatistic = strtod(aszFields[8], NULL);
+      pRecord->dPValue = strtod(aszFields[9], NULL);
+    }
+    else {
+      pRecord->dPValue = -1.0;
+    }
+  }
+  else if ((0 == strcmp(aszFields[0], "R")) && (11 == nFields)) {
+    pRecord->type = CURR_Summary;
+    pRecord->summary.nSuitesRun = (unsigned int)strtoul(aszFields[1], NULL, 10);
+    pRecord->summary.nSuitesFailed = (unsigned int)strtoul(aszFields[2], NULL, 10);
+    pRecord->summary.nSuitesInactive = (unsigned int)strtoul(aszFields[3], NULL, 10);
+    pRecord->summary.nTestsRun = (unsigned int)strtoul(aszFields[4], NULL, 10);
+    pRecord->summary.nTestsFailed = (unsigned int)strtoul(aszFields[5], NULL, 10);
+    pRecord->summary.nTestsInactive = (unsigned int)strtoul(aszFields[6], NULL, 10);
+    pRecord->summary.nAsserts = (unsigned int)strtoul(aszFields[7], NULL, 10);
+    pRecord->summary.nAssertsFailed = (unsigned int)strtoul(aszFields[8], NULL, 10);
+    pRecord->summary.nFailureRecords = (unsigned int)strtoul(aszFields[9], NULL, 10);
+    pRecord->summary.ElapsedTime = strtod(aszFields[10], NULL);
+  }
+  else {
+    CU_set_error(CUE_BAD_RESULT_RECORD);
+    return CU_FALSE;
+  }
+
+  return CU_TRUE;
+}
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_merge_result_logs(FILE *apLogs[],
+                                  unsigned int uiLogs,
+                                  FILE *pOutput,
+                                  CU_MergeRecordHandler pHandler,
+                                  CU_pMergeSummary pMerge)
+{
+  CU_ResultRecord header;
+  CU_ResultRecord summary;
+  CU_pResultRecord pRecord;
+  merge_input *pNext;
+  char szLastSuite[MAX_NAME_LEN] = "";
+  char szFailedSuite[MAX_NAME_LEN] = "";
+  unsigned int uiNextTest = 0;
+  unsigned int uiSuiteFailureIndex = 0;
+  unsigned int uiSuiteFailureTypes = 0;
+  unsigned int i;
+  CU_BOOL bEmit;
+  CU_ErrorCode result = CUE_SUCCESS;
+
+  assert(NULL != apLogs);
+  assert(NULL != pMerge);
+
+  memset(pMerge, 0, sizeof(*pMerge));
+  if ((0 == uiLogs) || (uiLogs > CU_MERGE_MAX_LOGS)) {
+    CU_set_error(CUE_NOMEMORY);
+    return CUE_NOMEMORY;
+  }
+
+  /* all logs must come from the same registry */
+  for (i = 0 ; (i < uiLogs) && (CUE_SUCCESS == result) ; i++) {
+    memset(&f_merge_inputs[i], 0, sizeof(merge_input));
+    f_merge_inputs[i].file = apLogs[i];
+    f_merge_inputs[i].uiLog = i;
+    if ((CU_FALSE == CU_read_result_record(apLogs[i], &f_merge_inputs[i].head)) ||
+        (CURR_Header != f_merge_inputs[i].head.type)) {
+      VLA_error(_("Result log %u does not start with a header."), i + 1);
+      result = CUE_BAD_RESULT_RECORD;
+    }
+    else if (0 == i) {
+      header = f_merge_inputs[0].head;
+    }
+    else if ((header.uiNumberOfSuites != f_merge_inputs[i].head.uiNumberOfSuites) ||
+             (header.uiNumberOfTests != f_merge_inputs[i].head.uiNumberOfTests) ||
+             (0 != strcmp(header.summary.PackageName, f_merge_inputs[i].head.summary.PackageName))) {
+      VLA_error(_("Result log %u is from a different registry than result log 1."), i + 1);
+      result = CUE_BAD_RESULT_RECORD;
+    }
+  }
+  for (i = 0 ; (i < uiLogs) && (CUE_SUCCESS == result) ; i++) {
+    result = merge_advance(&f_merge_inputs[i], pMerge);
+  }
+  if (CUE_SUCCESS != result) {
+    CU_set_error(result);
+    return result;
+  }
+
+  pMerge->uiNumberOfSuites = header.uiNumberOfSuites;
+  pMerge->uiNumberOfTests = header.uiNumberOfTests;
+  header.uiVersion = CU_RESULT_LOG_VERSION;
+  memcpy(pMerge->summary.PackageName, header.summary.PackageName, sizeof(pMerge->summary.PackageName));
+  result = merge_emit(pOutput, pHandler, &header);
+
+  while (CUE_SUCCESS == result) {
+    /* smallest key first, the earlier log on ties */
+    pNext = NULL;
+    for (i = 0 ; i < uiLogs ; i++) {
+      if ((CU_FALSE != f_merge_inputs[i].bHead) &&
+          ((NULL == pNext) || (merge_key(&f_merge_inputs[i].head) < merge_key(&pNext->head)))) {
+        pNext = &f_merge_inputs[i];
+      }
+    }
+    if (NULL == pNext) {
+      break;
+    }
+
+    pRecord = &pNext->head;
+    bEmit = CU_TRUE;
+    if ((CURR_Test == pRecord->type) && (CUTO_NotRun == pRecord->eOutcome)) {
+      /* sorted after any log running the test, so only kept if none did */
+      if (pRecord->uiIndex < uiNextTest) {
+        bEmit = CU_FALSE;
+      }
+      else {
+        if (pRecord->uiIndex > uiNextTest) {
+          merge_report_missing(uiNextTest, pRecord->uiIndex - 1, pMerge);
+        }
+        uiNextTest = pRecord->uiIndex + 1;
+      }
+    }
+    else if (CURR_Test == pRecord->type) {
+      if (pRecord->uiIndex < uiNextTest) {
+        VLA_error(_("Test %s/%s (%u) is reported by more than one result log, keeping the first."),
+                  pRecord->strSuiteName, pRecord->strTestName, pRecord->uiIndex);
+        pMerge->uiDuplicateTests++;
+        pNext->bSkipping = CU_TRUE;
+        pNext->uiSkipIndex = pRecord->uiIndex;
+        bEmit = CU_FALSE;
+      }
+      else {
+        if (pRecord->uiIndex > uiNextTest) {
+          merge_report_missing(uiNextTest, pRecord->uiIndex - 1, pMerge);
+        }
+        uiNextTest = pRecord->uiIndex + 1;
+        pNext->bSkipping = CU_FALSE;
+
+        if (0 != strcmp(szLastSuite, pRecord->strSuiteName)) {
+          pMerge->summary.nSuitesRun++;
+          copy_field(szLastSuite, pRecord->strSuiteName);
+        }
+        if (CUTO_Inactive == pRecord->eOutcome) {
+          pMerge->summary.nTestsInactive++;
+        }
+        else {
+          pMerge->summary.nTestsRun++;
+          if (CUTO_Failed == pRecord->eOutcome) {
+            pMerge->summary.nTestsFailed++;
+          }
+        }
+        pMerge->summary.nAsserts += pRecord->uiNumberOfAsserts;
+        pMerge->summary.nAssertsFailed += pRecord->uiNumberOfAssertsFailed;
+      }
+    }
+    else if ('\0' != pRecord->strTestName[0]) {
+      bEmit = ((CU_FALSE == pNext->bSkipping) || (pRecord->uiIndex != pNext->uiSkipIndex)) ? CU_TRUE : CU_FALSE;
+    }
+    else {
+      /* every shard running part of a suite reports its suite failures */
+      if ((pRecord->uiIndex != uiSuiteFailureIndex) || (0 != strcmp(szFailedSuite, pRecord->strSuiteName))) {
+        uiSuiteFailureIndex = pRecord->uiIndex;
+        copy_field(szFailedSuite, pRecord->strSuiteName);
+        uiSuiteFailureTypes = 0;
+      }
+      if (0 != (uiSuiteFailureTypes & (1U << (unsigned int)pRecord->eFailureType))) {
+        bEmit = CU_FALSE;
+      }
+      else {
+        uiSuiteFailureTypes |= 1U << (unsigned int)pRecord->eFailureType;
+        if ((CUF_SuiteInitFailed == pRecord->eFailureType) || (CUF_SuiteCleanupFailed == pRecord->eFailureType)) {
+          pMerge->summary.nSuitesFailed++;
+        }
+      }
+    }
+
+    if (CU_FALSE != bEmit) {
+      if (CURR_Failure == pRecord->type) {
+        pMerge->summary.nFailureRecords++;
+      }
+      result = merge_emit(pOutput, pHandler, pRecord);
+    }
+    if (CUE_SUCCESS == result) {
+      result = merge_advance(pNext, pMerge);
+    }
+  }
+
+  if ((CUE_SUCCESS == result) && (uiNextTest < pMerge->uiNumberOfTests)) {
+    merge_report_missing(uiNextTest, pMerge->uiNumberOfTests - 1, pMerge);
+  }
+  if (CUE_SUCCESS == result) {
+    memset(&summary, 0, sizeof(summary));
+    summary.type = CURR_Summary;
+    summary.summary = pMerge->summary;
+    result = merge_emit(pOutput, pHandler, &summary);
+  }
+  if ((CUE_SUCCESS == result) && (NULL != pOutput) && (0 != fflush(pOutput))) {
+    result = CUE_WRITE_ERROR;
+  }
+
+  CU_set_error(result);
+  return result;
+}
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_diff_result_logs(FILE *pBefore,
+                                 FILE *pAfter,
+                                 CU_DiffHandler pHandler,
+                                 CU_pDiffSummary pDiff)
+{
+  diff_side *pOld = &f_diff_sides[0];
+  diff_side *pNew = &f_diff_sides[1];
+  CU_ResultRecord record;
+  unsigned int uiOld;
+  unsigned int uiNew;
+  unsigned int i;
+  CU_ErrorCode result = CUE_SUCCESS;
+
+  assert(NULL != pBefore);
+  assert(NULL != pAfter);
+  assert(NULL != pDiff);
+
+  memset(pDiff, 0, sizeof(*pDiff));
+  memset(f_diff_sides, 0, sizeof(f_diff_sides));
+  pOld->file = pBefore;
+  pNew->file = pAfter;
+
+  for (i = 0 ; (i < 2) && (CUE_SUCCESS == result) ; i++) {
+    if ((CU_FALSE == CU_read_result_record(f_diff_sides[i].file, &record)) || (CURR_Header != record.type)) {
+      VLA_error(_("Result log %u does not start with a header."), i + 1);
+      result = CUE_BAD_RESULT_RECORD;
+    }
+  }
+
+  while (CUE_SUCCESS == result) {
+    if ((CUE_SUCCESS != (result = diff_fill(pOld))) || (CUE_SUCCESS != (result = diff_fill(pNew)))) {
+      break;
+    }
+
+    if ((0 == pOld->uiCount) && (0 == pNew->uiCount)) {
+      break;
+    }
+    else if (0 == pNew->uiCount) {
+      diff_pop(pOld, pNew, CUDT_Disappeared, pHandler, pDiff);
+    }
+    else if (0 == pOld->uiCount) {
+      diff_pop(pNew, pOld, CUDT_Added, pHandler, pDiff);
+    }
+    else if (CU_FALSE != diff_at(pOld, 0)->bMatched) {
+      diff_pop(pOld, pNew, CUDT_Disappeared, pHandler, pDiff);
+    }
+    else if (CU_FALSE != diff_at(pNew, 0)->bMatched) {
+      diff_pop(pNew, pOld, CUDT_Added, pHandler, pDiff);
+    }
+    else if (0 == diff_find(pNew, diff_at(pOld, 0))) {
+      diff_compare(diff_at(pOld, 0), diff_at(pNew, 0), pHandler, pDiff);
+      diff_at(pOld, 0)->bMatched = CU_TRUE;
+      diff_at(pNew, 0)->bMatched = CU_TRUE;
+      diff_pop(pOld, pNew, CUDT_Disappeared, pHandler, pDiff);
+      diff_pop(pNew, pOld, CUDT_Added, pHandler, pDiff);
+    }
+    else {
+      /* resynchronize on the nearer match, tests skipped over changed */
+      uiOld = diff_find(pOld, diff_at(pNew, 0));
+      uiNew = diff_find(pNew, diff_at(pOld, 0));
+      if ((uiOld < CU_DIFF_WINDOW) && (uiOld <= uiNew)) {
+        for (i = 0 ; i < uiOld ; i++) {
+          diff_pop(pOld, pNew, CUDT_Disappeared, pHandler, pDiff);
+        }
+      }
+      else if (uiNew < CU_DIFF_WINDOW) {
+        for (i = 0 ; i < uiNew ; i++) {
+          diff_pop(pNew, pOld, CUDT_Added, pHandler, pDiff);
+        }
+      }
+      else {
+        diff_pop(pOld, pNew, CUDT_Disappeared, pHandler, pDiff);
+        diff_pop(pNew, pOld, CUDT_Added, pHandler, pDiff);
+      }
+    }
+  }
+
+  qsort(pDiff->aDeltas, pDiff->uiNumberOfDeltas, sizeof(CU_DiffEntry), diff_compare_significance);
+
+  CU_set_error(result);
+  return result;
+}
+
+/*=================================================================
+ *  Static module functions
+ *=================================================================*/
+/**
+ *  Writes a string field, replacing the characters used as
+ *  separators in the result log (tab, newline) with spaces.
+ *
+ *  @param file    Stream to write to (non-NULL).
+ *  @param szField String to write (NULL is written as empty).
+ */
+static void write_field(FILE *file, const char *szField)
+{
+  if (NULL == szField) {
+    return;
+  }
+  for ( ; '\0' != *szField ; szField++) {
+    fputc((('\t' == *szField) || ('\n' == *szField) || ('\r' == *szField)) ? ' ' : *szField, file);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/** Writes the header record of a result log.
+ *  @param file      Stream to write to (non-NULL).
+ *  @param pRegistry Registry of the run (non-NULL).
+ *  @return A CU_ErrorCode indicating the write status.
+ */
+static CU_ErrorCode export_header(FILE *file, CU_pTestRegistry pRegistry)
+{
+  CU_ResultRecord record;
+
+  memset(&record, 0, sizeof(record));
+  record.type = CURR_Header;
+  record.uiVersion = CU_RESULT_LOG_VERSION;
+  record.uiNumberOfSuites = pRegistry->uiNumberOfSuites;
+  record.uiNumberOfTests = pRegistry->uiNumberOfTests;
+  memcpy(record.summary.PackageName, CU_get_run_summary()->PackageName, sizeof(record.summary.PackageName));
+  return CU_write_result_record(file, &record);
+}
+
+/*------------------------------------------------------------------------*/
+/** Writes the test record of a test followed by its failure records.
+ *  @param file    Stream to write to (non-NULL).
+ *  @param pFirst  First failure record to consider for the test.
+ *  @param pSuite  Suite of the test (non-NULL).
+ *  @param pTest   Test to write (non-NULL).
+ *  @param uiIndex Registration index of the test.
+ *  @return A CU_ErrorCode indicating the write status.
+ */
+static CU_ErrorCode export_test(FILE *file, CU_pFailureRecord pFirst,
+                                CU_pSuite pSuite, CU_pTest pTest, unsigned int uiIndex)
+{
+  CU_ResultRecord record;
+  CU_ErrorCode result;
+
+  memset(&record, 0, sizeof(record));
+  record.type = CURR_Test;
+  record.uiIndex = uiIndex;
+  copy_field(record.strSuiteName, pSuite->pName);
+  copy_field(record.strTestName, pTest->pName);
+  record.eOutcome = pTest->eOutcome;
+  record.uiNumberOfAsserts = pTest->uiNumberOfAsserts;
+  record.uiNumberOfAssertsFailed = pTest->uiNumberOfAssertsFailed;
+  record.dElapsedTime = pTest->dElapsedTime;
+  record.lHeapGrowth = pTest->lHeapGrowth;
+  record.dWallTime = pTest->dWallTime;
+  result = CU_write_result_record(file, &record);
+  if (CUE_SUCCESS == result) {
+    result = export_failures(file, pFirst, pSuite, pTest, uiIndex);
+  }
+  return result;
+}
+
+/*------------------------------------------------------------------------*/
+/** Writes the summary record of the last run.
+ *  @param file Stream to write to (non-NULL).
+ *  @return A CU_ErrorCode indicating the write status.
+ */
+static CU_ErrorCode export_summary(FILE *file)
+{
+  CU_ResultRecord record;
+
+  memset(&record, 0, sizeof(record));
+  record.type = CURR_Summary;
+  record.summary = *CU_get_run_summary();
+  return CU_write_result_record(file, &record);
+}
+
+/*------------------------------------------------------------------------*/
+/** Returns whether the initialization of a suite failed in the last run,
+ *  considering the failure records from pFirst on.
+ */
+static CU_BOOL suite_init_failed(CU_pFailureRecord pFirst, CU_pSuite pSuite)
+{
+  CU_pFailureRecord pFailure;
+
+  for (pFailure = pFirst ; NULL != pFailure ; pFailure = pFailure->pNext) {
+    if ((pFailure->pSuite == pSuite) && (NULL == pFailure->pTest) && (CUF_SuiteInitFailed == pFailure->type)) {
+      return CU_TRUE;
+    }
+  }
+  return CU_FALSE;
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Writes test records of outcome CUTO_NotRun for the tests of a suite
+ *  whose initialization failed, so that merging accounts for them.
+ *
+ *  @param file    Stream to write to (non-NULL).
+ *  @param pFirst  First failure record to consider for the tests.
+ *  @param pSuite  Suite of the tests (non-NULL).
+ *  @param uiIndex Registration index of the first test of the suite.
+ *  @return A CU_ErrorCode indicating the write status.
+ */
+static CU_ErrorCode export_not_run(FILE *file, CU_pFailureRecord pFirst,
+                                   CU_pSuite pSuite, unsigned int uiIndex)
+{
+  CU_pTest pTest;
+  CU_ErrorCode result = CUE_SUCCESS;
+
+  for (pTest = pSuite->pTest ; (NULL != pTest) && (CUE_SUCCESS == result) ; pTest = pTest->pNext, uiIndex++) {
+    result = export_test(file, pFirst, pSuite, pTest, uiIndex);
+  }
+  return result;
+}
+
+/*------------------------------------------------------------------------*/
+/** Returns the registration index of a test, or of the first test of
+ *  pSuite if pTest is NULL.
+ */
+static unsigned int registry_index(CU_pSuite pSuite, CU_pTest pTest)
+{
+  CU_pSuite pCurSuite;
+  CU_pTest pCurTest;
+  unsigned int uiIndex = 0;
+
+  for (pCurSuite = CU_get_registry()->pSuite ;
+       (NULL != pCurSuite) && (pCurSuite != pSuite) ;
+       pCurSuite = pCurSuite->pNext) {
+    uiIndex += pCurSuite->uiNumberOfTests;
+  }
+  for (pCurTest = (NULL != pTest) ? pSuite->pTest : NULL ;
+       (NULL != pCurTest) && (pCurTest != pTest) ;
+       pCurTest = pCurTest->pNext) {
+    uiIndex++;
+  }
+  return uiIndex;
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Returns the registration index of a streamed test, or of the first
+ *  test of pSuite if pTest is NULL.  Runs stream tests in registration
+ *  order, so the index is counted on from the previously streamed test
+ *  or suite instead of walking the registry each time.
+ */
+static unsigned int stream_index(CU_pSuite pSuite, CU_pTest pTest)
+{
+  CU_pSuite pCurSuite;
+  CU_pTest pCurTest;
+  unsigned int uiIndex;
+
+  if (pSuite != f_pStreamSuite) {
+    uiIndex = f_uiStreamSuiteIndex;
+    for (pCurSuite = f_pStreamSuite ;
+         (NULL != pCurSuite) && (pCurSuite != pSuite) ;
+         pCurSuite = pCurSuite->pNext) {
+      uiIndex += pCurSuite->uiNumberOfTests;
+    }
+    f_uiStreamSuiteIndex = (NULL != pCurSuite) ? uiIndex : registry_index(pSuite, NULL);
+    f_pStreamSuite = pSuite;
+    f_pStreamTest = NULL;
+  }
+
+  if (NULL == pTest) {
+    return f_uiStreamSuiteIndex;
+  }
+
+  pCurTest = NULL;
+  if (NULL != f_pStreamTest) {
+    uiIndex = f_uiStreamTestIndex;
+    for (pCurTest = f_pStreamTest ;
+         (NULL != pCurTest) && (pCurTest != pTest) ;
+         pCurTest = pCurTest->pNext) {
+      uiIndex++;
+    }
+  }
+  if (NULL == pCurTest) {
+    uiIndex = f_uiStreamSuiteIndex;
+    for (pCurTest = pSuite->pTest ;
+         (NULL != pCurTest) && (pCurTest != pTest) ;
+         pCurTest = pCurTest->pNext) {
+      uiIndex++;
+    }
+  }
+  f_uiStreamTestIndex = uiIndex;
+  f_pStreamTest = pTest;
+  return f_uiStreamTestIndex;
+}
+
+/*------------------------------------------------------------------------*/
+/** Returns the first failure record after pMark, or the head of the
+ *  failure list if pMark is NULL.
+ */
+static CU_pFailureRecord stream_failures(CU_pFailureRecord pMark)
+{
+  return (NULL != pMark) ? pMark->pNext : CU_get_failure_list();
+}
+
+/*------------------------------------------------------------------------*/
+/** Returns the last failure record of the list, walking on from pMark
+ *  (NULL for the head).  Records are only ever appended during a run.
+ */
+static CU_pFailureRecord last_failure(CU_pFailureRecord pMark)
+{
+  CU_pFailureRecord pFailure;
+
+  for (pFailure = stream_failures(pMark) ; NULL != pFailure ; pFailure = pFailure->pNext) {
+    pMark = pFailure;
+  }
+  return pMark;
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Writes the failure records of the last run belonging to a test,
+ *  or the suite-level failure records of a suite if pTest is NULL.
+ *
+ *  @param file    Stream to write to (non-NULL).
+ *  @param pFirst  First failure record to consider.
+ *  @param pSuite  Suite of the failures (non-NULL).
+ *  @param pTest   Test of the failures, NULL for suite-level failures.
+ *  @param uiIndex Registration index to record with the failures.
+ *  @return A CU_ErrorCode indicating the write status.
+ */
+static CU_ErrorCode export_failures(FILE *file, CU_pFailureRecord pFirst,
+                                    CU_pSuite pSuite, CU_pTest pTest, unsigned int uiIndex)
+{
+  CU_ResultRecord record;
+  CU_pFailureRecord pFailure = NULL;
+  CU_ErrorCode result = CUE_SUCCESS;
+
+  memset(&record, 0, sizeof(record));
+  record.type = CURR_Failure;
+  record.uiIndex = uiIndex;
+  copy_field(record.strSuiteName, pSuite->pName);
+  copy_field(record.strTestName, (NULL != pTest) ? pTest->pName : "");
+
+  for (pFailure = pFirst ;
+       (NULL != pFailure) && (CUE_SUCCESS == result) ;
+       pFailure = pFailure->pNext) {
+    if ((pFailure->pSuite == pSuite) && (pFailure->pTest == pTest)) {
+      record.eFailureType = pFailure->type;
+      record.uiLineNumber = pFailure->uiLineNumber;
+      copy_field(record.strFileName, pFailure->strFileName);
+      copy_field(record.strCondition, pFailure->strCondition);
+      record.fStatistic = pFailure->fStatistic;
+      record.dStatistic = pFailure->dStatistic;
+      record.dPValue = pFailure->dPValue;
+      result = CU_write_result_record(file, &record);
+    }
+  }
+
+  return result;
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Splits a line into tab-separated fields in place.
+ *  Empty fields are preserved.  Fields beyond RESULT_MAX_FIELDS are
+ *  left joined to the last field.
+ *
+ *  @param szLine    Line to split (modified).
+ *  @param aszFields Array receiving up to RESULT_MAX_FIELDS fields.
+ *  @return The number of fields found.
+ */
+static unsigned int split_fields(char *szLine, char *aszFields[])
+{
+  unsigned int nFields = 0;
+
+  aszFields[nFields++] = szLine;
+  for ( ; ('\0' != *szLine) && (nFields < RESULT_MAX_FIELDS) ; szLine++) {
+    if ('\t' == *szLine) {
+      *szLine = '\0';
+      aszFields[nFields++] = szLine + 1;
+    }
+  }
+
+  return nFields;
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Copies a string into a name buffer of MAX_NAME_LEN characters,
+ *  truncating as necessary.  The result is always NULL-terminated.
+ */
+static void copy_field(char *szDest, const char *szSrc)
+{
+  CU_copy_name(szDest, (NULL != szSrc) ? szSrc : "");
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Converts an outcome marker back into a CU_TestOutcome.
+ *  @return CU_TRUE if the marker is valid, CU_FALSE otherwise.
+ */
+static CU_BOOL parse_outcome(const char *szField, CU_TestOutcome *pOutcome)
+{
+  unsigned int i;
+
+  if (('\0' == szField[0]) || ('\0' != szField[1])) {
+    return CU_FALSE;
+  }
+  for (i = 0 ; i < sizeof(f_outcome_chars) ; i++) {
+    if (f_outcome_chars[i] == szField[0]) {
+      *pOutcome = (CU_TestOutcome)i;
+      return CU_TRUE;
+    }
+  }
+  return CU_FALSE;
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Reads the next record of a merged log into its head.  The summary
+ *  ends a log; its inactive suites and elapsed time are taken into
+ *  the merged summary.
+ *
+ *  @return CUE_BAD_RESULT_RECORD for a malformed record or a second
+ *          header, CUE_SUCCESS otherwise.
+ */
+static CU_ErrorCode merge_advance(merge_input *pInput, CU_pMergeSummary pMerge)
+{
+  pInput->bHead = CU_FALSE;
+  if (NULL == pInput->file) {
+    return CUE_SUCCESS;
+  }
+
+  if (CU_FALSE == CU_read_result_record(pInput->file, &pInput->head)) {
+    if (CUE_SUCCESS != CU_get_error()) {
+      VLA_error(_("Result log %u contains a malformed record."), pInput->uiLog + 1);
+      return CUE_BAD_RESULT_RECORD;
+    }
+    VLA_error(_("Result log %u ends without a run summary."), pInput->uiLog + 1);
+    pMerge->uiIncompleteLogs++;
+    pInput->file = NULL;
+    return CUE_SUCCESS;
+  }
+
+  switch (pInput->head.type) {
+    case CURR_Summary:
+      if (pInput->head.summary.nSuitesInactive > pMerge->summary.nSuitesInactive) {
+        pMerge->summary.nSuitesInactive = pInput->head.summary.nSuitesInactive;
+      }
+      if (pInput->head.summary.ElapsedTime > pMerge->summary.ElapsedTime) {
+        pMerge->summary.ElapsedTime = pInput->head.summary.ElapsedTime;
+      }
+      pInput->file = NULL;
+      return CUE_SUCCESS;
+
+    case CURR_Header:
+      VLA_error(_("Result log %u starts a new run without a run summary."), pInput->uiLog + 1);
+      return CUE_BAD_RESULT_RECORD;
+
+    default:
+      pInput->bHead = CU_TRUE;
+      return CUE_SUCCESS;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Returns the merge order of a record: by registration index, and for
+ *  the same index suite failures (of the suite before), then the test,
+ *  then its failures, then a not-run record of the test.
+ */
+static unsigned long merge_key(const CU_ResultRecord *pRecord)
+{
+  unsigned long ulOrder;
+
+  if (CURR_Test == pRecord->type) {
+    ulOrder = (CUTO_NotRun == pRecord->eOutcome) ? 3 : 1;
+  }
+  else {
+    ulOrder = ('\0' == pRecord->strTestName[0]) ? 0 : 2;
+  }
+  return ((unsigned long)pRecord->uiIndex << 2) | ulOrder;
+}
+
+/*------------------------------------------------------------------------*/
+/** Reports registered tests uiFirst to uiLast as missing from all logs. */
+static void merge_report_missing(unsigned int uiFirst, unsigned int uiLast, CU_pMergeSummary pMerge)
+{
+  if (uiFirst == uiLast) {
+    VLA_error(_("Test %u is missing from all result logs."), uiFirst);
+  }
+  else {
+    VLA_error(_("Tests %u to %u are missing from all result logs."), uiFirst, uiLast);
+  }
+  pMerge->uiMissingTests += uiLast - uiFirst + 1;
+}
+
+/*------------------------------------------------------------------------*/
+/** Passes a merged record to the output log and the handler. */
+static CU_ErrorCode merge_emit(FILE *pOutput, CU_MergeRecordHandler pHandler, const CU_ResultRecord *pRecord)
+{
+  CU_ErrorCode result = CUE_SUCCESS;
+
+  if (NULL != pOutput) {
+    result = CU_write_result_record(pOutput, pRecord);
+  }
+  if (NULL != pHandler) {
+    (*pHandler)(pRecord);
+  }
+  return result;
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Reads tests of a compared log until its window is full or the log
+ *  ends.  Failure records are skipped; the summary ends the log.
+ *
+ *  @return CUE_BAD_RESULT_RECORD for a malformed record, CUE_SUCCESS otherwise.
+ */
+static CU_ErrorCode diff_fill(diff_side *pSide)
+{
+  CU_ResultRecord record;
+  diff_test *pTest;
+
+  while ((NULL != pSide->file) && (pSide->uiCount < CU_DIFF_WINDOW)) {
+    if (CU_FALSE == CU_read_result_record(pSide->file, &record)) {
+      pSide->file = NULL;
+      return (CUE_SUCCESS != CU_get_error()) ? CUE_BAD_RESULT_RECORD : CUE_SUCCESS;
+    }
+    if ((CURR_Summary == record.type) || (CURR_Header == record.type)) {
+      pSide->file = NULL;
+    }
+    else if (CURR_Test == record.type) {
+      pTest = &pSide->aWindow[(pSide->uiFirst + pSide->uiCount++) % CU_DIFF_WINDOW];
+      memcpy(pTest->strSuiteName, record.strSuiteName, MAX_NAME_LEN);
+      memcpy(pTest->strTestName, record.strTestName, MAX_NAME_LEN);
+      pTest->eOutcome = record.eOutcome;
+      pTest->uiNumberOfAsserts = record.uiNumberOfAsserts;
+      pTest->dWallTime = record.dWallTime;
+      pTest->lHeapGrowth = record.lHeapGrowth;
+      pTest->bMatched = CU_FALSE;
+    }
+  }
+  return CUE_SUCCESS;
+}
+
+/*------------------------------------------------------------------------*/
+/** Returns the test at a position of the window of a compared log. */
+static diff_test* diff_at(diff_side *pSide, unsigned int uiPos)
+{
+  return &pSide->aWindow[(pSide->uiFirst + uiPos) % CU_DIFF_WINDOW];
+}
+
+/*------------------------------------------------------------------------*/
+/** Returns the position of an unmatched test in the window of a compared log, CU_DIFF_WINDOW if absent. */
+static unsigned int diff_find(diff_side *pSide, const diff_test *pTest)
+{
+  diff_test *pCur;
+  unsigned int i;
+
+  for (i = 0 ; i < pSide->uiCount ; i++) {
+    pCur = diff_at(pSide, i);
+    if ((CU_FALSE == pCur->bMatched) &&
+        (0 == strcmp(pCur->strTestName, pTest->strTestName)) &&
+        (0 == strcmp(pCur->strSuiteName, pTest->strSuiteName))) {
+      return i;
+    }
+  }
+  return CU_DIFF_WINDOW;
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Removes the next test of a compared log.  Unless it was matched
+ *  before, a test still found in the window of the other log has moved
+ *  and is compared; otherwise it is reported as type.
+ */
+static void diff_pop(diff_side *pSide, diff_side *pOther, CU_DiffType type,
+                     CU_DiffHandler pHandler, CU_pDiffSummary pDiff)
+{
+  CU_DiffEntry entry;
+  diff_test *pTest = diff_at(pSide, 0);
+  diff_test *pMoved;
+  unsigned int uiPos;
+
+  if (CU_FALSE == pTest->bMatched) {
+    if ((uiPos = diff_find(pOther, pTest)) < CU_DIFF_WINDOW) {
+      pMoved = diff_at(pOther, uiPos);
+      if (CUDT_Disappeared == type) {
+        diff_compare(pTest, pMoved, pHandler, pDiff);
+      }
+      else {
+        diff_compare(pMoved, pTest, pHandler, pDiff);
+      }
+      pMoved->bMatched = CU_TRUE;
+    }
+    else {
+      memset(&entry, 0, sizeof(entry));
+      entry.type = type;
+      memcpy(entry.strSuiteName, pTest->strSuiteName, MAX_NAME_LEN);
+      memcpy(entry.strTestName, pTest->strTestName, MAX_NAME_LEN);
+      if (CUDT_Disappeared == type) {
+        pDiff->uiDisappeared++;
+      }
+      else {
+        pDiff->uiAdded++;
+      }
+      if (NULL != pHandler) {
+        (*pHandler)(&entry);
+      }
+    }
+  }
+  pSide->uiFirst = (pSide->uiFirst + 1) % CU_DIFF_WINDOW;
+  pSide->uiCount--;
+}
+
+/*------------------------------------------------------------------------*/
+/** Compares a test found in both logs. */
+static void diff_compare(const diff_test *pBefore, const diff_test *pAfter,
+                         CU_DiffHandler pHandler, CU_pDiffSummary pDiff)
+{
+  CU_DiffEntry entry;
+  double dMin;
+
+  pDiff->uiCompared++;
+
+  memset(&entry, 0, sizeof(entry));
+  if ((CUTO_Passed == pBefore->eOutcome) && (CUTO_Failed == pAfter->eOutcome)) {
+    entry.type = CUDT_NewlyFailing;
+    pDiff->uiNewlyFailing++;
+  }
+  else if ((CUTO_Failed == pBefore->eOutcome) && (CUTO_Passed == pAfter->eOutcome)) {
+    entry.type = CUDT_NewlyPassing;
+    pDiff->uiNewlyPassing++;
+  }
+  if ((0 != entry.type) && (NULL != pHandler)) {
+    memcpy(entry.strSuiteName, pAfter->strSuiteName, MAX_NAME_LEN);
+    memcpy(entry.strTestName, pAfter->strTestName, MAX_NAME_LEN);
+    (*pHandler)(&entry);
+  }
+
+  if ((CUTO_Inactive == pBefore->eOutcome) || (CUTO_Inactive == pAfter->eOutcome) ||
+      (CUTO_NotRun == pBefore->eOutcome) || (CUTO_NotRun == pAfter->eOutcome)) {
+    return;
+  }
+  dMin = (pBefore->dWallTime < pAfter->dWallTime) ? pBefore->dWallTime : pAfter->dWallTime;
+  diff_add_delta(CUDT_Time, pAfter, pBefore->dWallTime, pAfter->dWallTime,
+                 DIFF_TIME_NOISE + DIFF_TIME_NOISE_REL * dMin, pDiff);
+  diff_add_delta(CUDT_Heap, pAfter, (double)pBefore->lHeapGrowth, (double)pAfter->lHeapGrowth,
+                 DIFF_HEAP_NOISE, pDiff);
+  diff_add_delta(CUDT_Asserts, pAfter, (double)pBefore->uiNumberOfAsserts, (double)pAfter->uiNumberOfAsserts,
+                 1.0, pDiff);
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Keeps a delta if it is significant and among the CU_DIFF_MAX_DELTAS
+ *  most significant so far, replacing the least significant.
+ */
+static void diff_add_delta(CU_DiffType type, const diff_test *pTest, double dBefore,
+                           double dAfter, double dNoise, CU_pDiffSummary pDiff)
+{
+  CU_pDiffEntry pEntry;
+  double dSignificance = ((dAfter > dBefore) ? (dAfter - dBefore) : (dBefore - dAfter)) / dNoise;
+  unsigned int i;
+
+  if (dSignificance < 1.0) {
+    return;
+  }
+  pDiff->uiDeltas++;
+
+  if (pDiff->uiNumberOfDeltas < CU_DIFF_MAX_DELTAS) {
+    pEntry = &pDiff->aDeltas[pDiff->uiNumberOfDeltas++];
+  }
+  else {
+    pEntry = &pDiff->aDeltas[0];
+    for (i = 1 ; i < CU_DIFF_MAX_DELTAS ; i++) {
+      if (pDiff->aDeltas[i].dSignificance < pEntry->dSignificance) {
+        pEntry = &pDiff->aDeltas[i];
+      }
+    }
+    if (pEntry->dSignificance >= dSignificance) {
+      return;
+    }
+  }
+
+  pEntry->type = type;
+  memcpy(pEntry->strSuiteName, pTest->strSuiteName, MAX_NAME_LEN);
+  memcpy(pEntry->strTestName, pTest->strTestName, MAX_NAME_LEN);
+  pEntry->dBefore = dBefore;
+  pEntry->dAfter = dAfter;
+  pEntry->dSignificance = dSignificance;
+}
+
+/*------------------------------------------------------------------------*/
+/** Orders deltas by decreasing significance. */
+static int diff_compare_significance(const void *pA, const void *pB)
+{
+  double dA = ((const CU_DiffEntry *)pA)->dSignificance;
+  double dB = ((const CU_DiffEntry *)pB)->dSignificance;
+
+  return (dA < dB) ? 1 : ((dA > dB) ? -1 : 0);
+}
+
+/** @} */
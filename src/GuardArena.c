@@ -0,0 +1,245 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Implementation of test buffers bounded by guard pages.
+ *
+ *  19-Oct-2026   Initial implementation of the guard-paged arena.
+ */
+
+/** @file
+ *  Guard-paged arena (implementation).
+ */
+/** @addtogroup Framework
+ @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#ifdef LINUX
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#include "CUnit.h"
+#include "GuardArena.h"
+
+/*=================================================================
+ *  Global/Static Definitions
+ *=================================================================*/
+#ifdef LINUX
+
+/** Buffer placed last in a slot. */
+typedef struct guard_slot
+{
+  unsigned char* pStart;    /**< First byte of the slot. */
+  unsigned char* pBuffer;   /**< Placed buffer, NULL if none. */
+  size_t         nLength;   /**< Length of the placed buffer. */
+  unsigned char* pCanary;   /**< First canary byte before the buffer. */
+} guard_slot;
+
+static unsigned char* f_pArena = NULL;          /**< Mapping of the arena, NULL if closed. */
+static size_t         f_nArenaBytes = 0;        /**< Size of the mapping. */
+static size_t         f_nSlotBytes = 0;         /**< Usable bytes per slot (whole pages). */
+static size_t         f_nPageBytes = 0;         /**< Page size. */
+static unsigned int   f_uiSlots = 0;            /**< Number of slots. */
+static guard_slot     f_slots[CU_GUARD_ARENA_MAX_SLOTS];
+
+/*=================================================================
+ *  Public Interface functions
+ *=================================================================*/
+CU_ErrorCode CU_guard_arena_open(size_t nSlotBytes, unsigned int uiSlots)
+{
+  unsigned int i;
+
+  if ((0 == uiSlots) || (uiSlots > CU_GUARD_ARENA_MAX_SLOTS)) {
+    CU_set_error(CUE_NOMEMORY);
+    return CUE_NOMEMORY;
+  }
+  if ((NULL != f_pArena) && (f_uiSlots >= uiSlots) && (f_nSlotBytes >= nSlotBytes)) {
+    CU_set_error(CUE_SUCCESS);
+    return CUE_SUCCESS;
+  }
+  CU_guard_arena_close();
+
+  f_nPageBytes = (size_t)sysconf(_SC_PAGESIZE);
+  f_nSlotBytes = (nSlotBytes + f_nPageBytes - 1) / f_nPageBytes * f_nPageBytes;
+  if (0 == f_nSlotBytes) {
+    f_nSlotBytes = f_nPageBytes;
+  }
+  f_nArenaBytes = uiSlots * (f_nSlotBytes + f_nPageBytes);
+
+  f_pArena = (unsigned char*)mmap(NULL, f_nArenaBytes, PROT_READ | PROT_WRITE,
+                                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (MAP_FAILED == (void*)f_pArena) {
+    f_pArena = NULL;
+    CU_set_error(CUE_NOMEMORY);
+    return CUE_NOMEMORY;
+  }
+
+  memset(f_slots, 0, sizeof(f_slots));
+  for (i = 0 ; i < uiSlots ; i++) {
+    f_slots[i].pStart = f_pArena + i * (f_nSlotBytes + f_nPageBytes);
+    if (0 != mprotect(f_slots[i].pStart + f_nSlotBytes, f_nPageBytes, PROT_NONE)) {
+      CU_guard_arena_close();
+      CU_set_error(CUE_NOMEMORY);
+      return CUE_NOMEMORY;
+    }
+  }
+  f_uiSlots = uiSlots;
+
+  CU_set_error(CUE_SUCCESS);
+  return CUE_SUCCESS;
+}
+
+/*------------------------------------------------------------------------*/
+void CU_guard_arena_close(void)
+{
+  if (NULL != f_pArena) {
+    munmap(f_pArena, f_nArenaBytes);
+    f_pArena = NULL;
+  }
+  f_nArenaBytes = 0;
+  f_nSlotBytes = 0;
+  f_uiSlots = 0;
+}
+
+/*------------------------------------------------------------------------*/
+void* CU_guard_arena_place(unsigned int uiSlot, size_t nLength, unsigned int uiOffset)
+{
+  guard_slot *pSlot;
+  unsigned char *pGuard;
+  size_t nBase;
+
+  if ((uiSlot >= f_uiSlots) || (nLength + 2 * CU_GUARD_ALIGN > f_nSlotBytes)) {
+    return NULL;
+  }
+  pSlot = &f_slots[uiSlot];
+  pGuard = pSlot->pStart + f_nSlotBytes;
+  uiOffset %= CU_GUARD_ALIGN;
+
+  /* the highest boundary at which the buffer still fits at this offset */
+  nBase = (f_nSlotBytes - nLength - uiOffset) / CU_GUARD_ALIGN * CU_GUARD_ALIGN;
+  pSlot->pBuffer = pSlot->pStart + nBase + uiOffset;
+  pSlot->nLength = nLength;
+  pSlot->pCanary = pSlot->pStart + nBase - CU_GUARD_ALIGN;
+
+  memset(pSlot->pCanary, CU_GUARD_SLOT_CANARY(uiSlot), (size_t)(pSlot->pBuffer - pSlot->pCanary));
+  memset(pSlot->pBuffer + nLength, CU_GUARD_SLOT_CANARY(uiSlot), (size_t)(pGuard - (pSlot->pBuffer + nLength)));
+  return pSlot->pBuffer;
+}
+
+/*------------------------------------------------------------------------*/
+CU_BOOL CU_guard_arena_check(unsigned int uiSlot, size_t *pnUnderrun, size_t *pnOverrun)
+{
+  guard_slot *pSlot;
+  unsigned char *pCur;
+  unsigned char *pEnd;
+  unsigned char ucCanary = CU_GUARD_SLOT_CANARY(uiSlot);
+  size_t nUnderrun = 0;
+  size_t nOverrun = 0;
+
+  if ((uiSlot < f_uiSlots) && (NULL != f_slots[uiSlot].pBuffer)) {
+    pSlot = &f_slots[uiSlot];
+    for (pCur = pSlot->pCanary ; pCur < pSlot->pBuffer ; pCur++) {
+      if (ucCanary != *pCur) {
+        nUnderrun = (size_t)(pSlot->pBuffer - pCur);
+        break;
+      }
+    }
+    pEnd = pSlot->pStart + f_nSlotBytes;
+    for (pCur = pEnd ; pCur-- > pSlot->pBuffer + pSlot->nLength ; ) {
+      if (ucCanary != *pCur) {
+        nOverrun = (size_t)(pCur - (pSlot->pBuffer + pSlot->nLength)) + 1;
+        break;
+      }
+    }
+  }
+
+  if (NULL != pnUnderrun) {
+    *pnUnderrun = nUnderrun;
+  }
+  if (NULL != pnOverrun) {
+    *pnOverrun = nOverrun;
+  }
+  return ((0 == nUnderrun) && (0 == nOverrun)) ? CU_TRUE : CU_FALSE;
+}
+
+/*------------------------------------------------------------------------*/
+CU_BOOL CU_guard_arena_is_guard(const void *pAddress)
+{
+  const unsigned char *pByte = (const unsigned char*)pAddress;
+  unsigned int i;
+
+  for (i = 0 ; i < f_uiSlots ; i++) {
+    if ((pByte >= f_slots[i].pStart + f_nSlotBytes) &&
+        (pByte < f_slots[i].pStart + f_nSlotBytes + f_nPageBytes)) {
+      return CU_TRUE;
+    }
+  }
+  return CU_FALSE;
+}
+
+#else  /* LINUX */
+
+/*=================================================================
+ *  Public Interface functions (not supported)
+ *=================================================================*/
+CU_ErrorCode CU_guard_arena_open(size_t nSlotBytes, unsigned int uiSlots)
+{
+  CU_UNREFERENCED_PARAMETER(nSlotBytes);
+  CU_UNREFERENCED_PARAMETER(uiSlots);
+  CU_set_error(CUE_NOT_SUPPORTED);
+  return CUE_NOT_SUPPORTED;
+}
+
+void CU_guard_arena_close(void)
+{
+}
+
+void* CU_guard_arena_place(unsigned int uiSlot, size_t nLength, unsigned int uiOffset)
+{
+  CU_UNREFERENCED_PARAMETER(uiSlot);
+  CU_UNREFERENCED_PARAMETER(nLength);
+  CU_UNREFERENCED_PARAMETER(uiOffset);
+  return NULL;
+}
+
+CU_BOOL CU_guard_arena_check(unsigned int uiSlot, size_t *pnUnderrun, size_t *pnOverrun)
+{
+  CU_UNREFERENCED_PARAMETER(uiSlot);
+  if (NULL != pnUnderrun) {
+    *pnUnderrun = 0;
+  }
+  if (NULL != pnOverrun) {
+    *pnOverrun = 0;
+  }
+  return CU_TRUE;
+}
+
+CU_BOOL CU_guard_arena_is_guard(const void *pAddress)
+{
+  CU_UNREFERENCED_PARAMETER(pAddress);
+  return CU_FALSE;
+}
+
+#endif /* LINUX */
+
+/** @} */
@@ -0,0 +1,392 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Implementation of running suites once per instruction set level.
+ *
+ *  19-Oct-2026   Initial implementation of ISA-matrix runs.
+ */
+
+/** @file
+ *  ISA-matrix runs (implementation).
+ *  Every run of the runner starts with an empty failure list, so the
+ *  records of each (suite, level) run are labelled and copied before the
+ *  next run, and the copies of all but the last run are recorded again
+ *  at the end.
+ */
+/** @addtogroup Framework
+ @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+#include "CUnit.h"
+#include "TestDB.h"
+#include "TestRun.h"
+#include "IsaMatrix.h"
+#include "VLA_Lite_Log.h"
+#include "CUnit_intl.h"
+
+/*=================================================================
+ *  Global/Static Definitions
+ *=================================================================*/
+/** Copy of a failure record of an earlier run. */
+typedef struct isa_failure
+{
+  CU_FailureType type;                         /**< Failure type. */
+  unsigned int   uiLine;                       /**< Line number of the failure. */
+  char           szCondition[MAX_NAME_LEN];    /**< Labelled condition. */
+  char           szFile[MAX_NAME_LEN];         /**< File of the failure. */
+  CU_pSuite      pSuite;                       /**< Suite of the failure. */
+  CU_pTest       pTest;                        /**< Test of the failure. */
+} isa_failure;
+
+static const char* const f_szLevelNames[CU_ISA_NUM_LEVELS] =
+  { "scalar", "sse4.2", "avx2", "avx512" };
+
+static CU_IsaDispatchHook f_pHook = NULL;                 /**< Registered dispatch hook. */
+static CU_pSuite    f_markedSuites[MAX_NUM_OF_SUITES];    /**< Suites marked for matrix runs. */
+static unsigned int f_uiNumMarked = 0;                    /**< Entries used in f_markedSuites. */
+
+static CU_IsaResult f_results[MAX_NUM_OF_TESTS];          /**< Results of the last matrix run. */
+static unsigned int f_uiNumResults = 0;                   /**< Entries used in f_results. */
+static isa_failure  f_failures[CU_ISA_MAX_FAILURES];      /**< Labelled failures of the matrix run. */
+static unsigned int f_uiNumFailures = 0;                  /**< Entries used in f_failures. */
+
+/*=================================================================
+ *  Private function forward declarations
+ *=================================================================*/
+static void          add_summary(CU_pRunSummary pTotal, const CU_RunSummary *pRun);
+static void          record_level(CU_pSuite pSuite, CU_IsaLevel eLevel);
+static CU_IsaResult* get_result(CU_pSuite pSuite, CU_pTest pTest);
+static void          label_failures(CU_IsaLevel eLevel);
+static void          report_matrix(unsigned int uiLevels);
+
+/*=================================================================
+ *  Public Interface functions
+ *=================================================================*/
+unsigned int CU_isa_host_levels(void)
+{
+  unsigned int uiLevels = CU_ISA_LEVEL_MASK(CU_ISA_SCALAR);
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  __builtin_cpu_init();
+  if (0 != __builtin_cpu_supports("sse4.2")) {
+    uiLevels |= CU_ISA_LEVEL_MASK(CU_ISA_SSE42);
+  }
+  if (0 != __builtin_cpu_supports("avx2")) {
+    uiLevels |= CU_ISA_LEVEL_MASK(CU_ISA_AVX2);
+  }
+  if (0 != __builtin_cpu_supports("avx512f")) {
+    uiLevels |= CU_ISA_LEVEL_MASK(CU_ISA_AVX512);
+  }
+#endif
+  return uiLevels;
+}
+
+/*------------------------------------------------------------------------*/
+const char* CU_isa_level_name(CU_IsaLevel eLevel)
+{
+  return ((unsigned int)eLevel < CU_ISA_NUM_LEVELS) ? f_szLevelNames[eLevel] : "?";
+}
+
+/*------------------------------------------------------------------------*/
+void CU_isa_set_dispatch_hook(CU_IsaDispatchHook pHook)
+{
+  f_pHook = pHook;
+}
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_isa_mark_suite(CU_pSuite pSuite, CU_BOOL bMarked)
+{
+  unsigned int i;
+
+  if (NULL == pSuite) {
+    CU_set_error(CUE_NOSUITE);
+    return CUE_NOSUITE;
+  }
+
+  for (i = 0 ; i < f_uiNumMarked ; i++) {
+    if (f_markedSuites[i] == pSuite) {
+      break;
+    }
+  }
+  if ((CU_FALSE == bMarked) && (i < f_uiNumMarked)) {
+    f_markedSuites[i] = f_markedSuites[--f_uiNumMarked];
+  }
+  else if ((CU_FALSE != bMarked) && (i == f_uiNumMarked)) {
+    if (f_uiNumMarked >= MAX_NUM_OF_SUITES) {
+      CU_set_error(CUE_NOMEMORY);
+      return CUE_NOMEMORY;
+    }
+    f_markedSuites[f_uiNumMarked++] = pSuite;
+  }
+
+  CU_set_error(CUE_SUCCESS);
+  return CUE_SUCCESS;
+}
+
+/*------------------------------------------------------------------------*/
+CU_BOOL CU_isa_is_marked(CU_pSuite pSuite)
+{
+  unsigned int i;
+
+  for (i = 0 ; i < f_uiNumMarked ; i++) {
+    if (f_markedSuites[i] == pSuite) {
+      return CU_TRUE;
+    }
+  }
+  return CU_FALSE;
+}
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_isa_run(CU_pSuite pSuite, unsigned int uiLevels)
+{
+  CU_pTestRegistry pRegistry = CU_get_registry();
+  CU_pRunSummary pSummary;
+  CU_RunSummary total;
+  CU_ErrorCode result = CUE_SUCCESS;
+  CU_ErrorCode runResult;
+  CU_pSuite pCurSuite;
+  unsigned int uiHostLevels = CU_isa_host_levels();
+  unsigned int uiLastRunStart = 0;
+  unsigned int uiLevel;
+  unsigned int uiBest = CU_ISA_SCALAR;
+  unsigned int i;
+
+  assert(CU_FALSE == CU_is_test_running());
+
+  if (NULL == pRegistry) {
+    CU_set_error(CUE_NOREGISTRY);
+    return CUE_NOREGISTRY;
+  }
+  if (NULL == f_pHook) {
+    CU_set_error(CUE_NOTEST);
+    return CUE_NOTEST;
+  }
+  if ((NULL != pSuite) && (CU_FALSE == CU_isa_is_marked(pSuite))) {
+    CU_set_error(CUE_NOSUITE);
+    return CUE_NOSUITE;
+  }
+
+  uiLevels = ((0 != uiLevels) ? uiLevels : uiHostLevels) & uiHostLevels;
+  memset(f_results, 0, sizeof(f_results));
+  f_uiNumResults = 0;
+  f_uiNumFailures = 0;
+  memset(&total, 0, sizeof(total));
+
+  for (uiLevel = 0 ; uiLevel < CU_ISA_NUM_LEVELS ; uiLevel++) {
+    if (0 != (uiHostLevels & CU_ISA_LEVEL_MASK(uiLevel))) {
+      uiBest = uiLevel;
+    }
+    if (0 == (uiLevels & CU_ISA_LEVEL_MASK(uiLevel))) {
+      continue;
+    }
+    if (CU_FALSE == (*f_pHook)((CU_IsaLevel)uiLevel)) {
+      uiLevels &= ~CU_ISA_LEVEL_MASK(uiLevel);
+      VLA_info(_("ISA level %s skipped by the dispatch hook."), f_szLevelNames[uiLevel]);
+      continue;
+    }
+
+    for (pCurSuite = pRegistry->pSuite ; NULL != pCurSuite ; pCurSuite = pCurSuite->pNext) {
+      if (((NULL != pSuite) && (pCurSuite != pSuite)) ||
+          ((NULL == pSuite) && ((CU_FALSE == pCurSuite->fActive) || (CU_FALSE == CU_isa_is_marked(pCurSuite))))) {
+        continue;
+      }
+
+      runResult = CU_run_suite(pCurSuite);
+      if ((CUE_SUCCESS != runResult) && (CUE_SUCCESS == result)) {
+        result = runResult;
+      }
+      add_summary(&total, CU_get_run_summary());
+      uiLastRunStart = f_uiNumFailures;
+      label_failures((CU_IsaLevel)uiLevel);
+      record_level(pCurSuite, (CU_IsaLevel)uiLevel);
+    }
+  }
+
+  (*f_pHook)((CU_IsaLevel)uiBest);
+
+  /* the records of the last run are still in the failure list */
+  for (i = 0 ; i < uiLastRunStart ; i++) {
+    CU_record_failure(f_failures[i].type, f_failures[i].uiLine, f_failures[i].szCondition,
+                      f_failures[i].szFile, f_failures[i].pSuite, f_failures[i].pTest);
+  }
+
+  /* each suite run reset the summary - the failure records are counted by now */
+  pSummary = CU_get_run_summary();
+  total.nFailureRecords = pSummary->nFailureRecords;
+  memcpy(total.PackageName, pSummary->PackageName, sizeof(total.PackageName));
+  *pSummary = total;
+
+  report_matrix(uiLevels);
+
+  CU_set_error(result);
+  return result;
+}
+
+/*------------------------------------------------------------------------*/
+const CU_IsaResult* CU_isa_get_result(CU_pTest pTest)
+{
+  unsigned int i;
+
+  for (i = 0 ; i < f_uiNumResults ; i++) {
+    if (f_results[i].pTest == pTest) {
+      return &f_results[i];
+    }
+  }
+  return NULL;
+}
+
+/*=================================================================
+ *  Static module functions
+ *=================================================================*/
+/** Adds the counts and time of a suite run to the totals of the matrix run. */
+static void add_summary(CU_pRunSummary pTotal, const CU_RunSummary *pRun)
+{
+  pTotal->nSuitesRun += pRun->nSuitesRun;
+  pTotal->nSuitesFailed += pRun->nSuitesFailed;
+  pTotal->nSuitesInactive += pRun->nSuitesInactive;
+  pTotal->nTestsRun += pRun->nTestsRun;
+  pTotal->nTestsFailed += pRun->nTestsFailed;
+  pTotal->nTestsInactive += pRun->nTestsInactive;
+  pTotal->nAsserts += pRun->nAsserts;
+  pTotal->nAssertsFailed += pRun->nAssertsFailed;
+  pTotal->ElapsedTime += pRun->ElapsedTime;
+}
+
+/*------------------------------------------------------------------------*/
+/** Copies the per-test results of a suite just run at a level. */
+static void record_level(CU_pSuite pSuite, CU_IsaLevel eLevel)
+{
+  CU_IsaResult *pResult;
+  CU_pTest pTest;
+
+  for (pTest = pSuite->pTest ; NULL != pTest ; pTest = pTest->pNext) {
+    if (NULL == (pResult = get_result(pSuite, pTest))) {
+      return;
+    }
+    pResult->aeOutcome[eLevel] = pTest->eOutcome;
+    pResult->adSeconds[eLevel] = pTest->dWallTime;
+    pResult->auiFailed[eLevel] = pTest->uiNumberOfAssertsFailed;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/** Finds or adds the entry of a test in f_results, NULL if full. */
+static CU_IsaResult* get_result(CU_pSuite pSuite, CU_pTest pTest)
+{
+  unsigned int i;
+
+  for (i = 0 ; i < f_uiNumResults ; i++) {
+    if (f_results[i].pTest == pTest) {
+      return &f_results[i];
+    }
+  }
+  if (f_uiNumResults >= MAX_NUM_OF_TESTS) {
+    return NULL;
+  }
+  f_results[f_uiNumResults].pSuite = pSuite;
+  f_results[f_uiNumResults].pTest = pTest;
+  return &f_results[f_uiNumResults++];
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Prefixes the conditions of the current failure records with a level
+ *  and keeps copies of them for the end of the matrix run.
+ */
+static void label_failures(CU_IsaLevel eLevel)
+{
+  CU_pFailureRecord pFailure;
+  isa_failure *pCopy;
+  char szLabelled[MAX_NAME_LEN];
+  size_t nPrefix;
+
+  for (pFailure = CU_get_failure_list() ; NULL != pFailure ; pFailure = pFailure->pNext) {
+    memset(szLabelled, 0, sizeof(szLabelled));
+    nPrefix = (size_t)snprintf(szLabelled, sizeof(szLabelled), "[%s] ", f_szLevelNames[eLevel]);
+    if (NULL != pFailure->strCondition) {
+      strncpy(szLabelled + nPrefix, pFailure->strCondition, sizeof(szLabelled) - nPrefix - 1);
+      memcpy(pFailure->strCondition, szLabelled, sizeof(szLabelled));
+    }
+    if (f_uiNumFailures >= CU_ISA_MAX_FAILURES) {
+      continue;
+    }
+    pCopy = &f_failures[f_uiNumFailures++];
+    pCopy->type = pFailure->type;
+    pCopy->uiLine = pFailure->uiLineNumber;
+    memcpy(pCopy->szCondition, szLabelled, sizeof(szLabelled));
+    memset(pCopy->szFile, 0, sizeof(pCopy->szFile));
+    if (NULL != pFailure->strFileName) {
+      strncpy(pCopy->szFile, pFailure->strFileName, sizeof(pCopy->szFile) - 1);
+    }
+    pCopy->pSuite = pFailure->pSuite;
+    pCopy->pTest = pFailure->pTest;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/** Prints the outcome and time of every test at every level run. */
+static void report_matrix(unsigned int uiLevels)
+{
+  const CU_IsaResult *pResult;
+  char szName[2 * MAX_NAME_LEN + 2];
+  char szLine[32 * CU_ISA_NUM_LEVELS];
+  size_t nLen;
+  unsigned int uiLevel;
+  unsigned int i;
+
+  VLA_info(_("ISA matrix (ms per test):"));
+  nLen = 0;
+  for (uiLevel = 0 ; uiLevel < CU_ISA_NUM_LEVELS ; uiLevel++) {
+    if (0 != (uiLevels & CU_ISA_LEVEL_MASK(uiLevel))) {
+      nLen += (size_t)snprintf(szLine + nLen, sizeof(szLine) - nLen, " %10s", f_szLevelNames[uiLevel]);
+    }
+  }
+  VLA_info("  %-32s%s", "", szLine);
+
+  for (i = 0 ; i < f_uiNumResults ; i++) {
+    pResult = &f_results[i];
+    nLen = 0;
+    for (uiLevel = 0 ; uiLevel < CU_ISA_NUM_LEVELS ; uiLevel++) {
+      if (0 == (uiLevels & CU_ISA_LEVEL_MASK(uiLevel))) {
+        continue;
+      }
+      switch (pResult->aeOutcome[uiLevel]) {
+        case CUTO_Passed:
+          nLen += (size_t)snprintf(szLine + nLen, sizeof(szLine) - nLen, " %10.3f",
+                                   pResult->adSeconds[uiLevel] * 1e3);
+          break;
+        case CUTO_Failed:
+          nLen += (size_t)snprintf(szLine + nLen, sizeof(szLine) - nLen, " %10s", _("FAILED"));
+          break;
+        default:
+          nLen += (size_t)snprintf(szLine + nLen, sizeof(szLine) - nLen, " %10s", "-");
+          break;
+      }
+    }
+    snprintf(szName, sizeof(szName), "%s:%s", pResult->pSuite->pName, pResult->pTest->pName);
+    VLA_info("  %-32s%s", szName, szLine);
+  }
+}
+
+/** @} */
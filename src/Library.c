@@ -0,0 +1,464 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Implementation of suite loading from shared libraries.
+ *
+ *  19-Oct-2026   Initial implementation of suite libraries and watch mode.
+ */
+
+/** @file
+ *  Loading of test suites from shared libraries (implementation).
+ */
+/** @addtogroup Framework
+ @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <signal.h>
+#ifdef LINUX
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/stat.h>
+#endif
+
+#include "CUnit.h"
+#include "TestDB.h"
+#include "TestRun.h"
+#include "Library.h"
+#include "VLA_Lite_Log.h"
+#include "CUnit_intl.h"
+
+/*=================================================================
+ *  Global/Static Definitions
+ *=================================================================*/
+#ifdef LINUX
+
+/** Default polling interval of the watch mode in milliseconds. */
+#define LIBRARY_DEFAULT_INTERVAL_MS 500
+
+/** Identity of a library file, used to detect rebuilds. */
+typedef struct library_stamp
+{
+  dev_t           dev;
+  ino_t           ino;
+  off_t           size;
+  struct timespec mtime;
+} library_stamp;
+
+/** A loaded test library. */
+typedef struct library_entry
+{
+  char          szPath[CU_MAX_LIBRARY_PATH];   /**< Path given by the user, empty if slot is free. */
+  void*         pHandle;                       /**< dlopen() handle of the private copy. */
+  CU_pSuite     apSuites[MAX_NUM_OF_SUITES];   /**< Suites registered from the library. */
+  unsigned int  uiNumberOfSuites;              /**< Number of entries in apSuites. */
+  library_stamp loaded;                        /**< File identity when loaded. */
+  library_stamp seen;                          /**< File identity at the last poll. */
+  CU_BOOL       bChanged;                      /**< File changed since loaded, awaiting a stable poll. */
+} library_entry;
+
+static library_entry f_libraries[CU_MAX_LIBRARIES];
+static volatile sig_atomic_t f_bStopWatching = 0;
+
+/*=================================================================
+ *  Private function forward declarations
+ *=================================================================*/
+static library_entry* find_library(const char *szPath);
+static CU_BOOL        read_stamp(const char *szPath, library_stamp *pStamp);
+static CU_BOOL        same_stamp(const library_stamp *pA, const library_stamp *pB);
+static void*          open_private_copy(const char *szPath);
+static void           unload_library(library_entry *pLibrary);
+static CU_ErrorCode   run_library_suites(library_entry *pLibrary, CU_LibrarySuiteRunner pRunner);
+
+/*=================================================================
+ *  Public Interface functions
+ *=================================================================*/
+CU_ErrorCode CU_load_suites_from_library(const char *szPath)
+{
+  CU_pTestRegistry pRegistry = CU_get_registry();
+  library_entry *pLibrary = NULL;
+  CU_pSuiteInfo pSuiteInfo = NULL;
+  CU_pSuite pLastSuite = NULL;
+  CU_pSuite pSuite = NULL;
+  CU_ErrorCode result = CUE_SUCCESS;
+  unsigned int i;
+
+  assert(CU_FALSE == CU_is_test_running());
+
+  if (NULL == pRegistry) {
+    CU_set_error(CUE_NOREGISTRY);
+    return CUE_NOREGISTRY;
+  }
+  if ((NULL == szPath) || ('\0' == *szPath) || (strlen(szPath) >= CU_MAX_LIBRARY_PATH)) {
+    CU_set_error(CUE_BAD_FILENAME);
+    return CUE_BAD_FILENAME;
+  }
+
+  if (NULL != (pLibrary = find_library(szPath))) {
+    unload_library(pLibrary);
+  }
+  else if (NULL == (pLibrary = find_library(""))) {
+    CU_set_error(CUE_NOMEMORY);
+    return CUE_NOMEMORY;
+  }
+
+  if (CU_FALSE == read_stamp(szPath, &pLibrary->loaded)) {
+    CU_set_error(CUE_BAD_FILENAME);
+    return CUE_BAD_FILENAME;
+  }
+
+  if (NULL == (pLibrary->pHandle = open_private_copy(szPath))) {
+    CU_set_error(CUE_DLOPEN_FAILED);
+    return CUE_DLOPEN_FAILED;
+  }
+
+  if (NULL == (pSuiteInfo = (CU_pSuiteInfo)dlsym(pLibrary->pHandle, CU_LIBRARY_SUITES_SYMBOL))) {
+    VLA_error("%s: %s", szPath, dlerror());
+    dlclose(pLibrary->pHandle);
+    pLibrary->pHandle = NULL;
+    CU_set_error(CUE_DLOPEN_FAILED);
+    return CUE_DLOPEN_FAILED;
+  }
+
+  strcpy(pLibrary->szPath, szPath);
+  pLibrary->seen = pLibrary->loaded;
+  pLibrary->bChanged = CU_FALSE;
+
+  /* the library's suites are appended after the current last suite */
+  for (pSuite = pRegistry->pSuite ; NULL != pSuite ; pSuite = pSuite->pNext) {
+    pLastSuite = pSuite;
+  }
+
+  result = CU_register_suites(pSuiteInfo);
+
+  pSuite = (NULL != pLastSuite) ? pLastSuite->pNext : pRegistry->pSuite;
+  for (i = 0 ; (NULL != pSuite) && (i < MAX_NUM_OF_SUITES) ; pSuite = pSuite->pNext) {
+    pLibrary->apSuites[i++] = pSuite;
+  }
+  pLibrary->uiNumberOfSuites = i;
+
+  if (CUE_SUCCESS != result) {
+    unload_library(pLibrary);
+  }
+
+  CU_set_error(result);
+  return result;
+}
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_unload_suites_from_library(const char *szPath)
+{
+  library_entry *pLibrary = NULL;
+
+  assert(CU_FALSE == CU_is_test_running());
+
+  if ((NULL == szPath) || ('\0' == *szPath) || (NULL == (pLibrary = find_library(szPath)))) {
+    CU_set_error(CUE_BAD_FILENAME);
+    return CUE_BAD_FILENAME;
+  }
+
+  unload_library(pLibrary);
+  CU_set_error(CUE_SUCCESS);
+  return CUE_SUCCESS;
+}
+
+/*------------------------------------------------------------------------*/
+void CU_unload_all_libraries(void)
+{
+  unsigned int i;
+
+  assert(CU_FALSE == CU_is_test_running());
+
+  for (i = 0 ; i < CU_MAX_LIBRARIES ; i++) {
+    if ('\0' != f_libraries[i].szPath[0]) {
+      unload_library(&f_libraries[i]);
+    }
+  }
+}
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_watch_libraries(unsigned int uiIntervalMs, CU_LibrarySuiteRunner pRunner)
+{
+  library_entry *pLibrary = NULL;
+  library_stamp stamp;
+  struct timespec interval;
+  char szPath[CU_MAX_LIBRARY_PATH];
+  unsigned int i;
+
+  assert(CU_FALSE == CU_is_test_running());
+
+  if (NULL == CU_get_registry()) {
+    CU_set_error(CUE_NOREGISTRY);
+    return CUE_NOREGISTRY;
+  }
+
+  if (0 == uiIntervalMs) {
+    uiIntervalMs = LIBRARY_DEFAULT_INTERVAL_MS;
+  }
+  if (NULL == pRunner) {
+    pRunner = CU_run_suite;
+  }
+  interval.tv_sec = uiIntervalMs / 1000;
+  interval.tv_nsec = (long)(uiIntervalMs % 1000) * 1000000L;
+
+  f_bStopWatching = 0;
+  while (0 == f_bStopWatching) {
+    nanosleep(&interval, NULL);
+
+    for (i = 0 ; (i < CU_MAX_LIBRARIES) && (0 == f_bStopWatching) ; i++) {
+      pLibrary = &f_libraries[i];
+      if (('\0' == pLibrary->szPath[0]) || (CU_FALSE == read_stamp(pLibrary->szPath, &stamp))) {
+        /* a file being replaced may be missing for a moment */
+        continue;
+      }
+
+      if (CU_FALSE == same_stamp(&stamp, &pLibrary->seen)) {
+        pLibrary->seen = stamp;
+        pLibrary->bChanged = CU_FALSE == same_stamp(&stamp, &pLibrary->loaded) ? CU_TRUE : CU_FALSE;
+        continue;
+      }
+      if (CU_FALSE == pLibrary->bChanged) {
+        continue;
+      }
+
+      VLA_info(_("Reloading test library %s."), pLibrary->szPath);
+      strcpy(szPath, pLibrary->szPath);
+      if (CUE_SUCCESS != CU_load_suites_from_library(szPath)) {
+        VLA_error("%s: %s", szPath, CU_get_error_msg());
+        /* keep watching the file, retry on its next change */
+        if (NULL == find_library(szPath) && (NULL != (pLibrary = find_library("")))) {
+          strcpy(pLibrary->szPath, szPath);
+          pLibrary->loaded = stamp;
+          pLibrary->seen = stamp;
+          pLibrary->bChanged = CU_FALSE;
+        }
+        continue;
+      }
+      run_library_suites(find_library(szPath), pRunner);
+    }
+  }
+
+  CU_set_error(CUE_SUCCESS);
+  return CUE_SUCCESS;
+}
+
+/*------------------------------------------------------------------------*/
+void CU_stop_watching_libraries(void)
+{
+  f_bStopWatching = 1;
+}
+
+/*=================================================================
+ *  Static module functions
+ *=================================================================*/
+/**
+ *  Finds the library table entry for szPath.
+ *  An empty szPath finds a free entry.
+ *
+ *  @param szPath Library path (non-NULL).
+ *  @return The entry, or NULL if none was found.
+ */
+static library_entry* find_library(const char *szPath)
+{
+  unsigned int i;
+
+  assert(NULL != szPath);
+
+  for (i = 0 ; i < CU_MAX_LIBRARIES ; i++) {
+    if (0 == strcmp(f_libraries[i].szPath, szPath)) {
+      return &f_libraries[i];
+    }
+  }
+  return NULL;
+}
+
+/*------------------------------------------------------------------------*/
+/** Reads the identity of the file at szPath into pStamp. */
+static CU_BOOL read_stamp(const char *szPath, library_stamp *pStamp)
+{
+  struct stat st;
+
+  if (0 != stat(szPath, &st)) {
+    return CU_FALSE;
+  }
+  pStamp->dev = st.st_dev;
+  pStamp->ino = st.st_ino;
+  pStamp->size = st.st_size;
+  pStamp->mtime = st.st_mtim;
+  return CU_TRUE;
+}
+
+/*------------------------------------------------------------------------*/
+/** Compares two file identities. */
+static CU_BOOL same_stamp(const library_stamp *pA, const library_stamp *pB)
+{
+  return ((pA->dev == pB->dev) &&
+          (pA->ino == pB->ino) &&
+          (pA->size == pB->size) &&
+          (pA->mtime.tv_sec == pB->mtime.tv_sec) &&
+          (pA->mtime.tv_nsec == pB->mtime.tv_nsec)) ? CU_TRUE : CU_FALSE;
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Loads a private copy of the library at szPath.
+ *  The dynamic loader reuses an already mapped object with the same
+ *  path, and the library may be rebuilt in place while it is mapped, so
+ *  the file is copied to a unique temporary file which is removed again
+ *  once loaded.
+ *
+ *  @param szPath Library path (non-NULL).
+ *  @return The dlopen() handle, or NULL on error.
+ */
+static void* open_private_copy(const char *szPath)
+{
+  const char *szTmpDir = getenv("TMPDIR");
+  char szCopy[CU_MAX_LIBRARY_PATH + 32];
+  char buffer[BUFSIZ];
+  void *pHandle = NULL;
+  ssize_t count = 0;
+  int in = -1;
+  int out = -1;
+
+  snprintf(szCopy, sizeof(szCopy), "%s/cunit-lib-XXXXXX",
+           ((NULL != szTmpDir) && ('\0' != *szTmpDir)) ? szTmpDir : "/tmp");
+
+  if ((in = open(szPath, O_RDONLY | O_CLOEXEC)) < 0) {
+    VLA_error(_("Unable to open test library %s."), szPath);
+    return NULL;
+  }
+  if ((out = mkstemp(szCopy)) < 0) {
+    VLA_error(_("Unable to create a copy of test library %s."), szPath);
+    close(in);
+    return NULL;
+  }
+
+  while ((count = read(in, buffer, sizeof(buffer))) > 0) {
+    if (write(out, buffer, (size_t)count) != count) {
+      count = -1;
+      break;
+    }
+  }
+  close(in);
+  if (0 != close(out)) {
+    count = -1;
+  }
+
+  if (count < 0) {
+    VLA_error(_("Unable to copy test library %s."), szPath);
+  }
+  else if (NULL == (pHandle = dlopen(szCopy, RTLD_NOW | RTLD_LOCAL))) {
+    VLA_error("%s", dlerror());
+  }
+
+  unlink(szCopy);
+  return pHandle;
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Removes the suites of a library from the registry and unloads it.
+ *  The previous results are cleared first, since failure records refer
+ *  to the suites and tests being released.
+ */
+static void unload_library(library_entry *pLibrary)
+{
+  unsigned int i;
+
+  assert(NULL != pLibrary);
+
+  CU_clear_previous_results();
+
+  for (i = 0 ; i < pLibrary->uiNumberOfSuites ; i++) {
+    CU_remove_suite(pLibrary->apSuites[i]);
+  }
+  pLibrary->uiNumberOfSuites = 0;
+
+  if (NULL != pLibrary->pHandle) {
+    dlclose(pLibrary->pHandle);
+    pLibrary->pHandle = NULL;
+  }
+  pLibrary->szPath[0] = '\0';
+  pLibrary->bChanged = CU_FALSE;
+}
+
+/*------------------------------------------------------------------------*/
+/** Runs the suites of a freshly loaded library with pRunner. */
+static CU_ErrorCode run_library_suites(library_entry *pLibrary, CU_LibrarySuiteRunner pRunner)
+{
+  CU_ErrorCode result = CUE_SUCCESS;
+  CU_ErrorCode error;
+  unsigned int i;
+
+  if (NULL == pLibrary) {
+    return CUE_SUCCESS;
+  }
+
+  for (i = 0 ; i < pLibrary->uiNumberOfSuites ; i++) {
+    error = (*pRunner)(pLibrary->apSuites[i]);
+    if (CUE_SUCCESS == result) {
+      result = error;
+    }
+  }
+  return result;
+}
+
+#else  /* LINUX */
+
+/*=================================================================
+ *  Public Interface functions (not supported)
+ *=================================================================*/
+CU_ErrorCode CU_load_suites_from_library(const char *szPath)
+{
+  CU_UNREFERENCED_PARAMETER(szPath);
+  CU_set_error(CUE_DLOPEN_FAILED);
+  return CUE_DLOPEN_FAILED;
+}
+
+CU_ErrorCode CU_unload_suites_from_library(const char *szPath)
+{
+  CU_UNREFERENCED_PARAMETER(szPath);
+  CU_set_error(CUE_BAD_FILENAME);
+  return CUE_BAD_FILENAME;
+}
+
+void CU_unload_all_libraries(void)
+{
+}
+
+CU_ErrorCode CU_watch_libraries(unsigned int uiIntervalMs, CU_LibrarySuiteRunner pRunner)
+{
+  CU_UNREFERENCED_PARAMETER(uiIntervalMs);
+  CU_UNREFERENCED_PARAMETER(pRunner);
+  CU_set_error(CUE_SUCCESS);
+  return CUE_SUCCESS;
+}
+
+void CU_stop_watching_libraries(void)
+{
+}
+
+#endif /* LINUX */
+
+/** @} */
@@ -0,0 +1,101 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Implementation of call-recording mock functions.
+ *
+ *  19-Oct-2026   Initial implementation of mocks.
+ */
+
+/** @file
+ *  Call-recording mock functions (implementation).
+ */
+/** @addtogroup Framework
+ @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "CUnit.h"
+#include "TestRun.h"
+#include "Mock.h"
+#include "CUnit_intl.h"
+
+/*=================================================================
+ *  Global/Static Definitions
+ *=================================================================*/
+/** Mocks used since the last reset (intrusive list, no allocation). */
+static CU_pMock f_pMockList = NULL;
+
+/*=================================================================
+ *  Public Interface functions
+ *=================================================================*/
+void CU_register_mock(CU_pMock pMock, const char *pName)
+{
+  assert(NULL != pMock);
+  assert(NULL != pName);
+
+  if (CU_FALSE == pMock->fRegistered) {
+    pMock->pName = pName;
+    pMock->fRegistered = CU_TRUE;
+    pMock->pNext = f_pMockList;
+    f_pMockList = pMock;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+void CU_reset_mocks(void)
+{
+  CU_pMock pMock = f_pMockList;
+  CU_pMock pNext = NULL;
+
+  /* mocks re-register on first use, so the list never refers to mocks
+   * of an unloaded test library */
+  while (NULL != pMock) {
+    pNext = pMock->pNext;
+    pMock->uiCalls = 0;
+    pMock->uiNumberOfReturns = 0;
+    pMock->uiNextReturn = 0;
+    pMock->fRepeatLast = CU_FALSE;
+    pMock->fRegistered = CU_FALSE;
+    pMock->pNext = NULL;
+    pMock = pNext;
+  }
+  f_pMockList = NULL;
+}
+
+/*------------------------------------------------------------------------*/
+unsigned int CU_mock_add_return(CU_pMock pMock, const char *pName)
+{
+  assert(NULL != pMock);
+
+  CU_register_mock(pMock, pName);
+
+  if (pMock->uiNumberOfReturns >= CU_MOCK_MAX_RETURNS) {
+    if (CU_FALSE != CU_is_test_running()) {
+      CU_assertImplementation(CU_FALSE, 0, _("Too many mock return values scripted."),
+                              pMock->pName, "", CU_FALSE);
+    }
+    return CU_MOCK_MAX_RETURNS;
+  }
+  return pMock->uiNumberOfReturns++;
+}
+
+/** @} */
@@ -0,0 +1,584 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Implementation of runtime mutation testing.
+ *
+ *  19-Oct-2026   Initial implementation of mutation testing.
+ */
+
+/** @file
+ *  Runtime mutation testing (implementation).
+ */
+/** @addtogroup Framework
+ @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <limits.h>
+#ifdef LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
+#include "CUnit.h"
+#include "TestDB.h"
+#include "TestRun.h"
+#include "Export.h"
+#include "Mutation.h"
+#include "VLA_Lite_Log.h"
+#include "CUnit_intl.h"
+
+/*=================================================================
+ *  Global/Static Definitions
+ *=================================================================*/
+#ifdef LINUX
+
+/** Maximum number of workers running at the same time. */
+#define MUTATION_MAX_WORKERS 64U
+
+/** Id of sites beyond CU_MUTATION_MAX_SITES (never active). */
+#define MUTATION_UNTRACKED UINT_MAX
+
+/** Bytes of the coverage bitmap of a test. */
+#define MUTATION_COVERAGE_BYTES ((CU_MUTATION_MAX_SITES + 7U) / 8U)
+
+/** Outcome of a mutant for a suite. */
+typedef enum mutation_result
+{
+  MUTATION_NOT_COVERED = 0,   /**< No test of the suite reaches the site. */
+  MUTATION_PENDING,           /**< Not yet tested. */
+  MUTATION_SURVIVED,          /**< All covering tests passed. */
+  MUTATION_KILLED             /**< A covering test failed or crashed. */
+} mutation_result;
+
+/** A running worker. */
+typedef struct mutation_worker
+{
+  pid_t           pid;        /**< Process id, 0 if the slot is free. */
+  unsigned int    uiSite;     /**< Index of the site tested. */
+  unsigned int    uiSuite;    /**< Index of the suite tested. */
+  struct timespec deadline;   /**< Time limit of the worker. */
+} mutation_worker;
+
+static CU_pMutationSite f_apSites[CU_MUTATION_MAX_SITES];
+static unsigned int     f_uiNumSites = 0;
+static CU_BOOL          f_bSitesDropped = CU_FALSE;
+
+/* the only state read on the path of a site that is not recording */
+static unsigned int     f_uiActiveSite = 0;
+static CU_BOOL          f_bRecording = CU_FALSE;
+
+static unsigned char    f_aucCoverage[MAX_NUM_OF_TESTS][MUTATION_COVERAGE_BYTES];
+static CU_BOOL          f_abBaselineFailed[MAX_NUM_OF_TESTS];
+static unsigned char    f_aucResults[CU_MUTATION_MAX_SITES][MAX_NUM_OF_SUITES];
+static unsigned int     f_uiTimeouts = 0;
+
+/* test index cache of the coverage pass */
+static CU_pTest         f_pIndexedTest = NULL;
+static unsigned int     f_uiIndexedTest = MAX_NUM_OF_TESTS;
+
+static mutation_worker  f_workers[MUTATION_MAX_WORKERS];
+
+/*=================================================================
+ *  Private function forward declarations
+ *=================================================================*/
+static void         register_site(CU_pMutationSite pSite);
+static unsigned int test_index(CU_pTest pTest);
+static CU_BOOL      is_covered(unsigned int uiTest, unsigned int uiSite);
+static void         run_coverage_pass(void);
+static pid_t        start_worker(unsigned int uiSite, unsigned int uiSuite);
+static void         run_mutant(unsigned int uiSite, unsigned int uiSuite);
+static CU_BOOL      reap_workers(void);
+static void         kill_late_workers(void);
+static double       seconds_since(const struct timespec *pStart);
+static void         report_scores(void);
+
+/*=================================================================
+ *  Public Interface functions
+ *=================================================================*/
+CU_BOOL CU_mutation_hit(CU_pMutationSite pSite)
+{
+  unsigned int uiTest;
+
+  assert(NULL != pSite);
+
+  if (0 == pSite->uiId) {
+    register_site(pSite);
+  }
+  if ((CU_FALSE != f_bRecording) && (MUTATION_UNTRACKED != pSite->uiId)) {
+    if (CU_get_current_test() != f_pIndexedTest) {
+      f_pIndexedTest = CU_get_current_test();
+      f_uiIndexedTest = test_index(f_pIndexedTest);
+    }
+    uiTest = f_uiIndexedTest;
+    if (uiTest < MAX_NUM_OF_TESTS) {
+      f_aucCoverage[uiTest][(pSite->uiId - 1) / 8] |= (unsigned char)(1U << ((pSite->uiId - 1) % 8));
+    }
+  }
+  return (pSite->uiId == f_uiActiveSite) ? CU_TRUE : CU_FALSE;
+}
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_mutation_run(unsigned int uiWorkers, double dTimeout)
+{
+  CU_pTestRegistry pRegistry = CU_get_registry();
+  CU_pSuite pSuite;
+  CU_pTest pTest;
+  struct timespec start;
+  unsigned int uiSite;
+  unsigned int uiSuite;
+  unsigned int uiTest;
+  unsigned int uiRunning = 0;
+  unsigned int i;
+  long lCpus;
+  pid_t pid;
+
+  assert(CU_FALSE == CU_is_test_running());
+
+  if (NULL == pRegistry) {
+    CU_set_error(CUE_NOREGISTRY);
+    return CUE_NOREGISTRY;
+  }
+  if (0 == uiWorkers) {
+    lCpus = sysconf(_SC_NPROCESSORS_ONLN);
+    uiWorkers = (lCpus > 0) ? (unsigned int)lCpus : 1U;
+  }
+  if (uiWorkers > MUTATION_MAX_WORKERS) {
+    uiWorkers = MUTATION_MAX_WORKERS;
+  }
+
+  CU_export_stream_results(-1);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  run_coverage_pass();
+  if (dTimeout <= 0.0) {
+    dTimeout = 10.0 * seconds_since(&start) + 1.0;
+  }
+
+  /* a mutant is tested against every suite with a covering test */
+  memset(f_aucResults, MUTATION_NOT_COVERED, sizeof(f_aucResults));
+  for (pSuite = pRegistry->pSuite, uiSuite = 0, uiTest = 0 ;
+       (NULL != pSuite) && (uiSuite < MAX_NUM_OF_SUITES) ;
+       pSuite = pSuite->pNext, uiSuite++) {
+    for (pTest = pSuite->pTest ; (NULL != pTest) && (uiTest < MAX_NUM_OF_TESTS) ; pTest = pTest->pNext, uiTest++) {
+      if ((CU_FALSE != f_abBaselineFailed[uiTest]) || (CU_FALSE == pSuite->fActive)) {
+        continue;
+      }
+      for (uiSite = 0 ; uiSite < f_uiNumSites ; uiSite++) {
+        if (CU_FALSE != is_covered(uiTest, uiSite)) {
+          f_aucResults[uiSite][uiSuite] = MUTATION_PENDING;
+        }
+      }
+    }
+  }
+
+  fflush(stdout);
+  fflush(stderr);
+  memset(f_workers, 0, sizeof(f_workers));
+  f_uiTimeouts = 0;
+
+  for (uiSite = 0 ; uiSite < f_uiNumSites ; uiSite++) {
+    for (uiSuite = 0 ; uiSuite < MAX_NUM_OF_SUITES ; uiSuite++) {
+      if (MUTATION_PENDING != f_aucResults[uiSite][uiSuite]) {
+        continue;
+      }
+      while (uiRunning >= uiWorkers) {
+        if (CU_FALSE != reap_workers()) {
+          uiRunning--;
+        }
+        else {
+          kill_late_workers();
+        }
+      }
+      if (0 > (pid = start_worker(uiSite, uiSuite))) {
+        VLA_error(_("Unable to start a mutation worker."));
+        for ( ; uiRunning > 0 ; uiRunning--) {
+          while (CU_FALSE == reap_workers()) {
+            kill_late_workers();
+          }
+        }
+        CU_set_error(CUE_NOMEMORY);
+        return CUE_NOMEMORY;
+      }
+      for (i = 0 ; 0 != f_workers[i].pid ; i++) {
+        /* find a free slot, there is one since uiRunning < uiWorkers */
+      }
+      f_workers[i].pid = pid;
+      f_workers[i].uiSite = uiSite;
+      f_workers[i].uiSuite = uiSuite;
+      clock_gettime(CLOCK_MONOTONIC, &f_workers[i].deadline);
+      f_workers[i].deadline.tv_sec += (time_t)dTimeout;
+      f_workers[i].deadline.tv_nsec += (long)((dTimeout - (double)(time_t)dTimeout) * 1e9);
+      if (f_workers[i].deadline.tv_nsec >= 1000000000L) {
+        f_workers[i].deadline.tv_sec++;
+        f_workers[i].deadline.tv_nsec -= 1000000000L;
+      }
+      uiRunning++;
+    }
+  }
+  for ( ; uiRunning > 0 ; uiRunning--) {
+    while (CU_FALSE == reap_workers()) {
+      kill_late_workers();
+    }
+  }
+
+  report_scores();
+
+  CU_set_error(CUE_SUCCESS);
+  return CUE_SUCCESS;
+}
+
+/*------------------------------------------------------------------------*/
+double CU_mutation_get_score(CU_pSuite pSuite)
+{
+  CU_pTestRegistry pRegistry = CU_get_registry();
+  CU_pSuite pCur;
+  unsigned int uiSuite = MAX_NUM_OF_SUITES;
+  unsigned int uiMutants = 0;
+  unsigned int uiKilled = 0;
+  unsigned int uiSite;
+  unsigned int i;
+  CU_BOOL bCovered;
+  CU_BOOL bKilled;
+
+  if ((NULL != pSuite) && (NULL != pRegistry)) {
+    for (pCur = pRegistry->pSuite, i = 0 ;
+         (NULL != pCur) && (i < MAX_NUM_OF_SUITES) ;
+         pCur = pCur->pNext, i++) {
+      if (pCur == pSuite) {
+        uiSuite = i;
+        break;
+      }
+    }
+    if (MAX_NUM_OF_SUITES == uiSuite) {
+      return -1.0;
+    }
+  }
+
+  for (uiSite = 0 ; uiSite < f_uiNumSites ; uiSite++) {
+    bCovered = CU_FALSE;
+    bKilled = CU_FALSE;
+    for (i = 0 ; i < MAX_NUM_OF_SUITES ; i++) {
+      if ((MAX_NUM_OF_SUITES != uiSuite) && (i != uiSuite)) {
+        continue;
+      }
+      if ((MUTATION_SURVIVED == f_aucResults[uiSite][i]) || (MUTATION_KILLED == f_aucResults[uiSite][i])) {
+        bCovered = CU_TRUE;
+      }
+      if (MUTATION_KILLED == f_aucResults[uiSite][i]) {
+        bKilled = CU_TRUE;
+      }
+    }
+    if (CU_FALSE != bCovered) {
+      uiMutants++;
+      if (CU_FALSE != bKilled) {
+        uiKilled++;
+      }
+    }
+  }
+
+  return (0 == uiMutants) ? -1.0 : (double)uiKilled / (double)uiMutants;
+}
+
+/*=================================================================
+ *  Static module functions
+ *=================================================================*/
+/** Assigns the next id to a site reached for the first time. */
+static void register_site(CU_pMutationSite pSite)
+{
+  if (f_uiNumSites >= CU_MUTATION_MAX_SITES) {
+    if (CU_FALSE == f_bSitesDropped) {
+      VLA_error(_("More than %u mutation sites, %s:%u and later sites are not mutated."),
+                CU_MUTATION_MAX_SITES, pSite->strFile, pSite->uiLine);
+      f_bSitesDropped = CU_TRUE;
+    }
+    pSite->uiId = MUTATION_UNTRACKED;
+    return;
+  }
+  f_apSites[f_uiNumSites++] = pSite;
+  pSite->uiId = f_uiNumSites;
+}
+
+/*------------------------------------------------------------------------*/
+/** Returns the position of a test in the registry, MAX_NUM_OF_TESTS if unknown. */
+static unsigned int test_index(CU_pTest pTest)
+{
+  CU_pTestRegistry pRegistry = CU_get_registry();
+  CU_pSuite pSuite;
+  CU_pTest pCur;
+  unsigned int uiTest = 0;
+
+  if ((NULL == pTest) || (NULL == pRegistry)) {
+    return MAX_NUM_OF_TESTS;
+  }
+  for (pSuite = pRegistry->pSuite ; NULL != pSuite ; pSuite = pSuite->pNext) {
+    for (pCur = pSuite->pTest ; (NULL != pCur) && (uiTest < MAX_NUM_OF_TESTS) ; pCur = pCur->pNext, uiTest++) {
+      if (pCur == pTest) {
+        return uiTest;
+      }
+    }
+  }
+  return MAX_NUM_OF_TESTS;
+}
+
+/*------------------------------------------------------------------------*/
+static CU_BOOL is_covered(unsigned int uiTest, unsigned int uiSite)
+{
+  return (0 != (f_aucCoverage[uiTest][uiSite / 8] & (1U << (uiSite % 8)))) ? CU_TRUE : CU_FALSE;
+}
+
+/*------------------------------------------------------------------------*/
+/** Runs all tests without mutation, recording the sites each test reaches. */
+static void run_coverage_pass(void)
+{
+  CU_pFailureRecord pFailure;
+  unsigned int uiTest;
+
+  memset(f_aucCoverage, 0, sizeof(f_aucCoverage));
+  memset(f_abBaselineFailed, 0, sizeof(f_abBaselineFailed));
+  f_pIndexedTest = NULL;
+  f_uiIndexedTest = MAX_NUM_OF_TESTS;
+  f_uiActiveSite = 0;
+
+  f_bRecording = CU_TRUE;
+  CU_run_all_tests();
+  f_bRecording = CU_FALSE;
+
+  /* a test failing anyway cannot tell whether a mutant is detected */
+  for (pFailure = CU_get_failure_list() ; NULL != pFailure ; pFailure = pFailure->pNext) {
+    if ((NULL != pFailure->pTest) && ((uiTest = test_index(pFailure->pTest)) < MAX_NUM_OF_TESTS)) {
+      f_abBaselineFailed[uiTest] = CU_TRUE;
+    }
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/** Forks a worker testing a site against a suite. */
+static pid_t start_worker(unsigned int uiSite, unsigned int uiSuite)
+{
+  pid_t pid = fork();
+
+  if (0 == pid) {
+    run_mutant(uiSite, uiSuite);
+    /* not reached */
+  }
+  return pid;
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Body of a worker: runs the covering tests of a suite with the site
+ *  active and exits with 1 at the first failure, 0 if all passed.
+ */
+static void run_mutant(unsigned int uiSite, unsigned int uiSuite)
+{
+  CU_pSuite pSuite = CU_get_registry()->pSuite;
+  CU_pTest pTest;
+  unsigned int uiTest = 0;
+  unsigned int i;
+  int iNull;
+
+  /* the handlers of the parent may print or wait for its threads */
+  CU_set_suite_start_handler(NULL);
+  CU_set_test_start_handler(NULL);
+  CU_set_test_complete_handler(NULL);
+  CU_set_suite_complete_handler(NULL);
+  CU_set_all_test_complete_handler(NULL);
+  CU_set_suite_init_failure_handler(NULL);
+  CU_set_suite_cleanup_failure_handler(NULL);
+
+  if (0 <= (iNull = open("/dev/null", O_WRONLY))) {
+    dup2(iNull, STDOUT_FILENO);
+    dup2(iNull, STDERR_FILENO);
+    close(iNull);
+  }
+
+  for (i = 0 ; i < uiSuite ; i++) {
+    for (pTest = pSuite->pTest ; NULL != pTest ; pTest = pTest->pNext) {
+      uiTest++;
+    }
+    pSuite = pSuite->pNext;
+  }
+
+  f_uiActiveSite = f_apSites[uiSite]->uiId;
+  for (pTest = pSuite->pTest ; (NULL != pTest) && (uiTest < MAX_NUM_OF_TESTS) ; pTest = pTest->pNext, uiTest++) {
+    if ((CU_FALSE == pTest->fActive) || (CU_FALSE != f_abBaselineFailed[uiTest]) ||
+        (CU_FALSE == is_covered(uiTest, uiSite))) {
+      continue;
+    }
+    if ((CUE_SUCCESS != CU_run_test(pSuite, pTest)) || (0 != CU_get_number_of_failure_records())) {
+      _exit(1);
+    }
+  }
+  _exit(0);
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Collects a finished worker and records its result.
+ *  @return CU_TRUE if a worker was collected.
+ */
+static CU_BOOL reap_workers(void)
+{
+  struct timespec pause = { 0, 1000000L };
+  int iStatus;
+  pid_t pid;
+  unsigned int i;
+
+  while (0 < (pid = waitpid(-1, &iStatus, WNOHANG))) {
+    for (i = 0 ; i < MUTATION_MAX_WORKERS ; i++) {
+      if (f_workers[i].pid != pid) {
+        continue;
+      }
+      f_aucResults[f_workers[i].uiSite][f_workers[i].uiSuite] =
+        (WIFEXITED(iStatus) && (0 == WEXITSTATUS(iStatus))) ? MUTATION_SURVIVED : MUTATION_KILLED;
+      f_workers[i].pid = 0;
+      return CU_TRUE;
+    }
+    /* not a worker, e.g. a process started by a test */
+  }
+  nanosleep(&pause, NULL);
+  return CU_FALSE;
+}
+
+/*------------------------------------------------------------------------*/
+/** Kills workers beyond their time limit (the mutant counts as killed). */
+static void kill_late_workers(void)
+{
+  struct timespec now;
+  unsigned int i;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  for (i = 0 ; i < MUTATION_MAX_WORKERS ; i++) {
+    if ((0 == f_workers[i].pid) ||
+        (now.tv_sec < f_workers[i].deadline.tv_sec) ||
+        ((now.tv_sec == f_workers[i].deadline.tv_sec) && (now.tv_nsec < f_workers[i].deadline.tv_nsec))) {
+      continue;
+    }
+    kill(f_workers[i].pid, SIGKILL);
+    f_workers[i].deadline.tv_sec += 3600;
+    f_uiTimeouts++;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+static double seconds_since(const struct timespec *pStart)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)(now.tv_sec - pStart->tv_sec)
+       + (double)(now.tv_nsec - pStart->tv_nsec) / 1e9;
+}
+
+/*------------------------------------------------------------------------*/
+/** Prints the score of each suite and the surviving mutants. */
+static void report_scores(void)
+{
+  CU_pSuite pSuite;
+  CU_pMutationSite pSite;
+  unsigned int uiSuite;
+  unsigned int uiSite;
+  unsigned int uiMutants;
+  unsigned int uiKilled;
+  double dScore;
+
+  dScore = CU_mutation_get_score(NULL);
+  if (dScore < 0.0) {
+    VLA_info(_("Mutation run: no mutation site reached by a passing test."));
+    return;
+  }
+  VLA_info(_("Mutation run: %u sites, score %.1f%% (%u timeouts)."),
+           f_uiNumSites,
+           100.0 * dScore, f_uiTimeouts);
+
+  for (pSuite = CU_get_registry()->pSuite, uiSuite = 0 ;
+       (NULL != pSuite) && (uiSuite < MAX_NUM_OF_SUITES) ;
+       pSuite = pSuite->pNext, uiSuite++) {
+    uiMutants = 0;
+    uiKilled = 0;
+    for (uiSite = 0 ; uiSite < f_uiNumSites ; uiSite++) {
+      if (MUTATION_NOT_COVERED != f_aucResults[uiSite][uiSuite]) {
+        uiMutants++;
+      }
+      if (MUTATION_KILLED == f_aucResults[uiSite][uiSuite]) {
+        uiKilled++;
+      }
+    }
+    if (0 != uiMutants) {
+      VLA_info(_("  %-32s %u/%u killed (%.1f%%)"), pSuite->pName, uiKilled, uiMutants,
+               100.0 * (double)uiKilled / (double)uiMutants);
+    }
+  }
+
+  /* a mutant survives if it was tested and no suite killed it */
+  for (uiSite = 0 ; uiSite < f_uiNumSites ; uiSite++) {
+    uiMutants = 0;
+    uiKilled = 0;
+    for (uiSuite = 0 ; uiSuite < MAX_NUM_OF_SUITES ; uiSuite++) {
+      if (MUTATION_NOT_COVERED != f_aucResults[uiSite][uiSuite]) {
+        uiMutants++;
+      }
+      if (MUTATION_KILLED == f_aucResults[uiSite][uiSuite]) {
+        uiKilled++;
+      }
+    }
+    if ((0 != uiMutants) && (0 == uiKilled)) {
+      pSite = f_apSites[uiSite];
+      VLA_info(_("  survived: %s:%u  %s -> %s"), pSite->strFile, pSite->uiLine,
+               pSite->strOriginal, pSite->strMutant);
+    }
+  }
+}
+
+#else  /* LINUX */
+
+/*=================================================================
+ *  Public Interface functions (not supported)
+ *=================================================================*/
+CU_BOOL CU_mutation_hit(CU_pMutationSite pSite)
+{
+  CU_UNREFERENCED_PARAMETER(pSite);
+  return CU_FALSE;
+}
+
+CU_ErrorCode CU_mutation_run(unsigned int uiWorkers, double dTimeout)
+{
+  CU_UNREFERENCED_PARAMETER(uiWorkers);
+  CU_UNREFERENCED_PARAMETER(dTimeout);
+  CU_set_error(CUE_FOPEN_FAILED);
+  return CUE_FOPEN_FAILED;
+}
+
+double CU_mutation_get_score(CU_pSuite pSuite)
+{
+  CU_UNREFERENCED_PARAMETER(pSuite);
+  return -1.0;
+}
+
+#endif /* LINUX */
+
+/** @} */
@@ -0,0 +1,622 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Implementation of deterministic performance checks with hardware counters.
+ *
+ *  19-Oct-2026   Initial implementation of counter-based checks.
+ */
+
+/** @file
+ *  Hardware performance counters (implementation).
+ */
+/** @addtogroup Framework
+ @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#ifdef LINUX
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "CUnit.h"
+#include "TestDB.h"
+#include "TestRun.h"
+#include "PerfCounters.h"
+#include "Util.h"
+#include "VLA_Lite_Log.h"
+#include "CUnit_intl.h"
+
+/*=================================================================
+ *  Global/Static Definitions
+ *=================================================================*/
+#ifdef LINUX
+
+/** Tag on the first line of a budget file. */
+#define PERF_BUDGET_TAG "CUnit-budget"
+
+/** File name used in CUF_PerfRegression failure records. */
+#define PERF_FAILURE_FILE "budget"
+
+/** Budget of a single test. */
+typedef struct perf_budget
+{
+  CU_TestNames       names;                                 /**< Suite and test name. */
+  unsigned int       uiEvents;                              /**< Mask of events with a budget. */
+  unsigned long long aullBudget[CU_PERF_NUM_EVENTS];        /**< Budget of each event. */
+} perf_budget;
+
+/** Counts of a test in the last counter run. */
+typedef struct perf_count
+{
+  CU_pSuite          pSuite;                                /**< Suite of the test. */
+  CU_pTest           pTest;                                 /**< Counted test. */
+  CU_BOOL            bCounted;                              /**< Whether the counts are valid. */
+  unsigned long long aullCounts[CU_PERF_NUM_EVENTS];        /**< Smallest count of each event. */
+} perf_count;
+
+static const char* const f_szEventNames[CU_PERF_NUM_EVENTS] =
+  { "instructions", "L1D misses", "LLC misses" };
+
+static int          f_aiFds[CU_PERF_NUM_EVENTS] = { -1, -1, -1 };  /**< Counter of each event, -1 if closed. */
+static unsigned int f_auiSlots[CU_PERF_NUM_EVENTS];                /**< Position of each event in a group read. */
+static unsigned int f_uiNumOpen = 0;                               /**< Number of open counters. */
+
+static perf_budget   f_budgets[MAX_NUM_OF_TESTS];   /**< Budgets of the current run. */
+static unsigned int  f_uiNumBudgets = 0;            /**< Entries used in f_budgets. */
+static unsigned int  f_uiNextBudget = 0;            /**< Entry expected for the next test. */
+static perf_count    f_counts[MAX_NUM_OF_TESTS];    /**< Counts of the last run. */
+static unsigned int  f_uiNumCounts = 0;             /**< Entries used in f_counts. */
+static CU_PerfConfig f_config;                      /**< Parameters of the current run. */
+static unsigned int  f_uiRunEvents = 0;             /**< Mask of events counted in the last run. */
+
+/*=================================================================
+ *  Private function forward declarations
+ *=================================================================*/
+static int          open_event(unsigned int uiType, unsigned long long ullConfig, int iGroupFd);
+static void         perf_test_body(const CU_pSuite pSuite, const CU_pTest pTest);
+static void         check_budget(CU_pSuite pSuite, CU_pTest pTest, const perf_count *pCount);
+static CU_ErrorCode load_budgets(const char *szFile);
+static CU_BOOL      parse_budget(char *szLine, perf_budget *pBudget);
+static void         report_counts(void);
+
+/*=================================================================
+ *  Public Interface functions
+ *=================================================================*/
+CU_ErrorCode CU_perf_open(unsigned int uiEvents)
+{
+  unsigned long long ullL1d = PERF_COUNT_HW_CACHE_L1D
+                            | ((unsigned long long)PERF_COUNT_HW_CACHE_OP_READ << 8)
+                            | ((unsigned long long)PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  unsigned long long ullLlc = PERF_COUNT_HW_CACHE_LL
+                            | ((unsigned long long)PERF_COUNT_HW_CACHE_OP_READ << 8)
+                            | ((unsigned long long)PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+  CU_perf_close();
+
+  /* the instruction counter leads the group */
+  f_aiFds[CU_PERF_INSTRUCTIONS] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, -1);
+  if (-1 == f_aiFds[CU_PERF_INSTRUCTIONS]) {
+    CU_set_error(CUE_FOPEN_FAILED);
+    return CUE_FOPEN_FAILED;
+  }
+  f_auiSlots[CU_PERF_INSTRUCTIONS] = f_uiNumOpen++;
+
+  if (0 != (uiEvents & CU_PERF_EVENT_MASK(CU_PERF_L1D_MISSES))) {
+    f_aiFds[CU_PERF_L1D_MISSES] = open_event(PERF_TYPE_HW_CACHE, ullL1d, f_aiFds[CU_PERF_INSTRUCTIONS]);
+    if (-1 == f_aiFds[CU_PERF_L1D_MISSES]) {
+      CU_perf_close();
+      CU_set_error(CUE_FOPEN_FAILED);
+      return CUE_FOPEN_FAILED;
+    }
+    f_auiSlots[CU_PERF_L1D_MISSES] = f_uiNumOpen++;
+  }
+  if (0 != (uiEvents & CU_PERF_EVENT_MASK(CU_PERF_LLC_MISSES))) {
+    f_aiFds[CU_PERF_LLC_MISSES] = open_event(PERF_TYPE_HW_CACHE, ullLlc, f_aiFds[CU_PERF_INSTRUCTIONS]);
+    if (-1 == f_aiFds[CU_PERF_LLC_MISSES]) {
+      CU_perf_close();
+      CU_set_error(CUE_FOPEN_FAILED);
+      return CUE_FOPEN_FAILED;
+    }
+    f_auiSlots[CU_PERF_LLC_MISSES] = f_uiNumOpen++;
+  }
+
+  CU_set_error(CUE_SUCCESS);
+  return CUE_SUCCESS;
+}
+
+/*------------------------------------------------------------------------*/
+void CU_perf_close(void)
+{
+  unsigned int i;
+
+  /* followers first, the leader last */
+  for (i = CU_PERF_NUM_EVENTS ; i-- > 0 ; ) {
+    if (-1 != f_aiFds[i]) {
+      close(f_aiFds[i]);
+      f_aiFds[i] = -1;
+    }
+  }
+  f_uiNumOpen = 0;
+}
+
+/*------------------------------------------------------------------------*/
+CU_BOOL CU_perf_is_open(void)
+{
+  return (0 != f_uiNumOpen) ? CU_TRUE : CU_FALSE;
+}
+
+/*------------------------------------------------------------------------*/
+void CU_perf_start(void)
+{
+  if (0 != f_uiNumOpen) {
+    ioctl(f_aiFds[CU_PERF_INSTRUCTIONS], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(f_aiFds[CU_PERF_INSTRUCTIONS], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+CU_BOOL CU_perf_stop(unsigned long long aullCounts[CU_PERF_NUM_EVENTS])
+{
+  /* nr, time enabled, time running, one value per counter */
+  unsigned long long aullRead[3 + CU_PERF_NUM_EVENTS];
+  unsigned int i;
+
+  memset(aullCounts, 0, CU_PERF_NUM_EVENTS * sizeof(unsigned long long));
+  if (0 == f_uiNumOpen) {
+    return CU_FALSE;
+  }
+
+  ioctl(f_aiFds[CU_PERF_INSTRUCTIONS], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+  if ((ssize_t)((3 + f_uiNumOpen) * sizeof(unsigned long long)) !=
+      read(f_aiFds[CU_PERF_INSTRUCTIONS], aullRead, sizeof(aullRead))) {
+    return CU_FALSE;
+  }
+
+  for (i = 0 ; i < CU_PERF_NUM_EVENTS ; i++) {
+    if (-1 != f_aiFds[i]) {
+      aullCounts[i] = aullRead[3 + f_auiSlots[i]];
+    }
+  }
+
+  /* a group that was not on the PMU all the time has estimated counts */
+  return (aullRead[1] == aullRead[2]) ? CU_TRUE : CU_FALSE;
+}
+
+/*------------------------------------------------------------------------*/
+void CU_perf_default_config(CU_pPerfConfig pConfig)
+{
+  assert(NULL != pConfig);
+
+  pConfig->uiEvents = CU_PERF_EVENT_MASK(CU_PERF_INSTRUCTIONS);
+  pConfig->uiRepeats = 3;
+  pConfig->dTolerance = 0.005;
+  pConfig->dMissTolerance = 0.10;
+  pConfig->ulMissSlack = 64;
+}
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_perf_run(CU_pSuite pSuite, const char *szBudgetFile, const CU_PerfConfig *pConfig)
+{
+  CU_TestBodyWrapper pPrevWrapper;
+  CU_BOOL bPrevCountOnly;
+  CU_BOOL bOpened = CU_FALSE;
+  CU_ErrorCode result;
+  unsigned int i;
+
+  assert(CU_FALSE == CU_is_test_running());
+
+  if (NULL == CU_get_registry()) {
+    CU_set_error(CUE_NOREGISTRY);
+    return CUE_NOREGISTRY;
+  }
+  if (NULL == pConfig) {
+    CU_perf_default_config(&f_config);
+  }
+  else {
+    f_config = *pConfig;
+  }
+  if (0 == f_config.uiRepeats) {
+    f_config.uiRepeats = 1;
+  }
+
+  f_uiNumBudgets = 0;
+  f_uiNextBudget = 0;
+  if ((NULL != szBudgetFile) && (CUE_SUCCESS != (result = load_budgets(szBudgetFile)))) {
+    CU_set_error(result);
+    return result;
+  }
+
+  if (CU_FALSE == CU_perf_is_open()) {
+    if (CUE_SUCCESS != (result = CU_perf_open(f_config.uiEvents))) {
+      return result;
+    }
+    bOpened = CU_TRUE;
+  }
+
+  memset(f_counts, 0, sizeof(f_counts));
+  f_uiNumCounts = 0;
+  f_uiRunEvents = 0;
+  for (i = 0 ; i < CU_PERF_NUM_EVENTS ; i++) {
+    if (-1 != f_aiFds[i]) {
+      f_uiRunEvents |= CU_PERF_EVENT_MASK(i);
+    }
+  }
+
+  pPrevWrapper = CU_get_test_body_wrapper();
+  bPrevCountOnly = CU_get_assert_count_only();
+  CU_set_test_body_wrapper(perf_test_body);
+
+  result = (NULL != pSuite) ? CU_run_suite(pSuite) : CU_run_all_tests();
+
+  CU_set_test_body_wrapper(pPrevWrapper);
+  CU_set_assert_count_only(bPrevCountOnly);
+  if (CU_FALSE != bOpened) {
+    CU_perf_close();
+  }
+
+  report_counts();
+
+  CU_set_error(result);
+  return result;
+}
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_perf_write_budgets(const char *szFile)
+{
+  FILE *pFile;
+  CU_ErrorCode result = CUE_SUCCESS;
+  unsigned int i;
+  unsigned int j;
+
+  if ((NULL == szFile) || ('\0' == *szFile)) {
+    CU_set_error(CUE_BAD_FILENAME);
+    return CUE_BAD_FILENAME;
+  }
+  if (NULL == (pFile = fopen(szFile, "w"))) {
+    CU_set_error(CUE_FOPEN_FAILED);
+    return CUE_FOPEN_FAILED;
+  }
+
+  if (0 > fprintf(pFile, "%s\t%d\n", PERF_BUDGET_TAG, CU_PERF_BUDGET_VERSION)) {
+    result = CUE_WRITE_ERROR;
+  }
+  for (i = 0 ; (i < f_uiNumCounts) && (CUE_SUCCESS == result) ; i++) {
+    if ((CU_FALSE == f_counts[i].bCounted) || (CUTO_Passed != f_counts[i].pTest->eOutcome)) {
+      continue;
+    }
+    fprintf(pFile, "%s\t%s", f_counts[i].pSuite->pName, f_counts[i].pTest->pName);
+    for (j = 0 ; j < CU_PERF_NUM_EVENTS ; j++) {
+      if (0 != (f_uiRunEvents & CU_PERF_EVENT_MASK(j))) {
+        fprintf(pFile, "\t%llu", f_counts[i].aullCounts[j]);
+      }
+      else {
+        fprintf(pFile, "\t-");
+      }
+    }
+    if (0 > fprintf(pFile, "\n")) {
+      result = CUE_WRITE_ERROR;
+    }
+  }
+
+  if ((0 != fclose(pFile)) && (CUE_SUCCESS == result)) {
+    result = CUE_WRITE_ERROR;
+  }
+  CU_set_error(result);
+  return result;
+}
+
+/*------------------------------------------------------------------------*/
+CU_BOOL CU_perf_get_counts(CU_pTest pTest, unsigned long long aullCounts[CU_PERF_NUM_EVENTS])
+{
+  unsigned int i;
+
+  for (i = 0 ; i < f_uiNumCounts ; i++) {
+    if ((f_counts[i].pTest == pTest) && (CU_FALSE != f_counts[i].bCounted)) {
+      memcpy(aullCounts, f_counts[i].aullCounts, sizeof(f_counts[i].aullCounts));
+      return CU_TRUE;
+    }
+  }
+  return CU_FALSE;
+}
+
+/*=================================================================
+ *  Static module functions
+ *=================================================================*/
+/** Opens a user-space counter of the calling thread, disabled until started. */
+static int open_event(unsigned int uiType, unsigned long long ullConfig, int iGroupFd)
+{
+  struct perf_event_attr attr;
+
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = uiType;
+  attr.config = ullConfig;
+  attr.disabled = (-1 == iGroupFd) ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  return (int)syscall(SYS_perf_event_open, &attr, 0, -1, iGroupFd, PERF_FLAG_FD_CLOEXEC);
+}
+
+/*------------------------------------------------------------------------*/
+/** Test body wrapper counting the test function. */
+static void perf_test_body(const CU_pSuite pSuite, const CU_pTest pTest)
+{
+  perf_count *pCount;
+  unsigned long long aullCounts[CU_PERF_NUM_EVENTS];
+  unsigned int uiFailures;
+  unsigned int uiFailedBefore;
+  unsigned int uiCounted;
+  unsigned int i;
+  unsigned int j;
+  char szCondition[MAX_NAME_LEN];
+
+  if (NULL == pTest->pTestFunc) {
+    return;
+  }
+  if (f_uiNumCounts >= MAX_NUM_OF_TESTS) {
+    (*pTest->pTestFunc)();
+    return;
+  }
+  pCount = &f_counts[f_uiNumCounts++];
+  pCount->pSuite = pSuite;
+  pCount->pTest = pTest;
+
+  /* checked run - failing tests are not counted */
+  uiFailures = CU_get_number_of_failure_records();
+  (*pTest->pTestFunc)();
+  if (CU_get_number_of_failure_records() != uiFailures) {
+    return;
+  }
+
+  CU_set_assert_count_only(CU_TRUE);
+  uiFailedBefore = pTest->uiNumberOfAssertsFailed;
+
+  pCount->bCounted = CU_TRUE;
+  for (i = 0 ; i < f_config.uiRepeats ; i++) {
+    CU_perf_start();
+    (*pTest->pTestFunc)();
+    if (CU_FALSE == CU_perf_stop(aullCounts)) {
+      pCount->bCounted = CU_FALSE;
+      break;
+    }
+    for (j = 0 ; j < CU_PERF_NUM_EVENTS ; j++) {
+      if ((0 == i) || (aullCounts[j] < pCount->aullCounts[j])) {
+        pCount->aullCounts[j] = aullCounts[j];
+      }
+    }
+  }
+
+  CU_set_assert_count_only(CU_FALSE);
+
+  uiCounted = pTest->uiNumberOfAssertsFailed - uiFailedBefore;
+  if (0 != uiCounted) {
+    snprintf(szCondition, sizeof(szCondition), "%u assertions failed while counting", uiCounted);
+    CU_record_failure(CUF_AssertFailed, 0, szCondition, PERF_FAILURE_FILE, pSuite, pTest);
+    pCount->bCounted = CU_FALSE;
+  }
+  else if (CU_FALSE != pCount->bCounted) {
+    check_budget(pSuite, pTest, pCount);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/** Records a CUF_PerfRegression failure for each event over its budget. */
+static void check_budget(CU_pSuite pSuite, CU_pTest pTest, const perf_count *pCount)
+{
+  const perf_budget *pBudget;
+  double dLimit;
+  unsigned int i;
+  char szCondition[MAX_NAME_LEN];
+
+  if (NULL == (pBudget = (const perf_budget*)CU_find_test_entry(f_budgets, sizeof(f_budgets[0]), f_uiNumBudgets,
+                                                                 &f_uiNextBudget, pSuite->pName, pTest->pName))) {
+    return;
+  }
+
+  for (i = 0 ; i < CU_PERF_NUM_EVENTS ; i++) {
+    if (0 == (f_uiRunEvents & pBudget->uiEvents & CU_PERF_EVENT_MASK(i))) {
+      continue;
+    }
+    if (CU_PERF_INSTRUCTIONS == i) {
+      dLimit = (double)pBudget->aullBudget[i] * (1.0 + f_config.dTolerance);
+    }
+    else {
+      dLimit = (double)pBudget->aullBudget[i] * (1.0 + f_config.dMissTolerance)
+             + (double)f_config.ulMissSlack;
+    }
+    if ((double)pCount->aullCounts[i] > dLimit) {
+      snprintf(szCondition, sizeof(szCondition), "%s %llu > budget %llu (%+.2f%%)",
+               f_szEventNames[i], pCount->aullCounts[i], pBudget->aullBudget[i],
+               (0 != pBudget->aullBudget[i])
+                 ? 100.0 * ((double)pCount->aullCounts[i] / (double)pBudget->aullBudget[i] - 1.0)
+                 : 100.0);
+      CU_record_failure(CUF_PerfRegression, 0, szCondition, PERF_FAILURE_FILE, pSuite, pTest);
+    }
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/** Loads a budget file into f_budgets. */
+static CU_ErrorCode load_budgets(const char *szFile)
+{
+  FILE *pFile;
+  char szLine[2 * MAX_NAME_LEN + 128];
+  char szHeader[sizeof(PERF_BUDGET_TAG) + 16];
+  CU_ErrorCode result = CUE_SUCCESS;
+
+  if (NULL == (pFile = fopen(szFile, "r"))) {
+    return CUE_FOPEN_FAILED;
+  }
+
+  snprintf(szHeader, sizeof(szHeader), "%s\t%d\n", PERF_BUDGET_TAG, CU_PERF_BUDGET_VERSION);
+  if ((NULL == fgets(szLine, sizeof(szLine), pFile)) || (0 != strcmp(szLine, szHeader))) {
+    result = CUE_BAD_BASELINE;
+  }
+  while ((CUE_SUCCESS == result) && (NULL != fgets(szLine, sizeof(szLine), pFile))) {
+    if ('\n' == szLine[0]) {
+      continue;
+    }
+    if ((f_uiNumBudgets >= MAX_NUM_OF_TESTS) ||
+        (CU_FALSE == parse_budget(szLine, &f_budgets[f_uiNumBudgets]))) {
+      result = CUE_BAD_BASELINE;
+      break;
+    }
+    f_uiNumBudgets++;
+  }
+  fclose(pFile);
+
+  if (CUE_SUCCESS != result) {
+    f_uiNumBudgets = 0;
+  }
+  return result;
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Parses a test line of a budget file.
+ *  @return CU_TRUE if the line is valid, CU_FALSE otherwise.
+ */
+static CU_BOOL parse_budget(char *szLine, perf_budget *pBudget)
+{
+  char *aszFields[2 + CU_PERF_NUM_EVENTS];
+  char *szEnd;
+  unsigned int i;
+
+  if ((2 + CU_PERF_NUM_EVENTS != CU_split_tab_line(szLine, aszFields, 2 + CU_PERF_NUM_EVENTS)) ||
+      ('\0' == aszFields[0][0]) || ('\0' == aszFields[1][0])) {
+    return CU_FALSE;
+  }
+
+  CU_copy_name(pBudget->names.szSuiteName, aszFields[0]);
+  CU_copy_name(pBudget->names.szTestName, aszFields[1]);
+  pBudget->uiEvents = 0;
+  for (i = 0 ; i < CU_PERF_NUM_EVENTS ; i++) {
+    pBudget->aullBudget[i] = 0;
+    if (0 == strcmp(aszFields[2 + i], "-")) {
+      continue;
+    }
+    pBudget->aullBudget[i] = strtoull(aszFields[2 + i], &szEnd, 10);
+    if ((szEnd == aszFields[2 + i]) || ('\0' != *szEnd)) {
+      return CU_FALSE;
+    }
+    pBudget->uiEvents |= CU_PERF_EVENT_MASK(i);
+  }
+  return CU_TRUE;
+}
+
+/*------------------------------------------------------------------------*/
+/** Prints the counts of all tests of the last counter run. */
+static void report_counts(void)
+{
+  const perf_count *pCount;
+  char szCounts[128];
+  size_t nLen;
+  unsigned int i;
+  unsigned int j;
+
+  VLA_info(_("Counter run: %u tests (smallest of %u calls)."), f_uiNumCounts, f_config.uiRepeats);
+  for (i = 0 ; i < f_uiNumCounts ; i++) {
+    pCount = &f_counts[i];
+    if (CU_FALSE == pCount->bCounted) {
+      VLA_info(_("  %s:%s not counted (failed or multiplexed)"),
+               pCount->pSuite->pName, pCount->pTest->pName);
+      continue;
+    }
+    szCounts[0] = '\0';
+    for (j = 0, nLen = 0 ; (j < CU_PERF_NUM_EVENTS) && (nLen < sizeof(szCounts)) ; j++) {
+      if (0 != (f_uiRunEvents & CU_PERF_EVENT_MASK(j))) {
+        nLen += (size_t)snprintf(szCounts + nLen, sizeof(szCounts) - nLen, " %s %llu",
+                                 f_szEventNames[j], pCount->aullCounts[j]);
+      }
+    }
+    VLA_info(_("  %s:%s%s"), pCount->pSuite->pName, pCount->pTest->pName, szCounts);
+  }
+}
+
+#else  /* LINUX */
+
+/*=================================================================
+ *  Public Interface functions (not supported)
+ *=================================================================*/
+CU_ErrorCode CU_perf_open(unsigned int uiEvents)
+{
+  CU_UNREFERENCED_PARAMETER(uiEvents);
+  CU_set_error(CUE_FOPEN_FAILED);
+  return CUE_FOPEN_FAILED;
+}
+
+void CU_perf_close(void)
+{
+}
+
+CU_BOOL CU_perf_is_open(void)
+{
+  return CU_FALSE;
+}
+
+void CU_perf_start(void)
+{
+}
+
+CU_BOOL CU_perf_stop(unsigned long long aullCounts[CU_PERF_NUM_EVENTS])
+{
+  memset(aullCounts, 0, CU_PERF_NUM_EVENTS * sizeof(unsigned long long));
+  return CU_FALSE;
+}
+
+void CU_perf_default_config(CU_pPerfConfig pConfig)
+{
+  assert(NULL != pConfig);
+  memset(pConfig, 0, sizeof(*pConfig));
+}
+
+CU_ErrorCode CU_perf_run(CU_pSuite pSuite, const char *szBudgetFile, const CU_PerfConfig *pConfig)
+{
+  CU_UNREFERENCED_PARAMETER(pSuite);
+  CU_UNREFERENCED_PARAMETER(szBudgetFile);
+  CU_UNREFERENCED_PARAMETER(pConfig);
+  CU_set_error(CUE_FOPEN_FAILED);
+  return CUE_FOPEN_FAILED;
+}
+
+CU_ErrorCode CU_perf_write_budgets(const char *szFile)
+{
+  CU_UNREFERENCED_PARAMETER(szFile);
+  CU_set_error(CUE_FOPEN_FAILED);
+  return CUE_FOPEN_FAILED;
+}
+
+CU_BOOL CU_perf_get_counts(CU_pTest pTest, unsigned long long aullCounts[CU_PERF_NUM_EVENTS])
+{
+  CU_UNREFERENCED_PARAMETER(pTest);
+  memset(aullCounts, 0, CU_PERF_NUM_EVENTS * sizeof(unsigned long long));
+  return CU_FALSE;
+}
+
+#endif /* LINUX */
+
+/** @} */
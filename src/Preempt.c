@@ -0,0 +1,500 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Implementation of preempting test bodies with emulated interrupts.
+ *
+ *  19-Oct-2026   Initial implementation of preemption injection.
+ */
+
+/** @file
+ *  Preemption injection (implementation).
+ *  The ISR failure queue is a ring of CU_PREEMPT_QUEUE_SIZE entries.
+ *  Producers reserve an entry by advancing f_uiQueueHead with a
+ *  compare-and-swap and publish it by setting its ready flag; the test
+ *  thread consumes entries in order and advances f_uiQueueTail.  No
+ *  producer ever waits, so CU_PREEMPT_ASSERT() may be used in the signal
+ *  handler and in other threads alike.
+ */
+/** @addtogroup Framework
+ @{
+*/
+
+#ifdef LINUX
+#define _GNU_SOURCE   /* SIGEV_THREAD_ID */
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#ifdef LINUX
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+#include "CUnit.h"
+#include "TestDB.h"
+#include "TestRun.h"
+#include "Util.h"
+#include "Preempt.h"
+#include "VLA_Lite_Log.h"
+#include "CUnit_intl.h"
+
+/*=================================================================
+ *  Global/Static Definitions
+ *=================================================================*/
+#ifdef LINUX
+
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+/** Failure queued by CU_preemptAssertImplementation(). */
+typedef struct preempt_entry
+{
+  int           iReady;         /**< Set when the entry is filled in. */
+  unsigned int  uiLine;         /**< Line of the failed check. */
+  const char*   strCondition;   /**< Condition of the failed check. */
+  const char*   strFile;        /**< File of the failed check. */
+  unsigned long ulInterrupt;    /**< Interrupt of the test during which it failed. */
+  CU_pSuite     pSuite;         /**< Suite interrupted. */
+  CU_pTest      pTest;          /**< Test interrupted. */
+} preempt_entry;
+
+static CU_PreemptConfig   f_config;                  /**< Configuration of the current run. */
+static unsigned long long f_ullSeed = 0;             /**< Seed of the current run. */
+static unsigned long long f_ullRandomState = 1;      /**< State of the interval generator. */
+static timer_t            f_timer;                   /**< Timer signalling the test thread. */
+static struct sigaction   f_prevAction;              /**< Action of the timer signal before the run. */
+
+static volatile sig_atomic_t        f_iArmed = 0;           /**< Whether the handler calls the ISR. */
+static CU_pSuite volatile           f_pArmedSuite = NULL;   /**< Suite of the interrupted test. */
+static CU_pTest volatile            f_pArmedTest = NULL;    /**< Test whose body is interrupted. */
+static CU_PreemptResult* volatile   f_pCurrent = NULL;      /**< Result of the interrupted test. */
+static volatile unsigned long       f_ulInterrupt = 0;      /**< Number of the interrupt being handled. */
+static unsigned int                 f_uiReplayNext = 0;     /**< Next replayed interval. */
+
+static unsigned long    f_aulIntervals[CU_PREEMPT_MAX_INTERRUPTS];  /**< Intervals armed in the run. */
+static volatile unsigned int f_uiNumIntervals = 0;                  /**< Entries used in f_aulIntervals. */
+static CU_PreemptResult f_results[MAX_NUM_OF_TESTS];                /**< Results of the last run. */
+static unsigned int     f_uiNumResults = 0;                         /**< Entries used in f_results. */
+
+static preempt_entry f_queue[CU_PREEMPT_QUEUE_SIZE];  /**< ISR failures not recorded yet. */
+static unsigned int  f_uiQueueHead = 0;               /**< Entries reserved by producers. */
+static unsigned int  f_uiQueueTail = 0;               /**< Entries consumed. */
+static unsigned long f_ulLost = 0;                    /**< Failures dropped because the queue was full. */
+
+/*=================================================================
+ *  Private function forward declarations
+ *=================================================================*/
+static void preempt_test_body(const CU_pSuite pSuite, const CU_pTest pTest);
+static void preempt_handler(int iSignal);
+static void arm_next(void);
+static void disarm(void);
+static unsigned long next_interval(void);
+static void drain_queue(CU_pTest pTest);
+static void report_results(void);
+
+/*=================================================================
+ *  Public Interface functions
+ *=================================================================*/
+void CU_preempt_default_config(CU_pPreemptConfig pConfig)
+{
+  assert(NULL != pConfig);
+
+  memset(pConfig, 0, sizeof(*pConfig));
+  pConfig->ulMinIntervalNs = 20000;
+  pConfig->ulMaxIntervalNs = 200000;
+}
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_preempt_run(CU_pSuite pSuite, const CU_PreemptConfig *pConfig)
+{
+  struct sigaction action;
+  struct sigevent event;
+  CU_TestBodyWrapper pPrevWrapper;
+  CU_ErrorCode result;
+
+  assert(NULL != pConfig);
+  assert(0 != pConfig->ulMaxIntervalNs);
+
+  f_config = *pConfig;
+  if (f_config.ulMinIntervalNs > f_config.ulMaxIntervalNs) {
+    f_config.ulMinIntervalNs = f_config.ulMaxIntervalNs;
+  }
+  if (NULL == f_config.pulReplay) {
+    f_config.uiReplayLength = 0;
+  }
+  f_ullSeed = (0 != f_config.ullSeed) ? f_config.ullSeed : CU_get_time_ns();
+  f_ullRandomState = f_ullSeed | 1;
+
+  memset(f_results, 0, sizeof(f_results));
+  f_uiNumResults = 0;
+  f_uiNumIntervals = 0;
+  f_iArmed = 0;
+  f_pCurrent = NULL;
+
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = preempt_handler;
+  action.sa_flags = SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  if (0 != sigaction(SIGRTMIN, &action, &f_prevAction)) {
+    CU_set_error(CUE_NOT_SUPPORTED);
+    return CUE_NOT_SUPPORTED;
+  }
+  memset(&event, 0, sizeof(event));
+  event.sigev_notify = SIGEV_THREAD_ID;
+  event.sigev_signo = SIGRTMIN;
+  event.sigev_notify_thread_id = (pid_t)syscall(SYS_gettid);
+  if (0 != timer_create(CLOCK_MONOTONIC, &event, &f_timer)) {
+    sigaction(SIGRTMIN, &f_prevAction, NULL);
+    CU_set_error(CUE_NOT_SUPPORTED);
+    return CUE_NOT_SUPPORTED;
+  }
+
+  pPrevWrapper = CU_get_test_body_wrapper();
+  CU_set_test_body_wrapper(preempt_test_body);
+
+  result = (NULL != pSuite) ? CU_run_suite(pSuite) : CU_run_all_tests();
+
+  CU_set_test_body_wrapper(pPrevWrapper);
+  disarm();
+  drain_queue(NULL);
+  timer_delete(f_timer);
+  sigaction(SIGRTMIN, &f_prevAction, NULL);
+  f_pArmedSuite = NULL;
+  f_pArmedTest = NULL;
+  f_pCurrent = NULL;
+
+  report_results();
+
+  CU_set_error(result);
+  return result;
+}
+
+/*------------------------------------------------------------------------*/
+const CU_PreemptResult* CU_preempt_get_result(CU_pTest pTest)
+{
+  unsigned int i;
+
+  for (i = 0 ; i < f_uiNumResults ; i++) {
+    if (f_results[i].pTest == pTest) {
+      return &f_results[i];
+    }
+  }
+  return NULL;
+}
+
+/*------------------------------------------------------------------------*/
+const unsigned long* CU_preempt_get_intervals(CU_pTest pTest, unsigned int *puiCount)
+{
+  const CU_PreemptResult *pResult = CU_preempt_get_result(pTest);
+
+  assert(NULL != puiCount);
+
+  if (NULL == pResult) {
+    *puiCount = 0;
+    return NULL;
+  }
+  *puiCount = pResult->uiIntervals;
+  return &f_aulIntervals[pResult->uiFirstInterval];
+}
+
+/*------------------------------------------------------------------------*/
+CU_BOOL CU_preemptAssertImplementation(CU_BOOL bValue, unsigned int uiLine,
+                                       const char *strCondition, const char *strFile)
+{
+  CU_PreemptResult *pResult = f_pCurrent;
+  preempt_entry *pEntry;
+  unsigned int uiHead;
+
+  if (NULL != pResult) {
+    __atomic_add_fetch(&pResult->ulIsrAsserts, 1, __ATOMIC_RELAXED);
+  }
+  if (CU_FALSE != bValue) {
+    return bValue;
+  }
+  if (NULL != pResult) {
+    __atomic_add_fetch(&pResult->ulIsrFailures, 1, __ATOMIC_RELAXED);
+  }
+
+  uiHead = __atomic_load_n(&f_uiQueueHead, __ATOMIC_RELAXED);
+  do {
+    if (uiHead - __atomic_load_n(&f_uiQueueTail, __ATOMIC_ACQUIRE) >= CU_PREEMPT_QUEUE_SIZE) {
+      __atomic_add_fetch(&f_ulLost, 1, __ATOMIC_RELAXED);
+      return bValue;
+    }
+  } while (!__atomic_compare_exchange_n(&f_uiQueueHead, &uiHead, uiHead + 1, 0,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+  pEntry = &f_queue[uiHead % CU_PREEMPT_QUEUE_SIZE];
+  pEntry->uiLine = uiLine;
+  pEntry->strCondition = (NULL != strCondition) ? strCondition : "";
+  pEntry->strFile = (NULL != strFile) ? strFile : "";
+  pEntry->ulInterrupt = f_ulInterrupt;
+  pEntry->pSuite = f_pArmedSuite;
+  pEntry->pTest = f_pArmedTest;
+  __atomic_store_n(&pEntry->iReady, 1, __ATOMIC_RELEASE);
+  return bValue;
+}
+
+/*=================================================================
+ *  Static module functions
+ *=================================================================*/
+/** Test body wrapper arming the timer around the test function. */
+static void preempt_test_body(const CU_pSuite pSuite, const CU_pTest pTest)
+{
+  CU_PreemptResult *pResult;
+  jmp_buf *pRunnerJump = pTest->pJumpBuf;
+  jmp_buf buf;
+
+  if (f_uiNumResults >= MAX_NUM_OF_TESTS) {
+    if (NULL != pTest->pTestFunc) {
+      (*pTest->pTestFunc)();
+    }
+    return;
+  }
+  pResult = &f_results[f_uiNumResults++];
+  pResult->pTest = pTest;
+  pResult->uiFirstInterval = f_uiNumIntervals;
+
+  f_pArmedSuite = pSuite;
+  f_pArmedTest = pTest;
+  f_pCurrent = pResult;
+  f_uiReplayNext = 0;
+  f_iArmed = 1;
+  arm_next();
+
+  /* a fatal assertion comes back here to disarm before teardown runs */
+  pTest->pJumpBuf = &buf;
+  if (0 == setjmp(buf)) {
+    if (NULL != pTest->pTestFunc) {
+      (*pTest->pTestFunc)();
+    }
+    pTest->pJumpBuf = pRunnerJump;
+    disarm();
+    drain_queue(pTest);
+  }
+  else {
+    pTest->pJumpBuf = pRunnerJump;
+    disarm();
+    drain_queue(pTest);
+    if (NULL != pRunnerJump) {
+      longjmp(*pRunnerJump, 1);
+    }
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Handler of the timer signal, calling the ISR and arming the next
+ *  interrupt.  A signal arriving after the interrupted test body ended
+ *  only stops the timer.
+ */
+static void preempt_handler(int iSignal)
+{
+  int iErrno = errno;
+  CU_PreemptResult *pResult = f_pCurrent;
+
+  CU_UNREFERENCED_PARAMETER(iSignal);
+
+  if ((0 != f_iArmed) && (NULL != pResult) && (CU_get_current_test() == f_pArmedTest)) {
+    f_ulInterrupt = pResult->uiInterrupts++;
+    if (NULL != f_config.pIsr) {
+      (*f_config.pIsr)(f_ulInterrupt, f_config.pContext);
+    }
+    arm_next();
+  }
+  else {
+    f_iArmed = 0;
+  }
+  errno = iErrno;
+}
+
+/*------------------------------------------------------------------------*/
+/** Arms the timer with the next interval and records it. */
+static void arm_next(void)
+{
+  struct itimerspec spec;
+  unsigned long ulInterval;
+
+  if (f_uiNumIntervals >= CU_PREEMPT_MAX_INTERRUPTS) {
+    return;
+  }
+  if (0 != f_config.uiReplayLength) {
+    if (f_uiReplayNext >= f_config.uiReplayLength) {
+      return;
+    }
+    ulInterval = f_config.pulReplay[f_uiReplayNext++];
+  }
+  else {
+    ulInterval = next_interval();
+  }
+  f_aulIntervals[f_uiNumIntervals] = ulInterval;
+  f_uiNumIntervals = f_uiNumIntervals + 1;
+
+  memset(&spec, 0, sizeof(spec));
+  spec.it_value.tv_sec = (time_t)(ulInterval / 1000000000UL);
+  spec.it_value.tv_nsec = (long)(ulInterval % 1000000000UL);
+  if (0 == ulInterval) {
+    spec.it_value.tv_nsec = 1;    /* a zero time would disarm the timer */
+  }
+  timer_settime(f_timer, 0, &spec, NULL);
+}
+
+/*------------------------------------------------------------------------*/
+/** Stops the interrupts and completes the result of the interrupted test. */
+static void disarm(void)
+{
+  struct itimerspec spec;
+  CU_PreemptResult *pResult = f_pCurrent;
+
+  f_iArmed = 0;
+  memset(&spec, 0, sizeof(spec));
+  timer_settime(f_timer, 0, &spec, NULL);
+
+  if (NULL != pResult) {
+    pResult->uiIntervals = f_uiNumIntervals - pResult->uiFirstInterval;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/** Draws an interval from the configured range (xorshift64*). */
+static unsigned long next_interval(void)
+{
+  unsigned long long ullRange = f_config.ulMaxIntervalNs - f_config.ulMinIntervalNs + 1ULL;
+
+  f_ullRandomState ^= f_ullRandomState >> 12;
+  f_ullRandomState ^= f_ullRandomState << 25;
+  f_ullRandomState ^= f_ullRandomState >> 27;
+  return f_config.ulMinIntervalNs +
+         (unsigned long)((f_ullRandomState * 2685821657736338717ULL) % ullRange);
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Records the queued ISR failures.  Failures of pTest count as its
+ *  failed assertions; failures of an earlier test (one that ended with a
+ *  fatal assertion) are recorded for that test.
+ */
+static void drain_queue(CU_pTest pTest)
+{
+  char szCondition[MAX_NAME_LEN];
+  preempt_entry *pEntry;
+  unsigned int uiTail = f_uiQueueTail;
+  unsigned long ulLost;
+
+  while (uiTail != __atomic_load_n(&f_uiQueueHead, __ATOMIC_ACQUIRE)) {
+    pEntry = &f_queue[uiTail % CU_PREEMPT_QUEUE_SIZE];
+    if (0 == __atomic_load_n(&pEntry->iReady, __ATOMIC_ACQUIRE)) {
+      break;    /* still being filled in by another thread */
+    }
+    snprintf(szCondition, sizeof(szCondition), "ISR #%lu: %s", pEntry->ulInterrupt, pEntry->strCondition);
+    if ((NULL != pTest) && (pEntry->pTest == pTest)) {
+      CU_assertImplementation(CU_FALSE, pEntry->uiLine, szCondition, pEntry->strFile, "", CU_FALSE);
+    }
+    else {
+      CU_record_failure(CUF_AssertFailed, pEntry->uiLine, szCondition, pEntry->strFile,
+                        pEntry->pSuite, pEntry->pTest);
+    }
+    __atomic_store_n(&pEntry->iReady, 0, __ATOMIC_RELAXED);
+    uiTail++;
+    __atomic_store_n(&f_uiQueueTail, uiTail, __ATOMIC_RELEASE);
+  }
+
+  ulLost = __atomic_exchange_n(&f_ulLost, 0, __ATOMIC_RELAXED);
+  if (0 != ulLost) {
+    snprintf(szCondition, sizeof(szCondition), "%lu ISR failures lost (queue full)", ulLost);
+    CU_record_failure(CUF_AssertFailed, 0, szCondition, "", f_pArmedSuite, f_pArmedTest);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/** Prints the seed and the interrupts of each test. */
+static void report_results(void)
+{
+  unsigned int i;
+
+  if (0 != f_config.uiReplayLength) {
+    VLA_info(_("Preemption run replaying %u intervals:"), f_config.uiReplayLength);
+  }
+  else {
+    VLA_info(_("Preemption run with seed %llu, intervals %lu to %lu ns:"),
+             f_ullSeed, f_config.ulMinIntervalNs, f_config.ulMaxIntervalNs);
+  }
+  for (i = 0 ; i < f_uiNumResults ; i++) {
+    VLA_info(_("  %-32s%u interrupts, %lu of %lu ISR asserts failed"),
+             f_results[i].pTest->pName, f_results[i].uiInterrupts,
+             f_results[i].ulIsrFailures, f_results[i].ulIsrAsserts);
+  }
+  if (f_uiNumIntervals >= CU_PREEMPT_MAX_INTERRUPTS) {
+    VLA_info(_("  interrupts stopped after %u intervals"), CU_PREEMPT_MAX_INTERRUPTS);
+  }
+}
+
+#else  /* LINUX */
+
+/*=================================================================
+ *  Public Interface functions (not supported)
+ *=================================================================*/
+void CU_preempt_default_config(CU_pPreemptConfig pConfig)
+{
+  assert(NULL != pConfig);
+
+  memset(pConfig, 0, sizeof(*pConfig));
+  pConfig->ulMinIntervalNs = 20000;
+  pConfig->ulMaxIntervalNs = 200000;
+}
+
+CU_ErrorCode CU_preempt_run(CU_pSuite pSuite, const CU_PreemptConfig *pConfig)
+{
+  CU_UNREFERENCED_PARAMETER(pSuite);
+  CU_UNREFERENCED_PARAMETER(pConfig);
+  CU_set_error(CUE_NOT_SUPPORTED);
+  return CUE_NOT_SUPPORTED;
+}
+
+const CU_PreemptResult* CU_preempt_get_result(CU_pTest pTest)
+{
+  CU_UNREFERENCED_PARAMETER(pTest);
+  return NULL;
+}
+
+const unsigned long* CU_preempt_get_intervals(CU_pTest pTest, unsigned int *puiCount)
+{
+  CU_UNREFERENCED_PARAMETER(pTest);
+  *puiCount = 0;
+  return NULL;
+}
+
+CU_BOOL CU_preemptAssertImplementation(CU_BOOL bValue, unsigned int uiLine,
+                                       const char *strCondition, const char *strFile)
+{
+  CU_UNREFERENCED_PARAMETER(uiLine);
+  CU_UNREFERENCED_PARAMETER(strCondition);
+  CU_UNREFERENCED_PARAMETER(strFile);
+  return bValue;
+}
+
+#endif /* LINUX */
+
+/** @} */
@@ -0,0 +1,442 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Implementation of soak runs with resource trend detection.
+ *
+ *  19-Oct-2026   Initial implementation of soak mode.
+ */
+
+/** @file
+ *  Soak mode (implementation).
+ */
+/** @addtogroup Framework
+ @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <signal.h>
+#ifdef LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <time.h>
+#endif
+
+#include "CUnit.h"
+#include "TestDB.h"
+#include "TestRun.h"
+#include "Util.h"
+#include "Soak.h"
+#include "VLA_Lite_Log.h"
+#include "CUnit_intl.h"
+
+/*=================================================================
+ *  Global/Static Definitions
+ *=================================================================*/
+#ifdef LINUX
+
+/** Minimum number of samples after the warmup for a trend. */
+#define SOAK_MIN_SAMPLES 3U
+
+/** File name used in CUF_ResourceGrowth failure records. */
+#define SOAK_FAILURE_FILE "soak"
+
+/** Online least squares fit of y over the iteration number. */
+typedef struct soak_trend
+{
+  unsigned int uiSamples;   /**< Number of points. */
+  double       dMeanX;      /**< Mean iteration number. */
+  double       dMeanY;      /**< Mean value. */
+  double       dSxx;        /**< Sum of squared deviations of x. */
+  double       dSxy;        /**< Sum of co-deviations of x and y. */
+} soak_trend;
+
+/** Per-suite state of a soak run. */
+typedef struct soak_suite
+{
+  CU_pSuite  pSuite;                                 /**< Suite, NULL if slot is unused. */
+  double     adTotal[CU_SOAK_NUM_METRICS];           /**< Growth accumulated across the suite. */
+  soak_trend aTrend[CU_SOAK_NUM_METRICS];            /**< Trend of adTotal. */
+} soak_suite;
+
+static const char* const f_szMetricNames[CU_SOAK_NUM_METRICS] =
+  { "RSS", "file descriptors", "threads", "heap" };
+static const char* const f_szMetricUnits[CU_SOAK_NUM_METRICS] =
+  { "bytes", "fds", "threads", "bytes" };
+
+static soak_suite   f_suites[MAX_NUM_OF_SUITES];
+static soak_trend   f_process[CU_SOAK_NUM_METRICS];
+static unsigned int f_uiIterations = 0;
+static volatile sig_atomic_t f_bStopSoak = 0;
+
+/* /proc files opened once per run, so sampling is just a read */
+static int  f_iStatmFd = -1;
+static int  f_iStatFd  = -1;
+static DIR* f_pFdDir   = NULL;
+static long f_lPageSize = 0;
+
+/*=================================================================
+ *  Private function forward declarations
+ *=================================================================*/
+static CU_BOOL open_proc_files(void);
+static void    close_proc_files(void);
+static void    sample_resources(double adSample[CU_SOAK_NUM_METRICS]);
+static void    add_trend_point(soak_trend *pTrend, double dX, double dY);
+static double  trend_slope(const soak_trend *pTrend);
+static double  elapsed_seconds(const struct timespec *pStart);
+static void    report_growth(const CU_SoakConfig *pConfig);
+
+/*=================================================================
+ *  Public Interface functions
+ *=================================================================*/
+void CU_soak_default_config(CU_pSoakConfig pConfig)
+{
+  assert(NULL != pConfig);
+
+  pConfig->dDuration = 60.0;
+  pConfig->uiMaxIterations = 0;
+  pConfig->uiWarmupIterations = 2;
+  pConfig->adMaxGrowth[CU_SOAK_RSS] = 4096.0;
+  pConfig->adMaxGrowth[CU_SOAK_FDS] = 0.5;
+  pConfig->adMaxGrowth[CU_SOAK_THREADS] = 0.5;
+  pConfig->adMaxGrowth[CU_SOAK_HEAP] = 64.0;
+}
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_soak_run(const CU_SoakConfig *pConfig)
+{
+  CU_pTestRegistry pRegistry = CU_get_registry();
+  CU_SoakConfig defaults;
+  CU_pSuite pSuite;
+  CU_ErrorCode result = CUE_SUCCESS;
+  CU_BOOL bFailed = CU_FALSE;
+  struct timespec start;
+  double adBefore[CU_SOAK_NUM_METRICS];
+  double adAfter[CU_SOAK_NUM_METRICS];
+  unsigned int uiSuite;
+  unsigned int i;
+
+  assert(CU_FALSE == CU_is_test_running());
+
+  if (NULL == pRegistry) {
+    CU_set_error(CUE_NOREGISTRY);
+    return CUE_NOREGISTRY;
+  }
+  if (NULL == pConfig) {
+    CU_soak_default_config(&defaults);
+    pConfig = &defaults;
+  }
+
+  memset(f_suites, 0, sizeof(f_suites));
+  memset(f_process, 0, sizeof(f_process));
+  f_uiIterations = 0;
+  f_bStopSoak = 0;
+
+  if (CU_FALSE == open_proc_files()) {
+    CU_set_error(CUE_FOPEN_FAILED);
+    return CUE_FOPEN_FAILED;
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  sample_resources(adBefore);
+
+  while ((0 == f_bStopSoak) && (CU_FALSE == bFailed)) {
+    if ((0 != pConfig->uiMaxIterations) && (f_uiIterations >= pConfig->uiMaxIterations)) {
+      break;
+    }
+    if ((pConfig->dDuration > 0.0) && (elapsed_seconds(&start) >= pConfig->dDuration)) {
+      break;
+    }
+
+    for (pSuite = pRegistry->pSuite, uiSuite = 0 ;
+         (NULL != pSuite) && (uiSuite < MAX_NUM_OF_SUITES) ;
+         pSuite = pSuite->pNext, uiSuite++) {
+      if (CU_FALSE == pSuite->fActive) {
+        continue;
+      }
+
+      result = CU_run_suite(pSuite);
+      sample_resources(adAfter);
+
+      if ((CUE_SUCCESS != result) || (0 != CU_get_number_of_failure_records())) {
+        bFailed = CU_TRUE;
+        break;
+      }
+
+      /* growth between the samples around a suite is attributed to it */
+      f_suites[uiSuite].pSuite = pSuite;
+      for (i = 0 ; i < CU_SOAK_NUM_METRICS ; i++) {
+        f_suites[uiSuite].adTotal[i] += adAfter[i] - adBefore[i];
+        if (f_uiIterations >= pConfig->uiWarmupIterations) {
+          add_trend_point(&f_suites[uiSuite].aTrend[i],
+                          (double)f_uiIterations, f_suites[uiSuite].adTotal[i]);
+        }
+        adBefore[i] = adAfter[i];
+      }
+    }
+
+    if (CU_FALSE == bFailed) {
+      if (f_uiIterations >= pConfig->uiWarmupIterations) {
+        for (i = 0 ; i < CU_SOAK_NUM_METRICS ; i++) {
+          add_trend_point(&f_process[i], (double)f_uiIterations, adBefore[i]);
+        }
+      }
+      f_uiIterations++;
+    }
+  }
+
+  close_proc_files();
+
+  if (CU_FALSE == bFailed) {
+    CU_clear_previous_results();
+    report_growth(pConfig);
+  }
+  else {
+    VLA_error(_("Soak run stopped in iteration %u after failures in suite %s."),
+              f_uiIterations + 1, pSuite->pName);
+  }
+
+  CU_set_error(result);
+  return result;
+}
+
+/*------------------------------------------------------------------------*/
+void CU_soak_stop(void)
+{
+  f_bStopSoak = 1;
+}
+
+/*------------------------------------------------------------------------*/
+unsigned int CU_soak_get_iterations(void)
+{
+  return f_uiIterations;
+}
+
+/*------------------------------------------------------------------------*/
+double CU_soak_get_growth(CU_pSuite pSuite, CU_SoakMetric metric)
+{
+  unsigned int i;
+
+  if ((unsigned int)metric >= CU_SOAK_NUM_METRICS) {
+    return 0.0;
+  }
+  if (NULL == pSuite) {
+    return trend_slope(&f_process[metric]);
+  }
+  for (i = 0 ; i < MAX_NUM_OF_SUITES ; i++) {
+    if (f_suites[i].pSuite == pSuite) {
+      return trend_slope(&f_suites[i].aTrend[metric]);
+    }
+  }
+  return 0.0;
+}
+
+/*=================================================================
+ *  Static module functions
+ *=================================================================*/
+/** Opens the /proc files sampled after every suite. */
+static CU_BOOL open_proc_files(void)
+{
+  f_lPageSize = sysconf(_SC_PAGESIZE);
+  f_iStatmFd = open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+  f_iStatFd = open("/proc/self/stat", O_RDONLY | O_CLOEXEC);
+  f_pFdDir = opendir("/proc/self/fd");
+
+  if ((f_iStatmFd < 0) || (f_iStatFd < 0) || (NULL == f_pFdDir)) {
+    VLA_error(_("Unable to open the process statistics in /proc/self."));
+    close_proc_files();
+    return CU_FALSE;
+  }
+  return CU_TRUE;
+}
+
+/*------------------------------------------------------------------------*/
+static void close_proc_files(void)
+{
+  if (f_iStatmFd >= 0) {
+    close(f_iStatmFd);
+    f_iStatmFd = -1;
+  }
+  if (f_iStatFd >= 0) {
+    close(f_iStatFd);
+    f_iStatFd = -1;
+  }
+  if (NULL != f_pFdDir) {
+    closedir(f_pFdDir);
+    f_pFdDir = NULL;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/** Reads the current value of all metrics. */
+static void sample_resources(double adSample[CU_SOAK_NUM_METRICS])
+{
+  char buf[512];
+  ssize_t len;
+  unsigned long ulSize = 0;
+  unsigned long ulResident = 0;
+  unsigned int uiFds = 0;
+  char *pField;
+  int iField;
+  struct dirent *pEntry;
+
+  memset(adSample, 0, CU_SOAK_NUM_METRICS * sizeof(double));
+
+  /* statm: size resident shared text lib data dt (in pages) */
+  if ((len = pread(f_iStatmFd, buf, sizeof(buf) - 1, 0)) > 0) {
+    buf[len] = '\0';
+    if (2 == sscanf(buf, "%lu %lu", &ulSize, &ulResident)) {
+      adSample[CU_SOAK_RSS] = (double)ulResident * (double)f_lPageSize;
+    }
+  }
+
+  /* stat: the command name may contain blanks, so fields are counted
+   * from its closing parenthesis (field 3) to num_threads (field 20) */
+  if ((len = pread(f_iStatFd, buf, sizeof(buf) - 1, 0)) > 0) {
+    buf[len] = '\0';
+    if (NULL != (pField = strrchr(buf, ')'))) {
+      for (iField = 2 ; (iField < 20) && (NULL != pField) ; iField++) {
+        pField = strchr(pField + 1, ' ');
+      }
+      if (NULL != pField) {
+        adSample[CU_SOAK_THREADS] = strtod(pField + 1, NULL);
+      }
+    }
+  }
+
+  /* "." and ".." and the descriptor of the directory stream itself,
+   * the other /proc files are constant and do not affect a trend */
+  rewinddir(f_pFdDir);
+  while (NULL != (pEntry = readdir(f_pFdDir))) {
+    uiFds++;
+  }
+  adSample[CU_SOAK_FDS] = (uiFds > 3) ? (double)(uiFds - 3) : 0.0;
+
+  adSample[CU_SOAK_HEAP] = (double)CU_get_heap_in_use();
+}
+
+/*------------------------------------------------------------------------*/
+/** Adds a point to a trend (Welford's update, stable for large values). */
+static void add_trend_point(soak_trend *pTrend, double dX, double dY)
+{
+  double dDeltaX;
+
+  assert(NULL != pTrend);
+
+  pTrend->uiSamples++;
+  dDeltaX = dX - pTrend->dMeanX;
+  pTrend->dMeanX += dDeltaX / (double)pTrend->uiSamples;
+  pTrend->dMeanY += (dY - pTrend->dMeanY) / (double)pTrend->uiSamples;
+  pTrend->dSxx += dDeltaX * (dX - pTrend->dMeanX);
+  pTrend->dSxy += dDeltaX * (dY - pTrend->dMeanY);
+}
+
+/*------------------------------------------------------------------------*/
+/** Returns the slope of a trend, 0 if it has too few points. */
+static double trend_slope(const soak_trend *pTrend)
+{
+  if ((pTrend->uiSamples < SOAK_MIN_SAMPLES) || (pTrend->dSxx <= 0.0)) {
+    return 0.0;
+  }
+  return pTrend->dSxy / pTrend->dSxx;
+}
+
+/*------------------------------------------------------------------------*/
+static double elapsed_seconds(const struct timespec *pStart)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)(now.tv_sec - pStart->tv_sec)
+       + (double)(now.tv_nsec - pStart->tv_nsec) / 1e9;
+}
+
+/*------------------------------------------------------------------------*/
+/** Prints the trends and records a failure for each exceeded limit. */
+static void report_growth(const CU_SoakConfig *pConfig)
+{
+  char szCondition[MAX_NAME_LEN];
+  unsigned int uiSuite;
+  unsigned int i;
+  double dSlope;
+
+  VLA_info(_("Soak run: %u iterations."), f_uiIterations);
+  for (i = 0 ; i < CU_SOAK_NUM_METRICS ; i++) {
+    VLA_info(_("  %-16s %+.1f %s/iteration"), f_szMetricNames[i],
+             trend_slope(&f_process[i]), f_szMetricUnits[i]);
+  }
+
+  for (uiSuite = 0 ; uiSuite < MAX_NUM_OF_SUITES ; uiSuite++) {
+    if (NULL == f_suites[uiSuite].pSuite) {
+      continue;
+    }
+    for (i = 0 ; i < CU_SOAK_NUM_METRICS ; i++) {
+      dSlope = trend_slope(&f_suites[uiSuite].aTrend[i]);
+      if ((pConfig->adMaxGrowth[i] <= 0.0) || (dSlope <= pConfig->adMaxGrowth[i])) {
+        continue;
+      }
+      snprintf(szCondition, sizeof(szCondition), "%s grows %.1f %s/iteration (limit %.1f)",
+               f_szMetricNames[i], dSlope, f_szMetricUnits[i], pConfig->adMaxGrowth[i]);
+      VLA_error(_("Suite %s: %s"), f_suites[uiSuite].pSuite->pName, szCondition);
+      CU_record_failure(CUF_ResourceGrowth, 0, szCondition, SOAK_FAILURE_FILE,
+                        f_suites[uiSuite].pSuite, NULL);
+    }
+  }
+}
+
+#else  /* LINUX */
+
+/*=================================================================
+ *  Public Interface functions (not supported)
+ *=================================================================*/
+void CU_soak_default_config(CU_pSoakConfig pConfig)
+{
+  assert(NULL != pConfig);
+  memset(pConfig, 0, sizeof(*pConfig));
+}
+
+CU_ErrorCode CU_soak_run(const CU_SoakConfig *pConfig)
+{
+  CU_UNREFERENCED_PARAMETER(pConfig);
+  CU_set_error(CUE_FOPEN_FAILED);
+  return CUE_FOPEN_FAILED;
+}
+
+void CU_soak_stop(void)
+{
+}
+
+unsigned int CU_soak_get_iterations(void)
+{
+  return 0;
+}
+
+double CU_soak_get_growth(CU_pSuite pSuite, CU_SoakMetric metric)
+{
+  CU_UNREFERENCED_PARAMETER(pSuite);
+  CU_UNREFERENCED_PARAMETER(metric);
+  return 0.0;
+}
+
+#endif /* LINUX */
+
+/** @} */
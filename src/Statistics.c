@@ -0,0 +1,447 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Implementation of statistical assertions on sample arrays.
+ *
+ *  19-Oct-2026   Initial implementation of distribution assertions.
+ */
+
+/** @file
+ *  Statistical assertions (implementation).
+ *  The sample loops are written for throughput on large arrays: the
+ *  moment sums use independent accumulators, which lets the compiler
+ *  keep several additions in flight (or in one vector register) without
+ *  reordering floating point operations, and the histogram is spread
+ *  over interleaved copies so that consecutive samples falling into the
+ *  same bin do not serialize on one counter.
+ */
+/** @addtogroup Framework
+ @{
+*/
+
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#include "CUnit.h"
+#include "TestRun.h"
+#include "Statistics.h"
+#include "Util.h"
+
+/*=================================================================
+ *  Global/Static Definitions
+ *=================================================================*/
+/** Number of interleaved histogram copies and sum accumulators. */
+#define STAT_LANES 4U
+
+/** Iteration limit and accuracy of the incomplete gamma function. */
+#define STAT_GAMMA_ITERATIONS 500
+#define STAT_GAMMA_EPSILON    1e-15
+
+static unsigned int f_auiHistogram[STAT_LANES][CU_STAT_MAX_BINS];
+
+/*=================================================================
+ *  Private function forward declarations
+ *=================================================================*/
+static double sum_samples(const double *pdSamples, size_t nSamples);
+static double sum_products(const double *pdA, const double *pdB, size_t nSamples, double dMean);
+static double gamma_q(double dA, double dX);
+static double ks_p_value(double dD, size_t nSamples);
+
+/*=================================================================
+ *  Public Interface functions
+ *=================================================================*/
+double CU_stat_chi_square_uniform(const double *pdSamples,
+                                  size_t nSamples,
+                                  double dLow,
+                                  double dHigh,
+                                  unsigned int uiBins,
+                                  double *pdPValue)
+{
+  double dScale;
+  double dBin;
+  double dExpected;
+  double dDiff;
+  double dChi2 = 0.0;
+  size_t nOutside = 0;
+  size_t i;
+  unsigned int uiBin;
+  unsigned int uiCount;
+
+  assert(NULL != pdSamples);
+  assert((0 < nSamples) && (dLow < dHigh));
+  assert((2 <= uiBins) && (CU_STAT_MAX_BINS >= uiBins));
+
+  memset(f_auiHistogram, 0, sizeof(f_auiHistogram));
+  dScale = (double)uiBins / (dHigh - dLow);
+
+  for (i = 0 ; i < nSamples ; i++) {
+    dBin = (pdSamples[i] - dLow) * dScale;
+    /* written so that NaN is counted as outside */
+    if ((dBin >= 0.0) && (dBin < (double)uiBins)) {
+      f_auiHistogram[i % STAT_LANES][(unsigned int)dBin]++;
+    }
+    else {
+      nOutside++;
+    }
+  }
+
+  if (0 != nOutside) {
+    if (NULL != pdPValue) {
+      *pdPValue = 0.0;
+    }
+    return HUGE_VAL;
+  }
+
+  dExpected = (double)nSamples / (double)uiBins;
+  for (uiBin = 0 ; uiBin < uiBins ; uiBin++) {
+    uiCount = f_auiHistogram[0][uiBin] + f_auiHistogram[1][uiBin]
+            + f_auiHistogram[2][uiBin] + f_auiHistogram[3][uiBin];
+    dDiff = (double)uiCount - dExpected;
+    dChi2 += dDiff * dDiff;
+  }
+  dChi2 /= dExpected;
+
+  if (NULL != pdPValue) {
+    *pdPValue = gamma_q(0.5 * (double)(uiBins - 1), 0.5 * dChi2);
+  }
+  return dChi2;
+}
+
+/*------------------------------------------------------------------------*/
+double CU_stat_ks(double *pdSamples,
+                  size_t nSamples,
+                  CU_StatCdf pCdf,
+                  double *pdPValue)
+{
+  double dD = 0.0;
+  double dF;
+  double dN = (double)nSamples;
+  size_t i;
+
+  assert(NULL != pdSamples);
+  assert(NULL != pCdf);
+  assert(0 < nSamples);
+
+  qsort(pdSamples, nSamples, sizeof(double), CU_compare_doubles);
+
+  for (i = 0 ; i < nSamples ; i++) {
+    dF = (*pCdf)(pdSamples[i]);
+    if ((double)(i + 1) / dN - dF > dD) {
+      dD = (double)(i + 1) / dN - dF;
+    }
+    if (dF - (double)i / dN > dD) {
+      dD = dF - (double)i / dN;
+    }
+  }
+
+  if (NULL != pdPValue) {
+    *pdPValue = ks_p_value(dD, nSamples);
+  }
+  return dD;
+}
+
+/*------------------------------------------------------------------------*/
+void CU_stat_moments(const double *pdSamples,
+                     size_t nSamples,
+                     double *pdMean,
+                     double *pdVariance)
+{
+  double dMean;
+  double dSquares;
+  double dDeviation;
+
+  assert(NULL != pdSamples);
+  assert(0 < nSamples);
+
+  dMean = sum_samples(pdSamples, nSamples) / (double)nSamples;
+  if (NULL != pdMean) {
+    *pdMean = dMean;
+  }
+
+  if (NULL != pdVariance) {
+    if (2 > nSamples) {
+      *pdVariance = 0.0;
+      return;
+    }
+    /* two-pass algorithm, corrected for the rounding error of the mean */
+    dSquares = sum_products(pdSamples, pdSamples, nSamples, dMean);
+    dDeviation = sum_samples(pdSamples, nSamples) - dMean * (double)nSamples;
+    *pdVariance = (dSquares - dDeviation * dDeviation / (double)nSamples) / (double)(nSamples - 1);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+double CU_stat_autocorrelation(const double *pdSamples,
+                               size_t nSamples,
+                               unsigned int uiLag)
+{
+  double dMean;
+  double dVariance;
+
+  assert(NULL != pdSamples);
+  assert((0 < uiLag) && (uiLag < nSamples));
+
+  dMean = sum_samples(pdSamples, nSamples) / (double)nSamples;
+  dVariance = sum_products(pdSamples, pdSamples, nSamples, dMean);
+  if (0.0 >= dVariance) {
+    return 0.0;
+  }
+  return sum_products(pdSamples, pdSamples + uiLag, nSamples - uiLag, dMean) / dVariance;
+}
+
+/*------------------------------------------------------------------------*/
+double CU_stat_normal_cdf(double dX)
+{
+  return 0.5 * erfc(-dX / sqrt(2.0));
+}
+
+/*------------------------------------------------------------------------*/
+CU_BOOL CU_assertUniformImplementation(const double *pdSamples, size_t nSamples,
+                                       double dLow, double dHigh,
+                                       unsigned int uiBins, double dAlpha,
+                                       unsigned int uiLine, const char *strCondition,
+                                       const char *strFile, const char *strFunction,
+                                       CU_BOOL bFatal)
+{
+  double dChi2 = 0.0;
+  double dPValue = -1.0;
+  CU_BOOL bValue = CU_FALSE;
+
+  if ((NULL != pdSamples) && (0 < nSamples) && (dLow < dHigh) &&
+      (2 <= uiBins) && (CU_STAT_MAX_BINS >= uiBins)) {
+    dChi2 = CU_stat_chi_square_uniform(pdSamples, nSamples, dLow, dHigh, uiBins, &dPValue);
+    bValue = (dPValue >= dAlpha) ? CU_TRUE : CU_FALSE;
+  }
+  return CU_assertStatisticImplementation(bValue, uiLine, strCondition, strFile, strFunction,
+                                          bFatal, dChi2, dPValue);
+}
+
+/*------------------------------------------------------------------------*/
+CU_BOOL CU_assertDistributionImplementation(double *pdSamples, size_t nSamples,
+                                            CU_StatCdf pCdf, double dAlpha,
+                                            unsigned int uiLine, const char *strCondition,
+                                            const char *strFile, const char *strFunction,
+                                            CU_BOOL bFatal)
+{
+  double dD = 0.0;
+  double dPValue = -1.0;
+  CU_BOOL bValue = CU_FALSE;
+
+  if ((NULL != pdSamples) && (0 < nSamples) && (NULL != pCdf)) {
+    dD = CU_stat_ks(pdSamples, nSamples, pCdf, &dPValue);
+    bValue = (dPValue >= dAlpha) ? CU_TRUE : CU_FALSE;
+  }
+  return CU_assertStatisticImplementation(bValue, uiLine, strCondition, strFile, strFunction,
+                                          bFatal, dD, dPValue);
+}
+
+/*------------------------------------------------------------------------*/
+CU_BOOL CU_assertMeanImplementation(const double *pdSamples, size_t nSamples,
+                                    double dLow, double dHigh,
+                                    unsigned int uiLine, const char *strCondition,
+                                    const char *strFile, const char *strFunction,
+                                    CU_BOOL bFatal)
+{
+  double dMean = 0.0;
+  CU_BOOL bValue = CU_FALSE;
+
+  if ((NULL != pdSamples) && (0 < nSamples)) {
+    CU_stat_moments(pdSamples, nSamples, &dMean, NULL);
+    bValue = ((dMean >= dLow) && (dMean <= dHigh)) ? CU_TRUE : CU_FALSE;
+  }
+  return CU_assertStatisticImplementation(bValue, uiLine, strCondition, strFile, strFunction,
+                                          bFatal, dMean, -1.0);
+}
+
+/*------------------------------------------------------------------------*/
+CU_BOOL CU_assertVarianceImplementation(const double *pdSamples, size_t nSamples,
+                                        double dLow, double dHigh,
+                                        unsigned int uiLine, const char *strCondition,
+                                        const char *strFile, const char *strFunction,
+                                        CU_BOOL bFatal)
+{
+  double dVariance = 0.0;
+  CU_BOOL bValue = CU_FALSE;
+
+  if ((NULL != pdSamples) && (1 < nSamples)) {
+    CU_stat_moments(pdSamples, nSamples, NULL, &dVariance);
+    bValue = ((dVariance >= dLow) && (dVariance <= dHigh)) ? CU_TRUE : CU_FALSE;
+  }
+  return CU_assertStatisticImplementation(bValue, uiLine, strCondition, strFile, strFunction,
+                                          bFatal, dVariance, -1.0);
+}
+
+/*------------------------------------------------------------------------*/
+CU_BOOL CU_assertAutocorrelationImplementation(const double *pdSamples, size_t nSamples,
+                                               unsigned int uiMaxLag, double dLimit,
+                                               unsigned int uiLine, const char *strCondition,
+                                               const char *strFile, const char *strFunction,
+                                               CU_BOOL bFatal)
+{
+  double dWorst = 0.0;
+  double dR;
+  double dPValue = -1.0;
+  CU_BOOL bValue = CU_FALSE;
+  unsigned int uiLag;
+
+  if ((NULL != pdSamples) && (0 < uiMaxLag) && (uiMaxLag < nSamples)) {
+    for (uiLag = 1 ; uiLag <= uiMaxLag ; uiLag++) {
+      dR = CU_stat_autocorrelation(pdSamples, nSamples, uiLag);
+      if (fabs(dR) > fabs(dWorst)) {
+        dWorst = dR;
+      }
+    }
+    dPValue = erfc(fabs(dWorst) * sqrt((double)nSamples / 2.0));
+    bValue = (fabs(dWorst) <= dLimit) ? CU_TRUE : CU_FALSE;
+  }
+  return CU_assertStatisticImplementation(bValue, uiLine, strCondition, strFile, strFunction,
+                                          bFatal, dWorst, dPValue);
+}
+
+/*=================================================================
+ *  Static module functions
+ *=================================================================*/
+/** Sums the samples using STAT_LANES independent accumulators. */
+static double sum_samples(const double *pdSamples, size_t nSamples)
+{
+  double adSum[STAT_LANES] = { 0.0, 0.0, 0.0, 0.0 };
+  size_t nBlocked = nSamples - (nSamples % STAT_LANES);
+  size_t i;
+
+  for (i = 0 ; i < nBlocked ; i += STAT_LANES) {
+    adSum[0] += pdSamples[i];
+    adSum[1] += pdSamples[i + 1];
+    adSum[2] += pdSamples[i + 2];
+    adSum[3] += pdSamples[i + 3];
+  }
+  for ( ; i < nSamples ; i++) {
+    adSum[0] += pdSamples[i];
+  }
+  return (adSum[0] + adSum[1]) + (adSum[2] + adSum[3]);
+}
+
+/*------------------------------------------------------------------------*/
+/** Sums (a[i] - mean) * (b[i] - mean) using STAT_LANES independent accumulators. */
+static double sum_products(const double *pdA, const double *pdB, size_t nSamples, double dMean)
+{
+  double adSum[STAT_LANES] = { 0.0, 0.0, 0.0, 0.0 };
+  size_t nBlocked = nSamples - (nSamples % STAT_LANES);
+  size_t i;
+
+  for (i = 0 ; i < nBlocked ; i += STAT_LANES) {
+    adSum[0] += (pdA[i] - dMean) * (pdB[i] - dMean);
+    adSum[1] += (pdA[i + 1] - dMean) * (pdB[i + 1] - dMean);
+    adSum[2] += (pdA[i + 2] - dMean) * (pdB[i + 2] - dMean);
+    adSum[3] += (pdA[i + 3] - dMean) * (pdB[i + 3] - dMean);
+  }
+  for ( ; i < nSamples ; i++) {
+    adSum[0] += (pdA[i] - dMean) * (pdB[i] - dMean);
+  }
+  return (adSum[0] + adSum[1]) + (adSum[2] + adSum[3]);
+}
+
+/*------------------------------------------------------------------------*/
+/** Regularized upper incomplete gamma function Q(a, x), i.e. the
+ *  p-value of a chi-square statistic 2x with 2a degrees of freedom.
+ *  Uses the series for x < a + 1 and a continued fraction otherwise.
+ */
+static double gamma_q(double dA, double dX)
+{
+  double dPrefix;
+  double dSum, dTerm, dAp;
+  double dB, dC, dD, dH, dDelta, dAn;
+  int i;
+
+  if (0.0 >= dX) {
+    return 1.0;
+  }
+  dPrefix = exp(-dX + dA * log(dX) - lgamma(dA));
+
+  if (dX < dA + 1.0) {
+    dAp = dA;
+    dSum = dTerm = 1.0 / dA;
+    for (i = 0 ; i < STAT_GAMMA_ITERATIONS ; i++) {
+      dAp += 1.0;
+      dTerm *= dX / dAp;
+      dSum += dTerm;
+      if (fabs(dTerm) < fabs(dSum) * STAT_GAMMA_EPSILON) {
+        break;
+      }
+    }
+    return 1.0 - dSum * dPrefix;
+  }
+
+  /* modified Lentz's method */
+  dB = dX + 1.0 - dA;
+  dC = 1.0 / DBL_MIN;
+  dD = 1.0 / dB;
+  dH = dD;
+  for (i = 1 ; i <= STAT_GAMMA_ITERATIONS ; i++) {
+    dAn = -i * (i - dA);
+    dB += 2.0;
+    dD = dAn * dD + dB;
+    if (fabs(dD) < DBL_MIN) {
+      dD = DBL_MIN;
+    }
+    dC = dB + dAn / dC;
+    if (fabs(dC) < DBL_MIN) {
+      dC = DBL_MIN;
+    }
+    dD = 1.0 / dD;
+    dDelta = dD * dC;
+    dH *= dDelta;
+    if (fabs(dDelta - 1.0) < STAT_GAMMA_EPSILON) {
+      break;
+    }
+  }
+  return dH * dPrefix;
+}
+
+/*------------------------------------------------------------------------*/
+/** Asymptotic p-value of a Kolmogorov-Smirnov statistic, using the
+ *  small sample correction of Stephens (1970).
+ */
+static double ks_p_value(double dD, size_t nSamples)
+{
+  double dRootN = sqrt((double)nSamples);
+  double dLambda = (dRootN + 0.12 + 0.11 / dRootN) * dD;
+  double dSum = 0.0;
+  double dTerm;
+  double dSign = 1.0;
+  int k;
+
+  if (dLambda < 0.2) {
+    return 1.0;
+  }
+  for (k = 1 ; k <= 100 ; k++) {
+    dTerm = dSign * exp(-2.0 * k * k * dLambda * dLambda);
+    dSum += dTerm;
+    if (fabs(dTerm) < 1e-12) {
+      break;
+    }
+    dSign = -dSign;
+  }
+  dSum *= 2.0;
+  return (dSum < 0.0) ? 0.0 : ((dSum > 1.0) ? 1.0 : dSum);
+}
+
+/** @} */
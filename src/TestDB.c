@@ -75,7 +75,9 @@
 static CU_pTestRegistry f_pTestRegistry = NULL; /**< The active internal Test Registry. */
 
 
-/* Instead of dynamic allocation static storage is used */
+/* Instead of dynamic allocation static storage is used.  A slot is
+ * free while its pName is NULL, so slots released by cleanup_suite()
+ * and cleanup_test() are reused by later registrations. */
 
 static struct {
   CU_Suite suite;
@@ -87,11 +89,6 @@ static struct {
   char name[MAX_NAME_LEN];
 } _tests_buf[MAX_NUM_OF_TESTS];
 
-static struct {
-    unsigned int currSuiteIndex;
-    unsigned int currTestIndex;
-} test_db_storage_info = { 0, 0 };
-
 /*=================================================================
  * Private function forward declarations
  *=================================================================*/
@@ -103,8 +100,10 @@ static CU_pTest  create_test(const char* strName, CU_TestFunc pTestFunc);
 static void      cleanup_test(CU_pTest pTest);
 static void      insert_test(CU_pSuite pSuite, CU_pTest pTest);
 
+static void      remove_suite(CU_pTestRegistry pRegistry, CU_pSuite pSuite);
 static CU_BOOL   suite_exists(CU_pTestRegistry pRegistry, const char* szSuiteName);
 static CU_BOOL   test_exists(CU_pSuite pSuite, const char* szTestName);
+static void      compile_time_test(void);
 
 static CU_Suite* getNewSuitePtr();
 static CU_Test* getNewTestPtr();
@@ -241,6 +240,149 @@ CU_pTest CU_add_test(CU_pSuite pSuite, const char* strName, CU_TestFunc pTestFun
   return pRetValue;
 }
 
+/*------------------------------------------------------------------------*/
+CU_pTest CU_add_compile_time_test(CU_pSuite pSuite, const char* strName)
+{
+  CU_pTest pRetValue = CU_add_test(pSuite, strName, compile_time_test);
+
+  if (NULL != pRetValue) {
+    pRetValue->fCompileTime = CU_TRUE;
+  }
+  return pRetValue;
+}
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_add_tests(CU_pSuite pSuite, CU_TestInfo test_info[])
+{
+  CU_TestInfo *pTestItem = NULL;
+  CU_pTest pTail = NULL;
+  CU_pTest pTest = NULL;
+  CU_ErrorCode error = CUE_SUCCESS;
+
+  assert(CU_FALSE == CU_is_test_running());
+
+  if (NULL == f_pTestRegistry) {
+    error = CUE_NOREGISTRY;
+  }
+  else if (NULL == pSuite) {
+    error = CUE_NOSUITE;
+  }
+  else if (NULL != test_info) {
+    /* validate the whole array before registering any of it */
+    for (pTestItem = test_info ; (NULL != pTestItem->pName) || (NULL != pTestItem->pTestFunc) ; pTestItem++) {
+      if (NULL == pTestItem->pName) {
+        error = CUE_NO_TESTNAME;
+        break;
+      }
+      if (NULL == pTestItem->pTestFunc) {
+        error = CUE_NOTEST;
+        break;
+      }
+    }
+  }
+
+  if ((CUE_SUCCESS == error) && (NULL != test_info)) {
+    /* find the tail once and append behind it */
+    for (pTail = pSuite->pTest ; (NULL != pTail) && (NULL != pTail->pNext) ; pTail = pTail->pNext) {
+    }
+
+    for (pTestItem = test_info ; NULL != pTestItem->pName ; pTestItem++) {
+      if (NULL == (pTest = create_test(pTestItem->pName, pTestItem->pTestFunc))) {
+        error = CUE_NOMEMORY;
+        break;
+      }
+      if ((CUE_SUCCESS == error) && (CU_TRUE == test_exists(pSuite, pTestItem->pName))) {
+        error = CUE_DUP_TEST;
+      }
+
+      pTest->pPrev = pTail;
+      if (NULL == pTail) {
+        pSuite->pTest = pTest;
+      }
+      else {
+        pTail->pNext = pTest;
+      }
+      pTail = pTest;
+      pSuite->uiNumberOfTests++;
+      f_pTestRegistry->uiNumberOfTests++;
+    }
+  }
+
+  CU_set_error(error);
+  return error;
+}
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_remove_suite(CU_pSuite pSuite)
+{
+  CU_pSuite pCurSuite = NULL;
+  CU_ErrorCode error = CUE_SUCCESS;
+
+  assert(CU_FALSE == CU_is_test_running());
+
+  if (NULL == f_pTestRegistry) {
+    error = CUE_NOREGISTRY;
+  }
+  else if (NULL == pSuite) {
+    error = CUE_NOSUITE;
+  }
+  else {
+    pCurSuite = f_pTestRegistry->pSuite;
+    while ((NULL != pCurSuite) && (pCurSuite != pSuite)) {
+      pCurSuite = pCurSuite->pNext;
+    }
+    if (NULL == pCurSuite) {
+      error = CUE_NOSUITE;
+    }
+    else {
+      remove_suite(f_pTestRegistry, pSuite);
+    }
+  }
+
+  CU_set_error(error);
+  return error;
+}
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_register_suites(CU_SuiteInfo suite_info[])
+{
+  return CU_register_nsuites(1, suite_info);
+}
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_register_nsuites(int suite_count, ...)
+{
+  CU_SuiteInfo *pSuiteItem = NULL;
+  CU_pSuite     pSuite = NULL;
+  CU_ErrorCode  result = CUE_SUCCESS;
+  va_list argptr;
+  int i;
+
+  va_start(argptr, suite_count);
+
+  for (i = 0 ; (i < suite_count) && (CUE_SUCCESS == result) ; ++i) {
+    pSuiteItem = va_arg(argptr, CU_pSuiteInfo);
+    if (NULL == pSuiteItem) {
+      continue;
+    }
+    for ( ; (NULL != pSuiteItem->pName) && (CUE_SUCCESS == result) ; pSuiteItem++) {
+      pSuite = CU_add_suite_with_setup_and_teardown(pSuiteItem->pName,
+                                                    pSuiteItem->pInitFunc,
+                                                    pSuiteItem->pCleanupFunc,
+                                                    pSuiteItem->pSetUpFunc,
+                                                    pSuiteItem->pTearDownFunc);
+      result = CU_get_error();
+      /* duplicate names are registered but reported */
+      if ((NULL != pSuite) && (CUE_SUCCESS == result)) {
+        result = CU_add_tests(pSuite, pSuiteItem->pTests);
+      }
+    }
+  }
+
+  va_end(argptr);
+  CU_set_error(result);
+  return result;
+}
 
 /*=================================================================
  *  Private static function definitions
@@ -404,6 +546,42 @@ static void insert_suite(CU_pTestRegistry pRegistry, CU_pSuite pSuite)
   }
 }
 
+/*------------------------------------------------------------------------*/
+/**
+ *  Internal function to remove a suite from a registry.
+ *  The suite is unlinked from the registry's list of suites, the
+ *  registry counts are updated, and the suite and its tests are
+ *  cleaned up so that their storage can be reused.  pSuite must be
+ *  registered in pRegistry.  Severe problems can occur if this
+ *  function is called during a test run involving pRegistry.
+ *
+ *  @param pRegistry CU_pTestRegistry to remove from (non-NULL).
+ *  @param pSuite    CU_pSuite to remove (non-NULL).
+ *  @see insert_suite()
+ */
+static void remove_suite(CU_pTestRegistry pRegistry, CU_pSuite pSuite)
+{
+  assert(NULL != pRegistry);
+  assert(NULL != pSuite);
+
+  if (NULL != pSuite->pPrev) {
+    pSuite->pPrev->pNext = pSuite->pNext;
+  }
+  else {
+    pRegistry->pSuite = pSuite->pNext;
+  }
+  if (NULL != pSuite->pNext) {
+    pSuite->pNext->pPrev = pSuite->pPrev;
+  }
+
+  pRegistry->uiNumberOfSuites--;
+  pRegistry->uiNumberOfTests -= pSuite->uiNumberOfTests;
+
+  cleanup_suite(pSuite);
+  pSuite->pNext = NULL;
+  pSuite->pPrev = NULL;
+}
+
 /*------------------------------------------------------------------------*/
 /**
  *  Internal function to create a new test case having the specified parameters.
@@ -429,8 +607,15 @@ static CU_pTest create_test(const char* strName, CU_TestFunc pTestFunc)
     if (NULL != pRetValue->pName) {
       strncpy(pRetValue->pName, strName, MAX_NAME_LEN);
       pRetValue->fActive = CU_TRUE;
+      pRetValue->fCompileTime = CU_FALSE;
       pRetValue->pTestFunc = pTestFunc;
       pRetValue->pJumpBuf = NULL;
+      pRetValue->eOutcome = CUTO_NotRun;
+      pRetValue->uiNumberOfAsserts = 0;
+      pRetValue->uiNumberOfAssertsFailed = 0;
+      pRetValue->dElapsedTime = 0.0;
+      pRetValue->dWallTime = 0.0;
+      pRetValue->lHeapGrowth = 0;
       pRetValue->pNext = NULL;
       pRetValue->pPrev = NULL;
     }
@@ -563,6 +748,16 @@ static CU_BOOL test_exists(CU_pSuite pSuite, const char* szTestName)
 }
 
 
+/*------------------------------------------------------------------------*/
+/**
+ *  Test function of compile-time tests.
+ *  Never called by the runner; registered so that every test has a
+ *  function.
+ */
+static void compile_time_test(void)
+{
+}
+
 /*------------------------------------------------------------------------*/
 CU_pTest CU_get_test_by_name(const char* szTestName, CU_pSuite pSuite)
 {
@@ -590,27 +785,30 @@ CU_pTest CU_get_test_by_name(const char* szTestName, CU_pSuite pSuite)
 
 static CU_pSuite getNewSuitePtr()
 {
-  if (test_db_storage_info.currSuiteIndex >= MAX_NUM_OF_SUITES) {
-    return NULL;
+  unsigned int i;
+
+  for (i = 0 ; i < MAX_NUM_OF_SUITES ; i++) {
+    if (NULL == _suites_buf[i].suite.pName) {
+      _suites_buf[i].suite.pName = _suites_buf[i].name;
+      return &_suites_buf[i].suite;
+    }
   }
 
-  CU_pSuite pSuite = &_suites_buf[test_db_storage_info.currSuiteIndex].suite;
-  pSuite->pName = _suites_buf[test_db_storage_info.currSuiteIndex].name;
-  test_db_storage_info.currSuiteIndex++;
-  
-  return pSuite;
+  return NULL;
 }
 
 static CU_pTest getNewTestPtr()
 {
-  if (test_db_storage_info.currTestIndex >= MAX_NUM_OF_TESTS) {
-    return NULL;
+  unsigned int i;
+
+  for (i = 0 ; i < MAX_NUM_OF_TESTS ; i++) {
+    if (NULL == _tests_buf[i].test.pName) {
+      _tests_buf[i].test.pName = _tests_buf[i].name;
+      return &_tests_buf[i].test;
+    }
   }
-  CU_pTest pTest = &_tests_buf[test_db_storage_info.currTestIndex].test;
-  pTest->pName = _tests_buf[test_db_storage_info.currTestIndex].name;
-  test_db_storage_info.currTestIndex++;
-  
-  return pTest;
+
+  return NULL;
 }
 
 
@@ -77,11 +77,20 @@
 #include <stdio.h>
 #include <setjmp.h>
 #include <time.h>
+#ifdef LINUX
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#endif
 
 #include "CUnit.h"
 #include "MyMem.h"
 #include "TestDB.h"
 #include "TestRun.h"
+#include "Mock.h"
+#include "Export.h"
+#include "Baseline.h"
 #include "Util.h"
 #include "CUnit_intl.h"
 
@@ -104,6 +113,12 @@ static CU_pFailureRecord f_last_failure = NULL;
 /** Flag for whether inactive suites/tests are treated as failures. */
 static CU_BOOL f_failure_on_inactive = CU_TRUE;
 
+/** Flag for whether failed assertions only update the counts. */
+static CU_BOOL f_bAssertCountOnly = CU_FALSE;
+
+/** Function running the body of each test, NULL to call the test function. */
+static CU_TestBodyWrapper f_pTestBodyWrapper = NULL;
+
 /** Variable for storage of start time for test run. */
 static clock_t f_start_time;
 
@@ -142,15 +157,34 @@ static struct {
     unsigned int currFailureIndex;
 } test_run_storage_info = { 0 };
 
+#ifdef LINUX
+/** Wall-clock start of the current test, for state dumps. */
+static struct timespec f_test_start_wall;
+
+/** Slowest tests of the current run, slowest first, for state dumps. */
+static struct {
+  CU_pSuite pSuite;
+  CU_pTest  pTest;
+  double    dSeconds;
+} f_slowest[CU_DUMP_SLOWEST];
+
+static int              f_iDumpFd = -1;           /**< Destination of state dumps, -1 if disabled. */
+static CU_BOOL          f_bDumpOwnsFd = CU_FALSE; /**< Whether f_iDumpFd was opened for dumps. */
+static struct sigaction f_prev_dump_action;       /**< SIGUSR1 action replaced by the dump handler. */
+static char             f_szDump[2048];           /**< Preallocated output buffer of a dump. */
+static size_t           f_nDumpLen = 0;           /**< Characters in f_szDump. */
+#endif
+
 
 /*=================================================================
  * Private function forward declarations
  *=================================================================*/
 static void         clear_previous_results(CU_pRunSummary pRunSummary, CU_pFailureRecord* ppFailure);
+static void         clear_test_results(CU_pTestRegistry pRegistry);
 static void         cleanup_failure_list(CU_pFailureRecord* ppFailure);
 static CU_ErrorCode run_single_suite(CU_pSuite pSuite, CU_pRunSummary pRunSummary);
 static CU_ErrorCode run_single_test(CU_pTest pTest, CU_pRunSummary pRunSummary);
-static void         add_failure(CU_pFailureRecord* ppFailure,
+static CU_pFailureRecord add_failure(CU_pFailureRecord* ppFailure,
                                 CU_pRunSummary pRunSummary,
                                 CU_FailureType type,
                                 unsigned int uiLineNumber,
@@ -158,8 +192,24 @@ static void         add_failure(CU_pFailureRecord* ppFailure,
                                 const char *szFileName,
                                 CU_pSuite pSuite,
                                 CU_pTest pTest);
+static CU_BOOL      assert_implementation(CU_BOOL bValue,
+                                          unsigned int uiLine,
+                                          const char *strCondition,
+                                          const char *strFile,
+                                          CU_BOOL bFatal,
+                                          CU_BOOL fStatistic,
+                                          double dStatistic,
+                                          double dPValue);
 
 static CU_pFailureRecord getNewFailureRecordPtr();      
+#ifdef LINUX
+static void         record_slowest(CU_pSuite pSuite, CU_pTest pTest);
+static void         dump_state_handler(int iSignal);
+static void         dump_flush(void);
+static void         dump_str(const char *szText);
+static void         dump_uint(unsigned long ulValue);
+static void         dump_seconds(double dSeconds);
+#endif
 
 /*=================================================================
  *  Public Interface functions
@@ -174,24 +224,104 @@ CU_BOOL CU_assertImplementation(CU_BOOL bValue,
   /* not used in current implementation - stop compiler warning */
   CU_UNREFERENCED_PARAMETER(strFunction);
 
-  /* these should always be non-NULL (i.e. a test run is in progress) */
-  assert(NULL != f_pCurSuite);
-  assert(NULL != f_pCurTest);
+  return assert_implementation(bValue, uiLine, strCondition, strFile, bFatal,
+                               CU_FALSE, 0.0, -1.0);
+}
 
-  ++f_run_summary.nAsserts;
-  if (CU_FALSE == bValue) {
-    ++f_run_summary.nAssertsFailed;
-    add_failure(&f_failure_list, &f_run_summary, CUF_AssertFailed,
-                uiLine, strCondition, strFile, f_pCurSuite, f_pCurTest);
+/*------------------------------------------------------------------------*/
+CU_BOOL CU_assertStatisticImplementation(CU_BOOL bValue,
+                                         unsigned int uiLine,
+                                         const char *strCondition,
+                                         const char *strFile,
+                                         const char *strFunction,
+                                         CU_BOOL bFatal,
+                                         double dStatistic,
+                                         double dPValue)
+{
+  /* not used in current implementation - stop compiler warning */
+  CU_UNREFERENCED_PARAMETER(strFunction);
 
-    if ((CU_TRUE == bFatal) && (NULL != f_pCurTest->pJumpBuf)) {
-      longjmp(*(f_pCurTest->pJumpBuf), 1);
+  return assert_implementation(bValue, uiLine, strCondition, strFile, bFatal,
+                               CU_TRUE, dStatistic, dPValue);
+}
+
+/*------------------------------------------------------------------------*/
+void CU_record_failure(CU_FailureType type,
+                       unsigned int uiLine,
+                       const char *strCondition,
+                       const char *strFile,
+                       CU_pSuite pSuite,
+                       CU_pTest pTest)
+{
+  assert(NULL != strCondition);
+  assert(NULL != strFile);
+
+  add_failure(&f_failure_list, &f_run_summary, type,
+              uiLine, strCondition, strFile, pSuite, pTest);
+}
+
+#ifdef LINUX
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_enable_state_dump(const char *szFile)
+{
+  struct sigaction action;
+  int fd = STDERR_FILENO;
+
+  CU_disable_state_dump();
+
+  if ((NULL != szFile) && (0 > (fd = open(szFile, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644)))) {
+    CU_set_error(CUE_FOPEN_FAILED);
+    return CUE_FOPEN_FAILED;
+  }
+  f_iDumpFd = fd;
+  f_bDumpOwnsFd = (NULL != szFile) ? CU_TRUE : CU_FALSE;
+
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = dump_state_handler;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = SA_RESTART;
+  if (0 != sigaction(SIGUSR1, &action, &f_prev_dump_action)) {
+    if (CU_FALSE != f_bDumpOwnsFd) {
+      close(f_iDumpFd);
     }
+    f_iDumpFd = -1;
+    CU_set_error(CUE_FOPEN_FAILED);
+    return CUE_FOPEN_FAILED;
   }
 
-  return bValue;
+  CU_set_error(CUE_SUCCESS);
+  return CUE_SUCCESS;
 }
 
+/*------------------------------------------------------------------------*/
+void CU_disable_state_dump(void)
+{
+  if (0 > f_iDumpFd) {
+    return;
+  }
+  sigaction(SIGUSR1, &f_prev_dump_action, NULL);
+  if (CU_FALSE != f_bDumpOwnsFd) {
+    close(f_iDumpFd);
+  }
+  f_iDumpFd = -1;
+}
+
+#else  /* LINUX */
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_enable_state_dump(const char *szFile)
+{
+  CU_UNREFERENCED_PARAMETER(szFile);
+  CU_set_error(CUE_FOPEN_FAILED);
+  return CUE_FOPEN_FAILED;
+}
+
+/*------------------------------------------------------------------------*/
+void CU_disable_state_dump(void)
+{
+}
+#endif /* LINUX */
+
 /*------------------------------------------------------------------------*/
 void CU_set_suite_start_handler(CU_SuiteStartMessageHandler pSuiteStartHandler)
 {
@@ -377,6 +507,7 @@ CU_ErrorCode CU_run_all_tests(void)
     /* test run is starting - set flag */
     f_bTestIsRunning = CU_TRUE;
     f_start_time = CU_get_time();
+    CU_export_stream_run_start();
 
     pSuite = pRegistry->pSuite;
     while ((NULL != pSuite) && ((CUE_SUCCESS == result) || (CU_get_error_action() == CUEA_IGNORE))) {
@@ -388,6 +519,7 @@ CU_ErrorCode CU_run_all_tests(void)
     /* test run is complete - clear flag */
     f_bTestIsRunning = CU_FALSE;
     f_run_summary.ElapsedTime = ((double)CU_get_time() - (double)f_start_time)/(double)CLOCKS_PER_SEC;
+    CU_export_stream_run_complete();
 
     if (NULL != f_pAllTestsCompleteMessageHandler) {
      (*f_pAllTestsCompleteMessageHandler)(f_failure_list);
@@ -413,12 +545,14 @@ CU_ErrorCode CU_run_suite(CU_pSuite pSuite)
     /* test run is starting - set flag */
     f_bTestIsRunning = CU_TRUE;
     f_start_time = CU_get_time();
+    CU_export_stream_run_start();
 
     result = run_single_suite(pSuite, &f_run_summary);
 
     /* test run is complete - clear flag */
     f_bTestIsRunning = CU_FALSE;
     f_run_summary.ElapsedTime = ((double)CU_get_time() - (double)f_start_time)/(double)CLOCKS_PER_SEC;
+    CU_export_stream_run_complete();
 
     /* run handler for overall completion, if any */
     if (NULL != f_pAllTestsCompleteMessageHandler) {
@@ -460,6 +594,7 @@ CU_ErrorCode CU_run_test(CU_pSuite pSuite, CU_pTest pTest)
     /* test run is starting - set flag */
     f_bTestIsRunning = CU_TRUE;
     f_start_time = CU_get_time();
+    CU_export_stream_run_start();
 
     f_pCurTest = NULL;
     f_pCurSuite = pSuite;
@@ -506,10 +641,12 @@ CU_ErrorCode CU_run_test(CU_pSuite pSuite, CU_pTest pTest)
     if (NULL != f_pSuiteCompleteMessageHandler) {
       (*f_pSuiteCompleteMessageHandler)(pSuite, NULL);
     }
+    CU_export_stream_suite(pSuite);
 
     /* test run is complete - clear flag */
     f_bTestIsRunning = CU_FALSE;
     f_run_summary.ElapsedTime = ((double)CU_get_time() - (double)f_start_time)/(double)CLOCKS_PER_SEC;
+    CU_export_stream_run_complete();
 
     /* run handler for overall completion, if any */
     if (NULL != f_pAllTestsCompleteMessageHandler) {
@@ -559,6 +696,30 @@ CU_EXPORT CU_BOOL CU_get_fail_on_inactive(void)
   return f_failure_on_inactive;
 }
 
+/*------------------------------------------------------------------------*/
+CU_EXPORT void CU_set_test_body_wrapper(CU_TestBodyWrapper pWrapper)
+{
+  f_pTestBodyWrapper = pWrapper;
+}
+
+/*------------------------------------------------------------------------*/
+CU_EXPORT CU_TestBodyWrapper CU_get_test_body_wrapper(void)
+{
+  return f_pTestBodyWrapper;
+}
+
+/*------------------------------------------------------------------------*/
+CU_EXPORT void CU_set_assert_count_only(CU_BOOL bCountOnly)
+{
+  f_bAssertCountOnly = bCountOnly;
+}
+
+/*------------------------------------------------------------------------*/
+CU_EXPORT CU_BOOL CU_get_assert_count_only(void)
+{
+  return f_bAssertCountOnly;
+}
+
 /*------------------------------------------------------------------------*/
 CU_EXPORT void CU_print_run_results(FILE *file)
 {
@@ -696,15 +857,16 @@ CU_EXPORT char * CU_get_run_results_string(void)
  *  @param szFileName   Name of file, if applicable
  *  @param pSuite       The suite being run at time of failure
  *  @param pTest        The test being run at time of failure
+ *  @return The new failure record, NULL if none could be created.
  */
-static void add_failure(CU_pFailureRecord* ppFailure,
-                        CU_pRunSummary pRunSummary,
-                        CU_FailureType type,
-                        unsigned int uiLineNumber,
-                        const char *szCondition,
-                        const char *szFileName,
-                        CU_pSuite pSuite,
-                        CU_pTest pTest)
+static CU_pFailureRecord add_failure(CU_pFailureRecord* ppFailure,
+                                     CU_pRunSummary pRunSummary,
+                                     CU_FailureType type,
+                                     unsigned int uiLineNumber,
+                                     const char *szCondition,
+                                     const char *szFileName,
+                                     CU_pSuite pSuite,
+                                     CU_pTest pTest)
 {
   CU_pFailureRecord pFailureNew = NULL;
   CU_pFailureRecord pTemp = NULL;
@@ -715,7 +877,7 @@ static void add_failure(CU_pFailureRecord* ppFailure,
   
 
   if (NULL == pFailureNew) {
-    return;
+    return NULL;
   }
 
   // pFailureNew->strFileName = NULL;
@@ -724,7 +886,7 @@ static void add_failure(CU_pFailureRecord* ppFailure,
     // pFailureNew->strFileName = (char*)CU_ MALLOC(strlen(szFileName) + 1);
     if(NULL == pFailureNew->strFileName) {
       //CU_FREE(pFailureNew);
-      return;
+      return NULL;
     }
     strncpy(pFailureNew->strFileName, szFileName, MAX_NAME_LEN);
   }
@@ -736,7 +898,7 @@ static void add_failure(CU_pFailureRecord* ppFailure,
         //CU_FREE(pFailureNew->strFileName);
       }
       //CU_FREE(pFailureNew);
-      return;
+      return NULL;
     }
     strncpy(pFailureNew->strCondition, szCondition, MAX_NAME_LEN);
   }
@@ -745,6 +907,9 @@ static void add_failure(CU_pFailureRecord* ppFailure,
   pFailureNew->uiLineNumber = uiLineNumber;
   pFailureNew->pTest = pTest;
   pFailureNew->pSuite = pSuite;
+  pFailureNew->fStatistic = CU_FALSE;
+  pFailureNew->dStatistic = 0.0;
+  pFailureNew->dPValue = -1.0;
   pFailureNew->pNext = NULL;
   pFailureNew->pPrev = NULL;
 
@@ -765,6 +930,52 @@ static void add_failure(CU_pFailureRecord* ppFailure,
   }
   
   f_last_failure = pFailureNew;
+  return pFailureNew;
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Records the outcome of an assertion in the current test.
+ *  Common implementation of CU_assertImplementation() and
+ *  CU_assertStatisticImplementation().
+ */
+static CU_BOOL assert_implementation(CU_BOOL bValue,
+                                     unsigned int uiLine,
+                                     const char *strCondition,
+                                     const char *strFile,
+                                     CU_BOOL bFatal,
+                                     CU_BOOL fStatistic,
+                                     double dStatistic,
+                                     double dPValue)
+{
+  CU_pFailureRecord pFailure;
+
+  /* these should always be non-NULL (i.e. a test run is in progress) */
+  assert(NULL != f_pCurSuite);
+  assert(NULL != f_pCurTest);
+
+  ++f_run_summary.nAsserts;
+  ++f_pCurTest->uiNumberOfAsserts;
+  if (CU_FALSE == bValue) {
+    ++f_run_summary.nAssertsFailed;
+    ++f_pCurTest->uiNumberOfAssertsFailed;
+    if ((CU_FALSE != f_bAssertCountOnly) && (CU_FALSE == bFatal)) {
+      return bValue;
+    }
+    pFailure = add_failure(&f_failure_list, &f_run_summary, CUF_AssertFailed,
+                           uiLine, strCondition, strFile, f_pCurSuite, f_pCurTest);
+    if ((NULL != pFailure) && (CU_TRUE == fStatistic)) {
+      pFailure->fStatistic = CU_TRUE;
+      pFailure->dStatistic = dStatistic;
+      pFailure->dPValue = dPValue;
+    }
+
+    if ((CU_TRUE == bFatal) && (NULL != f_pCurTest->pJumpBuf)) {
+      longjmp(*(f_pCurTest->pJumpBuf), 1);
+    }
+  }
+
+  return bValue;
 }
 
 
@@ -824,6 +1035,41 @@ static void clear_previous_results(CU_pRunSummary pRunSummary, CU_pFailureRecord
   }
 
   f_last_failure = NULL;
+#ifdef LINUX
+  memset(f_slowest, 0, sizeof(f_slowest));
+#endif
+
+  clear_test_results(CU_get_registry());
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Resets the per-test results (outcome, assertion counts and
+ *  elapsed time) of all tests in the specified registry.  Tests
+ *  which are not reached during the next run are thereby reported
+ *  as not run rather than with stale results.
+ *
+ *  @param pRegistry The registry holding the tests (ignored if NULL).
+ */
+static void clear_test_results(CU_pTestRegistry pRegistry)
+{
+  CU_pSuite pSuite = NULL;
+  CU_pTest pTest = NULL;
+
+  if (NULL == pRegistry) {
+    return;
+  }
+
+  for (pSuite = pRegistry->pSuite ; NULL != pSuite ; pSuite = pSuite->pNext) {
+    for (pTest = pSuite->pTest ; NULL != pTest ; pTest = pTest->pNext) {
+      pTest->eOutcome = CUTO_NotRun;
+      pTest->uiNumberOfAsserts = 0;
+      pTest->uiNumberOfAssertsFailed = 0;
+      pTest->dElapsedTime = 0.0;
+      pTest->dWallTime = 0.0;
+      pTest->lHeapGrowth = 0;
+    }
+  }
 }
 
 /*------------------------------------------------------------------------*/
@@ -858,6 +1104,9 @@ static void cleanup_failure_list(CU_pFailureRecord* ppFailure)
   }
 
   *ppFailure = NULL;
+
+  /* all records are in the list, so the static pool is free again */
+  test_run_storage_info.currFailureIndex = 0;
 }
 
 /*------------------------------------------------------------------------*/
@@ -923,6 +1172,7 @@ static CU_ErrorCode run_single_suite(CU_pSuite pSuite, CU_pRunSummary pRunSummar
         }
         else {
           f_run_summary.nTestsInactive++;
+          pTest->eOutcome = CUTO_Inactive;
           if (CU_FALSE != f_failure_on_inactive) {
             add_failure(&f_failure_list, &f_run_summary, CUF_TestInactive,
                         0, _("Test inactive"), _("CUnit System"), pSuite, pTest);
@@ -981,6 +1231,7 @@ static CU_ErrorCode run_single_suite(CU_pSuite pSuite, CU_pRunSummary pRunSummar
     (*f_pSuiteCompleteMessageHandler)(pSuite, pLastFailure);
   }
 
+  CU_export_stream_suite(pSuite);
   f_pCurSuite = NULL;
   return result;
 }
@@ -1007,6 +1258,10 @@ static CU_ErrorCode run_single_test(CU_pTest pTest, CU_pRunSummary pRunSummary)
   /* keep track of the last failure BEFORE running the test */
   volatile CU_pFailureRecord pLastFailure = f_last_failure;
   jmp_buf buf;
+  clock_t start_time;
+  unsigned long long start_wall;
+  size_t start_heap;
+  volatile CU_BOOL bCountOnly;
   CU_ErrorCode result = CUE_SUCCESS;
 
   assert(NULL != f_pCurSuite);
@@ -1017,34 +1272,69 @@ static CU_ErrorCode run_single_test(CU_pTest pTest, CU_pRunSummary pRunSummary)
   nStartFailures = pRunSummary->nFailureRecords;
 
   f_pCurTest = pTest;
+  pTest->uiNumberOfAsserts = 0;
+  pTest->uiNumberOfAssertsFailed = 0;
+  pTest->dElapsedTime = 0.0;
+  pTest->dWallTime = 0.0;
+  pTest->lHeapGrowth = 0;
+  CU_reset_mocks();
 
   if (NULL != f_pTestStartMessageHandler) {
     (*f_pTestStartMessageHandler)(f_pCurTest, f_pCurSuite);
   }
 
-  /* run test if it is active */
+  /* run test if it is active - compile-time tests have nothing to run */
   if (CU_FALSE != pTest->fActive) {
 
-    if (NULL != f_pCurSuite->pSetUpFunc) {
-      (*f_pCurSuite->pSetUpFunc)();
-    }
+    if (CU_FALSE == pTest->fCompileTime) {
+      start_heap = CU_get_heap_in_use();
+#ifdef LINUX
+      clock_gettime(CLOCK_MONOTONIC, &f_test_start_wall);
+#endif
+      start_time = CU_get_time();
+      start_wall = CU_get_time_ns();
 
-    /* set jmp_buf and run test */
-    pTest->pJumpBuf = &buf;
-    if (0 == setjmp(buf)) {
-      if (NULL != pTest->pTestFunc) {
-        (*pTest->pTestFunc)();
+      if (NULL != f_pCurSuite->pSetUpFunc) {
+        (*f_pCurSuite->pSetUpFunc)();
       }
-    }
 
-    if (NULL != f_pCurSuite->pTearDownFunc) {
-       (*f_pCurSuite->pTearDownFunc)();
-    }
+      /* set jmp_buf and run test */
+      pTest->pJumpBuf = &buf;
+      bCountOnly = f_bAssertCountOnly;
+      if (0 == setjmp(buf)) {
+        if (NULL != f_pTestBodyWrapper) {
+          (*f_pTestBodyWrapper)(f_pCurSuite, pTest);
+        }
+        else if (NULL != pTest->pTestFunc) {
+          (*pTest->pTestFunc)();
+        }
+      }
+      else {
+        /* a fatal assertion skips the end of a wrapper counting assertions */
+        f_bAssertCountOnly = bCountOnly;
+      }
 
+      if (NULL != f_pCurSuite->pTearDownFunc) {
+         (*f_pCurSuite->pTearDownFunc)();
+      }
+
+      pTest->dElapsedTime = ((double)CU_get_time() - (double)start_time)/(double)CLOCKS_PER_SEC;
+      pTest->dWallTime = (double)(CU_get_time_ns() - start_wall) / 1e9;
+      pTest->lHeapGrowth = (long)(CU_get_heap_in_use() - start_heap);
+#ifdef LINUX
+      record_slowest(f_pCurSuite, pTest);
+#endif
+      /* the baseline is checked after the time is taken, only for passing tests */
+      if (pRunSummary->nFailureRecords == nStartFailures) {
+        CU_baseline_check_test(f_pCurSuite, pTest);
+      }
+    }
+    pTest->eOutcome = CUTO_Passed;
     pRunSummary->nTestsRun++;
   }
   else {
     f_run_summary.nTestsInactive++;
+    pTest->eOutcome = CUTO_Inactive;
     if (CU_FALSE != f_failure_on_inactive) {
       add_failure(&f_failure_list, &f_run_summary, CUF_TestInactive,
                   0, _("Test inactive"), _("CUnit System"), f_pCurSuite, f_pCurTest);
@@ -1055,6 +1345,9 @@ static CU_ErrorCode run_single_test(CU_pTest pTest, CU_pRunSummary pRunSummary)
   /* if additional failures have occurred... */
   if (pRunSummary->nFailureRecords > nStartFailures) {
     pRunSummary->nTestsFailed++;
+    if (CUTO_Passed == pTest->eOutcome) {
+      pTest->eOutcome = CUTO_Failed;
+    }
     if (NULL != pLastFailure) {
       pLastFailure = pLastFailure->pNext;  /* was a previous failure, so go to next one */
     }
@@ -1069,11 +1362,187 @@ static CU_ErrorCode run_single_test(CU_pTest pTest, CU_pRunSummary pRunSummary)
   if (NULL != f_pTestCompleteMessageHandler) {
     (*f_pTestCompleteMessageHandler)(f_pCurTest, f_pCurSuite, pLastFailure);
   }
+  CU_export_stream_test(f_pCurSuite, pTest);
 
   pTest->pJumpBuf = NULL;
   f_pCurTest = NULL;
+  CU_reset_mocks();
 
   return result;
 }
 
+#ifdef LINUX
+/*------------------------------------------------------------------------*/
+/**
+ *  Inserts a completed test into the list of slowest tests of the run.
+ *  Tests are ranked by wall-clock time since f_test_start_wall, so that
+ *  tests blocking or sleeping rank like the running test in a dump.
+ */
+static void record_slowest(CU_pSuite pSuite, CU_pTest pTest)
+{
+  struct timespec now;
+  double dSeconds;
+  unsigned int i;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  dSeconds = (double)(now.tv_sec - f_test_start_wall.tv_sec)
+             + (double)(now.tv_nsec - f_test_start_wall.tv_nsec) / 1e9;
+
+  if (dSeconds <= f_slowest[CU_DUMP_SLOWEST - 1].dSeconds) {
+    return;
+  }
+  for (i = CU_DUMP_SLOWEST - 1 ; (i > 0) && (f_slowest[i - 1].dSeconds < dSeconds) ; i--) {
+    f_slowest[i] = f_slowest[i - 1];
+  }
+  f_slowest[i].pSuite = pSuite;
+  f_slowest[i].pTest = pTest;
+  f_slowest[i].dSeconds = dSeconds;
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  SIGUSR1 handler writing a snapshot of the run to f_iDumpFd.
+ *  Only async-signal-safe functions are called.  The run may be
+ *  interrupted anywhere, so the snapshot may be slightly inconsistent,
+ *  but failure records are only reached through f_last_failure, which
+ *  is set after a record is complete.
+ */
+static void dump_state_handler(int iSignal)
+{
+  int iErrno = errno;
+  CU_pSuite pSuite = f_pCurSuite;
+  CU_pTest pTest = f_pCurTest;
+  CU_pFailureRecord pFailure = f_last_failure;
+  struct timespec now;
+  unsigned int i;
+
+  CU_UNREFERENCED_PARAMETER(iSignal);
+
+  f_nDumpLen = 0;
+  dump_str("\n--- CUnit run state ---\nsuite:   ");
+  dump_str((NULL != pSuite) ? pSuite->pName : "(none)");
+  dump_str("\ntest:    ");
+  if (NULL != pTest) {
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    dump_str(pTest->pName);
+    dump_str(" (running for ");
+    dump_seconds((double)(now.tv_sec - f_test_start_wall.tv_sec)
+                 + (double)(now.tv_nsec - f_test_start_wall.tv_nsec) / 1e9);
+    dump_str(" s)");
+  }
+  else {
+    dump_str("(none)");
+  }
+
+  dump_str("\nsuites:  ");
+  dump_uint(f_run_summary.nSuitesRun);
+  dump_str(" run, ");
+  dump_uint(f_run_summary.nSuitesFailed);
+  dump_str(" failed, ");
+  dump_uint(f_run_summary.nSuitesInactive);
+  dump_str(" inactive\ntests:   ");
+  dump_uint(f_run_summary.nTestsRun);
+  dump_str(" run, ");
+  dump_uint(f_run_summary.nTestsFailed);
+  dump_str(" failed, ");
+  dump_uint(f_run_summary.nTestsInactive);
+  dump_str(" inactive\nasserts: ");
+  dump_uint(f_run_summary.nAsserts);
+  dump_str(" run, ");
+  dump_uint(f_run_summary.nAssertsFailed);
+  dump_str(" failed, ");
+  dump_uint(f_run_summary.nFailureRecords);
+  dump_str(" failure records\n");
+
+  dump_str("slowest tests:\n");
+  for (i = 0 ; (i < CU_DUMP_SLOWEST) && (NULL != f_slowest[i].pTest) ; i++) {
+    dump_str("  ");
+    dump_seconds(f_slowest[i].dSeconds);
+    dump_str(" s  ");
+    dump_str(f_slowest[i].pSuite->pName);
+    dump_str("/");
+    dump_str(f_slowest[i].pTest->pName);
+    dump_str("\n");
+  }
+
+  dump_str("last failures:\n");
+  for (i = 0 ; (i < CU_DUMP_FAILURES) && (NULL != pFailure) ; i++, pFailure = pFailure->pPrev) {
+    dump_str("  ");
+    dump_str((NULL != pFailure->pSuite) ? pFailure->pSuite->pName : "");
+    dump_str("/");
+    dump_str((NULL != pFailure->pTest) ? pFailure->pTest->pName : "(suite)");
+    dump_str(" ");
+    dump_str(pFailure->strFileName);
+    dump_str(":");
+    dump_uint(pFailure->uiLineNumber);
+    dump_str(" ");
+    dump_str(pFailure->strCondition);
+    dump_str("\n");
+  }
+
+  dump_flush();
+  errno = iErrno;
+}
+
+/*------------------------------------------------------------------------*/
+/** Writes the dump buffer to the dump destination. */
+static void dump_flush(void)
+{
+  size_t nWritten = 0;
+  ssize_t n;
+
+  while (nWritten < f_nDumpLen) {
+    n = write(f_iDumpFd, f_szDump + nWritten, f_nDumpLen - nWritten);
+    if ((n < 0) && (EINTR == errno)) {
+      continue;
+    }
+    if (n <= 0) {
+      break;
+    }
+    nWritten += (size_t)n;
+  }
+  f_nDumpLen = 0;
+}
+
+/*------------------------------------------------------------------------*/
+static void dump_str(const char *szText)
+{
+  if (NULL == szText) {
+    return;
+  }
+  for ( ; '\0' != *szText ; szText++) {
+    if (f_nDumpLen == sizeof(f_szDump)) {
+      dump_flush();
+    }
+    f_szDump[f_nDumpLen++] = *szText;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+static void dump_uint(unsigned long ulValue)
+{
+  char szDigits[24];
+  unsigned int i = sizeof(szDigits) - 1;
+
+  szDigits[i] = '\0';
+  do {
+    szDigits[--i] = (char)('0' + (ulValue % 10));
+    ulValue /= 10;
+  } while (0 != ulValue);
+  dump_str(&szDigits[i]);
+}
+
+/*------------------------------------------------------------------------*/
+/** Writes a non-negative number of seconds with millisecond precision. */
+static void dump_seconds(double dSeconds)
+{
+  unsigned long ulMillis = (dSeconds > 0.0) ? (unsigned long)(dSeconds * 1000.0 + 0.5) : 0;
+
+  dump_uint(ulMillis / 1000);
+  dump_str(".");
+  dump_str((ulMillis % 1000 < 100) ? ((ulMillis % 1000 < 10) ? "00" : "0") : "");
+  dump_uint(ulMillis % 1000);
+}
+#endif /* LINUX */
+
 /** @} */
@@ -0,0 +1,435 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Implementation of assertions searching large text buffers.
+ *
+ *  19-Oct-2026   Initial implementation of text search assertions.
+ */
+
+/** @file
+ *  Text search assertions (implementation).
+ *  The automaton is a complete transition table (a DFA), so matching
+ *  costs one table lookup per byte whatever the number of patterns.
+ */
+/** @addtogroup Framework
+ @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "CUnit.h"
+#include "TestRun.h"
+#include "TextSearch.h"
+
+/*=================================================================
+ *  Global/Static Definitions
+ *=================================================================*/
+static unsigned short f_ausNext[CU_TEXT_MAX_STATES][256];          /**< Transitions of the automaton. */
+static unsigned short f_ausFail[CU_TEXT_MAX_STATES];               /**< Failure links while building. */
+static unsigned short f_ausQueue[CU_TEXT_MAX_STATES];              /**< Breadth-first order while building. */
+static unsigned int   f_auiOutput[CU_TEXT_MAX_STATES];             /**< Patterns ending in each state (bit mask). */
+static size_t         f_anPatternLength[CU_TEXT_MAX_PATTERNS];     /**< Lengths of the patterns. */
+static unsigned int   f_uiStates = 0;                              /**< States of the automaton. */
+
+/*=================================================================
+ *  Private function forward declarations
+ *=================================================================*/
+static const char* find_scalar(const char *pText, size_t nLength, const char *pPattern, size_t nPattern);
+static size_t count_newlines(const char *pText, size_t nLength);
+static CU_ErrorCode build_automaton(const char * const *aszPatterns, unsigned int uiPatterns);
+static unsigned int lowest_pattern(unsigned int uiMask);
+
+/*=================================================================
+ *  Public Interface functions
+ *=================================================================*/
+const char* CU_text_find(const char *pText, size_t nLength, const char *szPattern)
+{
+  size_t nPattern;
+  size_t nCandidates;
+  size_t i = 0;
+
+  assert(NULL != szPattern);
+
+  nPattern = strlen(szPattern);
+  if (0 == nPattern) {
+    return pText;
+  }
+  if (nPattern > nLength) {
+    return NULL;
+  }
+  nCandidates = nLength - nPattern + 1;
+
+#ifdef __SSE2__
+  {
+    const __m128i first = _mm_set1_epi8(szPattern[0]);
+    const __m128i last = _mm_set1_epi8(szPattern[nPattern - 1]);
+    unsigned int uiMask;
+    unsigned int uiBit;
+
+    /* candidates are starts where both the first and the last byte match */
+    for ( ; i + 16 <= nCandidates ; i += 16) {
+      uiMask = (unsigned int)_mm_movemask_epi8(_mm_and_si128(
+                 _mm_cmpeq_epi8(first, _mm_loadu_si128((const __m128i*)(pText + i))),
+                 _mm_cmpeq_epi8(last, _mm_loadu_si128((const __m128i*)(pText + i + nPattern - 1)))));
+      while (0 != uiMask) {
+        uiBit = (unsigned int)__builtin_ctz(uiMask);
+        if (0 == memcmp(pText + i + uiBit + 1, szPattern + 1, nPattern - 1)) {
+          return pText + i + uiBit;
+        }
+        uiMask &= uiMask - 1;
+      }
+    }
+  }
+#endif
+
+  return find_scalar(pText + i, nLength - i, szPattern, nPattern);
+}
+
+/*------------------------------------------------------------------------*/
+CU_ErrorCode CU_text_find_any(const char *pText, size_t nLength,
+                              const char * const *aszPatterns, unsigned int uiPatterns,
+                              const char **ppFound, unsigned int *puiPattern)
+{
+  const unsigned char *pByte = (const unsigned char*)pText;
+  unsigned int uiState = 0;
+  unsigned int uiPattern = 0;
+  CU_ErrorCode result;
+  size_t i;
+
+  assert(NULL != ppFound);
+
+  *ppFound = NULL;
+  if (CUE_SUCCESS != (result = build_automaton(aszPatterns, uiPatterns))) {
+    CU_set_error(result);
+    return result;
+  }
+
+  if (0 != f_auiOutput[0]) {
+    *ppFound = pText;
+    uiPattern = lowest_pattern(f_auiOutput[0]);
+  }
+  else {
+    for (i = 0 ; i < nLength ; i++) {
+      uiState = f_ausNext[uiState][pByte[i]];
+      if (0 != f_auiOutput[uiState]) {
+        uiPattern = lowest_pattern(f_auiOutput[uiState]);
+        *ppFound = pText + i + 1 - f_anPatternLength[uiPattern];
+        break;
+      }
+    }
+  }
+  if ((NULL != puiPattern) && (NULL != *ppFound)) {
+    *puiPattern = uiPattern;
+  }
+
+  CU_set_error(CUE_SUCCESS);
+  return CUE_SUCCESS;
+}
+
+/*------------------------------------------------------------------------*/
+size_t CU_text_count_lines(const char *pText, size_t nLength)
+{
+  if (0 == nLength) {
+    return 0;
+  }
+  return count_newlines(pText, nLength) + (('\n' != pText[nLength - 1]) ? 1 : 0);
+}
+
+/*------------------------------------------------------------------------*/
+void CU_text_position(const char *pText, const char *pAt, size_t *pnLine, size_t *pnColumn)
+{
+  const char *pLineStart = pAt;
+
+  assert(NULL != pnLine);
+  assert(NULL != pnColumn);
+  assert(pAt >= pText);
+
+  while ((pLineStart > pText) && ('\n' != pLineStart[-1])) {
+    pLineStart--;
+  }
+  *pnLine = count_newlines(pText, (size_t)(pLineStart - pText)) + 1;
+  *pnColumn = (size_t)(pAt - pLineStart) + 1;
+}
+
+/*------------------------------------------------------------------------*/
+CU_BOOL CU_assertContainsImplementation(const char *pText, size_t nLength,
+                                        const char *szPattern, CU_BOOL bExpected,
+                                        unsigned int uiLine, const char *strCondition,
+                                        const char *strFile, const char *strFunction,
+                                        CU_BOOL bFatal)
+{
+  char szCondition[MAX_NAME_LEN];
+  const char *pFound = CU_text_find(pText, nLength, szPattern);
+  size_t nLine;
+  size_t nColumn;
+
+  if ((CU_FALSE != bExpected) && (NULL == pFound)) {
+    snprintf(szCondition, sizeof(szCondition), "not found in %lu bytes: %s",
+             (unsigned long)nLength, strCondition);
+    return CU_assertImplementation(CU_FALSE, uiLine, szCondition, strFile, strFunction, bFatal);
+  }
+  if ((CU_FALSE == bExpected) && (NULL != pFound)) {
+    CU_text_position(pText, pFound, &nLine, &nColumn);
+    snprintf(szCondition, sizeof(szCondition), "found at line %lu, column %lu: %s",
+             (unsigned long)nLine, (unsigned long)nColumn, strCondition);
+    return CU_assertImplementation(CU_FALSE, uiLine, szCondition, strFile, strFunction, bFatal);
+  }
+  return CU_assertImplementation(CU_TRUE, uiLine, strCondition, strFile, strFunction, bFatal);
+}
+
+/*------------------------------------------------------------------------*/
+CU_BOOL CU_assertPatternsImplementation(const char *pText, size_t nLength,
+                                        const char * const *aszPatterns, unsigned int uiPatterns,
+                                        CU_BOOL bExpected,
+                                        unsigned int uiLine, const char *strCondition,
+                                        const char *strFile, const char *strFunction,
+                                        CU_BOOL bFatal)
+{
+  const unsigned char *pByte = (const unsigned char*)pText;
+  char szCondition[MAX_NAME_LEN];
+  const char *pFound;
+  unsigned int uiAll;
+  unsigned int uiFound;
+  unsigned int uiState = 0;
+  unsigned int uiPattern = 0;
+  size_t nLine;
+  size_t nColumn;
+  size_t i;
+
+  if (CU_FALSE == bExpected) {
+    if (CUE_SUCCESS != CU_text_find_any(pText, nLength, aszPatterns, uiPatterns, &pFound, &uiPattern)) {
+      snprintf(szCondition, sizeof(szCondition), "pattern set too large: %s", strCondition);
+      return CU_assertImplementation(CU_FALSE, uiLine, szCondition, strFile, strFunction, bFatal);
+    }
+    if (NULL != pFound) {
+      CU_text_position(pText, pFound, &nLine, &nColumn);
+      snprintf(szCondition, sizeof(szCondition), "pattern %u found at line %lu, column %lu: %s",
+               uiPattern, (unsigned long)nLine, (unsigned long)nColumn, strCondition);
+      return CU_assertImplementation(CU_FALSE, uiLine, szCondition, strFile, strFunction, bFatal);
+    }
+    return CU_assertImplementation(CU_TRUE, uiLine, strCondition, strFile, strFunction, bFatal);
+  }
+
+  if (CUE_SUCCESS != build_automaton(aszPatterns, uiPatterns)) {
+    snprintf(szCondition, sizeof(szCondition), "pattern set too large: %s", strCondition);
+    return CU_assertImplementation(CU_FALSE, uiLine, szCondition, strFile, strFunction, bFatal);
+  }
+  uiAll = (uiPatterns < 32) ? ((1U << uiPatterns) - 1) : 0xFFFFFFFFU;
+  uiFound = f_auiOutput[0];
+  for (i = 0 ; (i < nLength) && (uiFound != uiAll) ; i++) {
+    uiState = f_ausNext[uiState][pByte[i]];
+    uiFound |= f_auiOutput[uiState];
+  }
+  if (uiFound != uiAll) {
+    snprintf(szCondition, sizeof(szCondition), "pattern %u not found: %s",
+             lowest_pattern(uiAll & ~uiFound), strCondition);
+    return CU_assertImplementation(CU_FALSE, uiLine, szCondition, strFile, strFunction, bFatal);
+  }
+  return CU_assertImplementation(CU_TRUE, uiLine, strCondition, strFile, strFunction, bFatal);
+}
+
+/*------------------------------------------------------------------------*/
+CU_BOOL CU_assertSequenceImplementation(const char *pText, size_t nLength,
+                                        const char * const *aszPatterns, unsigned int uiPatterns,
+                                        unsigned int uiLine, const char *strCondition,
+                                        const char *strFile, const char *strFunction,
+                                        CU_BOOL bFatal)
+{
+  char szCondition[MAX_NAME_LEN];
+  const char *pCur = pText;
+  const char *pFound;
+  size_t nLine;
+  size_t nColumn;
+  unsigned int i;
+
+  assert((NULL != aszPatterns) || (0 == uiPatterns));
+
+  for (i = 0 ; i < uiPatterns ; i++) {
+    pFound = CU_text_find(pCur, nLength - (size_t)(pCur - pText), aszPatterns[i]);
+    if (NULL == pFound) {
+      CU_text_position(pText, pCur, &nLine, &nColumn);
+      snprintf(szCondition, sizeof(szCondition), "pattern %u not found after line %lu, column %lu: %s",
+               i, (unsigned long)nLine, (unsigned long)nColumn, strCondition);
+      return CU_assertImplementation(CU_FALSE, uiLine, szCondition, strFile, strFunction, bFatal);
+    }
+    pCur = pFound + strlen(aszPatterns[i]);
+  }
+  return CU_assertImplementation(CU_TRUE, uiLine, strCondition, strFile, strFunction, bFatal);
+}
+
+/*------------------------------------------------------------------------*/
+CU_BOOL CU_assertLineCountImplementation(const char *pText, size_t nLength, size_t nExpected,
+                                         unsigned int uiLine, const char *strCondition,
+                                         const char *strFile, const char *strFunction,
+                                         CU_BOOL bFatal)
+{
+  char szCondition[MAX_NAME_LEN];
+  size_t nLines = CU_text_count_lines(pText, nLength);
+
+  if (nLines != nExpected) {
+    snprintf(szCondition, sizeof(szCondition), "%lu lines, expected %lu: %s",
+             (unsigned long)nLines, (unsigned long)nExpected, strCondition);
+    return CU_assertImplementation(CU_FALSE, uiLine, szCondition, strFile, strFunction, bFatal);
+  }
+  return CU_assertImplementation(CU_TRUE, uiLine, strCondition, strFile, strFunction, bFatal);
+}
+
+/*=================================================================
+ *  Static module functions
+ *=================================================================*/
+/** Finds a pattern of at least one byte with memchr() on its first byte. */
+static const char* find_scalar(const char *pText, size_t nLength, const char *pPattern, size_t nPattern)
+{
+  const char *pLast;
+  const char *pCur = pText;
+
+  if (nPattern > nLength) {
+    return NULL;
+  }
+  pLast = pText + nLength - nPattern;
+  while ((pCur <= pLast) &&
+         (NULL != (pCur = (const char*)memchr(pCur, pPattern[0], (size_t)(pLast - pCur) + 1)))) {
+    if (0 == memcmp(pCur + 1, pPattern + 1, nPattern - 1)) {
+      return pCur;
+    }
+    pCur++;
+  }
+  return NULL;
+}
+
+/*------------------------------------------------------------------------*/
+/** Counts the newlines in a text. */
+static size_t count_newlines(const char *pText, size_t nLength)
+{
+  size_t nNewlines = 0;
+  size_t i = 0;
+
+#ifdef __SSE2__
+  const __m128i newline = _mm_set1_epi8('\n');
+  const __m128i zero = _mm_setzero_si128();
+  __m128i counts;
+  size_t nBlocks;
+
+  /* byte counters overflow after 255 blocks, so they are summed up in between */
+  while (i + 16 <= nLength) {
+    counts = zero;
+    for (nBlocks = 0 ; (nBlocks < 255) && (i + 16 <= nLength) ; nBlocks++, i += 16) {
+      counts = _mm_sub_epi8(counts, _mm_cmpeq_epi8(newline, _mm_loadu_si128((const __m128i*)(pText + i))));
+    }
+    counts = _mm_sad_epu8(counts, zero);
+    nNewlines += (size_t)_mm_cvtsi128_si32(counts) + (size_t)_mm_cvtsi128_si32(_mm_srli_si128(counts, 8));
+  }
+#endif
+
+  for ( ; i < nLength ; i++) {
+    if ('\n' == pText[i]) {
+      nNewlines++;
+    }
+  }
+  return nNewlines;
+}
+
+/*------------------------------------------------------------------------*/
+/**
+ *  Builds the Aho-Corasick automaton of a pattern set: a trie of the
+ *  patterns whose missing transitions are filled in from the failure
+ *  links in breadth-first order.
+ */
+static CU_ErrorCode build_automaton(const char * const *aszPatterns, unsigned int uiPatterns)
+{
+  const unsigned char *pByte;
+  unsigned int uiHead = 0;
+  unsigned int uiTail = 0;
+  unsigned int uiState;
+  unsigned int uiChild;
+  unsigned int uiPattern;
+  unsigned int c;
+
+  assert((NULL != aszPatterns) || (0 == uiPatterns));
+
+  if (uiPatterns > CU_TEXT_MAX_PATTERNS) {
+    return CUE_NOMEMORY;
+  }
+
+  memset(f_ausNext[0], 0, sizeof(f_ausNext[0]));
+  f_auiOutput[0] = 0;
+  f_uiStates = 1;
+  for (uiPattern = 0 ; uiPattern < uiPatterns ; uiPattern++) {
+    uiState = 0;
+    for (pByte = (const unsigned char*)aszPatterns[uiPattern] ; '\0' != *pByte ; pByte++) {
+      if (0 == f_ausNext[uiState][*pByte]) {
+        if (f_uiStates >= CU_TEXT_MAX_STATES) {
+          return CUE_NOMEMORY;
+        }
+        memset(f_ausNext[f_uiStates], 0, sizeof(f_ausNext[0]));
+        f_auiOutput[f_uiStates] = 0;
+        f_ausNext[uiState][*pByte] = (unsigned short)f_uiStates++;
+      }
+      uiState = f_ausNext[uiState][*pByte];
+    }
+    f_auiOutput[uiState] |= 1U << uiPattern;
+    f_anPatternLength[uiPattern] = (size_t)(pByte - (const unsigned char*)aszPatterns[uiPattern]);
+  }
+
+  for (c = 0 ; c < 256 ; c++) {
+    if (0 != (uiChild = f_ausNext[0][c])) {
+      f_ausFail[uiChild] = 0;
+      f_ausQueue[uiTail++] = (unsigned short)uiChild;
+    }
+  }
+  while (uiHead < uiTail) {
+    uiState = f_ausQueue[uiHead++];
+    f_auiOutput[uiState] |= f_auiOutput[f_ausFail[uiState]];
+    for (c = 0 ; c < 256 ; c++) {
+      if (0 != (uiChild = f_ausNext[uiState][c])) {
+        f_ausFail[uiChild] = f_ausNext[f_ausFail[uiState]][c];
+        f_ausQueue[uiTail++] = (unsigned short)uiChild;
+      }
+      else {
+        f_ausNext[uiState][c] = f_ausNext[f_ausFail[uiState]][c];
+      }
+    }
+  }
+  return CUE_SUCCESS;
+}
+
+/*------------------------------------------------------------------------*/
+/** Returns the index of the lowest pattern in a non-empty mask. */
+static unsigned int lowest_pattern(unsigned int uiMask)
+{
+#ifdef __GNUC__
+  return (unsigned int)__builtin_ctz(uiMask);
+#else
+  unsigned int uiPattern = 0;
+
+  while (0 == (uiMask & 1U)) {
+    uiMask >>= 1;
+    uiPattern++;
+  }
+  return uiPattern;
+#endif
+}
+
+/** @} */
@@ -48,6 +48,10 @@
 #include <ctype.h>
 #include <assert.h>
 #include <string.h>
+#include <time.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
 
 #include "CUnit.h"
 #include "TestDB.h"
@@ -78,5 +82,112 @@ size_t CU_number_width(int number)
 	return (strlen(buf));
 }
 
+/*------------------------------------------------------------------------*/
+size_t CU_get_heap_in_use(void)
+{
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || ((__GLIBC__ == 2) && (__GLIBC_MINOR__ >= 33)))
+  struct mallinfo2 info = mallinfo2();
+  return info.uordblks + info.hblkhd;
+#elif defined(__GLIBC__)
+  struct mallinfo info = mallinfo();
+  return (size_t)(unsigned int)info.uordblks + (size_t)(unsigned int)info.hblkhd;
+#else
+  return 0;
+#endif
+}
+
+/*------------------------------------------------------------------------*/
+unsigned long long CU_get_time_ns(void)
+{
+#ifdef LINUX
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (unsigned long long)now.tv_sec * 1000000000ULL + (unsigned long long)now.tv_nsec;
+#else
+  /* the tick counter behind CU_get_time(), which counts down from it */
+  return (unsigned long long)((double)tx_time_get() * (1e9 / (double)CLOCKS_PER_SEC));
+#endif
+}
+
+
+/*------------------------------------------------------------------------*/
+int CU_compare_doubles(const void *pA, const void *pB)
+{
+  double dA = *(const double*)pA;
+  double dB = *(const double*)pB;
+
+  return (dA > dB) - (dA < dB);
+}
+
+/*------------------------------------------------------------------------*/
+double CU_median_of_sorted(const double adValues[], unsigned int uiCount)
+{
+  assert(0 != uiCount);
+
+  return (0 != (uiCount % 2))
+         ? adValues[uiCount / 2]
+         : (adValues[uiCount / 2 - 1] + adValues[uiCount / 2]) / 2.0;
+}
+
+/*------------------------------------------------------------------------*/
+void CU_copy_name(char szDest[MAX_NAME_LEN], const char *szSrc)
+{
+  size_t nLength = strlen(szSrc);
+
+  if (nLength > MAX_NAME_LEN - 1) {
+    nLength = MAX_NAME_LEN - 1;
+  }
+  memcpy(szDest, szSrc, nLength);
+  szDest[nLength] = '\0';
+}
+
+/*------------------------------------------------------------------------*/
+unsigned int CU_split_tab_line(char *szLine, char *aszFields[], unsigned int uiMaxFields)
+{
+  unsigned int uiFields = 0;
+
+  assert(NULL != szLine);
+  assert(0 != uiMaxFields);
+
+  if (NULL == strchr(szLine, '\n')) {
+    return 0;
+  }
+  szLine[strcspn(szLine, "\r\n")] = '\0';
+
+  aszFields[uiFields++] = szLine;
+  for ( ; '\0' != *szLine ; szLine++) {
+    if ('\t' == *szLine) {
+      if (uiFields >= uiMaxFields) {
+        return 0;
+      }
+      *szLine = '\0';
+      aszFields[uiFields++] = szLine + 1;
+    }
+  }
+  return uiFields;
+}
+
+/*------------------------------------------------------------------------*/
+const void* CU_find_test_entry(const void *pEntries, size_t nEntrySize, unsigned int uiEntries,
+                               unsigned int *puiNext, const char *szSuiteName, const char *szTestName)
+{
+  const CU_TestNames *pNames;
+  unsigned int i;
+  unsigned int uiEntry;
+
+  assert(NULL != puiNext);
+
+  for (i = 0 ; i < uiEntries ; i++) {
+    uiEntry = (*puiNext + i) % uiEntries;
+    pNames = (const CU_TestNames*)((const char*)pEntries + uiEntry * nEntrySize);
+    if ((0 == strncmp(pNames->szTestName, szTestName, MAX_NAME_LEN - 1)) &&
+        (0 == strncmp(pNames->szSuiteName, szSuiteName, MAX_NAME_LEN - 1))) {
+      *puiNext = uiEntry + 1;
+      return pNames;
+    }
+  }
+  return NULL;
+}
 
 /** @} */
@@ -0,0 +1,111 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Baseline update tool for CUnit result logs.
+ *
+ *  19-Oct-2026   Initial implementation.
+ */
+
+/** @file
+ *  Writes a duration baseline from the result logs of several runs.
+ *
+ *  Usage: cu_baseline [-o baseline] log...
+ *
+ *  The baseline holds the median and the MAD of the elapsed time of
+ *  each passed test (see CU_baseline_build()) and is written to standard
+ *  output unless a file is given.  The file is only replaced once the
+ *  new baseline is complete.  The exit status is 2 on errors.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "CUnit.h"
+#include "Baseline.h"
+
+static void usage(void)
+{
+  fprintf(stderr, "usage: cu_baseline [-o baseline] log...\n");
+  exit(2);
+}
+
+int main(int argc, char *argv[])
+{
+  FILE *apLogs[CU_BASELINE_MAX_RUNS];
+  FILE *pOutput = stdout;
+  const char *szOutput = NULL;
+  char szTemp[1024];
+  CU_ErrorCode result;
+  unsigned int uiLogs = 0;
+  unsigned int i;
+  int opt;
+
+  while (-1 != (opt = getopt(argc, argv, "o:"))) {
+    switch (opt) {
+      case 'o': szOutput = optarg; break;
+      default:  usage();
+    }
+  }
+  if (optind >= argc) {
+    usage();
+  }
+  if (argc - optind > CU_BASELINE_MAX_RUNS) {
+    fprintf(stderr, "cu_baseline: at most %d logs can be used\n", CU_BASELINE_MAX_RUNS);
+    return 2;
+  }
+
+  for ( ; optind < argc ; optind++) {
+    if (NULL == (apLogs[uiLogs] = fopen(argv[optind], "r"))) {
+      perror(argv[optind]);
+      return 2;
+    }
+    uiLogs++;
+  }
+  if (NULL != szOutput) {
+    snprintf(szTemp, sizeof(szTemp), "%s.tmp", szOutput);
+    if (NULL == (pOutput = fopen(szTemp, "w"))) {
+      perror(szTemp);
+      return 2;
+    }
+  }
+
+  result = CU_baseline_build(apLogs, uiLogs, pOutput);
+
+  for (i = 0 ; i < uiLogs ; i++) {
+    fclose(apLogs[i]);
+  }
+  if ((NULL != szOutput) && (0 != fclose(pOutput)) && (CUE_SUCCESS == result)) {
+    result = CUE_WRITE_ERROR;
+  }
+  if (CUE_SUCCESS != result) {
+    fprintf(stderr, "cu_baseline: %s\n", CU_get_error_msg());
+    if (NULL != szOutput) {
+      remove(szTemp);
+    }
+    return 2;
+  }
+  if ((NULL != szOutput) && (0 != rename(szTemp, szOutput))) {
+    perror(szOutput);
+    return 2;
+  }
+
+  return 0;
+}
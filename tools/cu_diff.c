@@ -0,0 +1,109 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Comparison tool for result logs of two CUnit runs.
+ *
+ *  19-Oct-2026   Initial implementation.
+ */
+
+/** @file
+ *  Compares the result logs of two runs of a test executable.
+ *
+ *  Usage: cu_diff before-log after-log
+ *
+ *  Lists newly failing, newly passing, disappeared and added tests, and
+ *  the most significant changes of test durations, heap growth and
+ *  assertion counts (see CU_diff_result_logs()).  The exit status is 1
+ *  if tests are newly failing or disappeared, and 2 if the logs cannot
+ *  be compared.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "CUnit.h"
+#include "TestRun.h"
+#include "Export.h"
+
+static const char* const f_szTypes[] =
+  { "", "newly failing", "newly passing", "disappeared", "added", "time", "heap", "asserts" };
+
+/** Prints a change of the test set or of an outcome. */
+static void print_change(const CU_DiffEntry *pEntry)
+{
+  printf("  %-14s %s/%s\n", f_szTypes[pEntry->type], pEntry->strSuiteName, pEntry->strTestName);
+}
+
+/*------------------------------------------------------------------------*/
+static void print_delta(const CU_DiffEntry *pEntry)
+{
+  char szName[2 * MAX_NAME_LEN + 1];
+
+  snprintf(szName, sizeof(szName), "%s/%s", pEntry->strSuiteName, pEntry->strTestName);
+  if (CUDT_Time == pEntry->type) {
+    printf("  %-8s %-40s %10.6f s -> %10.6f s %8.1f\n", f_szTypes[pEntry->type], szName,
+           pEntry->dBefore, pEntry->dAfter, pEntry->dSignificance);
+  }
+  else {
+    printf("  %-8s %-40s %12.0f -> %12.0f %8.1f\n", f_szTypes[pEntry->type], szName,
+           pEntry->dBefore, pEntry->dAfter, pEntry->dSignificance);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+  FILE *pBefore;
+  FILE *pAfter;
+  CU_DiffSummary diff;
+  CU_ErrorCode result;
+  unsigned int i;
+
+  if (3 != argc) {
+    fprintf(stderr, "usage: cu_diff before-log after-log\n");
+    return 2;
+  }
+  if (NULL == (pBefore = fopen(argv[1], "r"))) {
+    perror(argv[1]);
+    return 2;
+  }
+  if (NULL == (pAfter = fopen(argv[2], "r"))) {
+    perror(argv[2]);
+    fclose(pBefore);
+    return 2;
+  }
+
+  printf("Changes:\n");
+  result = CU_diff_result_logs(pBefore, pAfter, print_change, &diff);
+  fclose(pBefore);
+  fclose(pAfter);
+  if (CUE_SUCCESS != result) {
+    fprintf(stderr, "cu_diff: %s\n", CU_get_error_msg());
+    return 2;
+  }
+
+  printf("\nMost significant deltas (%u of %u):\n", diff.uiNumberOfDeltas, diff.uiDeltas);
+  for (i = 0 ; i < diff.uiNumberOfDeltas ; i++) {
+    print_delta(&diff.aDeltas[i]);
+  }
+  printf("\n%u tests compared: %u newly failing, %u newly passing, %u disappeared, %u added\n\n",
+         diff.uiCompared, diff.uiNewlyFailing, diff.uiNewlyPassing, diff.uiDisappeared, diff.uiAdded);
+
+  return ((0 != diff.uiNewlyFailing) || (0 != diff.uiDisappeared)) ? 1 : 0;
+}
@@ -0,0 +1,138 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Merge tool for result logs of sharded CUnit runs.
+ *
+ *  19-Oct-2026   Initial implementation.
+ */
+
+/** @file
+ *  Merges the result logs of shards of one test executable.
+ *
+ *  Usage: cu_merge [-o merged-log] log...
+ *
+ *  The logs (see Export.h) are combined in registration order with
+ *  CU_merge_result_logs().  The failures and the summary of the merged
+ *  run are printed, and the merged log is written if requested.  The
+ *  exit status is 1 if there are failures, missing or duplicated
+ *  tests, or incomplete logs, and 2 if the logs cannot be merged.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "CUnit.h"
+#include "TestRun.h"
+#include "Export.h"
+
+/** Prints a failure record of the merged run. */
+static void print_failure(const CU_ResultRecord *pRecord)
+{
+  if (CURR_Failure == pRecord->type) {
+    printf("  %s/%s %s:%u - %s\n", pRecord->strSuiteName,
+           ('\0' != pRecord->strTestName[0]) ? pRecord->strTestName : "(suite)",
+           pRecord->strFileName, pRecord->uiLineNumber, pRecord->strCondition);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+static void print_summary(const CU_MergeSummary *pMerge, unsigned int uiLogs)
+{
+  const CU_RunSummary *pSummary = &pMerge->summary;
+
+  printf("\nRun Summary:    Type  Total    Ran Passed Failed Inactive\n");
+  printf("              suites %6u %6u    n/a %6u %8u\n",
+         pMerge->uiNumberOfSuites, pSummary->nSuitesRun, pSummary->nSuitesFailed, pSummary->nSuitesInactive);
+  printf("               tests %6u %6u %6u %6u %8u\n",
+         pMerge->uiNumberOfTests, pSummary->nTestsRun, pSummary->nTestsRun - pSummary->nTestsFailed,
+         pSummary->nTestsFailed, pSummary->nTestsInactive);
+  printf("             asserts %6u %6u %6u %6u      n/a\n",
+         pSummary->nAsserts, pSummary->nAsserts, pSummary->nAsserts - pSummary->nAssertsFailed,
+         pSummary->nAssertsFailed);
+  printf("\nMerged %u logs: %u missing, %u duplicated tests, %u incomplete logs, %.3f seconds\n\n",
+         uiLogs, pMerge->uiMissingTests, pMerge->uiDuplicateTests, pMerge->uiIncompleteLogs,
+         pSummary->ElapsedTime);
+}
+
+/*------------------------------------------------------------------------*/
+static void usage(void)
+{
+  fprintf(stderr, "usage: cu_merge [-o merged-log] log...\n");
+  exit(2);
+}
+
+int main(int argc, char *argv[])
+{
+  FILE *apLogs[CU_MERGE_MAX_LOGS];
+  FILE *pOutput = NULL;
+  const char *szOutput = NULL;
+  CU_MergeSummary merge;
+  CU_ErrorCode result;
+  unsigned int uiLogs = 0;
+  unsigned int i;
+  int opt;
+
+  while (-1 != (opt = getopt(argc, argv, "o:"))) {
+    switch (opt) {
+      case 'o': szOutput = optarg; break;
+      default:  usage();
+    }
+  }
+  if (optind >= argc) {
+    usage();
+  }
+  if (argc - optind > CU_MERGE_MAX_LOGS) {
+    fprintf(stderr, "cu_merge: at most %d logs can be merged\n", CU_MERGE_MAX_LOGS);
+    return 2;
+  }
+
+  for ( ; optind < argc ; optind++) {
+    if (NULL == (apLogs[uiLogs] = fopen(argv[optind], "r"))) {
+      perror(argv[optind]);
+      return 2;
+    }
+    uiLogs++;
+  }
+  if ((NULL != szOutput) && (NULL == (pOutput = fopen(szOutput, "w")))) {
+    perror(szOutput);
+    return 2;
+  }
+
+  printf("Failures:\n");
+  result = CU_merge_result_logs(apLogs, uiLogs, pOutput, print_failure, &merge);
+
+  for (i = 0 ; i < uiLogs ; i++) {
+    fclose(apLogs[i]);
+  }
+  if ((NULL != pOutput) && (0 != fclose(pOutput)) && (CUE_SUCCESS == result)) {
+    result = CUE_WRITE_ERROR;
+    CU_set_error(result);
+  }
+  if (CUE_SUCCESS != result) {
+    fprintf(stderr, "cu_merge: %s\n", CU_get_error_msg());
+    return 2;
+  }
+
+  print_summary(&merge, uiLogs);
+
+  return ((0 != merge.summary.nFailureRecords) || (0 != merge.uiMissingTests) ||
+          (0 != merge.uiDuplicateTests) || (0 != merge.uiIncompleteLogs)) ? 1 : 0;
+}
@@ -0,0 +1,474 @@
+/*
+ *  CUnit - A Unit testing framework library for C.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ *  Local orchestrator for running many CUnit test executables.
+ *
+ *  19-Oct-2026   Initial implementation.
+ */
+
+/** @file
+ *  Runs several CUnit test executables concurrently and merges their results.
+ *
+ *  Usage: cu_orchestrator [-j jobs] [-m megabytes] [-H history] [-l logdir] binary...
+ *
+ *  Each binary is started with CU_RESULT_FD naming the write end of a
+ *  pipe, through which the basic interface exports its result log (see
+ *  Export.h).  Binaries are launched longest-first according to the
+ *  durations recorded in the history file, as long as the number of
+ *  running binaries stays within the job limit and the sum of their
+ *  recorded peak resident sizes stays within the memory budget.  The
+ *  results of all binaries are merged into a single run summary.
+ *  Requires a LINUX build.
+ */
+
+#define _GNU_SOURCE  /* pipe2() */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "CUnit.h"
+#include "TestRun.h"
+#include "Export.h"
+
+#define MAX_BINARIES       256    /**< Maximum number of binaries per run. */
+#define MAX_PATH_LEN       512    /**< Maximum length of a binary path. */
+#define RESULT_FD          3      /**< Descriptor receiving the result log in children. */
+#define POLL_INTERVAL_MS   100    /**< Interval for checking on exited children. */
+#define DEFAULT_HISTORY    ".cu_orchestrator_history"
+
+/** Scheduling state of a binary. */
+typedef enum {
+  JOB_PENDING = 0,
+  JOB_RUNNING,
+  JOB_DONE
+} JobState;
+
+/** Bookkeeping for one test binary. */
+typedef struct {
+  char            szPath[MAX_PATH_LEN];
+  JobState        state;
+  double          dExpectedTime;   /**< Duration from history, < 0 if unknown. */
+  long            lExpectedRssKb;  /**< Peak RSS from history, 0 if unknown. */
+  pid_t           pid;
+  int             fdResults;       /**< Read end of the result pipe, -1 at EOF. */
+  FILE           *pResults;        /**< Spool for the result log. */
+  struct timespec start;
+  double          dElapsedTime;
+  long            lMaxRssKb;
+  int             iStatus;
+  CU_BOOL         fHaveSummary;
+  CU_RunSummary   summary;
+  unsigned int    uiNumberOfSuites;
+  unsigned int    uiNumberOfTests;
+} Job;
+
+static Job          f_jobs[MAX_BINARIES];
+static unsigned int f_nJobs = 0;
+
+/* entries of the history file which are not part of this run */
+static char         f_history_other[MAX_BINARIES][MAX_PATH_LEN + 64];
+static unsigned int f_nHistoryOther = 0;
+
+static double elapsed_since(const struct timespec *pStart)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)(now.tv_sec - pStart->tv_sec) + (double)(now.tv_nsec - pStart->tv_nsec) / 1e9;
+}
+
+/*------------------------------------------------------------------------*/
+/** Reads "seconds<TAB>rss-kb<TAB>path" lines from the history file. */
+static void load_history(const char *szFile)
+{
+  char szLine[MAX_PATH_LEN + 64];
+  char *pTab1, *pTab2;
+  unsigned int i;
+  FILE *file = fopen(szFile, "r");
+
+  if (NULL == file) {
+    return;
+  }
+  while (NULL != fgets(szLine, sizeof(szLine), file)) {
+    szLine[strcspn(szLine, "\r\n")] = '\0';
+    if ((NULL == (pTab1 = strchr(szLine, '\t'))) || (NULL == (pTab2 = strchr(pTab1 + 1, '\t')))) {
+      continue;
+    }
+    for (i = 0 ; i < f_nJobs ; i++) {
+      if (0 == strcmp(pTab2 + 1, f_jobs[i].szPath)) {
+        f_jobs[i].dExpectedTime = strtod(szLine, NULL);
+        f_jobs[i].lExpectedRssKb = strtol(pTab1 + 1, NULL, 10);
+        break;
+      }
+    }
+    if ((i == f_nJobs) && (f_nHistoryOther < MAX_BINARIES)) {
+      strcpy(f_history_other[f_nHistoryOther++], szLine);
+    }
+  }
+  fclose(file);
+}
+
+/*------------------------------------------------------------------------*/
+static void save_history(const char *szFile)
+{
+  unsigned int i;
+  FILE *file = fopen(szFile, "w");
+
+  if (NULL == file) {
+    fprintf(stderr, "cu_orchestrator: unable to write history file %s\n", szFile);
+    return;
+  }
+  for (i = 0 ; i < f_nJobs ; i++) {
+    if (JOB_DONE == f_jobs[i].state) {
+      fprintf(file, "%.3f\t%ld\t%s\n", f_jobs[i].dElapsedTime, f_jobs[i].lMaxRssKb, f_jobs[i].szPath);
+    }
+    else if (f_jobs[i].dExpectedTime >= 0.0) {
+      fprintf(file, "%.3f\t%ld\t%s\n", f_jobs[i].dExpectedTime, f_jobs[i].lExpectedRssKb, f_jobs[i].szPath);
+    }
+  }
+  for (i = 0 ; i < f_nHistoryOther ; i++) {
+    fprintf(file, "%s\n", f_history_other[i]);
+  }
+  fclose(file);
+}
+
+/*------------------------------------------------------------------------*/
+/** Longest recorded duration first; binaries without history go first. */
+static int compare_expected_time(const void *pA, const void *pB)
+{
+  const Job *pJobA = (const Job *)pA;
+  const Job *pJobB = (const Job *)pB;
+  double dA = (pJobA->dExpectedTime < 0.0) ? 1e300 : pJobA->dExpectedTime;
+  double dB = (pJobB->dExpectedTime < 0.0) ? 1e300 : pJobB->dExpectedTime;
+
+  return (dA < dB) ? 1 : ((dA > dB) ? -1 : 0);
+}
+
+/*------------------------------------------------------------------------*/
+static CU_BOOL launch(Job *pJob, const char *szLogDir)
+{
+  int fds[2];
+  int fdOut;
+  int fdPipe;
+  char szLog[MAX_PATH_LEN + 64];
+  char szFd[16];
+  const char *szBase;
+
+  if (0 != pipe2(fds, O_CLOEXEC)) {
+    perror("cu_orchestrator: pipe");
+    return CU_FALSE;
+  }
+  if (NULL == (pJob->pResults = tmpfile())) {
+    perror("cu_orchestrator: tmpfile");
+    close(fds[0]);
+    close(fds[1]);
+    return CU_FALSE;
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &pJob->start);
+  pJob->pid = fork();
+  if (0 == pJob->pid) {
+    /* child - results go to RESULT_FD, output to the log or nowhere */
+    fdPipe = fcntl(fds[1], F_DUPFD, RESULT_FD + 1);  /* clears O_CLOEXEC */
+    if (NULL != szLogDir) {
+      szBase = strrchr(pJob->szPath, '/');
+      snprintf(szLog, sizeof(szLog), "%s/%s.log", szLogDir, (NULL != szBase) ? szBase + 1 : pJob->szPath);
+      fdOut = open(szLog, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+    else {
+      fdOut = open("/dev/null", O_WRONLY);
+    }
+    if (fdOut >= 0) {
+      dup2(fdOut, STDOUT_FILENO);
+      dup2(fdOut, STDERR_FILENO);
+    }
+    dup2(fdPipe, RESULT_FD);
+    snprintf(szFd, sizeof(szFd), "%d", RESULT_FD);
+    setenv(CU_RESULT_FD_ENV, szFd, 1);
+    execl(pJob->szPath, pJob->szPath, (char *)NULL);
+    _exit(127);
+  }
+
+  close(fds[1]);
+  if (pJob->pid < 0) {
+    perror("cu_orchestrator: fork");
+    close(fds[0]);
+    fclose(pJob->pResults);
+    pJob->pResults = NULL;
+    return CU_FALSE;
+  }
+
+  pJob->fdResults = fds[0];
+  pJob->state = JOB_RUNNING;
+  return CU_TRUE;
+}
+
+/*------------------------------------------------------------------------*/
+/** Parses the spooled result log of a finished binary and reports its failures. */
+static void collect(Job *pJob)
+{
+  CU_ResultRecord record;
+
+  rewind(pJob->pResults);
+  while (CU_TRUE == CU_read_result_record(pJob->pResults, &record)) {
+    switch (record.type) {
+      case CURR_Header:
+        pJob->uiNumberOfSuites += record.uiNumberOfSuites;
+        pJob->uiNumberOfTests += record.uiNumberOfTests;
+        break;
+      case CURR_Failure:
+        printf("  %s: %s/%s %s:%u - %s\n", pJob->szPath, record.strSuiteName,
+               ('\0' != record.strTestName[0]) ? record.strTestName : "(suite)",
+               record.strFileName, record.uiLineNumber, record.strCondition);
+        break;
+      case CURR_Summary:
+        pJob->fHaveSummary = CU_TRUE;
+        pJob->summary.nSuitesRun += record.summary.nSuitesRun;
+        pJob->summary.nSuitesFailed += record.summary.nSuitesFailed;
+        pJob->summary.nSuitesInactive += record.summary.nSuitesInactive;
+        pJob->summary.nTestsRun += record.summary.nTestsRun;
+        pJob->summary.nTestsFailed += record.summary.nTestsFailed;
+        pJob->summary.nTestsInactive += record.summary.nTestsInactive;
+        pJob->summary.nAsserts += record.summary.nAsserts;
+        pJob->summary.nAssertsFailed += record.summary.nAssertsFailed;
+        pJob->summary.nFailureRecords += record.summary.nFailureRecords;
+        pJob->summary.ElapsedTime += record.summary.ElapsedTime;
+        break;
+      default:
+        break;
+    }
+  }
+  if (CUE_SUCCESS != CU_get_error()) {
+    fprintf(stderr, "cu_orchestrator: %s: %s\n", pJob->szPath, CU_get_error_msg());
+  }
+  fclose(pJob->pResults);
+  pJob->pResults = NULL;
+}
+
+/*------------------------------------------------------------------------*/
+/** Drains result pipes and reaps exited binaries.  Returns the number reaped. */
+static unsigned int service_running(unsigned int nRunning)
+{
+  struct pollfd fds[MAX_BINARIES];
+  Job *apJobs[MAX_BINARIES];
+  char buf[4096];
+  struct rusage usage;
+  unsigned int nFds = 0;
+  unsigned int nReaped = 0;
+  unsigned int i;
+  ssize_t n;
+  int status;
+
+  for (i = 0 ; i < f_nJobs ; i++) {
+    if ((JOB_RUNNING == f_jobs[i].state) && (f_jobs[i].fdResults >= 0)) {
+      fds[nFds].fd = f_jobs[i].fdResults;
+      fds[nFds].events = POLLIN;
+      apJobs[nFds++] = &f_jobs[i];
+    }
+  }
+
+  if (0 < poll(fds, nFds, POLL_INTERVAL_MS)) {
+    for (i = 0 ; i < nFds ; i++) {
+      if (0 == (fds[i].revents & (POLLIN | POLLHUP | POLLERR))) {
+        continue;
+      }
+      n = read(fds[i].fd, buf, sizeof(buf));
+      if (n > 0) {
+        fwrite(buf, 1, (size_t)n, apJobs[i]->pResults);
+      }
+      else if ((0 == n) || (EINTR != errno)) {
+        close(fds[i].fd);
+        apJobs[i]->fdResults = -1;
+      }
+    }
+  }
+  else if (0 == nFds) {
+    usleep(POLL_INTERVAL_MS * 1000);
+  }
+
+  for (i = 0 ; (i < f_nJobs) && (nReaped < nRunning) ; i++) {
+    if ((JOB_RUNNING != f_jobs[i].state) || (f_jobs[i].fdResults >= 0)) {
+      continue;
+    }
+    if (f_jobs[i].pid == wait4(f_jobs[i].pid, &status, WNOHANG, &usage)) {
+      f_jobs[i].dElapsedTime = elapsed_since(&f_jobs[i].start);
+      f_jobs[i].lMaxRssKb = usage.ru_maxrss;
+      f_jobs[i].iStatus = status;
+      f_jobs[i].state = JOB_DONE;
+      collect(&f_jobs[i]);
+      nReaped++;
+    }
+  }
+
+  return nReaped;
+}
+
+/*------------------------------------------------------------------------*/
+static void print_summary(void)
+{
+  CU_RunSummary total;
+  unsigned int nSuites = 0;
+  unsigned int nTests = 0;
+  unsigned int nBinariesFailed = 0;
+  unsigned int i;
+  CU_BOOL fPassed;
+
+  memset(&total, 0, sizeof(total));
+  printf("\n%-6s %10s %10s  %s\n", "Result", "Seconds", "Peak KB", "Binary");
+  for (i = 0 ; i < f_nJobs ; i++) {
+    Job *pJob = &f_jobs[i];
+    fPassed = (CU_BOOL)(pJob->fHaveSummary && WIFEXITED(pJob->iStatus) && (0 == WEXITSTATUS(pJob->iStatus)) &&
+                        (0 == pJob->summary.nFailureRecords));
+    if (CU_FALSE == fPassed) {
+      nBinariesFailed++;
+    }
+    printf("%-6s %10.3f %10ld  %s", fPassed ? "PASS" : "FAIL", pJob->dElapsedTime, pJob->lMaxRssKb, pJob->szPath);
+    if (WIFSIGNALED(pJob->iStatus)) {
+      printf(" (signal %d)", WTERMSIG(pJob->iStatus));
+    }
+    else if (CU_FALSE == pJob->fHaveSummary) {
+      printf(" (no results)");
+    }
+    printf("\n");
+
+    nSuites += pJob->uiNumberOfSuites;
+    nTests += pJob->uiNumberOfTests;
+    total.nSuitesRun += pJob->summary.nSuitesRun;
+    total.nSuitesFailed += pJob->summary.nSuitesFailed;
+    total.nSuitesInactive += pJob->summary.nSuitesInactive;
+    total.nTestsRun += pJob->summary.nTestsRun;
+    total.nTestsFailed += pJob->summary.nTestsFailed;
+    total.nTestsInactive += pJob->summary.nTestsInactive;
+    total.nAsserts += pJob->summary.nAsserts;
+    total.nAssertsFailed += pJob->summary.nAssertsFailed;
+    total.nFailureRecords += pJob->summary.nFailureRecords;
+    total.ElapsedTime += pJob->summary.ElapsedTime;
+  }
+
+  printf("\nRun Summary:    Type  Total    Ran Passed Failed Inactive\n");
+  printf("              suites %6u %6u    n/a %6u %8u\n",
+         nSuites, total.nSuitesRun, total.nSuitesFailed, total.nSuitesInactive);
+  printf("               tests %6u %6u %6u %6u %8u\n",
+         nTests, total.nTestsRun, total.nTestsRun - total.nTestsFailed, total.nTestsFailed, total.nTestsInactive);
+  printf("             asserts %6u %6u %6u %6u      n/a\n",
+         total.nAsserts, total.nAsserts, total.nAsserts - total.nAssertsFailed, total.nAssertsFailed);
+  printf("            binaries %6u %6u %6u %6u      n/a\n\n",
+         f_nJobs, f_nJobs, f_nJobs - nBinariesFailed, nBinariesFailed);
+}
+
+/*------------------------------------------------------------------------*/
+static void usage(void)
+{
+  fprintf(stderr, "usage: cu_orchestrator [-j jobs] [-m megabytes] [-H history] [-l logdir] binary...\n");
+  exit(2);
+}
+
+int main(int argc, char *argv[])
+{
+  const char *szHistory = DEFAULT_HISTORY;
+  const char *szLogDir = NULL;
+  long lJobs = sysconf(_SC_NPROCESSORS_ONLN);
+  long lBudgetKb = 0;
+  long lRunningKb = 0;
+  unsigned int nRunning = 0;
+  unsigned int nDone = 0;
+  unsigned int nReaped;
+  unsigned int i;
+  int opt;
+
+  while (-1 != (opt = getopt(argc, argv, "j:m:H:l:"))) {
+    switch (opt) {
+      case 'j': lJobs = strtol(optarg, NULL, 10); break;
+      case 'm': lBudgetKb = strtol(optarg, NULL, 10) * 1024; break;
+      case 'H': szHistory = optarg; break;
+      case 'l': szLogDir = optarg; break;
+      default:  usage();
+    }
+  }
+  if ((optind >= argc) || (lJobs < 1)) {
+    usage();
+  }
+
+  for ( ; (optind < argc) && (f_nJobs < MAX_BINARIES) ; optind++) {
+    memset(&f_jobs[f_nJobs], 0, sizeof(Job));
+    strncpy(f_jobs[f_nJobs].szPath, argv[optind], MAX_PATH_LEN - 1);
+    f_jobs[f_nJobs].dExpectedTime = -1.0;
+    f_jobs[f_nJobs].fdResults = -1;
+    f_nJobs++;
+  }
+  if (optind < argc) {
+    fprintf(stderr, "cu_orchestrator: only the first %d binaries are run\n", MAX_BINARIES);
+  }
+
+  load_history(szHistory);
+  qsort(f_jobs, f_nJobs, sizeof(Job), compare_expected_time);
+
+  while (nDone < f_nJobs) {
+    /* start binaries in schedule order while within the budgets */
+    for (i = 0 ; (i < f_nJobs) && (nRunning < (unsigned int)lJobs) ; i++) {
+      if (JOB_PENDING != f_jobs[i].state) {
+        continue;
+      }
+      if ((0 < lBudgetKb) && (0 < nRunning) && (lRunningKb + f_jobs[i].lExpectedRssKb > lBudgetKb)) {
+        break;
+      }
+      if (CU_TRUE == launch(&f_jobs[i], szLogDir)) {
+        nRunning++;
+        lRunningKb += f_jobs[i].lExpectedRssKb;
+      }
+      else {
+        f_jobs[i].state = JOB_DONE;
+        nDone++;
+      }
+    }
+
+    nReaped = service_running(nRunning);
+    if (0 < nReaped) {
+      nRunning -= nReaped;
+      nDone += nReaped;
+      lRunningKb = 0;
+      for (i = 0 ; i < f_nJobs ; i++) {
+        if (JOB_RUNNING == f_jobs[i].state) {
+          lRunningKb += f_jobs[i].lExpectedRssKb;
+        }
+      }
+    }
+  }
+
+  save_history(szHistory);
+  print_summary();
+
+  for (i = 0 ; i < f_nJobs ; i++) {
+    if ((CU_FALSE == f_jobs[i].fHaveSummary) || (0 != f_jobs[i].summary.nFailureRecords) ||
+        !WIFEXITED(f_jobs[i].iStatus) || (0 != WEXITSTATUS(f_jobs[i].iStatus))) {
+      return 1;
+    }
+  }
+  return 0;
+}